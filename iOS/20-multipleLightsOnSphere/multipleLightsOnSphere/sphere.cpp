@@ -17,7 +17,7 @@
 //     return 0;
 // }
 
-Sphere::Sphere()
+Sphere::Sphere() : welder(8, 0.00001f, 382)
 {
     maxElements = 0;
     numElements = 0;
@@ -714,38 +714,30 @@ void Sphere::processSphereData(short indices[760][9], float vertices[382][3], fl
 
 void Sphere::addTriangle(float single_vertex[3][3], float single_normal[3][3], float single_texture[3][3])
 {
-    //variable declarations
-    const float diff = 0.00001f;
-    int i, j;
-
     // normals should be of unit length
     normalizeVector(single_normal[0]);
     normalizeVector(single_normal[1]);
     normalizeVector(single_normal[2]);
 
-    for (i = 0; i < 3; i++)
+    for (int i = 0; i < 3; i++)
     {
-        for (j = 0; j < numVertices; j++) //for the first ever iteration of 'j', numVertices will be 0 because of it's initialization in the parameterized constructor
+        // position, normal and texture co-ordinates of ONE vertex, the welder returns the index of an identical one if there is any
+        float single[8] =
         {
-            if (isFoundIdentical(model_vertices[j * 3], single_vertex[i][0], diff) &&
-                isFoundIdentical(model_vertices[(j * 3) + 1], single_vertex[i][1], diff) &&
-                isFoundIdentical(model_vertices[(j * 3) + 2], single_vertex[i][2], diff) &&
+            single_vertex[i][0], single_vertex[i][1], single_vertex[i][2],
+            single_normal[i][0], single_normal[i][1], single_normal[i][2],
+            single_texture[i][0], single_texture[i][1]
+        };
 
-                isFoundIdentical(model_normals[j * 3], single_normal[i][0], diff) &&
-                isFoundIdentical(model_normals[(j * 3) + 1], single_normal[i][1], diff) &&
-                isFoundIdentical(model_normals[(j * 3) + 2], single_normal[i][2], diff) &&
+        unsigned int j = welder.add(single);
 
-                isFoundIdentical(model_textures[j * 2], single_texture[i][0], diff) &&
-                isFoundIdentical(model_textures[(j * 2) + 1], single_texture[i][1], diff))
-            {
-                model_elements[numElements] = (short)j;
-                numElements++;
-                break;
-            }
+        if (j == VertexWelder::FAILED || numElements >= maxElements)
+        {
+            continue;
         }
 
-        //If the single vertex, normal and texture do not match with the given, then add the corressponding triangle to the end of the list
-        if (j == numVertices && numVertices < maxElements && numElements < maxElements)
+        //If the single vertex, normal and texture do not match with the given, then add the corressponding vertex to the end of the list
+        if ((int)j == numVertices)
         {
             model_vertices[numVertices * 3] = single_vertex[i][0];
             model_vertices[(numVertices * 3) + 1] = single_vertex[i][1];
@@ -758,10 +750,11 @@ void Sphere::addTriangle(float single_vertex[3][3], float single_normal[3][3], f
             model_textures[numVertices * 2] = single_texture[i][0];
             model_textures[(numVertices * 2) + 1] = single_texture[i][1];
 
-            model_elements[numElements] = (short)numVertices; //adding the index to the end of the list of elements/indices
-            numElements++; //incrementing the 'end' of the list
             numVertices++; //incrementing coun of vertices
         }
+
+        model_elements[numElements] = (short)j; //adding the index to the end of the list of elements/indices
+        numElements++; //incrementing the 'end' of the list
     }
 }
 
@@ -778,13 +771,3 @@ void Sphere::normalizeVector(float v[3])
     v[1] = v[1] * 1.0f/squareRootOfSquaredVectorLength;
     v[2] = v[2] * 1.0f/squareRootOfSquaredVectorLength;
 }
-
-bool Sphere::isFoundIdentical(float val1, float val2, float diff)
-{
-    if(abs(val1 - val2) < diff)
-    {
-        return true;
-    }
- 
-    return false;
-}
@@ -3,7 +3,7 @@
 
 #import "GLESView.h"
 #import "vmath.h"
-#import "sphere.h"
+#import "primitives.h"
 
 enum
 {
@@ -29,9 +29,7 @@ const int numberOfColumns = 4;
     GLuint shaderProgramObject;
 
     GLuint vaoSphere;
-    GLuint vboSpherePosition;
-    GLuint vboSphereNormal;
-    GLuint vboSphereElement;
+    GLuint vboSphere;
     GLuint modelMatrixUniform;
     GLuint viewMatrixUniform;
     GLuint projectionMatrixUniform;
@@ -62,7 +60,6 @@ const int numberOfColumns = 4;
     GLfloat materialShininess[numberOfColumns][numberOfRows];
 
     CADisplayLink *displayLink;
-    SphereData sphereData;
 
     NSInteger aimationFrameInterval;
     NSInteger singleTapCounter;
@@ -92,9 +89,7 @@ const int numberOfColumns = 4;
         shaderProgramObject = 0;
 
         vaoSphere = 0;
-        vboSpherePosition = 0;
-        vboSphereNormal = 0;
-        vboSphereElement = 0;
+        vboSphere = 0;
         modelMatrixUniform = 0;
         viewMatrixUniform = 0;
         projectionMatrixUniform = 0;
@@ -291,12 +286,6 @@ const int numberOfColumns = 4;
 
         [self listExtensions];
 
-        Sphere *sphere = new Sphere();
-        sphere->getSphereVertexData(&sphereData);
-
-        delete sphere;
-        sphere = NULL;
-
         // Initialize the shaders and shader program object.
         [self initializeGestures];
         [self initializeVertexShader];
@@ -713,30 +702,21 @@ const int numberOfColumns = 4;
     glGenVertexArrays(1, &vaoSphere);
     glBindVertexArray(vaoSphere);
 
-    glGenBuffers(1, &vboSpherePosition);
-    glBindBuffer(GL_ARRAY_BUFFER, vboSpherePosition);
+    // primitives::sphere is built by the compiler and holds the interleaved vertices followed by
+    // the elements, so one upload from read only data fills the whole buffer, which the VAO then
+    // uses for both the attributes and the elements.
+    glGenBuffers(1, &vboSphere);
+    glBindBuffer(GL_ARRAY_BUFFER, vboSphere);
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 1146, sphereData.vertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(primitives::sphere), &primitives::sphere, GL_STATIC_DRAW);
+    glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, primitives::STRIDE, (const GLvoid *)primitives::POSITION_OFFSET);
     glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    glGenBuffers(1, &vboSphereNormal);
-    glBindBuffer(GL_ARRAY_BUFFER, vboSphereNormal);
-
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 1146, sphereData.normals, GL_STATIC_DRAW);
-    glVertexAttribPointer(CG_ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+    glVertexAttribPointer(CG_ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, primitives::STRIDE, (const GLvoid *)primitives::NORMAL_OFFSET);
     glEnableVertexAttribArray(CG_ATTRIBUTE_NORMAL);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    glGenBuffers(1, &vboSphereElement);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboSphereElement);
-
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(short) * 2280, sphereData.elements, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboSphere);
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     glBindVertexArray(0);
 }
@@ -840,10 +820,8 @@ const int numberOfColumns = 4;
     // Now bind the VAO to which we want to use
     glBindVertexArray(vaoSphere);
 
-    // Draw the sphere
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboSphereElement);
-    glDrawElements(GL_TRIANGLES, sphereData.numberOfElements, GL_UNSIGNED_SHORT, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    // Draw the sphere, the element buffer binding is part of the VAO
+    glDrawElements(GL_TRIANGLES, primitives::sphere.numberOfElements, GL_UNSIGNED_SHORT, (const GLvoid *)primitives::elementsOffset(primitives::sphere));
 
     // unbind the vao
     glBindVertexArray(0);
@@ -919,22 +897,10 @@ const int numberOfColumns = 4;
         vaoSphere = 0;
     }
 
-    if(vboSpherePosition)
+    if(vboSphere)
     {
-        glDeleteBuffers(1, &vboSpherePosition);
-        vboSpherePosition = 0;
-    }
-
-    if(vboSphereNormal)
-    {
-        glDeleteBuffers(1, &vboSphereNormal);
-        vboSphereNormal = 0;
-    }
-
-    if(vboSphereElement)
-    {
-        glDeleteBuffers(1, &vboSphereElement);
-        vboSphereElement = 0;
+        glDeleteBuffers(1, &vboSphere);
+        vboSphere = 0;
     }
 
     if(shaderProgramObject)
@@ -970,16 +936,6 @@ const int numberOfColumns = 4;
 
     glUseProgram(0);
 
-    free(sphereData.vertices);
-    free(sphereData.normals);
-    free(sphereData.textureCoordinates);
-    free(sphereData.elements);
-
-    sphereData.vertices = NULL;
-    sphereData.normals = NULL;
-    sphereData.textureCoordinates = NULL;
-    sphereData.elements = NULL;
-
     if(depthRenderbuffer)
     {
         glDeleteRenderbuffers(1, &depthRenderbuffer);
@@ -1,3 +1,3 @@
 mkdir -p sphereWithLight.app/Contents/MacOS
 
-clang++ -o sphereWithLight.app/Contents/MacOS/sphereWithLight *.mm -framework Cocoa -framework QuartzCore -framework OpenGL
+clang++ -I../../xWindows/pp/common -o sphereWithLight.app/Contents/MacOS/sphereWithLight *.mm -framework Cocoa -framework QuartzCore -framework OpenGL
@@ -1,3 +1,3 @@
 mkdir -p perVertexLight.app/Contents/MacOS
 
-clang++ -o perVertexLight.app/Contents/MacOS/perVertexLight *.mm -framework Cocoa -framework QuartzCore -framework OpenGL
+clang++ -I../../xWindows/pp/common -o perVertexLight.app/Contents/MacOS/perVertexLight *.mm -framework Cocoa -framework QuartzCore -framework OpenGL
@@ -3,6 +3,8 @@
 #include <string.h>
 #include <math.h>
 
+#include "vertexWelder.h"
+
 struct SphereData
 {
 	float *vertices;
@@ -25,10 +27,11 @@ private:
     float model_textures[764];
     short model_elements[2280];
 
+    VertexWelder welder;
+
 	void processSphereData(short indices[760][9], float vertices[382][3], float normals[382][3], float textures[1][2]);
     void addTriangle(float single_vertex[3][3], float single_normal[3][3], float single_texture[3][3]);
     void normalizeVector(float v[3]);
-    bool isFoundIdentical(float val1, float val2, float diff);
 
 public:
 	Sphere();
@@ -1,3 +1,3 @@
 mkdir -p perFragmentLight.app/Contents/MacOS
 
-clang++ -o perFragmentLight.app/Contents/MacOS/perFragmentLight *.mm -framework Cocoa -framework QuartzCore -framework OpenGL
+clang++ -I../../xWindows/pp/common -o perFragmentLight.app/Contents/MacOS/perFragmentLight *.mm -framework Cocoa -framework QuartzCore -framework OpenGL
@@ -1,3 +1,3 @@
 mkdir -p perVertexAndFragmentLight.app/Contents/MacOS
 
-clang++ -o perVertexAndFragmentLight.app/Contents/MacOS/perVertexAndFragmentLight *.mm -framework Cocoa -framework QuartzCore -framework OpenGL
+clang++ -I../../xWindows/pp/common -o perVertexAndFragmentLight.app/Contents/MacOS/perVertexAndFragmentLight *.mm -framework Cocoa -framework QuartzCore -framework OpenGL
@@ -1,3 +1,3 @@
 mkdir -p multipleLightsOnSphere.app/Contents/MacOS
 
-clang++ -o multipleLightsOnSphere.app/Contents/MacOS/multipleLightsOnSphere *.mm *.cpp -framework Cocoa -framework QuartzCore -framework OpenGL
+clang++ -I../../xWindows/pp/common -o multipleLightsOnSphere.app/Contents/MacOS/multipleLightsOnSphere *.mm *.cpp -framework Cocoa -framework QuartzCore -framework OpenGL
@@ -645,7 +645,7 @@ const int numberOfColumns = 4;
     glGenBuffers(1, &vboSpherePosition);
     glBindBuffer(GL_ARRAY_BUFFER, vboSpherePosition);
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 1146, sphereData.vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 3 * sphereData.numberOfVertices, sphereData.vertices, GL_STATIC_DRAW);
     glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, NULL);
     glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
 
@@ -654,7 +654,7 @@ const int numberOfColumns = 4;
     glGenBuffers(1, &vboSphereNormal);
     glBindBuffer(GL_ARRAY_BUFFER, vboSphereNormal);
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 1146, sphereData.normals, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 3 * sphereData.numberOfVertices, sphereData.normals, GL_STATIC_DRAW);
     glVertexAttribPointer(CG_ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, 0, NULL);
     glEnableVertexAttribArray(CG_ATTRIBUTE_NORMAL);
 
@@ -663,7 +663,14 @@ const int numberOfColumns = 4;
     glGenBuffers(1, &vboSphereElement);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboSphereElement);
 
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(short) * 2280, sphereData.elements, GL_STATIC_DRAW);
+    if(sphereData.elements32 != NULL)
+    {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * sphereData.numberOfElements, sphereData.elements32, GL_STATIC_DRAW);
+    }
+    else
+    {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(short) * sphereData.numberOfElements, sphereData.elements, GL_STATIC_DRAW);
+    }
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
@@ -790,7 +797,7 @@ const int numberOfColumns = 4;
 
     // Draw the sphere
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboSphereElement);
-    glDrawElements(GL_TRIANGLES, sphereData.numberOfElements, GL_UNSIGNED_SHORT, 0);
+    glDrawElements(GL_TRIANGLES, sphereData.numberOfElements, sphereData.elements32 != NULL ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
     // unbind the vao
@@ -885,11 +892,13 @@ const int numberOfColumns = 4;
     free(sphereData.normals);
     free(sphereData.textureCoordinates);
     free(sphereData.elements);
+    free(sphereData.elements32);
 
     sphereData.vertices = NULL;
     sphereData.normals = NULL;
     sphereData.textureCoordinates = NULL;
     sphereData.elements = NULL;
+    sphereData.elements32 = NULL;
 
     [super dealloc];
 }
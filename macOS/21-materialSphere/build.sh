@@ -1,3 +1,3 @@
 mkdir -p materialSphere.app/Contents/MacOS
 
-clang++ -o materialSphere.app/Contents/MacOS/materialSphere *.mm *.cpp -framework Cocoa -framework QuartzCore -framework OpenGL
+clang++ -I../../xWindows/pp/common -o materialSphere.app/Contents/MacOS/materialSphere *.mm *.cpp -framework Cocoa -framework QuartzCore -framework OpenGL
@@ -3,35 +3,46 @@
 #include <string.h>
 #include <math.h>
 
+#include "vertexWelder.h"
+
+// Exactly one of elements and elements32 is set: elements (drawn as GL_UNSIGNED_SHORT) while the
+// vertices fit in 16 bit indices, elements32 (GL_UNSIGNED_INT) for higher resolutions.
 struct SphereData
 {
 	float *vertices;
 	float *normals;
 	float *textureCoordinates;
 	short *elements;
+	unsigned int *elements32;
 	int numberOfVertices;
 	int numberOfElements;
 };
 
+// Generates an indexed sphere centered at the origin with the poles on the y axis, either as a
+// grid of slices and stacks or as a subdivided icosahedron. Sphere() gives the 20 x 20 sphere,
+// 760 triangles, that used to be stored here as tables.
 class Sphere
 {
 private:
-	int maxElements;
-    int numElements;
-    int numVertices;
-
-    float model_vertices[1146];
-    float model_normals[1146];
-    float model_textures[764];
-    short model_elements[2280];
+	bool isIcosphere;
+	int slices;
+	int stacks;
+	int subdivisionLevel;
+	float radius;
 
-	void processSphereData(short indices[760][9], float vertices[382][3], float normals[382][3], float textures[1][2]);
-    void addTriangle(float single_vertex[3][3], float single_normal[3][3], float single_texture[3][3]);
-    void normalizeVector(float v[3]);
-    bool isFoundIdentical(float val1, float val2, float diff);
+	void generateSlicesAndStacks(SphereData *data);
+	void generateIcosphere(SphereData *data);
+	bool allocateSphereData(SphereData *data, int numberOfVertices, int numberOfElements);
+	void setVertex(SphereData *data, int index, float x, float y, float z, float u, float v);
+	void setElement(SphereData *data, int position, unsigned int index);
 
 public:
 	Sphere();
+	Sphere(int slices, int stacks, float radius = 0.5f);
 
+	// 20 * 4^subdivisionLevel triangles.
+	static Sphere icosphere(int subdivisionLevel, float radius = 0.5f);
+
+	// Allocates the arrays in data with malloc(), the caller frees them.
 	void getSphereVertexData(SphereData *data);
-};
\ No newline at end of file
+};
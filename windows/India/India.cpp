@@ -7,6 +7,7 @@
 #include <gl/glu.h>
 
 #include "resources/resource.h"
+#include "pathTessellator.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -24,17 +25,26 @@ const GLfloat LINE_WIDTH = 5.0f;
 GLfloat colorSaffron[3] = {255.0f / 255.0f, 153.0f / 255.0f, 51.0f / 255.0f};
 GLfloat colorIndiaGreen[3] = {19.0f / 255.0f, 136.0f / 255.0f, 8.0f / 255.0f};
 
+// The letters never change, so each is tessellated once and only placed every frame.
+PathTessellator paths;
+int letterI = PathTessellator::INVALID;
+int letterN = PathTessellator::INVALID;
+int letterD = PathTessellator::INVALID;
+int letterA = PathTessellator::INVALID;
+int flag = PathTessellator::INVALID;
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
 void initialize(void);
 void cleanUp(void);
 void display(void);
+void initializeIndia(void);
 void drawIndia(void);
-void drawI();
-void drawN();
-void drawD();
-void drawA();
-void drawFlag();
+void addI(Path *letter);
+void addN(Path *letter);
+void addD(Path *letter);
+void addA(Path *letter);
+void addFlag(Path *stripes);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -232,6 +242,8 @@ void initialize(void)
     glDepthFunc(GL_LEQUAL);
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
+    initializeIndia();
+
     // This is required for DirectX
     resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -243,134 +255,124 @@ void display(void)
     SwapBuffers(hdc);
 }
 
+void initializeIndia(void)
+{
+    Path shape;
+
+    addI(&shape);
+    letterI = paths.hairline(shape);
+
+    shape.clear();
+    addN(&shape);
+    letterN = paths.hairline(shape);
+
+    shape.clear();
+    addD(&shape);
+    letterD = paths.hairline(shape);
+
+    shape.clear();
+    addA(&shape);
+    letterA = paths.hairline(shape);
+
+    shape.clear();
+    addFlag(&shape);
+    flag = paths.hairline(shape);
+}
+
 void drawIndia(void)
 {
     glMatrixMode(GL_MODELVIEW);
+    glLineWidth(LINE_WIDTH);
     glLoadIdentity();
 
     glTranslatef(-2.5f, 0.0f, -6.0f);
-    drawI();
+    paths.draw(letterI);
 
     glLoadIdentity();
     glTranslatef(-1.25, 0.0f, -6.0f);
-    drawN();
+    paths.draw(letterN);
 
     glLoadIdentity();
     glTranslatef(0.0f, 0.0f, -6.0f);
-    drawD();
+    paths.draw(letterD);
 
     glLoadIdentity();
     glTranslatef(1.25f, 0.0f, -6.0f);
-    drawI();
+    paths.draw(letterI);
 
     glLoadIdentity();
     glTranslatef(2.5f, 0.0f, -6.0f);
-    drawA();
+    paths.draw(letterA);
 
     glLoadIdentity();
     glTranslatef(2.5f, 0.0f, -6.0f);
-    drawFlag();
+    paths.draw(flag);
 }
 
-void drawI()
+void addI(Path *letter)
 {
-    glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.0f, -1.0f, 0.0f);
-
-    glEnd();
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.0f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(0.0f, -1.0f);
 }
 
-void drawN()
+void addN(Path *letter)
 {
-    glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.25f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.25f, -1.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.25f, -1.0f, 0.0f);
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(-0.25f, 1.0f, 0.0f);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(-0.25f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(-0.25f, -1.0f, 0.0f);
-
-    glEnd();
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.25f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(0.25f, -1.0f);
+    letter->setColor(colorSaffron);
+    letter->lineTo(-0.25f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(-0.25f, -1.0f);
 }
 
-void drawD()
+void addD(Path *letter)
 {
-    glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.25f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.25f, -1.0f, 0.0f);
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.25f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(0.25f, -1.0f);
 
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.25f + (LINE_WIDTH * 0.5f * 0.01f), 1.0f, 0.0f);
-    glVertex3f(-0.3f, 1.0f, 0.0f);
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.25f + (LINE_WIDTH * 0.5f * 0.01f), 1.0f);
+    letter->lineTo(-0.3f, 1.0f);
 
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(-0.25f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(-0.25f, -1.0f, 0.0f);
+    letter->moveTo(-0.25f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(-0.25f, -1.0f);
 
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.25f + (LINE_WIDTH * 0.5f * 0.01f), -1.0f, 0.0f);
-    glVertex3f(-0.3f, -1.0f, 0.0f);
-
-    glEnd();
+    letter->moveTo(0.25f + (LINE_WIDTH * 0.5f * 0.01f), -1.0f);
+    letter->lineTo(-0.3f, -1.0f);
 }
 
-void drawA()
+void addA(Path *letter)
 {
-    glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(-0.25f, -1.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.25f, -1.0f, 0.0f);
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-
-    glEnd();
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.0f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(-0.25f, -1.0f);
+
+    letter->moveTo(0.25f, -1.0f);
+    letter->setColor(colorSaffron);
+    letter->lineTo(0.0f, 1.0f);
 }
 
-void drawFlag()
+void addFlag(Path *stripes)
 {
-    glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
+    stripes->setColor(colorSaffron);
+    stripes->moveTo(0.25f * 0.5f, 0.025f);
+    stripes->lineTo(-0.25 * 0.5f, 0.025f);
 
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.25f * 0.5f, 0.025f, 0.0f);
-    glVertex3f(-0.25 * 0.5f, 0.025f, 0.0f);
+    stripes->setColor(1.0f, 1.0f, 1.0f);
+    stripes->moveTo(0.26f * 0.5f, 0.0f);
+    stripes->lineTo(-0.26f * 0.5f, 0.0f);
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glVertex3f(0.26f * 0.5f, 0.0f, 0.0f);
-    glVertex3f(-0.26f * 0.5f, 0.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.27f * 0.5f, -0.025, 0.0f);
-    glVertex3f(-0.27f * 0.5f, -0.025, 0.0f);
-
-    glEnd();
+    stripes->setColor(colorIndiaGreen);
+    stripes->moveTo(0.27f * 0.5f, -0.025f);
+    stripes->lineTo(-0.27f * 0.5f, -0.025f);
 }
 
 void resize(int width, int height)
@@ -426,6 +428,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    paths.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
@@ -10,6 +10,7 @@
 #include <stdio.h>
 
 #include "resources/resource.h"
+#include "pathTessellator.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -44,12 +45,29 @@ GLfloat translationFactorFlag = 0.0f;
 GLfloat colorSaffron[3] = {255.0f / 255.0f, 153.0f / 255.0f, 51.0f / 255.0f};
 GLfloat colorIndiaGreen[3] = {19.0f / 255.0f, 136.0f / 255.0f, 8.0f / 255.0f};
 
+// The letters and the flag are tessellated once, the animation only changes the matrices and the
+// light they are drawn with.
+PathTessellator paths;
+int letterI = PathTessellator::INVALID;
+int letterN = PathTessellator::INVALID;
+int letterD = PathTessellator::INVALID;
+int letterA = PathTessellator::INVALID;
+int saffronStripe = PathTessellator::INVALID;
+int whiteStripe = PathTessellator::INVALID;
+int greenStripe = PathTessellator::INVALID;
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
 void initialize(void);
 void cleanUp(void);
 void update(void);
 void display(void);
+void initializeIndia(void);
+void addI(Path *letter);
+void addN(Path *letter);
+void addD(Path *letter);
+void addA(Path *letter);
+void addFlagStripe(Path *stripe, const GLfloat *color, GLfloat y);
 void drawIndia(void);
 bool drawIOne(void);
 bool drawITwo(void);
@@ -57,6 +75,7 @@ bool drawN(void);
 bool drawD(void);
 bool drawA(void);
 bool drawFlag(void);
+void drawFlagStripe(int stripe, GLfloat start, GLfloat end);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -257,10 +276,104 @@ void initialize(void)
     glDepthFunc(GL_LEQUAL);
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
+    initializeIndia();
+
     // This is required for DirectX
     resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
 
+void initializeIndia(void)
+{
+    const GLfloat white[] = {1.0f, 1.0f, 1.0f};
+    Path shape;
+
+    addI(&shape);
+    letterI = paths.hairline(shape);
+
+    shape.clear();
+    addN(&shape);
+    letterN = paths.hairline(shape);
+
+    shape.clear();
+    addD(&shape);
+    letterD = paths.hairline(shape);
+
+    shape.clear();
+    addA(&shape);
+    letterA = paths.hairline(shape);
+
+    shape.clear();
+    addFlagStripe(&shape, colorSaffron, 0.025f);
+    saffronStripe = paths.hairline(shape);
+
+    shape.clear();
+    addFlagStripe(&shape, white, 0.0f);
+    whiteStripe = paths.hairline(shape);
+
+    shape.clear();
+    addFlagStripe(&shape, colorIndiaGreen, -0.025f);
+    greenStripe = paths.hairline(shape);
+}
+
+void addI(Path *letter)
+{
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.0f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(0.0f, -1.0f);
+}
+
+void addN(Path *letter)
+{
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.25f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(0.25f, -1.0f);
+    letter->setColor(colorSaffron);
+    letter->lineTo(-0.25f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(-0.25f, -1.0f);
+}
+
+void addD(Path *letter)
+{
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.25f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(0.25f, -1.0f);
+
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.25f + (LINE_WIDTH * 0.5f * 0.01f), 1.0f);
+    letter->lineTo(-0.3f, 1.0f);
+
+    letter->moveTo(-0.25f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(-0.25f, -1.0f);
+
+    letter->moveTo(0.25f + (LINE_WIDTH * 0.5f * 0.01f), -1.0f);
+    letter->lineTo(-0.3f, -1.0f);
+}
+
+void addA(Path *letter)
+{
+    letter->setColor(colorSaffron);
+    letter->moveTo(0.0f, 1.0f);
+    letter->setColor(colorIndiaGreen);
+    letter->lineTo(-0.25f, -1.0f);
+
+    letter->moveTo(0.25f, -1.0f);
+    letter->setColor(colorSaffron);
+    letter->lineTo(0.0f, 1.0f);
+}
+
+// One unit long from the origin, drawFlagStripe() stretches it to where the stripe reaches.
+void addFlagStripe(Path *stripe, const GLfloat *color, GLfloat y)
+{
+    stripe->setColor(color);
+    stripe->moveTo(0.0f, y);
+    stripe->lineTo(1.0f, y);
+}
+
 void update()
 {
     double difference = 0.0f;
@@ -347,15 +460,7 @@ bool drawIOne()
     glTranslatef(position, 0.0f, Z_TRANSLATION);
 
     glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.0f, -1.0f, 0.0f);
-
-    glEnd();
+    paths.draw(letterI);
 
     return done;
 }
@@ -375,15 +480,7 @@ bool drawITwo()
     glTranslatef(1.5f, position, Z_TRANSLATION);
 
     glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.0f, -1.0f, 0.0f);
-
-    glEnd();
+    paths.draw(letterI);
 
     return done;
 }
@@ -403,24 +500,7 @@ bool drawN()
     glTranslatef(-1.5, position, Z_TRANSLATION);
 
     glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.25f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.25f, -1.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.25f, -1.0f, 0.0f);
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(-0.25f, 1.0f, 0.0f);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(-0.25f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(-0.25f, -1.0f, 0.0f);
-
-    glEnd();
+    paths.draw(letterN);
 
     return done;
 }
@@ -436,31 +516,23 @@ bool drawD()
         done = true;
     }
 
+    // The colors of D are in its buffer, so it fades in through the light instead: lit without
+    // any lights, a vertex gets its color times the ambient of the light model.
+    GLfloat ambient[] = {colorFactor, colorFactor, colorFactor, 1.0f};
+
     glLoadIdentity();
     glTranslatef(0.0f, 0.0f, Z_TRANSLATION);
 
-    glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0] * colorFactor, colorSaffron[1] * colorFactor, colorSaffron[2] * colorFactor);
-    glVertex3f(0.25f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0] * colorFactor, colorIndiaGreen[1] * colorFactor, colorIndiaGreen[2] * colorFactor);
-    glVertex3f(0.25f, -1.0f, 0.0f);
+    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, ambient);
+    glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT);
+    glEnable(GL_COLOR_MATERIAL);
+    glEnable(GL_LIGHTING);
 
-    glColor3f(colorSaffron[0] * colorFactor, colorSaffron[1] * colorFactor, colorSaffron[2] * colorFactor);
-    glVertex3f(0.25f + (LINE_WIDTH * 0.5f * 0.01f), 1.0f, 0.0f);
-    glVertex3f(-0.3f, 1.0f, 0.0f);
-
-    glColor3f(colorSaffron[0] * colorFactor, colorSaffron[1] * colorFactor, colorSaffron[2] * colorFactor);
-    glVertex3f(-0.25f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0] * colorFactor, colorIndiaGreen[1] * colorFactor, colorIndiaGreen[2] * colorFactor);
-    glVertex3f(-0.25f, -1.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0] * colorFactor, colorIndiaGreen[1] * colorFactor, colorIndiaGreen[2] * colorFactor);
-    glVertex3f(0.25f + (LINE_WIDTH * 0.5f * 0.01f), -1.0f, 0.0f);
-    glVertex3f(-0.3f, -1.0f, 0.0f);
+    glLineWidth(LINE_WIDTH);
+    paths.draw(letterD);
 
-    glEnd();
+    glDisable(GL_LIGHTING);
+    glDisable(GL_COLOR_MATERIAL);
 
     return done;
 }
@@ -480,19 +552,7 @@ bool drawA()
     glTranslatef(position, 0.0f, Z_TRANSLATION);
 
     glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(-0.25f, -1.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(0.25f, -1.0f, 0.0f);
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-
-    glEnd();
+    paths.draw(letterA);
 
     return done;
 }
@@ -518,25 +578,22 @@ bool drawFlag()
     glTranslatef(0.0f, 0.0f, Z_TRANSLATION);
 
     glLineWidth(LINE_WIDTH);
-    glBegin(GL_LINES);
-
-    glColor3f(colorSaffron[0], colorSaffron[1], colorSaffron[2]);
-    glVertex3f(start - 0.13f, 0.025f, 0.0f);
-    glVertex3f(end + 0.13f, 0.025f, 0.0f);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glVertex3f(start - 0.14f, 0.0f, 0.0f);
-    glVertex3f(end + 0.14f, 0.0f, 0.0f);
-
-    glColor3f(colorIndiaGreen[0], colorIndiaGreen[1], colorIndiaGreen[2]);
-    glVertex3f(start - 0.15f, -0.025, 0.0f);
-    glVertex3f(end + 0.15f, -0.025, 0.0f);
-
-    glEnd();
+    drawFlagStripe(saffronStripe, start - 0.13f, end + 0.13f);
+    drawFlagStripe(whiteStripe, start - 0.14f, end + 0.14f);
+    drawFlagStripe(greenStripe, start - 0.15f, end + 0.15f);
 
     return done;
 }
 
+void drawFlagStripe(int stripe, GLfloat start, GLfloat end)
+{
+    glPushMatrix();
+    glTranslatef(start, 0.0f, 0.0f);
+    glScalef(end - start, 1.0f, 1.0f);
+    paths.draw(stripe);
+    glPopMatrix();
+}
+
 void resize(int width, int height)
 {
     if(height == 0)
@@ -590,6 +647,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    paths.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
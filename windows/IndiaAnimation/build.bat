@@ -2,4 +2,4 @@ set root=%CD%
 cd resources
 rc.exe /V resource.rc
 cd %root%
-cl.exe /EHsc /Zi /DUNICODE IndiaAnimation.cpp /link resources\resource.res user32.lib kernel32.lib gdi32.lib openGL32.lib Winmm.lib glu32.lib
+cl.exe /EHsc /Zi /DUNICODE /I ..\..\xWindows\pp\common IndiaAnimation.cpp /link resources\resource.res user32.lib kernel32.lib gdi32.lib openGL32.lib Winmm.lib glu32.lib
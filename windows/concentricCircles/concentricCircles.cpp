@@ -6,6 +6,7 @@
 #include <gl/GL.h>
 
 #include "resources/resource.h"
+#include "lineBatch.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -32,12 +33,15 @@ GLfloat colors[10][3] = {
     {0.647058f, 0.164705f, 0.164705f} // brown
 };
 
+// The circles never change, so they are put into one vertex buffer once and drawn from there.
+LineBatch circles;
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
 void initialize(void);
 void cleanUp(void);
 void display(void);
-void drawConcentricCircles(int numberOfCircles);
+void addConcentricCircles(int numberOfCircles);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -231,6 +235,8 @@ void initialize(void)
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
+    addConcentricCircles(10);
+
     // This is required for DirectX
     // resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -238,11 +244,12 @@ void initialize(void)
 void display(void)
 {
     glClear(GL_COLOR_BUFFER_BIT);
-    drawConcentricCircles(10);
+    glLoadIdentity();
+    circles.draw();
     SwapBuffers(hdc);
 }
 
-void drawConcentricCircles(int numberOfCircles)
+void addConcentricCircles(int numberOfCircles)
 {
     if(numberOfCircles == 0)
     {
@@ -251,25 +258,12 @@ void drawConcentricCircles(int numberOfCircles)
 
     GLfloat step = 1.0f / numberOfCircles;
     GLint circlePoints = 10000;
-    GLfloat angle = 0.0f;
-
-    glLoadIdentity();
 
     for(int circleCounter = 0; circleCounter < numberOfCircles; ++circleCounter)
     {
         GLfloat radius = (step * (circleCounter + 1));
 
-        glBegin(GL_LINE_LOOP);
-
-        glColor3f(colors[circleCounter % 10][0], colors[circleCounter % 10][1], colors[circleCounter % 10][2]);
-
-        for (int pointCounter = 0; pointCounter < circlePoints; ++pointCounter)
-        {
-            angle = 2.0f * M_PI * pointCounter / circlePoints;
-            glVertex3f(cos(angle) * radius, sin(angle) * radius, 0.0f);
-        }
-
-        glEnd();
+        circles.circle(0.0f, 0.0f, radius, circlePoints, colors[circleCounter % 10], 1.0f);
     }
 }
 
@@ -323,6 +317,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    circles.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
@@ -7,6 +7,7 @@
 #include <gl/glu.h>
 
 #include "resources/resource.h"
+#include "pathTessellator.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -23,16 +24,21 @@ bool isEscapeKeyPressed = false;
 GLfloat angle = 0.0f;
 GLfloat speed = 0.1f;
 
+// The symbol is tessellated once, only the rotation it is drawn with changes every frame.
+PathTessellator paths;
+int deathlyHallows = PathTessellator::INVALID;
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
 void initialize(void);
 void cleanUp(void);
 void update(void);
 void display(void);
+void initializeDeathlyHallowsSymbol(void);
 void deathlyHallowsSymbol(void);
-void drawInvisibilityCloak(void);
-void drawResurrectionStone(void);
-void drawElderWand(void);
+void addInvisibilityCloak(Path *symbol);
+void addResurrectionStone(Path *symbol);
+void addElderWand(Path *symbol);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -236,6 +242,8 @@ void initialize(void)
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
+    initializeDeathlyHallowsSymbol();
+
     // This is required for DirectX
     resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -261,54 +269,45 @@ void display(void)
     SwapBuffers(hdc);
 }
 
-void deathlyHallowsSymbol(void)
-{
-    drawInvisibilityCloak();
-    drawResurrectionStone();
-    drawElderWand();
-}
-
-void drawInvisibilityCloak(void)
+void initializeDeathlyHallowsSymbol(void)
 {
-    glBegin(GL_LINE_LOOP);
+    Path symbol;
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(-1.0f, -1.0f, 0.0f);
-    glVertex3f(1.0f, -1.0f, 0.0f);
+    addInvisibilityCloak(&symbol);
+    addResurrectionStone(&symbol);
+    addElderWand(&symbol);
 
-    glEnd();
+    deathlyHallows = paths.hairline(symbol);
 }
 
-void drawResurrectionStone(void)
+void deathlyHallowsSymbol(void)
 {
-    GLint circlePoints = 10000;
-    GLfloat angle = 0.0f;
     glLineWidth(1.0f);
-
-    glBegin(GL_LINE_LOOP);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    for (int counter = 0; counter < circlePoints; ++counter)
-    {
-        angle = 2.0f * M_PI * counter / circlePoints;
-        glVertex3f(cos(angle) * 0.61f, (sin(angle) * 0.61f) - 0.39f, 0.0f);
-    }
-
-    glEnd();
+    paths.draw(deathlyHallows);
 }
 
-void drawElderWand(void)
+void addInvisibilityCloak(Path *symbol)
 {
-    glBegin(GL_LINES);
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->moveTo(0.0f, 1.0f);
+    symbol->lineTo(-1.0f, -1.0f);
+    symbol->lineTo(1.0f, -1.0f);
+    symbol->close();
+}
 
-    glColor3f(1.0f, 1.0f, 1.0f);
+void addResurrectionStone(Path *symbol)
+{
+    GLint circlePoints = 10000;
 
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(0.0f, -1.0f, 0.0f);
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->circle(0.0f, -0.39f, 0.61f, circlePoints);
+}
 
-    glEnd();
+void addElderWand(Path *symbol)
+{
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->moveTo(0.0f, 1.0f);
+    symbol->lineTo(0.0f, -1.0f);
 }
 
 void resize(int width, int height)
@@ -364,6 +363,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    paths.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
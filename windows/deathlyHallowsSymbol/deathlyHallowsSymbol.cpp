@@ -6,6 +6,7 @@
 #include <gl/GL.h>
 
 #include "resources/resource.h"
+#include "pathTessellator.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -19,15 +20,20 @@ bool isFullscreen = false;
 bool isActive = false;
 bool isEscapeKeyPressed = false;
 
+// The symbol never changes, so it is tessellated once and drawn from there.
+PathTessellator paths;
+int deathlyHallows = PathTessellator::INVALID;
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
 void initialize(void);
 void cleanUp(void);
 void display(void);
+void initializeDeathlyHallowsSymbol(void);
 void deathlyHallowsSymbol(void);
-void drawInvisibilityCloak(void);
-void drawResurrectionStone(void);
-void drawElderWand(void);
+void addInvisibilityCloak(Path *symbol);
+void addResurrectionStone(Path *symbol);
+void addElderWand(Path *symbol);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -221,6 +227,8 @@ void initialize(void)
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
+    initializeDeathlyHallowsSymbol();
+
     // This is required for DirectX
     // resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -232,61 +240,46 @@ void display(void)
     SwapBuffers(hdc);
 }
 
-void deathlyHallowsSymbol(void)
+void initializeDeathlyHallowsSymbol(void)
 {
-    drawInvisibilityCloak();
-    drawResurrectionStone();
-    drawElderWand();
-}
-
-void drawInvisibilityCloak(void)
-{
-    glLoadIdentity();
+    Path symbol;
 
-    glBegin(GL_LINE_LOOP);
+    addInvisibilityCloak(&symbol);
+    addResurrectionStone(&symbol);
+    addElderWand(&symbol);
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    glVertex3f(0.0f, 0.5f, 0.0f);
-    glVertex3f(-0.5f, -0.5f, 0.0f);
-    glVertex3f(0.5f, -0.5f, 0.0f);
-
-    glEnd();
+    deathlyHallows = paths.hairline(symbol);
 }
 
-void drawResurrectionStone(void)
+void deathlyHallowsSymbol(void)
 {
-    GLint circlePoints = 10000;
-    GLfloat angle = 0.0f;
-
     glLoadIdentity();
     glLineWidth(1.0f);
-
-    glBegin(GL_LINE_LOOP);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    for (int counter = 0; counter < circlePoints; ++counter)
-    {
-        angle = 2.0f * M_PI * counter / circlePoints;
-        glVertex3f(cos(angle) * 0.31f, (sin(angle) * 0.31f) - 0.19f, 0.0f);
-    }
-
-    glEnd();
+    paths.draw(deathlyHallows);
 }
 
-void drawElderWand(void)
+void addInvisibilityCloak(Path *symbol)
 {
-    glLoadIdentity();
-
-    glBegin(GL_LINES);
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->moveTo(0.0f, 0.5f);
+    symbol->lineTo(-0.5f, -0.5f);
+    symbol->lineTo(0.5f, -0.5f);
+    symbol->close();
+}
 
-    glColor3f(1.0f, 1.0f, 1.0f);
+void addResurrectionStone(Path *symbol)
+{
+    GLint circlePoints = 10000;
 
-    glVertex3f(0.0f, 0.5f, 0.0f);
-    glVertex3f(0.0f, -0.5f, 0.0f);
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->circle(0.0f, -0.19f, 0.31f, circlePoints);
+}
 
-    glEnd();
+void addElderWand(Path *symbol)
+{
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->moveTo(0.0f, 0.5f);
+    symbol->lineTo(0.0f, -0.5f);
 }
 
 void resize(int width, int height)
@@ -339,6 +332,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    paths.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
@@ -2,4 +2,4 @@ set root=%CD%
 cd resources
 rc.exe /V resource.rc
 cd %root%
-cl.exe /EHsc /DUNICODE /Zi /I %FREEGLUT_PATH%\include robotArm.cpp /link resources\resource.res /LIBPATH:%FREEGLUT_PATH%\lib\x64 user32.lib kernel32.lib gdi32.lib openGL32.lib freeglut.lib
+cl.exe /EHsc /DUNICODE /Zi /I ..\..\..\xWindows\pp\common /I %FREEGLUT_PATH%\include robotArm.cpp /link resources\resource.res /LIBPATH:%FREEGLUT_PATH%\lib\x64 user32.lib kernel32.lib gdi32.lib openGL32.lib freeglut.lib
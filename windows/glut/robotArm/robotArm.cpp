@@ -5,6 +5,7 @@
 #include <math.h>
 
 #include "resources/resource.h"
+#include "primitives.h"
 
 RECT windowRect = {0, 0, 800, 600};
 
@@ -15,7 +16,8 @@ bool isEscapeKeyPressed = false;
 GLint angleShoulder = 0;
 GLint angleElbow = 0;
 
-GLUquadric *guadric = NULL;
+PrimitiveLibrary primitives;
+int sphereArm = PrimitiveLibrary::INVALID;
 
 void initialize(void);
 void cleanUp(void);
@@ -120,6 +122,9 @@ void initialize(void)
     glDepthFunc(GL_LEQUAL);
     glShadeModel(GL_SMOOTH);
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+
+    // Tessellated once here instead of by gluSphere() every frame.
+    sphereArm = primitives.sphere(0.5f, 10, 10);
 }
 
 void display(void)
@@ -152,9 +157,8 @@ void drawRobotArm(void)
     glPushMatrix();
 
     glScalef(2.0f, 0.5f, 1.0f);
-    guadric = gluNewQuadric();
     glColor3f(0.5f, 0.35f, 0.05f);
-    gluSphere(guadric, 0.5, 10, 10);
+    primitives.draw(sphereArm);
 
     // Pop back to shoulder transformation state.
     glPopMatrix();
@@ -167,9 +171,8 @@ void drawRobotArm(void)
     // Push the elbow transformation state.
     glPushMatrix();
     glScalef(2.0f, 0.5f, 1.0f);
-    guadric = gluNewQuadric();
     glColor3f(0.5f, 0.35f, 0.05f);
-    gluSphere(guadric, 0.5, 10, 10);
+    primitives.draw(sphereArm);
 
     // Pop the elbow transformation state.
     glPopMatrix();
@@ -177,6 +180,8 @@ void drawRobotArm(void)
 
 void cleanUp(void)
 {
+    primitives.clear();
+
     if(isFullscreen)
     {
         glutLeaveFullScreen();
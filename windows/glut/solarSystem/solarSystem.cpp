@@ -5,6 +5,7 @@
 #include <math.h>
 
 #include "resources/resource.h"
+#include "primitives.h"
 
 RECT windowRect = {0, 0, 800, 600};
 
@@ -13,7 +14,9 @@ bool isFullscreen = false;
 GLint year = 0;
 GLint day = 0;
 
-GLUquadric *guadric = NULL;
+PrimitiveLibrary primitives;
+int sphereSun = PrimitiveLibrary::INVALID;
+int sphereEarth = PrimitiveLibrary::INVALID;
 
 void initialize(void);
 void cleanUp(void);
@@ -118,6 +121,14 @@ void initialize(void)
     glDepthFunc(GL_LEQUAL);
     glShadeModel(GL_SMOOTH);
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+
+    // Tessellated once here instead of by gluSphere() every frame.
+    // 2nd parameter is for slices (like longitudes)
+    // 3rd parameter is for stacks (like latitudes)
+    // Higher the value of 2nd and 3rd parameters, i.e. more the subdivisions,
+    // more circular the sphere will look.
+    sphereSun = primitives.sphere(0.75f, 30, 30);
+    sphereEarth = primitives.sphere(0.2f, 20, 20);
 }
 
 void display(void)
@@ -145,14 +156,9 @@ void drawSolarSystem(void)
     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
     // Draw the sun
-    guadric = gluNewQuadric();
     glColor3f(1.0f, 1.0f, 0.0f);
 
-    // 3rd parameter is for slices (like longitudes)
-    // 4th parameter is for stacks (like latitudes)
-    // Higher the value of 3rd and 4th parameters, i.e. more the subdivisions,
-    // more circular the sphere will look.
-    gluSphere(guadric, 0.75, 30, 30);
+    primitives.draw(sphereSun);
 
     // Pop back to initial state.
     glPopMatrix();
@@ -172,9 +178,8 @@ void drawSolarSystem(void)
     glRotatef((GLfloat)day, 0.0f, 0.0f, 1.0f);
 
     glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    guadric = gluNewQuadric();
     glColor3f(0.4f, 0.9f, 1.0f);
-    gluSphere(guadric, 0.2f, 20, 20);
+    primitives.draw(sphereEarth);
 
     // Pop the elbow transformation state.
     glPopMatrix();
@@ -182,6 +187,8 @@ void drawSolarSystem(void)
 
 void cleanUp(void)
 {
+    primitives.clear();
+
     if(isFullscreen)
     {
         glutLeaveFullScreen();
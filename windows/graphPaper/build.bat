@@ -2,4 +2,4 @@ set root=%CD%
 cd resources
 rc.exe /V resource.rc
 cd %root%
-cl.exe /EHsc /DUNICODE /Zi graphPaper.cpp /link resources\resource.res user32.lib kernel32.lib gdi32.lib openGL32.lib
+cl.exe /EHsc /DUNICODE /Zi /I ..\..\xWindows\pp\common graphPaper.cpp /link resources\resource.res user32.lib kernel32.lib gdi32.lib openGL32.lib
@@ -3,6 +3,7 @@
 #include <gl/GL.h>
 
 #include "resources/resource.h"
+#include "lineBatch.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -16,15 +17,19 @@ bool isFullscreen = false;
 bool isActive = false;
 bool isEscapeKeyPressed = false;
 
+// The grid never changes, so it is put into one vertex buffer once and drawn from there.
+LineBatch graphPaper;
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
 void initialize(void);
 void cleanUp(void);
 void display(void);
-void drawMajorXAxis(void);
-void drawMinorXAxis(void);
-void drawMajorYAxis(void);
-void drawMinorYAxis(void);
+void initializeGraphPaper(void);
+void addMajorXAxis(void);
+void addMinorXAxis(void);
+void addMajorYAxis(void);
+void addMinorYAxis(void);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -218,6 +223,8 @@ void initialize(void)
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
+    initializeGraphPaper();
+
     // This is required for DirectX
     // resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -225,91 +232,63 @@ void initialize(void)
 void display(void)
 {
     glClear(GL_COLOR_BUFFER_BIT);
-    drawMajorXAxis();
-    drawMajorYAxis();
-    drawMinorXAxis();
-    drawMinorYAxis();
+    glLoadIdentity();
+    graphPaper.draw();
     SwapBuffers(hdc);
 }
 
-void drawMajorXAxis(void)
+void initializeGraphPaper(void)
 {
-    glLoadIdentity();
-    glLineWidth(3.0f);
-
-    glBegin(GL_LINES);
+    addMajorXAxis();
+    addMajorYAxis();
+    addMinorXAxis();
+    addMinorYAxis();
+}
 
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glVertex3f(-1.0f, 0.0f, 0.0f);
-    glVertex3f(1.0f, 0.0f, 0.0f);
+void addMajorXAxis(void)
+{
+    const GLfloat red[] = {1.0f, 0.0f, 0.0f};
 
-    glEnd();
+    graphPaper.line(-1.0f, 0.0f, 1.0f, 0.0f, red, 3.0f);
 }
 
-void drawMinorXAxis(void)
+void addMinorXAxis(void)
 {
+    const GLfloat blue[] = {0.0f, 0.0f, 1.0f};
     int numberOfLines = 20;
     float difference = 1.0f / numberOfLines;
 
-    glLoadIdentity();
-    glLineWidth(1.0f);
-
-    glBegin(GL_LINES);
-
-    glColor3f(0.0f, 0.0f, 1.0f);
-
     for(int counter = 1; counter <= numberOfLines; ++counter)
     {
         // Positive axis
-        glVertex3f(-1.0f, (counter * difference), 0.0f);
-        glVertex3f(1.0f, (counter * difference), 0.0f);
+        graphPaper.line(-1.0f, (counter * difference), 1.0f, (counter * difference), blue, 1.0f);
 
         // Negative axis
-        glVertex3f(-1.0f, (-counter * difference), 0.0f);
-        glVertex3f(1.0f, (-counter * difference), 0.0f);
+        graphPaper.line(-1.0f, (-counter * difference), 1.0f, (-counter * difference), blue, 1.0f);
     }
-
-    glEnd();
 }
 
-void drawMajorYAxis(void)
+void addMajorYAxis(void)
 {
-    glLoadIdentity();
-    glLineWidth(3.0f);
-
-    glBegin(GL_LINES);
+    const GLfloat green[] = {0.0f, 1.0f, 0.0f};
 
-    glColor3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(0.0f, -1.0f, 0.0f);
-
-    glEnd();
+    graphPaper.line(0.0f, 1.0f, 0.0f, -1.0f, green, 3.0f);
 }
 
-void drawMinorYAxis(void)
+void addMinorYAxis(void)
 {
+    const GLfloat blue[] = {0.0f, 0.0f, 1.0f};
     int numberOfLines = 20;
     float difference = 1.0f / numberOfLines;
 
-    glLoadIdentity();
-    glLineWidth(1.0f);
-
-    glBegin(GL_LINES);
-
-    glColor3f(0.0f, 0.0f, 1.0f);
-
     for(int counter = 1; counter <= numberOfLines; ++counter)
     {
         // Positive axis
-        glVertex3f((counter * difference), 1.0f, 0.0f);
-        glVertex3f((counter * difference), -1.0f, 0.0f);
+        graphPaper.line((counter * difference), 1.0f, (counter * difference), -1.0f, blue, 1.0f);
 
         // Negative axis
-        glVertex3f((-counter * difference), 1.0f, 0.0f);
-        glVertex3f((-counter * difference), -1.0f, 0.0f);
+        graphPaper.line((-counter * difference), 1.0f, (-counter * difference), -1.0f, blue, 1.0f);
     }
-
-    glEnd();
 }
 
 void resize(int width, int height)
@@ -362,6 +341,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    graphPaper.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
@@ -3,6 +3,7 @@
 #include <gl/GL.h>
 
 #include "resources/resource.h"
+#include "pathTessellator.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -16,15 +17,20 @@ bool isFullscreen = false;
 bool isActive = false;
 bool isEscapeKeyPressed = false;
 
+// The kundali never changes, so it is tessellated once and drawn from there.
+PathTessellator paths;
+int kundali = PathTessellator::INVALID;
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
 void initialize(void);
 void cleanUp(void);
 void display(void);
+void initializeKundali(void);
 void drawKundali(void);
-void drawOutterRectangle(void);
-void drawInnerDiamond(void);
-void drawDiagonals(void);
+void addOutterRectangle(Path *outline);
+void addInnerDiamond(Path *outline);
+void addDiagonals(Path *outline);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -218,6 +224,8 @@ void initialize(void)
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
+    initializeKundali();
+
     // This is required for DirectX
     // resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -229,56 +237,50 @@ void display(void)
     SwapBuffers(hdc);
 }
 
-void drawKundali()
+void initializeKundali(void)
 {
-    drawOutterRectangle();
-    drawInnerDiamond();
-    drawDiagonals();
-}
+    Path outline;
 
-void drawOutterRectangle(void)
-{
-    glLoadIdentity();
-    glBegin(GL_LINE_LOOP);
+    addOutterRectangle(&outline);
+    addInnerDiamond(&outline);
+    addDiagonals(&outline);
 
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    glVertex3f(-1.0f, 1.0f, 0.0f);
-    glVertex3f(-1.0f, -1.0f, 0.0f);
-    glVertex3f(1.0f, -1.0f, 0.0f);
-    glVertex3f(1.0f, 1.0f, 0.0f);
-
-    glEnd();
+    kundali = paths.hairline(outline);
 }
 
-void drawDiagonals(void)
+void drawKundali(void)
 {
     glLoadIdentity();
-    glBegin(GL_LINES);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    glVertex3f(1.0f, 1.0f, 0.0f);
-    glVertex3f(-1.0f, -1.0f, 0.0f);
-    glVertex3f(-1.0f, 1.0f, 0.0f);
-    glVertex3f(1.0f, -1.0f, 0.0f);
-
-    glEnd();
+    paths.draw(kundali);
 }
 
-void drawInnerDiamond(void)
+void addOutterRectangle(Path *outline)
 {
-    glLoadIdentity();
-    glBegin(GL_LINE_LOOP);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
+    outline->setColor(1.0f, 1.0f, 1.0f);
+    outline->moveTo(-1.0f, 1.0f);
+    outline->lineTo(-1.0f, -1.0f);
+    outline->lineTo(1.0f, -1.0f);
+    outline->lineTo(1.0f, 1.0f);
+    outline->close();
+}
 
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(-1.0f, 0.0f, 0.0f);
-    glVertex3f(0.0f, -1.0f, 0.0f);
-    glVertex3f(1.0f, 0.0f, 0.0f);
+void addDiagonals(Path *outline)
+{
+    outline->setColor(1.0f, 1.0f, 1.0f);
+    outline->moveTo(1.0f, 1.0f);
+    outline->lineTo(-1.0f, -1.0f);
+    outline->moveTo(-1.0f, 1.0f);
+    outline->lineTo(1.0f, -1.0f);
+}
 
-    glEnd();
+void addInnerDiamond(Path *outline)
+{
+    outline->setColor(1.0f, 1.0f, 1.0f);
+    outline->moveTo(0.0f, 1.0f);
+    outline->lineTo(-1.0f, 0.0f);
+    outline->lineTo(0.0f, -1.0f);
+    outline->lineTo(1.0f, 0.0f);
+    outline->close();
 }
 
 void resize(int width, int height)
@@ -331,6 +333,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    paths.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
@@ -7,6 +7,7 @@
 #include <gl/glu.h>
 
 #include "resources/resource.h"
+#include "primitives.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -176,7 +177,8 @@ GLfloat matrialShininess[4][6][4] = {
     }
 };
 
-GLUquadric *guadric = NULL;
+PrimitiveLibrary primitives;
+int sphere = PrimitiveLibrary::INVALID;
 
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
@@ -450,6 +452,13 @@ void initialize(void)
     glLightModelfv(GL_LIGHT_MODEL_AMBIENT, lightModalAmbient);
     glLightModelfv(GL_LIGHT_MODEL_LOCAL_VIEWER, lightModalLocalViewer);
 
+    // Tessellated once here instead of by gluSphere() every frame.
+    // 2nd parameter is for slices (like longitudes)
+    // 3rd parameter is for stacks (like latitudes)
+    // Higher the value of 2nd and 3rd parameters, i.e. more the subdivisions,
+    // more circular the sphere will look.
+    sphere = primitives.sphere(0.75f, 30, 30);
+
     // This is required for DirectX
     resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -668,13 +677,7 @@ void drawSphere(void)
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
     // Draw the sun
-    guadric = gluNewQuadric();
-
-    // 3rd parameter is for slices (like longitudes)
-    // 4th parameter is for stacks (like latitudes)
-    // Higher the value of 3rd and 4th parameters, i.e. more the sub-divisions,
-    // more circular the sphere will look.
-    gluSphere(guadric, 0.75, 30, 30);
+    primitives.draw(sphere);
 
     // Pop back to initial state.
     glPopMatrix();
@@ -733,11 +736,7 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
-    if(guadric)
-    {
-        gluDeleteQuadric(guadric);
-        guadric = nullptr;
-    }
+    primitives.clear();
 
     wglMakeCurrent(NULL, NULL);
 
@@ -7,6 +7,7 @@
 #include <gl/glu.h>
 
 #include "resources/resource.h"
+#include "pathTessellator.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -23,18 +24,28 @@ bool isEscapeKeyPressed = false;
 GLfloat widthByHeightRatio = 1.0f;
 GLfloat heightByWidthRatio = 1.0f;
 
+// The patterns never change, so each is tessellated once and only placed every frame.
+PathTessellator paths;
+int dotPattern = PathTessellator::INVALID;
+int boxPattern = PathTessellator::INVALID;
+int trianglePattern = PathTessellator::INVALID;
+int boxTrianglePattern = PathTessellator::INVALID;
+int lineRayPattern = PathTessellator::INVALID;
+int coloredBoxPattern = PathTessellator::INVALID;
+
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
 void initialize(void);
 void cleanUp(void);
 void display(void);
+void initializePatterns(void);
 void drawPatterns(void);
-void drawDotPattern(void);
-void drawBoxPattern(void);
-void drawTrianglePattern(void);
-void drawBoxTrianglePattern(void);
-void drawLineRayPattern(void);
-void drawColoredBoxPattern(void);
+void addDotPattern(Path *pattern);
+void addBoxPattern(Path *pattern);
+void addTrianglePattern(Path *pattern);
+void addBoxTrianglePattern(Path *pattern);
+void addLineRayPattern(Path *pattern);
+void addColoredBoxPattern(Path *pattern);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -232,6 +243,8 @@ void initialize(void)
     glDepthFunc(GL_LEQUAL);
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
+    initializePatterns();
+
     // This is required for DirectX
     resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -244,153 +257,168 @@ void display(void)
     SwapBuffers(hdc);
 }
 
+void initializePatterns(void)
+{
+    Path pattern;
+
+    addDotPattern(&pattern);
+    dotPattern = paths.dots(pattern);
+
+    pattern.clear();
+    addBoxPattern(&pattern);
+    boxPattern = paths.hairline(pattern);
+
+    pattern.clear();
+    addTrianglePattern(&pattern);
+    trianglePattern = paths.hairline(pattern);
+
+    pattern.clear();
+    addBoxTrianglePattern(&pattern);
+    boxTrianglePattern = paths.hairline(pattern);
+
+    pattern.clear();
+    addLineRayPattern(&pattern);
+    lineRayPattern = paths.hairline(pattern);
+
+    pattern.clear();
+    addColoredBoxPattern(&pattern);
+    coloredBoxPattern = paths.fill(pattern);
+}
+
 void drawPatterns(void)
 {
     glLoadIdentity();
     glTranslatef(-40.0f * widthByHeightRatio, 20.0f * heightByWidthRatio, -6.0f);
-    drawDotPattern();
+    glPointSize(2.0f);
+    paths.draw(dotPattern);
 
     glLoadIdentity();
     glTranslatef(-8.5f * widthByHeightRatio, 20.0f * heightByWidthRatio, -6.0f);
-    drawTrianglePattern();
+    paths.draw(trianglePattern);
 
     glLoadIdentity();
     glTranslatef(20.0f * widthByHeightRatio, 20.0f * heightByWidthRatio, -6.0f);
-    drawBoxPattern();
+    paths.draw(boxPattern);
 
     glLoadIdentity();
     glTranslatef(-8.5f * widthByHeightRatio, -40.0f * heightByWidthRatio, -6.0f);
-    drawLineRayPattern();
+    paths.draw(lineRayPattern);
 
     glLoadIdentity();
     glTranslatef(20.0f * widthByHeightRatio, -40.0f * heightByWidthRatio, -6.0f);
-    drawColoredBoxPattern();
+    paths.draw(coloredBoxPattern);
 
     glLoadIdentity();
     glTranslatef(20.0f * widthByHeightRatio, -40.0f * heightByWidthRatio, -6.0f);
-    drawBoxPattern();
+    paths.draw(boxPattern);
 
     glLoadIdentity();
     glTranslatef(-40.0f * widthByHeightRatio, -40.0f * heightByWidthRatio, -6.0f);
-    drawBoxTrianglePattern();
+    paths.draw(boxTrianglePattern);
 }
 
-void drawDotPattern(void)
+void addDotPattern(Path *pattern)
 {
     GLfloat difference = 25.0f / 3.0f;
-    glPointSize(2.0f);
-    glBegin(GL_POINTS);
-    glColor3f(1.0f, 1.0f, 1.0f);
+
+    pattern->setColor(1.0f, 1.0f, 1.0f);
 
     for(int rowCounter = 0; rowCounter < 4; ++rowCounter)
     {
         for(int columnCounter = 0; columnCounter < 4; ++columnCounter)
         {
-            glVertex3f(difference * rowCounter, difference * columnCounter, 0.0f);
+            pattern->lineTo(difference * rowCounter, difference * columnCounter);
         }
     }
-
-    glEnd();
 }
 
-void drawBoxPattern(void)
+void addBoxPattern(Path *pattern)
 {
     GLfloat difference = 25.0f / 3.0f;
-    glBegin(GL_LINES);
-    glColor3f(1.0f, 1.0f, 1.0f);
+
+    pattern->setColor(1.0f, 1.0f, 1.0f);
 
     for(int verticalLineCounter = 0; verticalLineCounter < 4; ++verticalLineCounter)
     {
-        glVertex3f(difference * verticalLineCounter, 0.0f, 0.0f);
-        glVertex3f(difference * verticalLineCounter, difference * 3.0f, 0.0f);
+        pattern->moveTo(difference * verticalLineCounter, 0.0f);
+        pattern->lineTo(difference * verticalLineCounter, difference * 3.0f);
     }
 
     for(int horizontalLineCounter = 0; horizontalLineCounter < 4; ++horizontalLineCounter)
     {
-        glVertex3f(0.0f, difference * horizontalLineCounter, 0.0f);
-        glVertex3f(difference * 3.0f, difference * horizontalLineCounter, 0.0f);
+        pattern->moveTo(0.0f, difference * horizontalLineCounter);
+        pattern->lineTo(difference * 3.0f, difference * horizontalLineCounter);
     }
-
-    glEnd();
 }
 
-void drawTrianglePattern(void)
+void addTrianglePattern(Path *pattern)
 {
     GLfloat difference = 25.0f / 3.0f;
 
+    pattern->setColor(1.0f, 1.0f, 1.0f);
+
     for(int rowCounter = 0; rowCounter < 3; ++rowCounter)
     {
         for(int columnCounter = 0; columnCounter < 3; ++columnCounter)
         {
-            glBegin(GL_LINE_LOOP);
-            glColor3f(1.0f, 1.0f, 1.0f);
-            glVertex3f(difference * (0.0f + rowCounter), difference * (0.0f + columnCounter), 0.0f);
-            glVertex3f(difference * (0.0f + rowCounter), difference * (1.0f + columnCounter), 0.0f);
-            glVertex3f(difference * (1.0f + rowCounter), difference * (1.0f + columnCounter), 0.0f);
-            glEnd();
+            pattern->moveTo(difference * (0.0f + rowCounter), difference * (0.0f + columnCounter));
+            pattern->lineTo(difference * (0.0f + rowCounter), difference * (1.0f + columnCounter));
+            pattern->lineTo(difference * (1.0f + rowCounter), difference * (1.0f + columnCounter));
+            pattern->close();
         }
     }
 }
 
-void drawBoxTrianglePattern(void)
+void addBoxTrianglePattern(Path *pattern)
 {
     GLfloat difference = 25.0f / 3.0f;
+
+    pattern->setColor(1.0f, 1.0f, 1.0f);
+
     for(int rowCounter = 0; rowCounter < 3; ++rowCounter)
     {
         for(int columnCounter = 0; columnCounter < 3; ++columnCounter)
         {
-            glBegin(GL_LINE_LOOP);
-            glColor3f(1.0f, 1.0f, 1.0f);
-            glVertex3f(difference * (0.0f + rowCounter), difference * (0.0f + columnCounter), 0.0f);
-            glVertex3f(difference * (0.0f + rowCounter), difference * (1.0f + columnCounter), 0.0f);
-            glVertex3f(difference * (1.0f + rowCounter), difference * (1.0f + columnCounter), 0.0f);
-            glVertex3f(difference * (1.0f + rowCounter), difference * (0.0f + columnCounter), 0.0f);
-            glEnd();
-
-            glBegin(GL_LINES);
-            glColor3f(1.0f, 1.0f, 1.0f);
-            glVertex3f(difference * (0.0f + rowCounter), difference * (0.0f + columnCounter), 0.0f);
-            glVertex3f(difference * (1.0f + rowCounter), difference * (1.0f + columnCounter), 0.0f);
-            glEnd();
+            pattern->moveTo(difference * (0.0f + rowCounter), difference * (0.0f + columnCounter));
+            pattern->lineTo(difference * (0.0f + rowCounter), difference * (1.0f + columnCounter));
+            pattern->lineTo(difference * (1.0f + rowCounter), difference * (1.0f + columnCounter));
+            pattern->lineTo(difference * (1.0f + rowCounter), difference * (0.0f + columnCounter));
+            pattern->close();
+
+            pattern->moveTo(difference * (0.0f + rowCounter), difference * (0.0f + columnCounter));
+            pattern->lineTo(difference * (1.0f + rowCounter), difference * (1.0f + columnCounter));
         }
     }
 }
 
-void drawLineRayPattern(void)
+void addLineRayPattern(Path *pattern)
 {
     GLfloat difference = 25.0f / 3.0f;
 
-    glBegin(GL_LINE_LOOP);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glVertex3f(25.0f, 25.0f, 0.0f);
-    glVertex3f(0.0f, 25.0f, 0.0f);
-    glVertex3f(0.0f, 0.0f, 0.0f);
-    glVertex3f(25.0f, 0.0f, 0.0f);
-
-    glEnd();
+    pattern->setColor(1.0f, 1.0f, 1.0f);
+    pattern->moveTo(25.0f, 25.0f);
+    pattern->lineTo(0.0f, 25.0f);
+    pattern->lineTo(0.0f, 0.0f);
+    pattern->lineTo(25.0f, 0.0f);
+    pattern->close();
 
-    glBegin(GL_LINES);
+    pattern->moveTo(0.0f, 25.0f);
+    pattern->lineTo(difference * 1.0f, 0.0f);
 
-    glVertex3f(0.0f, 25.0f, 0.0f);
-    glVertex3f(difference * 1.0f, 0.0f, 0.0f);
+    pattern->moveTo(0.0f, 25.0f);
+    pattern->lineTo(difference * 2.0f, 0.0f);
 
-    glVertex3f(0.0f, 25.0f, 0.0f);
-    glVertex3f(difference * 2.0f, 0.0f, 0.0f);
+    pattern->moveTo(0.0f, 25.0f);
+    pattern->lineTo(difference * 3.0f, 0.0f);
 
-    glVertex3f(0.0f, 25.0f, 0.0f);
-    glVertex3f(difference * 3.0f, 0.0f, 0.0f);
+    pattern->moveTo(0.0f, 25.0f);
+    pattern->lineTo(difference * 3.0f, difference * 2.0f);
 
-    glVertex3f(0.0f, 25.0f, 0.0f);
-    glVertex3f(difference * 3.0f, difference * 2.0f, 0.0f);
-
-    glVertex3f(0.0f, 25.0f, 0.0f);
-    glVertex3f(difference * 3.0f, difference * 1.0f, 0.0f);
-
-    glEnd();
+    pattern->moveTo(0.0f, 25.0f);
+    pattern->lineTo(difference * 3.0f, difference * 1.0f);
 }
 
-void drawColoredBoxPattern(void)
+void addColoredBoxPattern(Path *pattern)
 {
     GLfloat difference = 25.0f / 3.0f;
 
@@ -398,27 +426,26 @@ void drawColoredBoxPattern(void)
     {
         for(int columnCounter = 0; columnCounter < 3; ++columnCounter)
         {
-            glBegin(GL_QUADS);
             if(columnCounter == 0)
             {
-                glColor3f(1.0f, 0.0f, 0.0f);
+                pattern->setColor(1.0f, 0.0f, 0.0f);
             }
 
             if(columnCounter == 1)
             {
-                glColor3f(0.0f, 1.0f, 0.0f);
+                pattern->setColor(0.0f, 1.0f, 0.0f);
             }
 
             if(columnCounter == 2)
             {
-                glColor3f(0.0f, 0.0f, 1.0f);
+                pattern->setColor(0.0f, 0.0f, 1.0f);
             }
 
-            glVertex3f(difference * (0.0f + columnCounter), difference * (0.0f + rowCounter), 0.0f);
-            glVertex3f(difference * (0.0f + columnCounter), difference * (1.0f + rowCounter), 0.0f);
-            glVertex3f(difference * (1.0f + columnCounter), difference * (1.0f + rowCounter), 0.0f);
-            glVertex3f(difference * (1.0f + columnCounter), difference * (0.0f + rowCounter), 0.0f);
-            glEnd();
+            pattern->moveTo(difference * (0.0f + columnCounter), difference * (0.0f + rowCounter));
+            pattern->lineTo(difference * (0.0f + columnCounter), difference * (1.0f + rowCounter));
+            pattern->lineTo(difference * (1.0f + columnCounter), difference * (1.0f + rowCounter));
+            pattern->lineTo(difference * (1.0f + columnCounter), difference * (0.0f + rowCounter));
+            pattern->close();
         }
     }
 }
@@ -497,6 +524,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    paths.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
@@ -1,12 +1,13 @@
 #include <windows.h>
 #include <stdio.h>
+#include <stddef.h>
 #include <gl/glew.h>
 #include <gl/gl.h>
 #include <math.h>
-#include <Sphere.h>
 
 #include "resources/resource.h"
 #include "vmath.h"
+#include "sphereLod.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -19,6 +20,9 @@ RECT windowRect = {0, 0, 800, 600};
 const int numberOfRows = 6;
 const int numberOfColumns = 4;
 
+// The field drawn instead of the grid with 'm', fieldSize x fieldSize spheres going into the distance.
+const int fieldSize = 64;
+
 int viewportWidth = 1;
 int viewportHeight = 1;
 int viewportInitialX = 0;
@@ -32,15 +36,32 @@ bool isAnimationEnabled = false;
 bool rotateLightOnXAxis = true;
 bool rotateLightOnYAxis = false;
 bool rotateLightOnZAxis = false;
+bool isLodEnabled = true;
+bool isFieldEnabled = false;
+
+// One viewport at a time measured faster than viewport arrays on llvmpipe, see the readme, so the
+// arrays are only used after 'v'.
+bool isViewportArrayEnabled = false;
+
+// The LOD chain, then the 20 x 20 sphere of Sphere.lib that is drawn everywhere with LOD off, all in
+// the same buffers.
+#define NUMBER_OF_SPHERE_MESHES (SPHERE_LOD_NUMBER_OF_LEVELS + 1)
+#define FULL_RESOLUTION_SPHERE SPHERE_LOD_NUMBER_OF_LEVELS
 
-float sphereVertices[1146];
-float sphereNormals[1146];
-float sphereTextures[764];
+const float sphereRadius = 0.5f;
 
-unsigned short sphereElements[2280];
+GLsizei sphereFirstElement[NUMBER_OF_SPHERE_MESHES];
+GLsizei sphereNumberOfElements[NUMBER_OF_SPHERE_MESHES];
 
-unsigned int numberOfSphereVertices = getNumberOfSphereVertices();
-unsigned int numberOfSphereElements = getNumberOfSphereElements();
+// Level each sphere was drawn at last frame, -1 before the first.
+int gridSphereLevels[numberOfColumns][numberOfRows];
+int fieldSphereLevels[fieldSize][fieldSize];
+
+// Triangles submitted in the frame, and the count last written to the log, which is only written
+// again after a toggle or a change of more than 5%.
+int trianglesPerFrame = 0;
+int loggedTrianglesPerFrame = -1;
+int drawsPerFrame = 0;
 
 enum
 {
@@ -48,31 +69,102 @@ enum
 	CG_ATTRIBUTE_COLOR,
 	CG_ATTRIBUTE_NORMAL,
 	CG_ATTRIBUTE_TEXTURE0,
+	CG_ATTRIBUTE_SPHERE_TRANSLATION,
+	CG_ATTRIBUTE_SPHERE_MATERIAL,
+};
+
+// Binding points of the uniform blocks, fixed in the shaders.
+enum
+{
+    CG_UNIFORM_BLOCK_MATERIALS = 0,
+    CG_UNIFORM_BLOCK_FRAME,
+};
+
+// Every sphere of both scenes has a place in one instance buffer, the grid first, then the field
+// column by column. A sphere is drawn as a single instance with its place as the base instance, so
+// the shaders find its translation and material from the instance attributes without a uniform.
+#define NUMBER_OF_MATERIALS (numberOfColumns * numberOfRows)
+#define FIRST_GRID_SPHERE 0
+#define FIRST_FIELD_SPHERE NUMBER_OF_MATERIALS
+#define NUMBER_OF_SPHERES (NUMBER_OF_MATERIALS + fieldSize * fieldSize)
+
+struct SphereInstance
+{
+    GLfloat translation[3];
+    GLuint material;
+};
+
+// std140 layout of the Materials block, the shininess in the w of the specular color.
+struct MaterialUniforms
+{
+    GLfloat ambient[4];
+    GLfloat diffuse[4];
+    GLfloat specularAndShininess[4];
+};
+
+// std140 layout of the Frame block, written once per frame.
+struct FrameUniforms
+{
+    GLfloat viewMatrix[16];
+    GLfloat projectionMatrix[16];
+    GLfloat lightZeroPosition[4];
+    GLfloat laZero[4];
+    GLfloat ldZero[4];
+    GLfloat lsZero[4];
+    GLint isLightingEnabled;
+    GLint padding[3];
+};
+
+SphereInstance sphereInstances[NUMBER_OF_SPHERES];
+
+// How the grid is drawn with 'v' on, see initializeViewportArray().
+enum
+{
+    VIEWPORT_ARRAY_NONE = 0,
+    VIEWPORT_ARRAY_VERTEX_SHADER,
+    VIEWPORT_ARRAY_GEOMETRY_SHADER,
 };
 
+int viewportArrayMode = VIEWPORT_ARRAY_NONE;
+GLint maxViewports = 1;
+
+// x, y, width and height of the viewport of each grid sphere, in the order of the instances.
+GLfloat gridViewports[NUMBER_OF_MATERIALS][4];
+
+// CPU time spent submitting the grid and GPU time spent drawing it, added up over
+// GRID_TIMING_FRAMES frames and then written to the log. The GPU time of a frame is read when it
+// is ready, a frame or more later, and frames drawn while the last query is still running are
+// not timed on the GPU.
+#define GRID_TIMING_FRAMES 512
+
+GLuint gridTimeQuery = 0;
+bool isGridTimeQueryPending = false;
+LARGE_INTEGER performanceFrequency;
+LONGLONG gridCpuTicks = 0;
+int gridCpuFrames = 0;
+GLuint64 gridGpuNanoseconds = 0;
+int gridGpuFrames = 0;
+
 GLfloat angleLightRotation = 0.0f;
+GLfloat angleField = 0.0f;
 GLfloat speed = 0.001f;
 
 GLuint vertexShaderObject = 0;
 GLuint fragmentShaderObject = 0;
 GLuint shaderProgramObject = 0;
 
+// The program drawing the whole grid at once, with its own vertex shader or the geometry shader.
+GLuint viewportVertexShaderObject = 0;
+GLuint geometryShaderObject = 0;
+GLuint viewportArrayProgramObject = 0;
+
 GLuint vaoSphere = 0;
 GLuint vboSpherePosition = 0;
 GLuint vboSphereNormal = 0;
 GLuint vboSphereElement = 0;
-GLuint modelMatrixUniform = 0;
-GLuint viewMatrixUniform = 0;
-GLuint projectionMatrixUniform = 0;
-GLuint laZeroUniform = 0;
-GLuint ldZeroUniform = 0;
-GLuint lsZeroUniform = 0;
-GLuint kaUniform = 0;
-GLuint kdUniform = 0;
-GLuint ksUniform = 0;
-GLuint materialShininessUniform = 0;
-GLuint lightZeroPositionUniform = 0;
-GLuint isLightingEnabledUniform = 0;
+GLuint vboSphereInstance = 0;
+GLuint uboMaterials = 0;
+GLuint uboFrame = 0;
 
 vmath::mat4 perspectiveProjectionMatrix;
 
@@ -227,14 +319,25 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam)
 
 void initialize(void);
 void listExtensions(void);
-void initializeVertexShader(void);
+void initializeVertexShader(GLuint *shaderObject, const GLchar *header);
+void initializeGeometryShader(void);
 void initializeFragmentShader(void);
-void initializeShaderProgram(void);
+void initializeShaderProgram(GLuint *programObject, GLuint vertexShader, GLuint geometryShader);
+void initializeViewportArray(void);
 void initializeSphereBuffers(void);
+void initializeSphereInstances(void);
+void initializeUniformBuffers(void);
+void resetSphereLevels(void);
 void cleanUp(void);
 void update(void);
 void display(void);
-void drawSphere(void);
+void updateFrameUniforms(vmath::mat4 viewMatrix);
+void drawGrid(vmath::mat4 viewMatrix);
+void drawGridWithViewportArray(vmath::mat4 viewMatrix);
+void readGridTime(void);
+void logGridTime(void);
+int selectSphereMesh(int sphere, vmath::mat4 viewMatrix, int *level, int viewportHeight);
+void drawSphere(int sphere, vmath::mat4 viewMatrix, int *level, int viewportHeight);
 void resize(int width, int height);
 void toggleFullscreen(HWND hWnd, bool isFullscreen);
 
@@ -421,6 +524,24 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam)
                     rotateLightOnZAxis = true;
                 break;
 
+                case 'O':
+                case 'o':
+                    isLodEnabled = !isLodEnabled;
+                    resetSphereLevels();
+                break;
+
+                case 'M':
+                case 'm':
+                    isFieldEnabled = !isFieldEnabled;
+                    resetSphereLevels();
+                break;
+
+                case 'V':
+                case 'v':
+                    isViewportArrayEnabled = !isViewportArrayEnabled;
+                    resetSphereLevels();
+                break;
+
                 default:
                 break;
             }
@@ -503,15 +624,18 @@ void initialize(void)
 
     listExtensions();
 
-    getSphereVertexData(sphereVertices, sphereNormals, sphereTextures, sphereElements);
-    numberOfSphereVertices = getNumberOfSphereVertices();
-    numberOfSphereElements = getNumberOfSphereElements();
-
     // Initialize the shaders and shader program object.
-    initializeVertexShader();
+    initializeVertexShader(&vertexShaderObject, "#version 450 core\n");
     initializeFragmentShader();
-    initializeShaderProgram();
+    initializeShaderProgram(&shaderProgramObject, vertexShaderObject, 0);
+    initializeViewportArray();
     initializeSphereBuffers();
+    initializeUniformBuffers();
+
+    glGenQueries(1, &gridTimeQuery);
+    QueryPerformanceFrequency(&performanceFrequency);
+
+    resetSphereLevels();
 
     glClearColor(0.25f, 0.25f, 0.25f, 0.25f);
     glClearDepth(1.0f);
@@ -550,51 +674,151 @@ void listExtensions()
     }
 }
 
-void initializeVertexShader()
+// Compiles the vertex shader after header, which with the viewport array in the vertex shader
+// picks each instance's viewport itself.
+void initializeVertexShader(GLuint *shaderObject, const GLchar *header)
 {
-    vertexShaderObject = glCreateShader(GL_VERTEX_SHADER);
+    *shaderObject = glCreateShader(GL_VERTEX_SHADER);
 
-    const GLchar *vertexShaderCode = "#version 450 core" \
-        "\n" \
+    const GLchar *vertexShaderCode[] = { header,
         "in vec4 vertexPosition;" \
         "in vec3 vertexNormal;" \
+        "in vec3 sphereTranslation;" \
+        "in uint sphereMaterial;" \
         "\n" \
-        "out vec3 tNormal;" \
-		"out vec3 lightZeroDirection;" \
-		"out vec4 eyeCoordinates;" \
-		"out vec3 viewVector;" \
+        "out VertexData" \
+        "{" \
+        "   vec3 tNormal;" \
+        "   vec3 lightZeroDirection;" \
+        "   vec4 eyeCoordinates;" \
+        "   vec3 viewVector;" \
+        "   flat uint material;" \
+        "   flat int viewportIndex;" \
+        "} vertexOut;" \
 		"\n" \
-        "uniform mat4 modelMatrix;" \
-        "uniform mat4 viewMatrix;" \
-        "uniform mat4 projectionMatrix;" \
-        "uniform vec4 lightZeroPosition;" \
-        "uniform int isLightingEnabled;" \
+        "layout(std140, binding = 1) uniform Frame" \
+        "{" \
+        "   mat4 viewMatrix;" \
+        "   mat4 projectionMatrix;" \
+        "   vec4 lightZeroPosition;" \
+        "   vec4 laZero;" \
+        "   vec4 ldZero;" \
+        "   vec4 lsZero;" \
+        "   int isLightingEnabled;" \
+        "};" \
         "\n" \
         "void main(void)" \
         "{" \
+        "   vec4 position = vertexPosition + vec4(sphereTranslation, 0.0);" \
+        "\n" \
         "   if(isLightingEnabled == 1)" \
         "   {" \
-        "       eyeCoordinates = viewMatrix * modelMatrix * vertexPosition;" \
-        "       tNormal = mat3(viewMatrix * modelMatrix) * vertexNormal;" \
-        "       lightZeroDirection = vec3(lightZeroPosition);" \
-        "       viewVector = -eyeCoordinates.xyz;" \
+        "       vertexOut.eyeCoordinates = viewMatrix * position;" \
+        "       vertexOut.tNormal = mat3(viewMatrix) * vertexNormal;" \
+        "       vertexOut.lightZeroDirection = vec3(lightZeroPosition);" \
+        "       vertexOut.viewVector = -vertexOut.eyeCoordinates.xyz;" \
+        "   }" \
+        "\n" \
+        "   vertexOut.material = sphereMaterial;" \
+        "   vertexOut.viewportIndex = gl_InstanceID;" \
+        "\n#ifdef VIEWPORT_FROM_INSTANCE\n" \
+        "   gl_ViewportIndex = gl_InstanceID;" \
+        "\n#endif\n" \
+        "   gl_Position = projectionMatrix * viewMatrix * position;" \
+        "}"
+    };
+
+    glShaderSource(*shaderObject, 2, (const char**)vertexShaderCode, NULL);
+    glCompileShader(*shaderObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderCompileStatus = 0;
+    char *infoLog = NULL;
+
+    glGetShaderiv(*shaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
+
+    if(shaderCompileStatus == GL_FALSE)
+    {
+        glGetShaderiv(*shaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetShaderInfoLog(*shaderObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Vertex shader compilation log: %s\n", infoLog);
+                free(infoLog);
+                cleanUp();
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+// Passes every triangle through unchanged, sending it to the viewport of its instance.
+void initializeGeometryShader()
+{
+    geometryShaderObject = glCreateShader(GL_GEOMETRY_SHADER);
+
+    const GLchar *geometryShaderCode = "#version 450 core" \
+        "\n" \
+        "layout(triangles) in;" \
+        "\n" \
+        "layout(triangle_strip, max_vertices = 3) out;" \
+        "\n" \
+        "in VertexData" \
+        "{" \
+        "   vec3 tNormal;" \
+        "   vec3 lightZeroDirection;" \
+        "   vec4 eyeCoordinates;" \
+        "   vec3 viewVector;" \
+        "   flat uint material;" \
+        "   flat int viewportIndex;" \
+        "} vertexIn[];" \
+        "\n" \
+        "out VertexData" \
+        "{" \
+        "   vec3 tNormal;" \
+        "   vec3 lightZeroDirection;" \
+        "   vec4 eyeCoordinates;" \
+        "   vec3 viewVector;" \
+        "   flat uint material;" \
+        "   flat int viewportIndex;" \
+        "} vertexOut;" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   for(int vertex = 0; vertex < 3; ++vertex)" \
+        "   {" \
+        "       vertexOut.tNormal = vertexIn[vertex].tNormal;" \
+        "       vertexOut.lightZeroDirection = vertexIn[vertex].lightZeroDirection;" \
+        "       vertexOut.eyeCoordinates = vertexIn[vertex].eyeCoordinates;" \
+        "       vertexOut.viewVector = vertexIn[vertex].viewVector;" \
+        "       vertexOut.material = vertexIn[vertex].material;" \
+        "       vertexOut.viewportIndex = vertexIn[vertex].viewportIndex;" \
+        "       gl_ViewportIndex = vertexIn[0].viewportIndex;" \
+        "       gl_Position = gl_in[vertex].gl_Position;" \
+        "       EmitVertex();" \
         "   }" \
         "\n" \
-        "   gl_Position = projectionMatrix * viewMatrix * modelMatrix * vertexPosition;" \
+        "   EndPrimitive();" \
         "}";
 
-    glShaderSource(vertexShaderObject, 1, (const char**)&vertexShaderCode, NULL);
-    glCompileShader(vertexShaderObject);
+    glShaderSource(geometryShaderObject, 1, (const char**)&geometryShaderCode, NULL);
+    glCompileShader(geometryShaderObject);
 
     GLint infoLogLength = 0;
     GLint shaderCompileStatus = 0;
     char *infoLog = NULL;
 
-    glGetShaderiv(vertexShaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
+    glGetShaderiv(geometryShaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
 
     if(shaderCompileStatus == GL_FALSE)
     {
-        glGetShaderiv(vertexShaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+        glGetShaderiv(geometryShaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
 
         if(infoLogLength > 0)
         {
@@ -603,8 +827,8 @@ void initializeVertexShader()
             if(infoLog != NULL)
             {
                 GLsizei written = 0;
-                glGetShaderInfoLog(vertexShaderObject, infoLogLength, &written, infoLog);
-                fprintf(logFile, "CG: Vertex shader compilation log: %s\n", infoLog);
+                glGetShaderInfoLog(geometryShaderObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Geometry shader compilation log: %s\n", infoLog);
                 free(infoLog);
                 cleanUp();
                 exit(EXIT_FAILURE);
@@ -619,36 +843,60 @@ void initializeFragmentShader()
 
     const GLchar *fragmentShaderCode = "#version 450 core" \
         "\n" \
-		"in vec3 tNormal;" \
-		"in vec3 lightZeroDirection;" \
-		"in vec4 eyeCoordinates;" \
-		"in vec3 viewVector;" \
+        "in VertexData" \
+        "{" \
+        "   vec3 tNormal;" \
+        "   vec3 lightZeroDirection;" \
+        "   vec4 eyeCoordinates;" \
+        "   vec3 viewVector;" \
+        "   flat uint material;" \
+        "   flat int viewportIndex;" \
+        "} fragmentIn;" \
         "\n" \
         "out vec4 fragmentColor;" \
         "\n" \
-        "uniform int isLightingEnabled;" \
-        "uniform vec3 laZero;" \
-        "uniform vec3 ldZero;" \
-        "uniform vec3 lsZero;" \
-        "uniform vec3 ka;" \
-        "uniform vec3 kd;" \
-        "uniform vec3 ks;" \
-        "uniform float materialShininess;" \
+        "struct Material" \
+        "{" \
+        "   vec4 ambient;" \
+        "   vec4 diffuse;" \
+        "   vec4 specularAndShininess;" \
+        "};" \
+        "\n" \
+        "layout(std140, binding = 0) uniform Materials" \
+        "{" \
+        "   Material materials[24];" \
+        "};" \
+        "\n" \
+        "layout(std140, binding = 1) uniform Frame" \
+        "{" \
+        "   mat4 viewMatrix;" \
+        "   mat4 projectionMatrix;" \
+        "   vec4 lightZeroPosition;" \
+        "   vec4 laZero;" \
+        "   vec4 ldZero;" \
+        "   vec4 lsZero;" \
+        "   int isLightingEnabled;" \
+        "};" \
         "\n" \
         "void main(void)" \
         "{" \
         "   vec3 phongAdsColor = vec3(0.0, 0.0, 0.0);" \
         "   if(isLightingEnabled == 1)" \
         "   {" \
-        "       vec3 normalizedTNormal = normalize(tNormal);" \
-        "       vec3 normalizedViewVector = normalize(viewVector);" \
+        "       vec3 ka = materials[fragmentIn.material].ambient.rgb;" \
+        "       vec3 kd = materials[fragmentIn.material].diffuse.rgb;" \
+        "       vec3 ks = materials[fragmentIn.material].specularAndShininess.rgb;" \
+        "       float materialShininess = materials[fragmentIn.material].specularAndShininess.w;" \
+        "\n" \
+        "       vec3 normalizedTNormal = normalize(fragmentIn.tNormal);" \
+        "       vec3 normalizedViewVector = normalize(fragmentIn.viewVector);" \
         "\n" \
-        "       vec3 normalizedLightZeroDirection = normalize(lightZeroDirection - eyeCoordinates.xyz);" \
+        "       vec3 normalizedLightZeroDirection = normalize(fragmentIn.lightZeroDirection - fragmentIn.eyeCoordinates.xyz);" \
         "       float tNormalDotLightZeroDirection = max(dot(normalizedTNormal, normalizedLightZeroDirection), 0.0);" \
-        "       vec3 ambientLightZero = laZero * ka;" \
-        "       vec3 diffuseLightZero = ldZero * kd * tNormalDotLightZeroDirection;" \
+        "       vec3 ambientLightZero = laZero.rgb * ka;" \
+        "       vec3 diffuseLightZero = ldZero.rgb * kd * tNormalDotLightZeroDirection;" \
         "       vec3 reflectionVectorLightZero = reflect(-normalizedLightZeroDirection, normalizedTNormal);" \
-        "       vec3 specularLightZero = lsZero * ks * pow(max(dot(reflectionVectorLightZero, normalizedViewVector), 0.0), materialShininess);" \
+        "       vec3 specularLightZero = lsZero.rgb * ks * pow(max(dot(reflectionVectorLightZero, normalizedViewVector), 0.0), materialShininess);" \
         "\n" \
         "       phongAdsColor = ambientLightZero + diffuseLightZero + specularLightZero;" \
         "   }" \
@@ -690,30 +938,41 @@ void initializeFragmentShader()
     }
 }
 
-void initializeShaderProgram()
+// Links the fragment shader with vertexShader, and geometryShader unless it is 0.
+void initializeShaderProgram(GLuint *programObject, GLuint vertexShader, GLuint geometryShader)
 {
-    shaderProgramObject = glCreateProgram();
-    glAttachShader(shaderProgramObject, vertexShaderObject);
-    glAttachShader(shaderProgramObject, fragmentShaderObject);
+    *programObject = glCreateProgram();
+    glAttachShader(*programObject, vertexShader);
+
+    if(geometryShader)
+    {
+        glAttachShader(*programObject, geometryShader);
+    }
+
+    glAttachShader(*programObject, fragmentShaderObject);
 
     // Bind the position attribute location before linking.
-    glBindAttribLocation(shaderProgramObject, CG_ATTRIBUTE_VERTEX_POSITION, "vertexPosition");
+    glBindAttribLocation(*programObject, CG_ATTRIBUTE_VERTEX_POSITION, "vertexPosition");
 
     // Bind the normal attribute location before linking.
-    glBindAttribLocation(shaderProgramObject, CG_ATTRIBUTE_NORMAL, "vertexNormal");
+    glBindAttribLocation(*programObject, CG_ATTRIBUTE_NORMAL, "vertexNormal");
+
+    // Bind the per sphere attribute locations before linking.
+    glBindAttribLocation(*programObject, CG_ATTRIBUTE_SPHERE_TRANSLATION, "sphereTranslation");
+    glBindAttribLocation(*programObject, CG_ATTRIBUTE_SPHERE_MATERIAL, "sphereMaterial");
 
     // Now link and check for error.
-    glLinkProgram(shaderProgramObject);
+    glLinkProgram(*programObject);
 
     GLint infoLogLength = 0;
     GLint shaderProgramLinkStatus = 0;
     char *infoLog = NULL;
 
-    glGetProgramiv(shaderProgramObject, GL_LINK_STATUS, &shaderProgramLinkStatus);
+    glGetProgramiv(*programObject, GL_LINK_STATUS, &shaderProgramLinkStatus);
 
     if(shaderProgramLinkStatus == GL_FALSE)
     {
-        glGetProgramiv(shaderProgramObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+        glGetProgramiv(*programObject, GL_INFO_LOG_LENGTH, &infoLogLength);
 
         if(infoLogLength > 0)
         {
@@ -722,7 +981,7 @@ void initializeShaderProgram()
             if(infoLog != NULL)
             {
                 GLsizei written = 0;
-                glGetProgramInfoLog(shaderProgramObject, infoLogLength, &written, infoLog);
+                glGetProgramInfoLog(*programObject, infoLogLength, &written, infoLog);
                 fprintf(logFile, "CG: Shader program link log: %s\n", infoLog);
                 free(infoLog);
                 cleanUp();
@@ -730,33 +989,89 @@ void initializeShaderProgram()
             }
         }
     }
+}
+
+// Picks how the grid is drawn in one pass: the vertex shader choosing the viewport when it can,
+// a pass through geometry shader otherwise, and one draw per viewport without viewport arrays.
+void initializeViewportArray(void)
+{
+    if(!GLEW_ARB_viewport_array)
+    {
+        viewportArrayMode = VIEWPORT_ARRAY_NONE;
+        fprintf(logFile, "No viewport arrays, the grid is drawn one viewport at a time.\n");
+        fflush(logFile);
+        return;
+    }
 
-    // After linking get the value of modelView and projection uniform location from the shader program.
-    modelMatrixUniform = glGetUniformLocation(shaderProgramObject, "modelMatrix");
-    viewMatrixUniform = glGetUniformLocation(shaderProgramObject, "viewMatrix");
-    projectionMatrixUniform = glGetUniformLocation(shaderProgramObject, "projectionMatrix");
+    glGetIntegerv(GL_MAX_VIEWPORTS, &maxViewports);
 
-    isLightingEnabledUniform = glGetUniformLocation(shaderProgramObject, "isLightingEnabled");
+    if(GLEW_ARB_shader_viewport_layer_array)
+    {
+        viewportArrayMode = VIEWPORT_ARRAY_VERTEX_SHADER;
+        initializeVertexShader(&viewportVertexShaderObject, "#version 450 core\n#extension GL_ARB_shader_viewport_layer_array : require\n#define VIEWPORT_FROM_INSTANCE\n");
+        initializeShaderProgram(&viewportArrayProgramObject, viewportVertexShaderObject, 0);
+    }
+    else
+    {
+        viewportArrayMode = VIEWPORT_ARRAY_GEOMETRY_SHADER;
+        initializeGeometryShader();
+        initializeShaderProgram(&viewportArrayProgramObject, vertexShaderObject, geometryShaderObject);
+    }
 
-    laZeroUniform = glGetUniformLocation(shaderProgramObject, "laZero");
-    ldZeroUniform = glGetUniformLocation(shaderProgramObject, "ldZero");
-    lsZeroUniform = glGetUniformLocation(shaderProgramObject, "lsZero");
-    kaUniform = glGetUniformLocation(shaderProgramObject, "ka");
-    kdUniform = glGetUniformLocation(shaderProgramObject, "kd");
-    ksUniform = glGetUniformLocation(shaderProgramObject, "ks");
-    lightZeroPositionUniform = glGetUniformLocation(shaderProgramObject, "lightZeroPosition");
-    materialShininessUniform = glGetUniformLocation(shaderProgramObject, "materialShininess");
+    fprintf(logFile, "Viewport arrays of %d viewports, set from the %s shader.\n", maxViewports, viewportArrayMode == VIEWPORT_ARRAY_VERTEX_SHADER ? "vertex" : "geometry");
+    fflush(logFile);
 }
 
 void initializeSphereBuffers()
 {
+    int sphereSlices[NUMBER_OF_SPHERE_MESHES];
+    int sphereStacks[NUMBER_OF_SPHERE_MESHES];
+    int numberOfVertices = 0;
+    int numberOfElements = 0;
+
+    for(int mesh = 0; mesh < NUMBER_OF_SPHERE_MESHES; ++mesh)
+    {
+        sphereSlices[mesh] = mesh == FULL_RESOLUTION_SPHERE ? 20 : sphereLodSlices[mesh];
+        sphereStacks[mesh] = mesh == FULL_RESOLUTION_SPHERE ? 20 : sphereLodSlices[mesh] / 2;
+        sphereFirstElement[mesh] = numberOfElements;
+        sphereNumberOfElements[mesh] = getSphereNumberOfElements(sphereSlices[mesh], sphereStacks[mesh]);
+
+        numberOfVertices += getSphereNumberOfVertices(sphereSlices[mesh], sphereStacks[mesh]);
+        numberOfElements += sphereNumberOfElements[mesh];
+    }
+
+    // All meshes together stay below 65536 vertices, so the elements are short and absolute.
+    float *sphereVertices = (float *)malloc(sizeof(float) * 3 * numberOfVertices);
+    float *sphereNormals = (float *)malloc(sizeof(float) * 3 * numberOfVertices);
+    unsigned short *sphereElements = (unsigned short *)malloc(sizeof(unsigned short) * numberOfElements);
+
+    if(sphereVertices == NULL || sphereNormals == NULL || sphereElements == NULL)
+    {
+        fprintf(logFile, "Cannot allocate the sphere meshes.\n");
+        fflush(logFile);
+
+        free(sphereVertices);
+        free(sphereNormals);
+        free(sphereElements);
+        cleanUp();
+        exit(EXIT_FAILURE);
+    }
+
+    int firstVertex = 0;
+
+    for(int mesh = 0; mesh < NUMBER_OF_SPHERE_MESHES; ++mesh)
+    {
+        generateSphere(sphereSlices[mesh], sphereStacks[mesh], sphereRadius, sphereVertices + firstVertex * 3, sphereNormals + firstVertex * 3, sphereElements + sphereFirstElement[mesh], (unsigned short)firstVertex);
+        firstVertex += getSphereNumberOfVertices(sphereSlices[mesh], sphereStacks[mesh]);
+    }
+
     glGenVertexArrays(1, &vaoSphere);
     glBindVertexArray(vaoSphere);
 
     glGenBuffers(1, &vboSpherePosition);
     glBindBuffer(GL_ARRAY_BUFFER, vboSpherePosition);
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(sphereVertices), sphereVertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 3 * numberOfVertices, sphereVertices, GL_STATIC_DRAW);
     glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, NULL);
     glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
 
@@ -765,20 +1080,129 @@ void initializeSphereBuffers()
     glGenBuffers(1, &vboSphereNormal);
     glBindBuffer(GL_ARRAY_BUFFER, vboSphereNormal);
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(sphereNormals), sphereNormals, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 3 * numberOfVertices, sphereNormals, GL_STATIC_DRAW);
     glVertexAttribPointer(CG_ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, 0, NULL);
     glEnableVertexAttribArray(CG_ATTRIBUTE_NORMAL);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+    // One translation and material per instance, the instance being picked by the base instance
+    // of each draw.
+    initializeSphereInstances();
+
+    glGenBuffers(1, &vboSphereInstance);
+    glBindBuffer(GL_ARRAY_BUFFER, vboSphereInstance);
+
+    glBufferData(GL_ARRAY_BUFFER, sizeof(sphereInstances), sphereInstances, GL_STATIC_DRAW);
+    glVertexAttribPointer(CG_ATTRIBUTE_SPHERE_TRANSLATION, 3, GL_FLOAT, GL_FALSE, sizeof(SphereInstance), (const GLvoid *)offsetof(SphereInstance, translation));
+    glVertexAttribIPointer(CG_ATTRIBUTE_SPHERE_MATERIAL, 1, GL_UNSIGNED_INT, sizeof(SphereInstance), (const GLvoid *)offsetof(SphereInstance, material));
+    glVertexAttribDivisor(CG_ATTRIBUTE_SPHERE_TRANSLATION, 1);
+    glVertexAttribDivisor(CG_ATTRIBUTE_SPHERE_MATERIAL, 1);
+    glEnableVertexAttribArray(CG_ATTRIBUTE_SPHERE_TRANSLATION);
+    glEnableVertexAttribArray(CG_ATTRIBUTE_SPHERE_MATERIAL);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // The element buffer stays attached to the VAO.
     glGenBuffers(1, &vboSphereElement);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboSphereElement);
 
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(sphereElements), sphereElements, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short) * numberOfElements, sphereElements, GL_STATIC_DRAW);
 
+    glBindVertexArray(0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
-    glBindVertexArray(0);
+    free(sphereVertices);
+    free(sphereNormals);
+    free(sphereElements);
+
+    fprintf(logFile, "Sphere meshes: %d vertices, %d triangles for all levels.\n", numberOfVertices, numberOfElements / 3);
+    fflush(logFile);
+}
+
+// The grid spheres all sit at the same place in their own viewport, the field is laid out in the
+// plane below the eye and moved away by the view matrix.
+void initializeSphereInstances(void)
+{
+    for(int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter)
+    {
+        for(int rowCounter = 0; rowCounter < numberOfRows; ++rowCounter)
+        {
+            SphereInstance *instance = &sphereInstances[FIRST_GRID_SPHERE + columnCounter * numberOfRows + rowCounter];
+
+            instance->translation[0] = 0.0f;
+            instance->translation[1] = 0.0f;
+            instance->translation[2] = -3.0f;
+            instance->material = columnCounter * numberOfRows + rowCounter;
+        }
+    }
+
+    for(int columnCounter = 0; columnCounter < fieldSize; ++columnCounter)
+    {
+        for(int rowCounter = 0; rowCounter < fieldSize; ++rowCounter)
+        {
+            SphereInstance *instance = &sphereInstances[FIRST_FIELD_SPHERE + columnCounter * fieldSize + rowCounter];
+
+            instance->translation[0] = (columnCounter - fieldSize / 2 + 0.5f) * 1.5f;
+            instance->translation[1] = -1.5f;
+            instance->translation[2] = -4.0f - rowCounter * 1.5f;
+            instance->material = (columnCounter % numberOfColumns) * numberOfRows + rowCounter % numberOfRows;
+        }
+    }
+}
+
+// The material tables go into the Materials block once, and only the Frame block is written again,
+// once per frame, so drawing a sphere sets no uniform at all.
+void initializeUniformBuffers(void)
+{
+    MaterialUniforms materials[NUMBER_OF_MATERIALS];
+
+    for(int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter)
+    {
+        for(int rowCounter = 0; rowCounter < numberOfRows; ++rowCounter)
+        {
+            MaterialUniforms *material = &materials[columnCounter * numberOfRows + rowCounter];
+
+            memcpy(material->ambient, materialAmbient[columnCounter][rowCounter], sizeof(material->ambient));
+            memcpy(material->diffuse, materialDiffuse[columnCounter][rowCounter], sizeof(material->diffuse));
+            memcpy(material->specularAndShininess, materialSpecular[columnCounter][rowCounter], sizeof(material->specularAndShininess));
+            material->specularAndShininess[3] = materialShininess[columnCounter][rowCounter];
+        }
+    }
+
+    glGenBuffers(1, &uboMaterials);
+    glBindBuffer(GL_UNIFORM_BUFFER, uboMaterials);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(materials), materials, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &uboFrame);
+    glBindBuffer(GL_UNIFORM_BUFFER, uboFrame);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), NULL, GL_DYNAMIC_DRAW);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Nothing else uses uniform buffers, so both stay bound for the life of the context.
+    glBindBufferBase(GL_UNIFORM_BUFFER, CG_UNIFORM_BLOCK_MATERIALS, uboMaterials);
+    glBindBufferBase(GL_UNIFORM_BUFFER, CG_UNIFORM_BLOCK_FRAME, uboFrame);
+}
+
+void resetSphereLevels(void)
+{
+    memset(gridSphereLevels, 0xFF, sizeof(gridSphereLevels));
+    memset(fieldSphereLevels, 0xFF, sizeof(fieldSphereLevels));
+    loggedTrianglesPerFrame = -1;
+
+    // Every toggle changes what is drawn, so the grid timing starts over.
+    if(isGridTimeQueryPending)
+    {
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(gridTimeQuery, GL_QUERY_RESULT, &nanoseconds);
+        isGridTimeQueryPending = false;
+    }
+
+    gridCpuTicks = 0;
+    gridCpuFrames = 0;
+    gridGpuNanoseconds = 0;
+    gridGpuFrames = 0;
 }
 
 void update(void)
@@ -794,93 +1218,254 @@ void update(void)
     {
         angleLightRotation = 0.0f;
     }
+
+    // The field slowly moves away and back, so spheres change level all the time.
+    angleField += 0.002f;
+
+    if(angleField >= 2.0f * SPHERE_LOD_PI)
+    {
+        angleField -= 2.0f * SPHERE_LOD_PI;
+    }
 }
 
 void display(void)
 {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-    for(int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter)
+    trianglesPerFrame = 0;
+    drawsPerFrame = 0;
+
+    glUseProgram(shaderProgramObject);
+    glBindVertexArray(vaoSphere);
+
+    if(isFieldEnabled)
     {
-        for(int rowCounter = 0; rowCounter < numberOfRows; ++rowCounter)
-        {
-            glViewport(viewportInitialX + (columnCounter * viewportWidth), viewportInitialY + (rowCounter * viewportHeight), viewportWidth, viewportHeight);
+        int width = windowRect.right - windowRect.left;
+        int height = windowRect.bottom - windowRect.top > 0 ? windowRect.bottom - windowRect.top : 1;
+        vmath::mat4 viewMatrix = vmath::translate(0.0f, 0.0f, -15.0f + 15.0f * cosf(angleField));
 
-            glUseProgram(shaderProgramObject);
+        glViewport(0, 0, width, height);
+        updateFrameUniforms(viewMatrix);
 
-            if(isLightingEnabled)
+        for(int columnCounter = 0; columnCounter < fieldSize; ++columnCounter)
+        {
+            for(int rowCounter = 0; rowCounter < fieldSize; ++rowCounter)
             {
-                glUniform1i(isLightingEnabledUniform, 1);
+                drawSphere(FIRST_FIELD_SPHERE + columnCounter * fieldSize + rowCounter, viewMatrix, &fieldSphereLevels[columnCounter][rowCounter], height);
+            }
+        }
+    }
+    else
+    {
+        vmath::mat4 viewMatrix = vmath::mat4::identity();
 
-                glUniform3fv(laZeroUniform, 1, lightZeroAmbient);
-                glUniform3fv(ldZeroUniform, 1, lightZeroDiffuse);
-                glUniform3fv(lsZeroUniform, 1, lightZeroSpecular);
+        updateFrameUniforms(viewMatrix);
+        drawGrid(viewMatrix);
+    }
 
-                if(rotateLightOnXAxis)
-                {
-                    lightZeroPosition[0] = 0.0f;
-                    lightZeroPosition[1] = sinf(angleLightRotation) * 100.0f - 3.0f;
-                    lightZeroPosition[2] = cosf(angleLightRotation) * 100.0f - 3.0f;
-                }
-                else if(rotateLightOnYAxis)
-                {
-                    lightZeroPosition[0] = sinf(angleLightRotation) * 100.0f - 3.0f;
-                    lightZeroPosition[1] = 0.0f;
-                    lightZeroPosition[2] = cosf(angleLightRotation) * 100.0f - 3.0f;
-                }
-                else if(rotateLightOnZAxis)
-                {
-                    lightZeroPosition[0] = sinf(angleLightRotation) * 100.0f - 3.0f;
-                    lightZeroPosition[1] = cosf(angleLightRotation) * 100.0f - 3.0f;
-                    lightZeroPosition[2] = 0.0f;
-                }
+    glBindVertexArray(0);
+    glUseProgram(0);
 
-                glUniform4fv(lightZeroPositionUniform, 1, lightZeroPosition);
-                glUniform3fv(kaUniform, 1, materialAmbient[columnCounter][rowCounter]);
-                glUniform3fv(kdUniform, 1, materialDiffuse[columnCounter][rowCounter]);
-                glUniform3fv(ksUniform, 1, materialSpecular[columnCounter][rowCounter]);
-                glUniform1f(materialShininessUniform, materialShininess[columnCounter][rowCounter]);
-            }
-            else
+    SwapBuffers(hdc);
+
+    if(loggedTrianglesPerFrame < 0 || abs(trianglesPerFrame - loggedTrianglesPerFrame) * 20 > loggedTrianglesPerFrame)
+    {
+        int spheres = isFieldEnabled ? fieldSize * fieldSize : numberOfColumns * numberOfRows;
+        int fullResolutionTriangles = spheres * sphereNumberOfElements[FULL_RESOLUTION_SPHERE] / 3;
+
+        fprintf(logFile, "Triangles per frame: %d for %d spheres in %d draws, %d at full resolution (%.1f%%), LOD %s.\n", trianglesPerFrame, spheres, drawsPerFrame, fullResolutionTriangles, 100.0f * trianglesPerFrame / fullResolutionTriangles, isLodEnabled ? "on" : "off");
+        fflush(logFile);
+
+        loggedTrianglesPerFrame = trianglesPerFrame;
+    }
+}
+
+// Everything that is the same for all spheres of the frame, written with a single update.
+void updateFrameUniforms(vmath::mat4 viewMatrix)
+{
+    FrameUniforms frame;
+
+    memcpy(frame.viewMatrix, (const GLfloat *)viewMatrix, sizeof(frame.viewMatrix));
+    memcpy(frame.projectionMatrix, (const GLfloat *)perspectiveProjectionMatrix, sizeof(frame.projectionMatrix));
+
+    if(rotateLightOnXAxis)
+    {
+        lightZeroPosition[0] = 0.0f;
+        lightZeroPosition[1] = sinf(angleLightRotation) * 100.0f - 3.0f;
+        lightZeroPosition[2] = cosf(angleLightRotation) * 100.0f - 3.0f;
+    }
+    else if(rotateLightOnYAxis)
+    {
+        lightZeroPosition[0] = sinf(angleLightRotation) * 100.0f - 3.0f;
+        lightZeroPosition[1] = 0.0f;
+        lightZeroPosition[2] = cosf(angleLightRotation) * 100.0f - 3.0f;
+    }
+    else if(rotateLightOnZAxis)
+    {
+        lightZeroPosition[0] = sinf(angleLightRotation) * 100.0f - 3.0f;
+        lightZeroPosition[1] = cosf(angleLightRotation) * 100.0f - 3.0f;
+        lightZeroPosition[2] = 0.0f;
+    }
+
+    memcpy(frame.lightZeroPosition, lightZeroPosition, sizeof(frame.lightZeroPosition));
+    memcpy(frame.laZero, lightZeroAmbient, sizeof(frame.laZero));
+    memcpy(frame.ldZero, lightZeroDiffuse, sizeof(frame.ldZero));
+    memcpy(frame.lsZero, lightZeroSpecular, sizeof(frame.lsZero));
+    frame.isLightingEnabled = isLightingEnabled ? 1 : 0;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, uboFrame);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(frame), &frame);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+// Draws the 24 material spheres each in its viewport, and times it.
+void drawGrid(vmath::mat4 viewMatrix)
+{
+    LARGE_INTEGER start;
+    LARGE_INTEGER end;
+
+    readGridTime();
+
+    if(!isGridTimeQueryPending)
+    {
+        glBeginQuery(GL_TIME_ELAPSED, gridTimeQuery);
+    }
+
+    QueryPerformanceCounter(&start);
+
+    if(isViewportArrayEnabled && viewportArrayMode != VIEWPORT_ARRAY_NONE)
+    {
+        drawGridWithViewportArray(viewMatrix);
+    }
+    else
+    {
+        for(int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter)
+        {
+            for(int rowCounter = 0; rowCounter < numberOfRows; ++rowCounter)
             {
-                glUniform1i(isLightingEnabledUniform, 0);
+                glViewport(viewportInitialX + (columnCounter * viewportWidth), viewportInitialY + (rowCounter * viewportHeight), viewportWidth, viewportHeight);
+                drawSphere(FIRST_GRID_SPHERE + columnCounter * numberOfRows + rowCounter, viewMatrix, &gridSphereLevels[columnCounter][rowCounter], viewportHeight);
             }
+        }
+    }
+
+    QueryPerformanceCounter(&end);
 
-            drawSphere();
+    if(!isGridTimeQueryPending)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        isGridTimeQueryPending = true;
+    }
+
+    gridCpuTicks += end.QuadPart - start.QuadPart;
+    ++gridCpuFrames;
 
-            glUseProgram(0);
+    if(gridCpuFrames == GRID_TIMING_FRAMES)
+    {
+        logGridTime();
+    }
+}
+
+// Every sphere of the grid has the same size on screen, so all are drawn at the level of the first,
+// as instances sent to their own viewport, as many at a time as there are viewports.
+void drawGridWithViewportArray(vmath::mat4 viewMatrix)
+{
+    int mesh = selectSphereMesh(FIRST_GRID_SPHERE, viewMatrix, &gridSphereLevels[0][0], viewportHeight);
+
+    for(int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter)
+    {
+        for(int rowCounter = 0; rowCounter < numberOfRows; ++rowCounter)
+        {
+            gridSphereLevels[columnCounter][rowCounter] = gridSphereLevels[0][0];
         }
     }
 
-    SwapBuffers(hdc);
+    glUseProgram(viewportArrayProgramObject);
+
+    for(int first = 0; first < NUMBER_OF_MATERIALS; first += maxViewports)
+    {
+        int count = NUMBER_OF_MATERIALS - first < maxViewports ? NUMBER_OF_MATERIALS - first : maxViewports;
+
+        glViewportArrayv(0, count, gridViewports[first]);
+        glDrawElementsInstancedBaseInstance(GL_TRIANGLES, sphereNumberOfElements[mesh], GL_UNSIGNED_SHORT, (const GLvoid *)(sphereFirstElement[mesh] * sizeof(unsigned short)), count, FIRST_GRID_SPHERE + first);
+
+        trianglesPerFrame += count * sphereNumberOfElements[mesh] / 3;
+        ++drawsPerFrame;
+    }
+
+    glUseProgram(shaderProgramObject);
 }
 
-void drawSphere()
+void readGridTime(void)
 {
-    vmath::mat4 modelMatrix = vmath::mat4::identity();
-    vmath::mat4 viewMatrix = vmath::mat4::identity();
+    GLint isAvailable = 0;
 
-    // Translate the modal matrix.
-    modelMatrix = vmath::translate(0.0f, 0.0f, -3.0f);
-    // Pass modelMatrix to vertex shader in 'modelMatrix' variable defined in shader.
-    glUniformMatrix4fv(modelMatrixUniform, 1, GL_FALSE, modelMatrix);
+    if(!isGridTimeQueryPending)
+    {
+        return;
+    }
 
-    // Pass viewMatrix to vertex shader in 'viewMatrix' variable defined in shader.
-    glUniformMatrix4fv(viewMatrixUniform, 1, GL_FALSE, viewMatrix);
+    glGetQueryObjectiv(gridTimeQuery, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
 
-    // Pass perspectiveProjectionMatrix to vertex shader in 'projectionMatrix' variable defined in shader.
-    glUniformMatrix4fv(projectionMatrixUniform, 1, GL_FALSE, perspectiveProjectionMatrix);
+    if(isAvailable)
+    {
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(gridTimeQuery, GL_QUERY_RESULT, &nanoseconds);
 
-    // Now bind the VAO to which we want to use
-    glBindVertexArray(vaoSphere);
+        gridGpuNanoseconds += nanoseconds;
+        ++gridGpuFrames;
+        isGridTimeQueryPending = false;
+    }
+}
 
-    // Draw the sphere
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboSphereElement);
-    glDrawElements(GL_TRIANGLES, numberOfSphereElements, GL_UNSIGNED_SHORT, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+void logGridTime(void)
+{
+    const char *method = "one viewport at a time";
 
-    // unbind the vao
-    glBindVertexArray(0);
+    if(isViewportArrayEnabled && viewportArrayMode == VIEWPORT_ARRAY_VERTEX_SHADER)
+    {
+        method = "viewport arrays from the vertex shader";
+    }
+    else if(isViewportArrayEnabled && viewportArrayMode == VIEWPORT_ARRAY_GEOMETRY_SHADER)
+    {
+        method = "viewport arrays from the geometry shader";
+    }
+
+    fprintf(logFile, "Grid drawn %s: %.3f ms CPU, %.3f ms GPU per frame.\n", method, 1000.0 * gridCpuTicks / gridCpuFrames / performanceFrequency.QuadPart, gridGpuFrames > 0 ? gridGpuNanoseconds / 1000000.0 / gridGpuFrames : 0.0);
+    fflush(logFile);
+
+    gridCpuTicks = 0;
+    gridCpuFrames = 0;
+    gridGpuNanoseconds = 0;
+    gridGpuFrames = 0;
+}
+
+// The mesh the sphere needs for its size on screen, level holding the one it was drawn at last frame.
+int selectSphereMesh(int sphere, vmath::mat4 viewMatrix, int *level, int viewportHeight)
+{
+    if(!isLodEnabled)
+    {
+        return FULL_RESOLUTION_SPHERE;
+    }
+
+    // The view matrix only translates, so the center is the sum of both translations.
+    const GLfloat *translation = sphereInstances[sphere].translation;
+    vmath::vec3 center(translation[0] + viewMatrix[3][0], translation[1] + viewMatrix[3][1], translation[2] + viewMatrix[3][2]);
+    float distance = sqrtf(center[0] * center[0] + center[1] * center[1] + center[2] * center[2]);
+
+    *level = selectSphereLod(*level, getSphereProjectedRadius(sphereRadius, distance, perspectiveProjectionMatrix[1][1], viewportHeight));
+    return *level;
+}
+
+// Draws the sphere at the level its size on screen needs. The sphere is the base instance, which is
+// all the shaders need to place and light it.
+void drawSphere(int sphere, vmath::mat4 viewMatrix, int *level, int viewportHeight)
+{
+    int mesh = selectSphereMesh(sphere, viewMatrix, level, viewportHeight);
+
+    glDrawElementsInstancedBaseInstance(GL_TRIANGLES, sphereNumberOfElements[mesh], GL_UNSIGNED_SHORT, (const GLvoid *)(sphereFirstElement[mesh] * sizeof(unsigned short)), 1, sphere);
+    trianglesPerFrame += sphereNumberOfElements[mesh] / 3;
+    ++drawsPerFrame;
 }
 
 void resize(int width, int height)
@@ -894,6 +1479,19 @@ void resize(int width, int height)
     viewportHeight = height / numberOfRows;
     viewportInitialX = (width - (viewportWidth * numberOfColumns)) / 2;
     viewportInitialY = (height - (viewportHeight * numberOfRows)) / 2;
+
+    for(int columnCounter = 0; columnCounter < numberOfColumns; ++columnCounter)
+    {
+        for(int rowCounter = 0; rowCounter < numberOfRows; ++rowCounter)
+        {
+            GLfloat *viewport = gridViewports[columnCounter * numberOfRows + rowCounter];
+
+            viewport[0] = (GLfloat)(viewportInitialX + (columnCounter * viewportWidth));
+            viewport[1] = (GLfloat)(viewportInitialY + (rowCounter * viewportHeight));
+            viewport[2] = (GLfloat)viewportWidth;
+            viewport[3] = (GLfloat)viewportHeight;
+        }
+    }
     perspectiveProjectionMatrix = vmath::perspective(45.0f, (GLfloat)width / (GLfloat)height, 1.0f, 100.0f);
 }
 
@@ -961,6 +1559,60 @@ void cleanUp(void)
         vboSphereElement = 0;
     }
 
+    if(vboSphereInstance)
+    {
+        glDeleteBuffers(1, &vboSphereInstance);
+        vboSphereInstance = 0;
+    }
+
+    if(uboMaterials)
+    {
+        glDeleteBuffers(1, &uboMaterials);
+        uboMaterials = 0;
+    }
+
+    if(uboFrame)
+    {
+        glDeleteBuffers(1, &uboFrame);
+        uboFrame = 0;
+    }
+
+    if(gridTimeQuery)
+    {
+        glDeleteQueries(1, &gridTimeQuery);
+        gridTimeQuery = 0;
+    }
+
+    if(viewportArrayProgramObject)
+    {
+        if(viewportVertexShaderObject)
+        {
+            glDetachShader(viewportArrayProgramObject, viewportVertexShaderObject);
+        }
+
+        if(geometryShaderObject)
+        {
+            glDetachShader(viewportArrayProgramObject, vertexShaderObject);
+            glDetachShader(viewportArrayProgramObject, geometryShaderObject);
+        }
+
+        glDetachShader(viewportArrayProgramObject, fragmentShaderObject);
+        glDeleteProgram(viewportArrayProgramObject);
+        viewportArrayProgramObject = 0;
+    }
+
+    if(viewportVertexShaderObject)
+    {
+        glDeleteShader(viewportVertexShaderObject);
+        viewportVertexShaderObject = 0;
+    }
+
+    if(geometryShaderObject)
+    {
+        glDeleteShader(geometryShaderObject);
+        geometryShaderObject = 0;
+    }
+
     if(shaderProgramObject)
     {
         if(vertexShaderObject)
@@ -0,0 +1,131 @@
+#ifndef __SPHERE_LOD_H__
+#define __SPHERE_LOD_H__
+
+#include <math.h>
+
+// Spheres of the same radius at increasing resolution, all generated from slices and stacks, plus
+// the choice of which one to draw for a sphere covering a given number of pixels.
+//
+// A sphere of n slices is off from the true silhouette by at most radius * (1 - cos(pi / n)). A
+// level is good enough while that stays under SPHERE_LOD_PIXEL_ERROR pixels, so each level has a
+// largest projected radius it is used for and the coarsest level that covers a radius is picked.
+// Going back to a coarser level waits until the radius is SPHERE_LOD_HYSTERESIS below that
+// level's limit, so a sphere sitting right on a limit doesn't switch back and forth every frame.
+
+#define SPHERE_LOD_NUMBER_OF_LEVELS 7
+#define SPHERE_LOD_PIXEL_ERROR 0.5f
+#define SPHERE_LOD_HYSTERESIS 0.2f
+
+// M_PI needs _USE_MATH_DEFINES with cl.exe.
+#define SPHERE_LOD_PI 3.14159265358979f
+
+// Slices of each level, coarsest first, and half as many stacks.
+const int sphereLodSlices[SPHERE_LOD_NUMBER_OF_LEVELS] = { 8, 12, 16, 24, 32, 48, 64 };
+
+// Vertices and elements of a sphere of slices and stacks, with one more column than slices for the
+// seam and a full row at each pole.
+inline int getSphereNumberOfVertices(int slices, int stacks)
+{
+    return (slices + 1) * (stacks + 1);
+}
+
+inline int getSphereNumberOfElements(int slices, int stacks)
+{
+    return slices * (stacks - 1) * 2 * 3;
+}
+
+// Writes positions and normals (3 floats per vertex each) and elements starting at firstVertex,
+// counter clockwise seen from outside, poles on the y axis like Sphere.lib.
+inline void generateSphere(int slices, int stacks, float radius, float *positions, float *normals, unsigned short *elements, unsigned short firstVertex)
+{
+    int columns = slices + 1;
+
+    for(int stack = 0; stack <= stacks; stack++)
+    {
+        float theta = SPHERE_LOD_PI * (float)stack / (float)stacks;
+        float ringRadius = sinf(theta);
+        float y = -cosf(theta);
+
+        for(int slice = 0; slice <= slices; slice++)
+        {
+            float phi = 2.0f * SPHERE_LOD_PI * (float)slice / (float)slices;
+            float *normal = normals + (stack * columns + slice) * 3;
+            float *position = positions + (stack * columns + slice) * 3;
+
+            normal[0] = ringRadius * sinf(phi);
+            normal[1] = y;
+            normal[2] = ringRadius * cosf(phi);
+
+            position[0] = normal[0] * radius;
+            position[1] = normal[1] * radius;
+            position[2] = normal[2] * radius;
+        }
+    }
+
+    for(int stack = 0; stack < stacks; stack++)
+    {
+        for(int slice = 0; slice < slices; slice++)
+        {
+            unsigned short bottomLeft = (unsigned short)(firstVertex + stack * columns + slice);
+            unsigned short bottomRight = bottomLeft + 1;
+            unsigned short topLeft = bottomLeft + columns;
+            unsigned short topRight = topLeft + 1;
+
+            // The stacks touching the poles have one triangle per slice, the others two.
+            if(stack != stacks - 1)
+            {
+                *elements++ = bottomLeft;
+                *elements++ = topRight;
+                *elements++ = topLeft;
+            }
+
+            if(stack != 0)
+            {
+                *elements++ = bottomLeft;
+                *elements++ = bottomRight;
+                *elements++ = topRight;
+            }
+        }
+    }
+}
+
+// Largest projected radius in pixels a level is drawn for.
+inline float getSphereLodLimit(int level)
+{
+    return SPHERE_LOD_PIXEL_ERROR / (1.0f - cosf(SPHERE_LOD_PI / (float)sphereLodSlices[level]));
+}
+
+// Pixels covered by the radius of a sphere whose center is distance away from the eye, for a
+// projection with projectionScale (projection matrix [1][1]) drawn into viewportHeight pixels.
+inline float getSphereProjectedRadius(float radius, float distance, float projectionScale, int viewportHeight)
+{
+    if(distance <= radius)
+    {
+        return (float)viewportHeight;
+    }
+
+    return radius / sqrtf(distance * distance - radius * radius) * projectionScale * 0.5f * (float)viewportHeight;
+}
+
+// Level to draw a sphere covering projectedRadius pixels that was drawn at currentLevel last frame,
+// -1 when it has not been drawn yet.
+inline int selectSphereLod(int currentLevel, float projectedRadius)
+{
+    int level = 0;
+
+    while(level < SPHERE_LOD_NUMBER_OF_LEVELS - 1 && projectedRadius > getSphereLodLimit(level))
+    {
+        level++;
+    }
+
+    // Finer levels are taken right away, coarser ones only once the radius is clearly below their
+    // limit.
+    while(level < currentLevel && projectedRadius > getSphereLodLimit(level) * (1.0f - SPHERE_LOD_HYSTERESIS))
+    {
+        level++;
+    }
+
+    return level;
+}
+
+#endif /* __SPHERE_LOD_H__ */
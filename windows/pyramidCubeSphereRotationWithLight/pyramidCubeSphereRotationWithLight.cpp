@@ -7,6 +7,7 @@
 #include <gl/glu.h>
 
 #include "resources/resource.h"
+#include "primitives.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -43,7 +44,8 @@ GLfloat materialDiffuse[] = {1.0f, 1.0f, 1.0f, 1.0f};
 GLfloat materialSpecular[] = {1.0f, 1.0f, 1.0f, 0.0f};
 GLfloat matrialShininess[] = {50.0f, 50.0f, 50.0f, 50.0f};
 
-GLUquadric *guadric = NULL;
+PrimitiveLibrary primitives;
+int sphere = PrimitiveLibrary::INVALID;
 
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
@@ -326,6 +328,13 @@ void initialize(void)
     glShadeModel(GL_SMOOTH);
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
 
+    // Tessellated once here instead of by gluSphere() every frame.
+    // 2nd parameter is for slices (like longitudes)
+    // 3rd parameter is for stacks (like latitudes)
+    // Higher the value of 2nd and 3rd parameters, i.e. more the subdivisions,
+    // more circular the sphere will look.
+    sphere = primitives.sphere(0.75f, 30, 30);
+
     // This is required for DirectX
     resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -458,13 +467,7 @@ void drawSphere(void)
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
     // Draw the sun
-    guadric = gluNewQuadric();
-
-    // 3rd parameter is for slices (like longitudes)
-    // 4th parameter is for stacks (like latitudes)
-    // Higher the value of 3rd and 4th parameters, i.e. more the sub-divisions,
-    // more circular the sphere will look.
-    gluSphere(guadric, 0.75, 30, 30);
+    primitives.draw(sphere);
 
     // Pop back to initial state.
     glPopMatrix();
@@ -523,11 +526,7 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
-    if(guadric)
-    {
-        gluDeleteQuadric(guadric);
-        guadric = nullptr;
-    }
+    primitives.clear();
 
     wglMakeCurrent(NULL, NULL);
 
@@ -7,6 +7,7 @@
 #include <gl/glu.h>
 
 #include "resources/resource.h"
+#include "primitives.h"
 
 HWND hWnd = NULL;
 HDC hdc = NULL;
@@ -23,7 +24,8 @@ bool isEscapeKeyPressed = false;
 GLint angleShoulder = 0;
 GLint angleElbow = 0;
 
-GLUquadric *guadric = NULL;
+PrimitiveLibrary primitives;
+int sphereArm = PrimitiveLibrary::INVALID;
 
 LRESULT CALLBACK WndProc(HWND hWnd, UINT iMessage, WPARAM wParam, LPARAM lParam);
 
@@ -251,6 +253,9 @@ void initialize(void)
     glShadeModel(GL_SMOOTH);
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
 
+    // Tessellated once here instead of by gluSphere() every frame.
+    sphereArm = primitives.sphere(0.5f, 10, 10);
+
     // This is required for DirectX
     resize(windowRect.right - windowRect.left, windowRect.bottom - windowRect.top);
 }
@@ -285,9 +290,8 @@ void drawRobotArm(void)
     glPushMatrix();
 
     glScalef(2.0f, 0.5f, 1.0f);
-    guadric = gluNewQuadric();
     glColor3f(0.5f, 0.35f, 0.05f);
-    gluSphere(guadric, 0.5, 10, 10);
+    primitives.draw(sphereArm);
 
     // Pop back to shoulder transformation state.
     glPopMatrix();
@@ -300,9 +304,8 @@ void drawRobotArm(void)
     // Push the elbow transformation state.
     glPushMatrix();
     glScalef(2.0f, 0.5f, 1.0f);
-    guadric = gluNewQuadric();
     glColor3f(0.5f, 0.35f, 0.05f);
-    gluSphere(guadric, 0.5, 10, 10);
+    primitives.draw(sphereArm);
 
     // Pop the elbow transformation state.
     glPopMatrix();
@@ -361,6 +364,8 @@ void cleanUp(void)
         ShowCursor(TRUE);
     }
 
+    primitives.clear();
+
     wglMakeCurrent(NULL, NULL);
 
     wglDeleteContext(hrc);
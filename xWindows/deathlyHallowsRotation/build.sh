@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o deathlyHallowsRotation deathlyHallowsRotation.cpp -lX11 -lGL -lGLU
+g++ -I../pp/common -o deathlyHallowsRotation deathlyHallowsRotation.cpp -lX11 -lGL -lGLU
@@ -13,6 +13,8 @@
 #include <GL/glu.h>
 #include <math.h>
 
+#include "pathTessellator.h"
+
 bool isFullscreen = false;
 bool isCloseButtonClicked = false;
 bool isEscapeKeyPressed = false;
@@ -32,16 +34,21 @@ glXCreateContextAttribsARBProc glXCreateContextAttribsARB = NULL;
 GLXFBConfig glxFBConfig;
 GLXContext glxContext;
 
+// The symbol is tessellated once, only the rotation it is drawn with changes every frame.
+PathTessellator paths;
+int deathlyHallows = PathTessellator::INVALID;
+
 void createWindow(void);
 void initialize(void);
 void cleanup(void);
 void handleEvent(XEvent *event);
 void update(void);
 void display(void);
+void initializeDeathlyHallowsSymbol(void);
 void deathlyHallowsSymbol(void);
-void drawInvisibilityCloak(void);
-void drawResurrectionStone(void);
-void drawElderWand(void);
+void addInvisibilityCloak(Path *symbol);
+void addResurrectionStone(Path *symbol);
+void addElderWand(Path *symbol);
 void resize(int width, int height);
 void toggleFullscreen(bool isFullscreen);
 
@@ -268,6 +275,10 @@ void initialize(void)
     // glEnable(GL_CULL_FACE);
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    initializeDeathlyHallowsSymbol();
+    printf("Deathly hallows: %d shape, tessellated once.\n", paths.numberOfShapes());
+
     resize(windowWidth, windowHeight);
 }
 
@@ -377,54 +388,45 @@ void display(void)
     glXSwapBuffers(gDisplay, window);
 }
 
-void deathlyHallowsSymbol(void)
+void initializeDeathlyHallowsSymbol(void)
 {
-    drawInvisibilityCloak();
-    drawResurrectionStone();
-    drawElderWand();
-}
+    Path symbol;
 
-void drawInvisibilityCloak(void)
-{
-    glBegin(GL_LINE_LOOP);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(-1.0f, -1.0f, 0.0f);
-    glVertex3f(1.0f, -1.0f, 0.0f);
+    addInvisibilityCloak(&symbol);
+    addResurrectionStone(&symbol);
+    addElderWand(&symbol);
 
-    glEnd();
+    deathlyHallows = paths.hairline(symbol);
 }
 
-void drawResurrectionStone(void)
+void deathlyHallowsSymbol(void)
 {
-    GLint circlePoints = 10000;
-    GLfloat angle = 0.0f;
     glLineWidth(1.0f);
-
-    glBegin(GL_LINE_LOOP);
-
-    glColor3f(1.0f, 1.0f, 1.0f);
-
-    for (int counter = 0; counter < circlePoints; ++counter)
-    {
-        angle = 2.0f * M_PI * counter / circlePoints;
-        glVertex3f(cos(angle) * 0.61f, (sin(angle) * 0.61f) - 0.39f, 0.0f);
-    }
-
-    glEnd();
+    paths.draw(deathlyHallows);
 }
 
-void drawElderWand(void)
+void addInvisibilityCloak(Path *symbol)
 {
-    glBegin(GL_LINES);
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->moveTo(0.0f, 1.0f);
+    symbol->lineTo(-1.0f, -1.0f);
+    symbol->lineTo(1.0f, -1.0f);
+    symbol->close();
+}
 
-    glColor3f(1.0f, 1.0f, 1.0f);
+void addResurrectionStone(Path *symbol)
+{
+    GLint circlePoints = 10000;
 
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(0.0f, -1.0f, 0.0f);
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->circle(0.0f, -0.39f, 0.61f, circlePoints);
+}
 
-    glEnd();
+void addElderWand(Path *symbol)
+{
+    symbol->setColor(1.0f, 1.0f, 1.0f);
+    symbol->moveTo(0.0f, 1.0f);
+    symbol->lineTo(0.0f, -1.0f);
 }
 
 void resize(int width, int height)
@@ -466,6 +468,7 @@ void cleanup(void)
 
     if(currentContext != NULL && currentContext == glxContext)
     {
+        paths.clear();
         glXMakeCurrent(gDisplay, 0, 0);
     }
 
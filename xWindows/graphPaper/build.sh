@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o graphPaper graphPaper.cpp -lX11 -lGL -lGLU
+g++ -I../pp/common -o graphPaper graphPaper.cpp -lX11 -lGL -lGLU
@@ -10,6 +10,8 @@
 #include <GL/glx.h>
 #include <GL/glu.h>
 
+#include "lineBatch.h"
+
 bool isFullscreen = false;
 bool isCloseButtonClicked = false;
 bool isEscapeKeyPressed = false;
@@ -26,15 +28,19 @@ glXCreateContextAttribsARBProc glXCreateContextAttribsARB = NULL;
 GLXFBConfig glxFBConfig;
 GLXContext glxContext;
 
+// The grid never changes, so it is put into one vertex buffer once and drawn from there.
+LineBatch graphPaper;
+
 void createWindow(void);
 void initialize(void);
 void cleanup(void);
 void handleEvent(XEvent *event);
 void display(void);
-void drawMajorXAxis(void);
-void drawMinorXAxis(void);
-void drawMajorYAxis(void);
-void drawMinorYAxis(void);
+void initializeGraphPaper(void);
+void addMajorXAxis(void);
+void addMinorXAxis(void);
+void addMajorYAxis(void);
+void addMinorYAxis(void);
 void resize(int width, int height);
 void toggleFullscreen(bool isFullscreen);
 
@@ -260,6 +266,10 @@ void initialize(void)
     // glEnable(GL_CULL_FACE);
 
     glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    initializeGraphPaper();
+    printf("Graph paper: %d vertices in %d draws.\n", graphPaper.numberOfVertices(), graphPaper.numberOfDraws());
+
     resize(windowWidth, windowHeight);
 }
 
@@ -341,91 +351,63 @@ void handleEvent(XEvent *event)
 void display(void)
 {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    drawMajorXAxis();
-    drawMajorYAxis();
-    drawMinorXAxis();
-    drawMinorYAxis();
+    glLoadIdentity();
+    graphPaper.draw();
     glXSwapBuffers(gDisplay, window);
 }
 
-void drawMajorXAxis(void)
+void initializeGraphPaper(void)
 {
-    glLoadIdentity();
-    glLineWidth(3.0f);
-
-    glBegin(GL_LINES);
+    addMajorXAxis();
+    addMajorYAxis();
+    addMinorXAxis();
+    addMinorYAxis();
+}
 
-    glColor3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(-1.0f, 0.0f, 0.0f);
-    glVertex3f(1.0f, 0.0f, 0.0f);
+void addMajorXAxis(void)
+{
+    const GLfloat green[] = {0.0f, 1.0f, 0.0f};
 
-    glEnd();
+    graphPaper.line(-1.0f, 0.0f, 1.0f, 0.0f, green, 3.0f);
 }
 
-void drawMinorXAxis(void)
+void addMinorXAxis(void)
 {
+    const GLfloat blue[] = {0.0f, 0.0f, 1.0f};
     int numberOfLines = 20;
     float difference = 1.0f / numberOfLines;
 
-    glLoadIdentity();
-    glLineWidth(1.0f);
-
-    glBegin(GL_LINES);
-
-    glColor3f(0.0f, 0.0f, 1.0f);
-
     for(int counter = 1; counter <= numberOfLines; ++counter)
     {
         // Positive axis
-        glVertex3f(-1.0f, (counter * difference), 0.0f);
-        glVertex3f(1.0f, (counter * difference), 0.0f);
+        graphPaper.line(-1.0f, (counter * difference), 1.0f, (counter * difference), blue, 1.0f);
 
         // Negative axis
-        glVertex3f(-1.0f, (-counter * difference), 0.0f);
-        glVertex3f(1.0f, (-counter * difference), 0.0f);
+        graphPaper.line(-1.0f, (-counter * difference), 1.0f, (-counter * difference), blue, 1.0f);
     }
-
-    glEnd();
 }
 
-void drawMajorYAxis(void)
+void addMajorYAxis(void)
 {
-    glLoadIdentity();
-    glLineWidth(3.0f);
-
-    glBegin(GL_LINES);
-
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glVertex3f(0.0f, 1.0f, 0.0f);
-    glVertex3f(0.0f, -1.0f, 0.0f);
+    const GLfloat red[] = {1.0f, 0.0f, 0.0f};
 
-    glEnd();
+    graphPaper.line(0.0f, 1.0f, 0.0f, -1.0f, red, 3.0f);
 }
 
-void drawMinorYAxis(void)
+void addMinorYAxis(void)
 {
+    const GLfloat blue[] = {0.0f, 0.0f, 1.0f};
     int numberOfLines = 20;
     float difference = 1.0f / numberOfLines;
 
-    glLoadIdentity();
-    glLineWidth(1.0f);
-
-    glBegin(GL_LINES);
-
-    glColor3f(0.0f, 0.0f, 1.0f);
-
     for(int counter = 1; counter <= numberOfLines; ++counter)
     {
         // Positive axis
-        glVertex3f((counter * difference), 1.0f, 0.0f);
-        glVertex3f((counter * difference), -1.0f, 0.0f);
+        graphPaper.line((counter * difference), 1.0f, (counter * difference), -1.0f, blue, 1.0f);
 
         // Negative axis
-        glVertex3f((-counter * difference), 1.0f, 0.0f);
-        glVertex3f((-counter * difference), -1.0f, 0.0f);
+        graphPaper.line((-counter * difference), 1.0f, (-counter * difference), -1.0f, blue, 1.0f);
     }
-
-    glEnd();
 }
 
 void resize(int width, int height)
@@ -467,6 +449,7 @@ void cleanup(void)
 
     if(currentContext != NULL && currentContext == glxContext)
     {
+        graphPaper.clear();
         glXMakeCurrent(gDisplay, 0, 0);
     }
 
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -I../pp/common -o materialSphere materialSphere.cpp -lX11 -lGL -lGLU
@@ -0,0 +1,679 @@
+#define _USE_MATH_DEFINES
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/XKBlib.h>
+#include <X11/keysym.h>
+#include <GL/gl.h>
+#include <GL/glx.h>
+#include <GL/glu.h>
+
+#include "primitives.h"
+
+bool isFullscreen = false;
+bool isCloseButtonClicked = false;
+bool isEscapeKeyPressed = false;
+bool isLightingEnabled = false;
+
+int windowWidth = 800;
+int windowHeight = 600;
+
+GLboolean rotateLightOnXAxis = GL_TRUE;
+GLboolean rotateLightOnYAxis = GL_FALSE;
+GLboolean rotateLightOnZAxis = GL_FALSE;
+
+GLfloat angleLight = 0.0f;
+GLfloat speed = 0.1f;
+
+GLfloat lightZeroAmbient[] = {0.5f, 0.5f, 0.5f, 1.0f};
+GLfloat lightZeroDiffuse[] = {1.0f, 1.0f, 1.0f, 1.0f};
+GLfloat lightZeroSpecular[] = {1.0f, 1.0f, 1.0f, 1.0f};
+GLfloat lightZeroPosition[] = {0.0f, 0.0f, 1.0f, 0.0f};
+
+GLfloat lightModalAmbient[] = {0.2f, 0.2f, 0.2f, 0.0f};
+GLfloat lightModalLocalViewer[] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+GLfloat materialAmbient[4][6][4] = {
+    {   // Column 1
+        {0.0215f, 0.1745f, 0.0215f, 1.0f },
+        {0.135f, 0.2225f, 0.1575f, 1.0f },
+        {0.05375f, 0.05f, 0.06625f, 1.0f },
+        {0.25f, 0.20725f, 0.20725f, 1.0f },
+        {0.1745f, 0.01175f, 0.01175f, 1.0f },
+        {0.1f, 0.18725f, 0.1745f, 1.0f }
+    },
+    {   // Column 2
+        {0.329412f, 0.223529f, 0.027451f, 1.0f },
+        {0.2125f, 0.1275f, 0.054f, 1.0f },
+        {0.25f, 0.25f, 0.25f, 1.0f },
+        {0.19125f, 0.0735f, 0.0225f, 1.0f },
+        {0.24725f, 0.1995f, 0.0745f, 1.0f },
+        {0.19225f, 0.19225f, 0.19225f, 1.0f }
+    },
+    {   // Column 3
+        {0.0f, 0.0f, 0.0f, 1.0f },
+        {0.0f, 0.1f, 0.06f, 1.0f },
+        {0.0f, 0.0f, 0.0f, 1.0f },
+        {0.0f, 0.0f, 0.0f, 1.0f },
+        {0.0f, 0.0f, 0.0f, 1.0f },
+        {0.0f, 0.0f, 0.0f, 1.0f }
+    },
+    {   // Column 4
+        {0.02f, 0.02f, 0.02f, 1.0f },
+        {0.0f, 0.05f, 0.05f, 1.0f },
+        {0.0f, 0.05f, 0.0f, 1.0f },
+        {0.05f, 0.0f, 0.0f, 1.0f },
+        {0.05f, 0.05f, 0.05f, 1.0f },
+        {0.05f, 0.05f, 0.0f, 1.0f }
+    }
+};
+
+GLfloat materialDiffuse[4][6][4] = {
+    {   // Column 1
+        {0.07568f, 0.61424f, 0.07568f, 1.0f},
+        {0.54f, 0.89f, 0.63f, 1.0f},
+        {0.18275f, 0.17f, 0.22525f, 1.0f},
+        {1.0f, 0.829f, 0.829f, 1.0f},
+        {0.61424f, 0.04136f, 0.04136f, 1.0f},
+        {0.396f, 0.74151f, 0.69102f, 1.0f},
+    },
+    {   // Column 2
+        {0.780392f, 0.568627f, 0.113725f, 1.0f},
+        {0.714f, 0.4284f, 0.18144f, 1.0f},
+        {0.4f, 0.4f, 0.4f, 1.0f},
+        {0.7038f, 0.27048f, 0.0828f, 1.0f},
+        {0.75164f, 0.60648f, 0.22648f, 1.0f},
+        {0.50754f, 0.50754f, 0.50754f, 1.0f},
+    },
+    {   // Column 3
+        {0.01f, 0.01f, 0.01f, 1.0f},
+        {0.0f, 0.50980392f, 0.50980392f, 1.0f},
+        {0.1f, 0.35f, 0.1f, 1.0f},
+        {0.5f, 0.0f, 0.0f, 1.0f},
+        {0.55f, 0.55f, 0.55f, 1.0f},
+        {0.5f, 0.5f, 0.0f, 1.0f},
+    },
+    {   // Column 4
+        {0.01f, 0.01f, 0.01f, 1.0f},
+        {0.4f, 0.5f, 0.5f, 1.0f},
+        {0.4f, 0.5f, 0.4f, 1.0f},
+        {0.5f, 0.4f, 0.4f, 1.0f},
+        {0.5f, 0.5f, 0.5f, 1.0f},
+        {0.5f, 0.5f, 0.4f, 1.0f},
+    },
+};
+
+GLfloat materialSpecular[4][6][4] = {
+    {   // Column 1
+        {0.633f, 0.727811f, 0.633f, 1.0f},
+        {0.316228f, 0.316228f, 0.316228f, 1.0f},
+        {0.332741f, 0.328634f, 0.346435f, 1.0f},
+        {0.296648f, 0.296648f, 0.296648f, 1.0f},
+        {0.727811f, 0.626959f, 0.626959f, 1.0f},
+        {0.297254f, 0.30829f, 0.306678f, 1.0f},
+    },
+    {   // Column 2
+        {0.992157f, 0.941176f, 0.807843f, 1.0f},
+        {0.393548f, 0.271906f, 0.166721f, 1.0f},
+        {0.774597f, 0.774597f, 0.774597f, 1.0f},
+        {0.256777f, 0.137622f, 0.086014f, 1.0f},
+        {0.628281f, 0.555802f, 0.366065f, 1.0f},
+        {0.508273f, 0.508273f, 0.508273f, 1.0f},
+    },
+    {   // Column 3
+        {0.50f, 0.50f, 0.50f, 1.0f},
+        {0.50196078f, 0.50196078f, 0.50196078f, 1.0f},
+        {0.45f, 0.55f, 0.45f, 1.0f},
+        {0.7f, 0.6f, 0.6f, 1.0f},
+        {0.70f, 0.70f, 0.70f, 1.0f},
+        {0.60f, 0.60f, 0.50f, 1.0f},
+    },
+    {   // Column 4
+        {0.4f, 0.4f, 0.4f, 1.0f},
+        {0.04f, 0.7f, 0.7f, 1.0f},
+        {0.04f, 0.7f, 0.04f, 1.0f},
+        {0.7f, 0.04f, 0.04f, 1.0f},
+        {0.7f, 0.7f, 0.7f, 1.0f},
+        {0.7f, 0.7f, 0.04f, 1.0f},
+    }
+};
+
+GLfloat matrialShininess[4][6][4] = {
+    {   // Column 1
+        {0.6f * 128.0f, 0.6f * 128.0f, 0.6f * 128.0f, 0.6f * 128.0f},
+        {0.1f * 128.0f, 0.1f * 128.0f, 0.1f * 128.0f, 0.1f * 128.0f},
+        {0.3f * 128.0f, 0.3f * 128.0f, 0.3f * 128.0f, 0.3f * 128.0f},
+        {0.088f * 128.0f, 0.088f * 128.0f, 0.088f * 128.0f, 0.088f * 128.0f},
+        {0.6f * 128.0f, 0.6f * 128.0f, 0.6f * 128.0f, 0.6f * 128.0f},
+        {0.1f * 128.0f, 0.1f * 128.0f, 0.1f * 128.0f, 0.1f * 128.0f},
+    },
+    {   // Column 2
+        {0.21794872f * 128.0f, 0.21794872f * 128.0f, 0.21794872f * 128.0f, 0.21794872f * 128.0f},
+        {0.2f * 128.0f, 0.2f * 128.0f, 0.2f * 128.0f, 0.2f * 128.0f},
+        {0.6f * 128.0f, 0.6f * 128.0f, 0.6f * 128.0f, 0.6f * 128.0f},
+        {0.1f * 128.0f, 0.1f * 128.0f, 0.1f * 128.0f, 0.1f * 128.0f},
+        {0.4f * 128.0f, 0.4f * 128.0f, 0.4f * 128.0f, 0.4f * 128.0f},
+        {0.4f * 128.0f, 0.4f * 128.0f, 0.4f * 128.0f, 0.4f * 128.0f},
+    },
+    {   // Column 3
+        {0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f},
+        {0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f},
+        {0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f},
+        {0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f},
+        {0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f},
+        {0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f, 0.25f * 128.0f},
+    },
+    {   // Column 4
+        {0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f},
+        {0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f},
+        {0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f},
+        {0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f},
+        {0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f},
+        {0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f, 0.078125f * 128.0f},
+    }
+};
+
+PrimitiveLibrary primitives;
+int sphere = PrimitiveLibrary::INVALID;
+
+// With --statistics, heap growth and primitives tessellated per frame, averaged over FRAMES_PER_LOG
+// frames because the driver allocates and frees a little on its own, printed whenever they change.
+// The heap is measured with glibc's mallinfo2() and stays 0 elsewhere.
+#define FRAMES_PER_LOG 100
+bool isStatisticsEnabled = false;
+int framesSinceLog = 0;
+long long heapInUseAtLog = 0;
+unsigned int tessellationsSinceLog = 0;
+long long loggedHeapGrowth = -1;
+unsigned int loggedTessellations = ~0u;
+
+Display *gDisplay = NULL;
+XVisualInfo *visualInfo = NULL;
+Colormap colormap;
+Window window;
+GLXContext glxContext;
+
+void createWindow(void);
+void initialize(void);
+void cleanup(void);
+void handleEvent(XEvent *event);
+void update(void);
+void display(void);
+void logFrameStatistics(void);
+long long heapInUse(void);
+void rotateLight(void);
+void loadMaterial(int row, int column);
+void drawSphere(void);
+void resize(int width, int height);
+void toggleFullscreen(bool isFullscreen);
+
+int main(int argc, char **argv)
+{
+    XEvent event;
+    bool done = false;
+
+    for(int n = 1; n < argc; n++)
+    {
+        if(strcmp(argv[n], "--statistics") == 0)
+        {
+            isStatisticsEnabled = true;
+        }
+    }
+
+    createWindow();
+    initialize();
+
+    while(!done)
+    {
+        while(XPending(gDisplay))
+        {
+            XNextEvent(gDisplay, &event);
+            handleEvent(&event);
+        }
+
+        done = (isCloseButtonClicked || isEscapeKeyPressed);
+        update();
+        display();
+    }
+
+    cleanup();
+    return EXIT_SUCCESS;
+}
+
+void createWindow(void)
+{
+    XSetWindowAttributes windowAttributes;
+    int defaultScreen;
+    int styleMask;
+
+    static int frameBufferAttributes[] = {
+        GLX_RGBA,
+        GLX_RED_SIZE, 8,
+        GLX_GREEN_SIZE, 8,
+        GLX_BLUE_SIZE, 8,
+        GLX_ALPHA_SIZE, 8,
+        GLX_DOUBLEBUFFER, True,
+        GLX_DEPTH_SIZE, 24,
+        GLX_DEPTH_SIZE, 24,
+        // GLX_X_RENDERABLE, true, // did not work.
+        GLX_X_VISUAL_TYPE, GLX_TRUE_COLOR,
+        // GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT, // did not work.
+        // GLX_RENDER_TYPE, GLX_RGBA_BIT, // did not work.
+        None
+    };
+
+    gDisplay = XOpenDisplay(NULL);
+
+    if(gDisplay == NULL)
+    {
+        printf("Error: Unable to open XgDisplay.\n");
+        cleanup();
+        exit(EXIT_FAILURE);
+    }
+
+    defaultScreen = XDefaultScreen(gDisplay);
+    visualInfo = glXChooseVisual(gDisplay, defaultScreen, frameBufferAttributes);
+
+    if(visualInfo == NULL)
+    {
+        printf("Error: Unable to choose visual.\n");
+        cleanup();
+        exit(EXIT_FAILURE);
+    }
+
+    windowAttributes.border_pixel = 0;
+    windowAttributes.border_pixmap = 0;
+    windowAttributes.background_pixel = BlackPixel(gDisplay, defaultScreen);
+    windowAttributes.background_pixmap = 0;
+    windowAttributes.colormap = XCreateColormap(gDisplay, XRootWindow(gDisplay, visualInfo->screen), visualInfo->visual, AllocNone);
+    windowAttributes.event_mask = ExposureMask | VisibilityChangeMask | ButtonPressMask | KeyPressMask | PointerMotionMask | StructureNotifyMask;
+
+    styleMask = CWBorderPixel | CWBackPixel | CWEventMask | CWColormap;
+    colormap = windowAttributes.colormap;
+
+    window = XCreateWindow(gDisplay, XRootWindow(gDisplay, visualInfo->screen), 0, 0, windowWidth, windowHeight, 0, visualInfo->depth, InputOutput, visualInfo->visual, styleMask, &windowAttributes);
+
+    if(!window)
+    {
+        printf("Error: Failed to create main window.");
+        cleanup();
+        exit(EXIT_FAILURE);
+    }
+
+    XStoreName(gDisplay, window, "CG - Material on Sphere");
+
+    Atom windowManagerDelete = XInternAtom(gDisplay, "WM_DELETE_WINDOW", True);
+    XSetWMProtocols(gDisplay, window, &windowManagerDelete, 1);
+    XMapWindow(gDisplay, window);
+}
+
+void initialize(void)
+{
+    glxContext = glXCreateContext(gDisplay, visualInfo, NULL, GL_TRUE);
+    glXMakeCurrent(gDisplay, window, glxContext);
+    glClearColor(0.25f, 0.25f, 0.25f, 0.25f);
+    glClearDepth(1.0f);
+
+    glLightfv(GL_LIGHT0, GL_AMBIENT, lightZeroAmbient);
+    glLightfv(GL_LIGHT0, GL_DIFFUSE, lightZeroDiffuse);
+    glLightfv(GL_LIGHT0, GL_SPECULAR, lightZeroSpecular);
+
+    glEnable(GL_DEPTH_TEST);
+    // Lighting and light 0 is enabled in handleEvent() when 'L' or 'l' key is pressed.
+    // glEnable(GL_LIGHT0);
+
+    glDepthFunc(GL_LEQUAL);
+    glShadeModel(GL_SMOOTH);
+    glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+
+    glEnable(GL_AUTO_NORMAL);
+    glEnable(GL_NORMALIZE);
+    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, lightModalAmbient);
+    glLightModelfv(GL_LIGHT_MODEL_LOCAL_VIEWER, lightModalLocalViewer);
+
+    // All 24 spheres draw the one tessellated here, the Windows version calls
+    // gluNewQuadric() and gluSphere() for each of them every frame.
+    sphere = primitives.sphere(0.75f, 30, 30);
+
+    resize(windowWidth, windowHeight);
+}
+
+void handleEvent(XEvent *event)
+{
+    KeySym keySymbol;
+    char asciiChars[32] = {0};
+
+    switch(event->type)
+    {
+        case MapNotify: // Window created.
+        break;
+
+        case KeyPress: // Key events.
+            keySymbol = XkbKeycodeToKeysym(gDisplay, event->xkey.keycode, 0, 0);
+
+            switch(keySymbol)
+            {
+                case XK_Escape:
+                    isEscapeKeyPressed = true;
+                break;
+
+                default:
+                break;
+            }
+
+            XLookupString(&event->xkey, asciiChars, sizeof(asciiChars), NULL, NULL);
+            switch(asciiChars[0])
+            {
+                case 'F':
+                case 'f':
+                    isFullscreen = !isFullscreen;
+                    toggleFullscreen(isFullscreen);
+                break;
+
+                case 'L':
+                case 'l':
+                    if(!isLightingEnabled) {
+                        isLightingEnabled = true;
+                        glEnable(GL_LIGHTING);
+                        glEnable(GL_LIGHT0);
+                    }
+                    else {
+                        isLightingEnabled = false;
+                        glDisable(GL_LIGHTING);
+                        glDisable(GL_LIGHT0);
+                    }
+                break;
+
+                case 'X':
+                case 'x':
+                    rotateLightOnXAxis = GL_TRUE;
+                    rotateLightOnYAxis = GL_FALSE;
+                    rotateLightOnZAxis = GL_FALSE;
+                break;
+
+                case 'Y':
+                case 'y':
+                    rotateLightOnXAxis = GL_FALSE;
+                    rotateLightOnYAxis = GL_TRUE;
+                    rotateLightOnZAxis = GL_FALSE;
+                break;
+
+                case 'Z':
+                case 'z':
+                    rotateLightOnXAxis = GL_FALSE;
+                    rotateLightOnYAxis = GL_FALSE;
+                    rotateLightOnZAxis = GL_TRUE;
+                break;
+
+                default:
+                break;
+            }
+
+            if(asciiChars[0] > '0' && asciiChars[0] <= '9')
+            {
+                speed = 0.1f * (asciiChars[0] - '0');
+            }
+
+        break;
+
+        case ButtonPress: // Mouse event.
+            switch(event->xbutton.button)
+            {
+                case 1: // Left button.
+                break;
+
+                case 2: // Middle button.
+                break;
+
+                case 3: // Right button.
+                break;
+
+                case 4: // Mouse wheel up.
+                break;
+
+                case 5: // Mouse wheel down.
+                break;
+            }
+
+        break;
+
+        case MotionNotify: // Mouse move event.
+        break;
+
+        case ConfigureNotify: // Window configuration change, like resize.
+            windowWidth = event->xconfigure.width;
+            windowHeight = event->xconfigure.height;
+            resize(windowWidth, windowHeight);
+        break;
+
+        case Expose: // Paint window.
+        break;
+
+        case DestroyNotify: // Window destroyed, cleanup resources.
+        break;
+
+        case 33: // Windows close button event.
+            isCloseButtonClicked = true;
+        break;
+
+        default:
+        break;
+    }
+}
+
+void update(void)
+{
+    angleLight += speed;
+
+    if(angleLight >= 360.0f)
+    {
+        angleLight = 0.0f;
+    }
+}
+
+void display(void)
+{
+    primitives.resetFrameStatistics();
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glMatrixMode(GL_MODELVIEW);
+
+    // 4 columns of 6 materials.
+    for(int column = 0; column < 4; column++)
+    {
+        for(int row = 0; row < 6; row++)
+        {
+            glLoadIdentity();
+            glTranslatef(-6.0f + 4.0f * column, -5.0f + 2.0f * row, -20.0f);
+            rotateLight();
+            loadMaterial(column, row);
+            drawSphere();
+        }
+    }
+
+    if(isStatisticsEnabled)
+    {
+        logFrameStatistics();
+    }
+
+    glXSwapBuffers(gDisplay, window);
+}
+
+long long heapInUse(void)
+{
+#ifdef __GLIBC__
+    return (long long)mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+void logFrameStatistics(void)
+{
+    long long heapNow = heapInUse();
+
+    tessellationsSinceLog += primitives.getFrameStatistics().tessellations;
+
+    if(framesSinceLog++ == 0)
+    {
+        heapInUseAtLog = heapNow;
+        return;
+    }
+
+    if(framesSinceLog <= FRAMES_PER_LOG)
+    {
+        return;
+    }
+
+    long long heapGrowth = (heapNow - heapInUseAtLog) / FRAMES_PER_LOG;
+
+    if(heapGrowth != loggedHeapGrowth || tessellationsSinceLog != loggedTessellations)
+    {
+        printf("Per frame: %lld bytes of heap allocated, %u primitives tessellated, %u drawn with %u triangles.\n", heapGrowth, tessellationsSinceLog / FRAMES_PER_LOG, primitives.getFrameStatistics().draws, primitives.getFrameStatistics().trianglesDrawn);
+        loggedHeapGrowth = heapGrowth;
+        loggedTessellations = tessellationsSinceLog;
+    }
+
+    framesSinceLog = 1;
+    heapInUseAtLog = heapNow;
+    tessellationsSinceLog = 0;
+}
+
+void rotateLight(void)
+{
+    if(rotateLightOnXAxis == GL_TRUE)
+    {
+        glRotatef(angleLight, 1.0f, 0.0f, 0.0f);
+        lightZeroPosition[0] = 0;
+        lightZeroPosition[1] = angleLight;
+        lightZeroPosition[2] = 0;
+        glLightfv(GL_LIGHT0, GL_POSITION, lightZeroPosition);
+    }
+    else if(rotateLightOnYAxis == GL_TRUE)
+    {
+        glRotatef(angleLight, 0.0f, 1.0f, 0.0f);
+        lightZeroPosition[0] = angleLight;
+        lightZeroPosition[1] = 0;
+        lightZeroPosition[2] = 0;
+        glLightfv(GL_LIGHT0, GL_POSITION, lightZeroPosition);
+    }
+    else if(rotateLightOnZAxis == GL_TRUE)
+    {
+        glRotatef(angleLight, 0.0f, 0.0f, 1.0f);
+        lightZeroPosition[0] = 0;
+        lightZeroPosition[1] = angleLight;
+        lightZeroPosition[2] = 0;
+        glLightfv(GL_LIGHT0, GL_POSITION, lightZeroPosition);
+    }
+}
+
+void loadMaterial(int row, int column)
+{
+    glMaterialfv(GL_FRONT, GL_AMBIENT, materialAmbient[row][column]);
+    glMaterialfv(GL_FRONT, GL_DIFFUSE, materialDiffuse[row][column]);
+    glMaterialfv(GL_FRONT, GL_SPECULAR, materialSpecular[row][column]);
+    glMaterialfv(GL_FRONT, GL_SHININESS, matrialShininess[row][column]);
+}
+
+void drawSphere(void)
+{
+    // Push initial matrix.
+    glPushMatrix();
+
+    // Rotate the sphere by 90 degree on x-axis
+    // because sphere created by GLUT has it rotated in x-axis
+    // The north-south poles are on x-axis instead of y-axis.
+    glRotatef(90.0f, 1.0f, 0.0f, 0.0f);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    primitives.draw(sphere);
+
+    // Pop back to initial state.
+    glPopMatrix();
+}
+
+void resize(int width, int height)
+{
+    if(height == 0)
+    {
+        height = 1;
+    }
+
+    glViewport(0, 0, (GLsizei)width, (GLsizei)height);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    gluPerspective(45.0f, (GLfloat)width/(GLfloat)height, 1.0f, 100.0f);
+}
+
+void toggleFullscreen(bool isFullscreen)
+{
+    Atom wmStateNormal;
+    Atom wmStateFullscreen;
+    XEvent event = {0};
+
+    wmStateNormal = XInternAtom(gDisplay, "_NET_WM_STATE", False);
+    wmStateFullscreen = XInternAtom(gDisplay, "_NET_WM_STATE_FULLSCREEN", False);
+
+    memset(&event, 0, sizeof(event));
+    event.type = ClientMessage;
+    event.xclient.window = window;
+    event.xclient.message_type = wmStateNormal;
+    event.xclient.format = 32;
+    event.xclient.data.l[0] = isFullscreen ? 1 : 0;
+    event.xclient.data.l[1] = wmStateFullscreen;
+
+    XSendEvent(gDisplay, XRootWindow(gDisplay, visualInfo->screen), False, StructureNotifyMask, &event);
+}
+
+void cleanup(void)
+{
+    if(isFullscreen)
+    {
+        isFullscreen = false;
+        toggleFullscreen(false);
+    }
+
+    primitives.clear();
+
+    GLXContext currentContext = glXGetCurrentContext();
+
+    if(currentContext != NULL && currentContext == glxContext)
+    {
+        glXMakeCurrent(gDisplay, 0, 0);
+    }
+
+    if(glxContext)
+    {
+        glXDestroyContext(gDisplay, glxContext);
+    }
+
+    if(window)
+    {
+        XDestroyWindow(gDisplay, window);
+    }
+
+    if(colormap)
+    {
+        XFreeColormap(gDisplay, colormap);
+    }
+
+    if(visualInfo)
+    {
+        free(visualInfo);
+        visualInfo = NULL;
+    }
+
+    if(gDisplay)
+    {
+        XCloseDisplay(gDisplay);
+        gDisplay = NULL;
+    }
+}
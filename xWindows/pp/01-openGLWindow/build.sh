@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o openGLWindow openGLWindow.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o openGLWindow openGLWindow.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
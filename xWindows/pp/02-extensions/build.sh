@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o extensions extensions.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o extensions extensions.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o triangleOrtho triangleOrtho.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o triangleOrtho triangleOrtho.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o trianglePerspective trianglePerspective.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o trianglePerspective trianglePerspective.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
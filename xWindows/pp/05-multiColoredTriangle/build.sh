@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o multiColoredTriangle multiColoredTriangle.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o multiColoredTriangle multiColoredTriangle.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
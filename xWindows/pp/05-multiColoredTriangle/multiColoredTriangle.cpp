@@ -2,22 +2,11 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
-#include <X11/Xlib.h>
-#include <X11/Xutil.h>
-#include <X11/XKBlib.h>
-#include <X11/keysym.h>
 #include <GL/glew.h>
 #include <GL/gl.h>
-#include <GL/glx.h>
 
 #include "vmath.h"
-
-bool isFullscreen = false;
-bool isCloseButtonClicked = false;
-bool isEscapeKeyPressed = false;
-
-int windowWidth = 800;
-int windowHeight = 600;
+#include "platform.h"
 
 enum
 {
@@ -40,16 +29,8 @@ vmath::mat4 perspectiveProjectionMatrix;
 
 FILE *logFile = NULL;
 
-Display *gDisplay = NULL;
-XVisualInfo *visualInfo = NULL;
-Colormap colormap;
-Window window;
-typedef GLXContext (*glXCreateContextAttribsARBProc)(Display *display, GLXFBConfig fbConfig, GLXContext sharedContext, Bool direct, const int* attributes);
-glXCreateContextAttribsARBProc glXCreateContextAttribsARB = NULL;
-GLXFBConfig glxFBConfig;
-GLXContext glxContext;
+Platform platform;
 
-void createWindow(void);
 void initialize(void);
 void listExtensions(void);
 void initializeVertexShader(void);
@@ -57,12 +38,10 @@ void initializeFragmentShader(void);
 void initializeShaderProgram(void);
 void initializeBuffers(void);
 void cleanUp(void);
-void handleEvent(XEvent *event);
 void display(void);
 void resize(int width, int height);
-void toggleFullscreen(bool isFullscreen);
 
-int main(void)
+int main(int argc, char **argv)
 {
     logFile = fopen("debug.log", "w");
     if(logFile == NULL)
@@ -74,315 +53,22 @@ int main(void)
     fprintf(logFile, "---------- CG: OpenGL Debug Logs Start ----------\n");
     fflush(logFile);
 
-    XEvent event;
-    bool done = false;
-
-    createWindow();
-    initialize();
-
-    while(!done)
-    {
-        while(XPending(gDisplay))
-        {
-            XNextEvent(gDisplay, &event);
-            handleEvent(&event);
-        }
-
-        done = (isCloseButtonClicked || isEscapeKeyPressed);
-        display();
-    }
+    PlatformOptions options;
+    options.title = "CG - PP - Multi Colored Triangle";
+    options.logFile = logFile;
 
-    cleanUp();
+    PlatformCallbacks callbacks = {initialize, resize, NULL, display, NULL, cleanUp};
+    int status = platform.run(argc, argv, options, callbacks);
 
     fprintf(logFile, "---------- CG: OpenGL Debug Logs End ----------\n");
     fflush(logFile);
     fclose(logFile);
 
-    return EXIT_SUCCESS;
-}
-
-void createWindow(void)
-{
-    XSetWindowAttributes windowAttributes;     // This is an array of all available FBConfig matching to frameBufferAttributes.
-    GLXFBConfig *pGLXFBConfigs = NULL;
-    XVisualInfo *pTempXVisualInfo = NULL;
-    int numberOfFBConfigs = 0;
-    int defaultScreen = 0;
-    int styleMask = 0;
-    int counter = 0;
-
-    static int frameBufferAttributes[] = {
-        GLX_RED_SIZE, 8,
-        GLX_GREEN_SIZE, 8,
-        GLX_BLUE_SIZE, 8,
-        GLX_ALPHA_SIZE, 8,
-        GLX_DEPTH_SIZE, 24,
-        GLX_STENCIL_SIZE, 8,
-        GLX_DOUBLEBUFFER, True,
-        GLX_X_RENDERABLE, True,
-        GLX_X_VISUAL_TYPE, GLX_TRUE_COLOR,
-        GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
-        GLX_RENDER_TYPE, GLX_RGBA_BIT,
-        // GLX_SAMPLE_BUFFERS, 1,
-        // GLX_SAMPLES, 4,
-        None
-    };
-
-    gDisplay = XOpenDisplay(NULL);
-
-    if(gDisplay == NULL)
-    {
-        fprintf(logFile, "Error: Unable to open XgDisplay.\n");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    defaultScreen = XDefaultScreen(gDisplay);
-
-    // Get the frame buffer configuration list as per our requirement specified in frameBufferAttributes array.
-    pGLXFBConfigs = glXChooseFBConfig(gDisplay, defaultScreen, frameBufferAttributes, &numberOfFBConfigs);
-
-    if(pGLXFBConfigs == NULL)
-    {
-        fprintf(logFile, "Error: Unable to get valid frame buffer configurations.\n");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    fprintf(logFile, "Total frame buffer configurations: %d\n", numberOfFBConfigs);
-
-    // Select that FBConfig/visual which have the maximum samples per pixel.
-    int bestFrameBufferConfig = -1;
-    int worstFrameBufferConfig = -1;
-    int bestNumberOfSamples = -1;
-    int worstNumberOfSamples = 999;
-
-    for(counter = 0; counter < numberOfFBConfigs; ++counter)
-    {
-        pTempXVisualInfo = glXGetVisualFromFBConfig(gDisplay, pGLXFBConfigs[counter]);
-
-        if(pTempXVisualInfo)
-        {
-            int sampleBuffer = 0;
-            int samples = 0;
-
-            glXGetFBConfigAttrib(gDisplay, pGLXFBConfigs[counter], GLX_SAMPLE_BUFFERS, &sampleBuffer);
-            glXGetFBConfigAttrib(gDisplay, pGLXFBConfigs[counter], GLX_SAMPLES, &samples);
-
-            fprintf(logFile, "----------------------------------------\n");
-            fprintf(logFile, "Frame Buffer Config: %d\n", counter);
-            fprintf(logFile, "Visual ID: 0x%lu\n", pTempXVisualInfo->visualid);
-            fprintf(logFile, "Sample Buffers: %d\n", sampleBuffer);
-            fprintf(logFile, "Samples: %d\n", samples);
-            fprintf(logFile, "----------------------------------------\n");
-
-            if(bestFrameBufferConfig < 0 || sampleBuffer && samples > bestNumberOfSamples)
-            {
-                bestFrameBufferConfig = counter;
-                bestNumberOfSamples = samples;
-            }
-
-            if(worstFrameBufferConfig < 0 || !sampleBuffer || samples < worstNumberOfSamples)
-            {
-                worstFrameBufferConfig = counter;
-                worstNumberOfSamples = samples;
-            }
-        }
-
-        XFree(pTempXVisualInfo);
-    }
-
-    // Set the global glxFBConfig to best found.
-    glxFBConfig = pGLXFBConfigs[bestFrameBufferConfig];
-
-    // Free the frame buffer configuration list.
-    XFree(pGLXFBConfigs);
-
-    visualInfo = glXGetVisualFromFBConfig(gDisplay, glxFBConfig);
-
-    if(visualInfo == NULL)
-    {
-        fprintf(logFile, "Error: Unable to choose visual.\n");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    fprintf(logFile, "----------------------------------------\n");
-    fprintf(logFile, "Selected Visual ID: 0x%lu\n", visualInfo->visualid);
-    fprintf(logFile, "----------------------------------------\n");
-
-    windowAttributes.border_pixel = 0;
-    windowAttributes.border_pixmap = 0;
-    windowAttributes.background_pixel = BlackPixel(gDisplay, defaultScreen);
-    windowAttributes.background_pixmap = 0;
-    windowAttributes.colormap = XCreateColormap(gDisplay, XRootWindow(gDisplay, visualInfo->screen), visualInfo->visual, AllocNone);
-    windowAttributes.event_mask = ExposureMask | VisibilityChangeMask | ButtonPressMask | KeyPressMask | PointerMotionMask | StructureNotifyMask;
-
-    styleMask = CWBorderPixel | CWBackPixel | CWEventMask | CWColormap;
-    colormap = windowAttributes.colormap;
-
-    window = XCreateWindow(gDisplay, XRootWindow(gDisplay, visualInfo->screen), 0, 0, windowWidth, windowHeight, 0, visualInfo->depth, InputOutput, visualInfo->visual, styleMask, &windowAttributes);
-
-    if(!window)
-    {
-        fprintf(logFile, "Error: Failed to create main window.");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    XStoreName(gDisplay, window, "CG - PP - Multi Colored Triangle");
-
-    Atom windowManagerDelete = XInternAtom(gDisplay, "WM_DELETE_WINDOW", True);
-    XSetWMProtocols(gDisplay, window, &windowManagerDelete, 1);
-    XMapWindow(gDisplay, window);
-}
-
-void handleEvent(XEvent *event)
-{
-    KeySym keySymbol;
-    char asciiChars[32] = {0};
-
-    switch(event->type)
-    {
-        case MapNotify: // Window created.
-        break;
-
-        case KeyPress: // Key events.
-            keySymbol = XkbKeycodeToKeysym(gDisplay, event->xkey.keycode, 0, 0);
-
-            switch(keySymbol)
-            {
-                case XK_Escape:
-                    isEscapeKeyPressed = true;
-                break;
-
-                default:
-                break;
-            }
-
-            XLookupString(&event->xkey, asciiChars, sizeof(asciiChars), NULL, NULL);
-            switch(asciiChars[0])
-            {
-                case 'F':
-                case 'f':
-                    isFullscreen = !isFullscreen;
-                    toggleFullscreen(isFullscreen);
-                break;
-
-                default:
-                break;
-            }
-
-        break;
-
-        case ButtonPress: // Mouse event.
-            switch(event->xbutton.button)
-            {
-                case 1: // Left button.
-                break;
-
-                case 2: // Middle button.
-                break;
-
-                case 3: // Right button.
-                break;
-
-                case 4: // Mouse wheel up.
-                break;
-
-                case 5: // Mouse wheel down.
-                break;
-            }
-
-        break;
-
-        case MotionNotify: // Mouse move event.
-        break;
-
-        case ConfigureNotify: // Window configuration change, like resize.
-            windowWidth = event->xconfigure.width;
-            windowHeight = event->xconfigure.height;
-            resize(windowWidth, windowHeight);
-        break;
-
-        case Expose: // Paint window.
-        break;
-
-        case DestroyNotify: // Window destroyed, cleanUp resources.
-        break;
-
-        case 33: // Windows close button event.
-            isCloseButtonClicked = true;
-        break;
-
-        default:
-        break;
-    }
+    return status;
 }
 
 void initialize(void)
 {
-    // Create new GL context 4.5 for rendering.
-    glXCreateContextAttribsARB = (glXCreateContextAttribsARBProc)glXGetProcAddressARB((GLubyte *)"glXCreateContextAttribsARB");
-
-    if(glXCreateContextAttribsARB == NULL)
-    {
-        fprintf(logFile, "Error: Unable to get glXCreateContextAttribsARBProc address.");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    GLint attributes[] = {
-        GLX_CONTEXT_MAJOR_VERSION_ARB, 4,
-        GLX_CONTEXT_MINOR_VERSION_ARB, 5,
-        GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
-        None
-    };
-
-    glxContext = glXCreateContextAttribsARB(gDisplay, glxFBConfig, 0, True, attributes);
-
-    // Not able to get context for OpenGL version 4.5, fallback to old version.
-    if(!glxContext)
-    {
-        fprintf(logFile, "Failed to get GLX Context for OpenGL version 4.5, using old version.\n");
-
-        // When a context version below 3.0 is requested, implementation will return
-        // the newest context version compatible with OpenGL version less than 3.0
-        GLint attributes[] = {
-            GLX_CONTEXT_MAJOR_VERSION_ARB, 1,
-            GLX_CONTEXT_MINOR_VERSION_ARB, 0,
-            None
-        };
-
-        glxContext = glXCreateContextAttribsARB(gDisplay, glxFBConfig, 0, True, attributes);
-    }
-    else
-    {
-        fprintf(logFile, "GLX Context for OpenGL version 4.5 is created.\n");
-    }
-
-    // Check do we have a direct context so that we get hardware rendering.
-    if(!glXIsDirect(gDisplay, glxContext))
-    {
-        fprintf(logFile, "Indirect GLX rendering context is used.\n");
-    }
-    else
-    {
-        fprintf(logFile, "Direct GLX rendering context is used, hardware rendering is available.\n");
-    }
-
-    glXMakeCurrent(gDisplay, window, glxContext);
-
-    GLenum glewError = glewInit();
-	if (glewError != GLEW_OK)
-	{
-        fprintf(logFile, "Cannot initialize GLEW, Error: %d", glewError);
-        fflush(logFile);
-
-        cleanUp();
-        exit(EXIT_FAILURE);
-	}
-
     listExtensions();
 
     // Initialize the shaders and shader program object.
@@ -401,8 +87,6 @@ void initialize(void)
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
 
     perspectiveProjectionMatrix = vmath::mat4::identity();
-
-    resize(windowWidth, windowHeight);
 }
 
 void listExtensions()
@@ -462,8 +146,7 @@ void initializeVertexShader()
                 glGetShaderInfoLog(vertexShaderObject, infoLogLength, &written, infoLog);
                 fprintf(logFile, "CG: Vertex shader compilation log: %s\n", infoLog);
                 free(infoLog);
-                cleanUp();
-                exit(EXIT_FAILURE);
+                platform.exit(EXIT_FAILURE);
             }
         }
     }
@@ -506,8 +189,7 @@ void initializeFragmentShader()
                 glGetShaderInfoLog(fragmentShaderObject, infoLogLength, &written, infoLog);
                 fprintf(logFile, "CG: Fragment shader compilation log: %s\n", infoLog);
                 free(infoLog);
-                cleanUp();
-                exit(EXIT_FAILURE);
+                platform.exit(EXIT_FAILURE);
             }
         }
     }
@@ -548,8 +230,7 @@ void initializeShaderProgram()
                 glGetProgramInfoLog(shaderProgramObject, infoLogLength, &written, infoLog);
                 fprintf(logFile, "CG: Shader program link log: %s\n", infoLog);
                 free(infoLog);
-                cleanUp();
-                exit(EXIT_FAILURE);
+                platform.exit(EXIT_FAILURE);
             }
         }
     }
@@ -626,7 +307,6 @@ void display(void)
     glBindVertexArray(0);
 
     glUseProgram(0);
-    glXSwapBuffers(gDisplay, window);
 }
 
 void resize(int width, int height)
@@ -640,26 +320,6 @@ void resize(int width, int height)
     perspectiveProjectionMatrix = vmath::perspective(45.0f, (GLfloat)width / (GLfloat)height, 1.0f, 100.0f);
 }
 
-void toggleFullscreen(bool isFullscreen)
-{
-    Atom wmStateNormal;
-    Atom wmStateFullscreen;
-    XEvent event = {0};
-
-    wmStateNormal = XInternAtom(gDisplay, "_NET_WM_STATE", False);
-    wmStateFullscreen = XInternAtom(gDisplay, "_NET_WM_STATE_FULLSCREEN", False);
-
-    memset(&event, 0, sizeof(event));
-    event.type = ClientMessage;
-    event.xclient.window = window;
-    event.xclient.message_type = wmStateNormal;
-    event.xclient.format = 32;
-    event.xclient.data.l[0] = isFullscreen ? 1 : 0;
-    event.xclient.data.l[1] = wmStateFullscreen;
-
-    XSendEvent(gDisplay, XRootWindow(gDisplay, visualInfo->screen), False, StructureNotifyMask, &event);
-}
-
 void cleanUp(void)
 {
     if(vao)
@@ -712,38 +372,4 @@ void cleanUp(void)
     }
 
     glUseProgram(0);
-
-    GLXContext currentContext = glXGetCurrentContext();
-
-    if(currentContext != NULL && currentContext == glxContext)
-    {
-        glXMakeCurrent(gDisplay, 0, 0);
-    }
-
-    if(glxContext)
-    {
-        glXDestroyContext(gDisplay, glxContext);
-    }
-
-    if(window)
-    {
-        XDestroyWindow(gDisplay, window);
-    }
-
-    if(colormap)
-    {
-        XFreeColormap(gDisplay, colormap);
-    }
-
-    if(visualInfo)
-    {
-        free(visualInfo);
-        visualInfo = NULL;
-    }
-
-    if(gDisplay)
-    {
-        XCloseDisplay(gDisplay);
-        gDisplay = NULL;
-    }
 }
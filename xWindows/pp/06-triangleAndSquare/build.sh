@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o triangleAndSquare triangleAndSquare.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o triangleAndSquare triangleAndSquare.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
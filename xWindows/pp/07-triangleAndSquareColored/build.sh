@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o triangleAndSquareColored triangleAndSquareColored.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o triangleAndSquareColored triangleAndSquareColored.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o triangleAndSquareRotation triangleAndSquareRotation.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o triangleAndSquareRotation triangleAndSquareRotation.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o pyramidAndCubeRotation pyramidAndCubeRotation.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o pyramidAndCubeRotation pyramidAndCubeRotation.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o pyramidAndCubeTexture pyramidAndCubeTexture.cpp -lX11 -lGL -lGLU -lGLEW -lSOIL
+g++ -I../common -o pyramidAndCubeTexture pyramidAndCubeTexture.cpp -lX11 -lGL -lGLU -lGLEW -lEGL -lSOIL
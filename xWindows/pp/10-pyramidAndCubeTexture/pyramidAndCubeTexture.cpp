@@ -2,24 +2,17 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
-#include <X11/Xlib.h>
-#include <X11/Xutil.h>
-#include <X11/XKBlib.h>
-#include <X11/keysym.h>
 #include <GL/glew.h>
 #include <GL/gl.h>
-#include <GL/glx.h>
 #include <SOIL/SOIL.h>
 
 #include "vmath.h"
 #include "resources/resource.h"
-
-bool isFullscreen = false;
-bool isCloseButtonClicked = false;
-bool isEscapeKeyPressed = false;
-
-int windowWidth = 800;
-int windowHeight = 600;
+#include "stateCache.h"
+#include "geometryPool.h"
+#include "streamBuffer.h"
+#include "drawBatch.h"
+#include "platform.h"
 
 enum
 {
@@ -37,31 +30,44 @@ GLuint vertexShaderObject = 0;
 GLuint fragmentShaderObject = 0;
 GLuint shaderProgramObject = 0;
 
-GLuint vaoPyramid = 0;
-GLuint vboPyramidPosition = 0;
-GLuint vboPyramidTexture = 0;
-GLuint vaoCube = 0;
-GLuint vboCubePosition = 0;
-GLuint vboCubeTexture = 0;
-GLuint mvpUniform = 0;
-GLuint textureSamplerUniform = 0;
 GLuint textureKundali = 0;
 GLuint textureStone = 0;
 
 vmath::mat4 perspectiveProjectionMatrix;
 
+// Program, VAO and textures go through the cache, which skips the ones already bound.
+StateCache stateCache;
+
+// What a draw of the pass reads as draws[gl_DrawIDARB], laid out like the std430 struct Draw.
+struct DrawData
+{
+    vmath::mat4 mvpMatrix;
+    GLint texture;
+    GLint padding[3];
+};
+
+#define DRAW_DATA_BINDING 0
+
+// Pyramid and cube as indexed triangles in one pool, drawn as one pass with a single
+// glMultiDrawElementsIndirect() from commands and draw data streamed every frame.
+GeometryPool geometryPool(CG_ATTRIBUTE_VERTEX_POSITION, CG_ATTRIBUTE_NORMAL, CG_ATTRIBUTE_TEXTURE0, 3, 0, 2, 64, 128);
+StreamBuffer streamBuffer(4096);
+DrawBatch drawBatch(&geometryPool, &streamBuffer, sizeof(DrawData), DRAW_DATA_BINDING);
+
+// Without buffer storage, GL_ARB_multi_draw_indirect or GL_ARB_shader_draw_parameters there is no
+// pass: every object is drawn from the pool on its own with glDrawElementsBaseVertex(), the draw
+// data set as the two uniforms instead.
+bool isDrawBatchEnabled = false;
+GLint mvpUniform = -1;
+GLint drawTextureUniform = -1;
+
+int pyramidMesh = GeometryPool::INVALID;
+int cubeMesh = GeometryPool::INVALID;
+
 FILE *logFile = NULL;
 
-Display *gDisplay = NULL;
-XVisualInfo *visualInfo = NULL;
-Colormap colormap;
-Window window;
-typedef GLXContext (*glXCreateContextAttribsARBProc)(Display *display, GLXFBConfig fbConfig, GLXContext sharedContext, Bool direct, const int* attributes);
-glXCreateContextAttribsARBProc glXCreateContextAttribsARB = NULL;
-GLXFBConfig glxFBConfig;
-GLXContext glxContext;
+Platform platform;
 
-void createWindow(void);
 void initialize(void);
 void listExtensions(void);
 void initializeVertexShader(void);
@@ -70,16 +76,17 @@ void initializeShaderProgram(void);
 void initializePyramidBuffers(void);
 void initializeCubeBuffers(void);
 void cleanUp(void);
-void handleEvent(XEvent *event);
+void keyPress(KeySym keySymbol, char character);
 void update(void);
 void display(void);
 void drawPyramid(void);
 void drawCube(void);
+void drawObject(int mesh, const DrawData& draw);
 bool loadGLTextures(GLuint *texture, const char *resourcePath);
+int addMesh(const GLfloat *positions, const GLfloat *textureCoordinates, int numberOfVertices, GLenum mode, int verticesPerPrimitive);
 void resize(int width, int height);
-void toggleFullscreen(bool isFullscreen);
 
-int main(void)
+int main(int argc, char **argv)
 {
     logFile = fopen("debug.log", "w");
     if(logFile == NULL)
@@ -91,331 +98,63 @@ int main(void)
     fprintf(logFile, "---------- CG: OpenGL Debug Logs Start ----------\n");
     fflush(logFile);
 
-    XEvent event;
-    bool done = false;
+    PlatformOptions options;
+    options.title = "CG - PP - Pyramid and Cube Texture";
+    options.logFile = logFile;
 
-    createWindow();
-    initialize();
-
-    while(!done)
-    {
-        while(XPending(gDisplay))
-        {
-            XNextEvent(gDisplay, &event);
-            handleEvent(&event);
-        }
-
-        done = (isCloseButtonClicked || isEscapeKeyPressed);
-        update();
-        display();
-    }
-
-    cleanUp();
+    PlatformCallbacks callbacks = {initialize, resize, update, display, keyPress, cleanUp};
+    int status = platform.run(argc, argv, options, callbacks);
 
     fprintf(logFile, "---------- CG: OpenGL Debug Logs End ----------\n");
     fflush(logFile);
     fclose(logFile);
 
-    return EXIT_SUCCESS;
+    return status;
 }
 
-void createWindow(void)
+void keyPress(KeySym keySymbol, char character)
 {
-    XSetWindowAttributes windowAttributes;     // This is an array of all available FBConfig matching to frameBufferAttributes.
-    GLXFBConfig *pGLXFBConfigs = NULL;
-    XVisualInfo *pTempXVisualInfo = NULL;
-    int numberOfFBConfigs = 0;
-    int defaultScreen = 0;
-    int styleMask = 0;
-    int counter = 0;
-
-    static int frameBufferAttributes[] = {
-        GLX_RED_SIZE, 8,
-        GLX_GREEN_SIZE, 8,
-        GLX_BLUE_SIZE, 8,
-        GLX_ALPHA_SIZE, 8,
-        GLX_DEPTH_SIZE, 24,
-        GLX_STENCIL_SIZE, 8,
-        GLX_DOUBLEBUFFER, True,
-        GLX_X_RENDERABLE, True,
-        GLX_X_VISUAL_TYPE, GLX_TRUE_COLOR,
-        GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
-        GLX_RENDER_TYPE, GLX_RGBA_BIT,
-        // GLX_SAMPLE_BUFFERS, 1,
-        // GLX_SAMPLES, 4,
-        None
-    };
-
-    gDisplay = XOpenDisplay(NULL);
-
-    if(gDisplay == NULL)
-    {
-        fprintf(logFile, "Error: Unable to open XgDisplay.\n");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    defaultScreen = XDefaultScreen(gDisplay);
-
-    // Get the frame buffer configuration list as per our requirement specified in frameBufferAttributes array.
-    pGLXFBConfigs = glXChooseFBConfig(gDisplay, defaultScreen, frameBufferAttributes, &numberOfFBConfigs);
-
-    if(pGLXFBConfigs == NULL)
-    {
-        fprintf(logFile, "Error: Unable to get valid frame buffer configurations.\n");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    fprintf(logFile, "Total frame buffer configurations: %d\n", numberOfFBConfigs);
-
-    // Select that FBConfig/visual which have the maximum samples per pixel.
-    int bestFrameBufferConfig = -1;
-    int worstFrameBufferConfig = -1;
-    int bestNumberOfSamples = -1;
-    int worstNumberOfSamples = 999;
-
-    for(counter = 0; counter < numberOfFBConfigs; ++counter)
-    {
-        pTempXVisualInfo = glXGetVisualFromFBConfig(gDisplay, pGLXFBConfigs[counter]);
-
-        if(pTempXVisualInfo)
-        {
-            int sampleBuffer = 0;
-            int samples = 0;
-
-            glXGetFBConfigAttrib(gDisplay, pGLXFBConfigs[counter], GLX_SAMPLE_BUFFERS, &sampleBuffer);
-            glXGetFBConfigAttrib(gDisplay, pGLXFBConfigs[counter], GLX_SAMPLES, &samples);
-
-            fprintf(logFile, "----------------------------------------\n");
-            fprintf(logFile, "Frame Buffer Config: %d\n", counter);
-            fprintf(logFile, "Visual ID: 0x%lu\n", pTempXVisualInfo->visualid);
-            fprintf(logFile, "Sample Buffers: %d\n", sampleBuffer);
-            fprintf(logFile, "Samples: %d\n", samples);
-            fprintf(logFile, "----------------------------------------\n");
-
-            if(bestFrameBufferConfig < 0 || sampleBuffer && samples > bestNumberOfSamples)
-            {
-                bestFrameBufferConfig = counter;
-                bestNumberOfSamples = samples;
-            }
-
-            if(worstFrameBufferConfig < 0 || !sampleBuffer || samples < worstNumberOfSamples)
-            {
-                worstFrameBufferConfig = counter;
-                worstNumberOfSamples = samples;
-            }
-        }
-
-        XFree(pTempXVisualInfo);
-    }
-
-    // Set the global glxFBConfig to best found.
-    glxFBConfig = pGLXFBConfigs[bestFrameBufferConfig];
-
-    // Free the frame buffer configuration list.
-    XFree(pGLXFBConfigs);
-
-    visualInfo = glXGetVisualFromFBConfig(gDisplay, glxFBConfig);
-
-    if(visualInfo == NULL)
-    {
-        fprintf(logFile, "Error: Unable to choose visual.\n");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    fprintf(logFile, "----------------------------------------\n");
-    fprintf(logFile, "Selected Visual ID: 0x%lu\n", visualInfo->visualid);
-    fprintf(logFile, "----------------------------------------\n");
-
-    windowAttributes.border_pixel = 0;
-    windowAttributes.border_pixmap = 0;
-    windowAttributes.background_pixel = BlackPixel(gDisplay, defaultScreen);
-    windowAttributes.background_pixmap = 0;
-    windowAttributes.colormap = XCreateColormap(gDisplay, XRootWindow(gDisplay, visualInfo->screen), visualInfo->visual, AllocNone);
-    windowAttributes.event_mask = ExposureMask | VisibilityChangeMask | ButtonPressMask | KeyPressMask | PointerMotionMask | StructureNotifyMask;
-
-    styleMask = CWBorderPixel | CWBackPixel | CWEventMask | CWColormap;
-    colormap = windowAttributes.colormap;
-
-    window = XCreateWindow(gDisplay, XRootWindow(gDisplay, visualInfo->screen), 0, 0, windowWidth, windowHeight, 0, visualInfo->depth, InputOutput, visualInfo->visual, styleMask, &windowAttributes);
-
-    if(!window)
+    switch(character)
     {
-        fprintf(logFile, "Error: Failed to create main window.");
-        cleanUp();
-        exit(EXIT_FAILURE);
-    }
-
-    XStoreName(gDisplay, window, "CG - PP - Pyramid and Cube Texture");
-
-    Atom windowManagerDelete = XInternAtom(gDisplay, "WM_DELETE_WINDOW", True);
-    XSetWMProtocols(gDisplay, window, &windowManagerDelete, 1);
-    XMapWindow(gDisplay, window);
-}
-
-void handleEvent(XEvent *event)
-{
-    KeySym keySymbol;
-    char asciiChars[32] = {0};
-
-    switch(event->type)
-    {
-        case MapNotify: // Window created.
-        break;
-
-        case KeyPress: // Key events.
-            keySymbol = XkbKeycodeToKeysym(gDisplay, event->xkey.keycode, 0, 0);
-
-            switch(keySymbol)
-            {
-                case XK_Escape:
-                    isEscapeKeyPressed = true;
-                break;
-
-                default:
-                break;
-            }
-
-            XLookupString(&event->xkey, asciiChars, sizeof(asciiChars), NULL, NULL);
-            switch(asciiChars[0])
-            {
-                case 'F':
-                case 'f':
-                    isFullscreen = !isFullscreen;
-                    toggleFullscreen(isFullscreen);
-                break;
-
-                case XK_9:
-                    speed = 0.9f;
-                break;
-
-                default:
-                break;
-            }
-
-            if(keySymbol > XK_0 && keySymbol < XK_9)
-            {
-                speed = 0.1f * (keySymbol - XK_0);
-            }
-
-        break;
-
-        case ButtonPress: // Mouse event.
-            switch(event->xbutton.button)
-            {
-                case 1: // Left button.
-                break;
-
-                case 2: // Middle button.
-                break;
-
-                case 3: // Right button.
-                break;
-
-                case 4: // Mouse wheel up.
-                break;
-
-                case 5: // Mouse wheel down.
-                break;
-            }
-
-        break;
-
-        case MotionNotify: // Mouse move event.
-        break;
-
-        case ConfigureNotify: // Window configuration change, like resize.
-            windowWidth = event->xconfigure.width;
-            windowHeight = event->xconfigure.height;
-            resize(windowWidth, windowHeight);
-        break;
-
-        case Expose: // Paint window.
-        break;
-
-        case DestroyNotify: // Window destroyed, cleanUp resources.
-        break;
-
-        case 33: // Windows close button event.
-            isCloseButtonClicked = true;
+        case XK_9:
+            speed = 0.9f;
         break;
 
         default:
         break;
     }
-}
-
-void initialize(void)
-{
-    // Create new GL context 4.5 for rendering.
-    glXCreateContextAttribsARB = (glXCreateContextAttribsARBProc)glXGetProcAddressARB((GLubyte *)"glXCreateContextAttribsARB");
 
-    if(glXCreateContextAttribsARB == NULL)
+    if(keySymbol > XK_0 && keySymbol < XK_9)
     {
-        fprintf(logFile, "Error: Unable to get glXCreateContextAttribsARBProc address.");
-        cleanUp();
-        exit(EXIT_FAILURE);
+        speed = 0.1f * (keySymbol - XK_0);
     }
+}
 
-    GLint attributes[] = {
-        GLX_CONTEXT_MAJOR_VERSION_ARB, 4,
-        GLX_CONTEXT_MINOR_VERSION_ARB, 5,
-        GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
-        None
-    };
-
-    glxContext = glXCreateContextAttribsARB(gDisplay, glxFBConfig, 0, True, attributes);
-
-    // Not able to get context for OpenGL version 4.5, fallback to old version.
-    if(!glxContext)
-    {
-        fprintf(logFile, "Failed to get GLX Context for OpenGL version 4.5, using old version.\n");
+void initialize(void)
+{
+    listExtensions();
 
-        // When a context version below 3.0 is requested, implementation will return
-        // the newest context version compatible with OpenGL version less than 3.0
-        GLint attributes[] = {
-            GLX_CONTEXT_MAJOR_VERSION_ARB, 1,
-            GLX_CONTEXT_MINOR_VERSION_ARB, 0,
-            None
-        };
+    // The shaders depend on whether there is a pass.
+    isDrawBatchEnabled = streamBuffer.create() && drawBatch.create();
 
-        glxContext = glXCreateContextAttribsARB(gDisplay, glxFBConfig, 0, True, attributes);
-    }
-    else
+    if(!isDrawBatchEnabled)
     {
-        fprintf(logFile, "GLX Context for OpenGL version 4.5 is created.\n");
-    }
-
-    // Check do we have a direct context so that we get hardware rendering.
-    if(!glXIsDirect(gDisplay, glxContext))
-    {
-        fprintf(logFile, "Indirect GLX rendering context is used.\n");
-    }
-    else
-    {
-        fprintf(logFile, "Direct GLX rendering context is used, hardware rendering is available.\n");
-    }
-
-    glXMakeCurrent(gDisplay, window, glxContext);
-
-    GLenum glewError = glewInit();
-	if (glewError != GLEW_OK)
-	{
-        fprintf(logFile, "Cannot initialize GLEW, Error: %d", glewError);
+        streamBuffer.destroy();
+        fprintf(logFile, "No draw batch, it needs GL 4.4 or GL_ARB_buffer_storage, GL_ARB_multi_draw_indirect and GL_ARB_shader_draw_parameters. Drawing object by object.\n");
         fflush(logFile);
-
-        cleanUp();
-        exit(EXIT_FAILURE);
-	}
-
-    listExtensions();
+    }
 
     // Initialize the shaders and shader program object.
     initializeVertexShader();
     initializeFragmentShader();
     initializeShaderProgram();
+
+    if(!geometryPool.create())
+    {
+        fprintf(logFile, "Error: Unable to create the geometry pool.\n");
+        platform.exit(EXIT_FAILURE);
+    }
+
     initializePyramidBuffers();
     initializeCubeBuffers();
 
@@ -436,8 +175,6 @@ void initialize(void)
 
     loadGLTextures(&textureStone, STONE_BMP_PATH);
     loadGLTextures(&textureKundali, VIJAY_KUNDALI_BMP_PATH);
-
-    resize(windowWidth, windowHeight);
 }
 
 void listExtensions()
@@ -459,21 +196,59 @@ void initializeVertexShader()
 {
     vertexShaderObject = glCreateShader(GL_VERTEX_SHADER);
 
+    // Every draw of the pass finds its matrix and texture in the draw data by its gl_DrawIDARB.
     const GLchar *vertexShaderCode = "#version 450 core" \
+        "\n" \
+        "#extension GL_ARB_shader_draw_parameters : require" \
         "\n" \
         "in vec4 vertexPosition;" \
         "in vec2 vertexTextureCoordinate0;" \
         "\n" \
         "out vec2 outVertexTextureCoordinate0;" \
+        "flat out int outTexture;" \
+        "\n" \
+        "struct Draw" \
+        "{" \
+        "   mat4 mvpMatrix;" \
+        "   int texture;" \
+        "};" \
+        "\n" \
+        "layout(std430, binding = 0) readonly buffer Draws" \
+        "{" \
+        "   Draw draws[];" \
+        "};" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   gl_Position = draws[gl_DrawIDARB].mvpMatrix * vertexPosition;" \
+        "   outVertexTextureCoordinate0 = vertexTextureCoordinate0;" \
+        "   outTexture = draws[gl_DrawIDARB].texture;" \
+        "}";
+
+    // Drawn object by object the same two come from uniforms set before each draw.
+    const GLchar *objectVertexShaderCode = "#version 450 core" \
+        "\n" \
+        "in vec4 vertexPosition;" \
+        "in vec2 vertexTextureCoordinate0;" \
+        "\n" \
+        "out vec2 outVertexTextureCoordinate0;" \
+        "flat out int outTexture;" \
         "\n" \
         "uniform mat4 mvpMatrix;" \
+        "uniform int drawTexture;" \
         "\n" \
         "void main(void)" \
         "{" \
         "   gl_Position = mvpMatrix * vertexPosition;" \
         "   outVertexTextureCoordinate0 = vertexTextureCoordinate0;" \
+        "   outTexture = drawTexture;" \
         "}";
 
+    if(!isDrawBatchEnabled)
+    {
+        vertexShaderCode = objectVertexShaderCode;
+    }
+
     glShaderSource(vertexShaderObject, 1, (const char**)&vertexShaderCode, NULL);
     glCompileShader(vertexShaderObject);
 
@@ -497,8 +272,7 @@ void initializeVertexShader()
                 glGetShaderInfoLog(vertexShaderObject, infoLogLength, &written, infoLog);
                 fprintf(logFile, "CG: Vertex shader compilation log: %s\n", infoLog);
                 free(infoLog);
-                cleanUp();
-                exit(EXIT_FAILURE);
+                platform.exit(EXIT_FAILURE);
             }
         }
     }
@@ -508,17 +282,23 @@ void initializeFragmentShader()
 {
     fragmentShaderObject = glCreateShader(GL_FRAGMENT_SHADER);
 
+    // Both textures are sampled and the draw picks one, which keeps the lookups out of
+    // divergent control flow where their derivatives would be undefined.
     const GLchar *fragmentShaderCode = "#version 450 core" \
         "\n" \
         "in vec2 outVertexTextureCoordinate0;" \
+        "flat in int outTexture;" \
         "\n" \
         "out vec4 fragmentColor;" \
         "\n" \
-        "uniform sampler2D textureSampler0;"
+        "layout(binding = 0) uniform sampler2D textureSampler0;" \
+        "layout(binding = 1) uniform sampler2D textureSampler1;" \
         "\n" \
         "void main(void)" \
         "{" \
-        "   fragmentColor = texture(textureSampler0, outVertexTextureCoordinate0);" \
+        "   vec4 color0 = texture(textureSampler0, outVertexTextureCoordinate0);" \
+        "   vec4 color1 = texture(textureSampler1, outVertexTextureCoordinate0);" \
+        "   fragmentColor = outTexture == 0 ? color0 : color1;" \
         "}";
 
     glShaderSource(fragmentShaderObject, 1, (const char**)&fragmentShaderCode, NULL);
@@ -544,8 +324,7 @@ void initializeFragmentShader()
                 glGetShaderInfoLog(fragmentShaderObject, infoLogLength, &written, infoLog);
                 fprintf(logFile, "CG: Fragment shader compilation log: %s\n", infoLog);
                 free(infoLog);
-                cleanUp();
-                exit(EXIT_FAILURE);
+                platform.exit(EXIT_FAILURE);
             }
         }
     }
@@ -586,17 +365,17 @@ void initializeShaderProgram()
                 glGetProgramInfoLog(shaderProgramObject, infoLogLength, &written, infoLog);
                 fprintf(logFile, "CG: Shader program link log: %s\n", infoLog);
                 free(infoLog);
-                cleanUp();
-                exit(EXIT_FAILURE);
+                platform.exit(EXIT_FAILURE);
             }
         }
     }
 
-    // After linking get the value of MVP uniform location from the shader program.
-    mvpUniform = glGetUniformLocation(shaderProgramObject, "mvpMatrix");
-
-    // Get the texture sampler uniform location from shader program.
-    textureSamplerUniform = glGetUniformLocation(shaderProgramObject, "textureSampler0");
+    // After linking get the uniform locations the draws without a pass set.
+    if(!isDrawBatchEnabled)
+    {
+        mvpUniform = glGetUniformLocation(shaderProgramObject, "mvpMatrix");
+        drawTextureUniform = glGetUniformLocation(shaderProgramObject, "drawTexture");
+    }
 }
 
 void initializePyramidBuffers()
@@ -645,28 +424,8 @@ void initializePyramidBuffers()
         1.0f, 0.0f
     };
 
-    glGenVertexArrays(1, &vaoPyramid);
-    glBindVertexArray(vaoPyramid);
-
-    glGenBuffers(1, &vboPyramidPosition);
-    glBindBuffer(GL_ARRAY_BUFFER, vboPyramidPosition);
-
-    glBufferData(GL_ARRAY_BUFFER, sizeof(pyramidVertices), pyramidVertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-    glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    glGenBuffers(1, &vboPyramidTexture);
-    glBindBuffer(GL_ARRAY_BUFFER, vboPyramidTexture);
-
-    glBufferData(GL_ARRAY_BUFFER, sizeof(pyramidTextureCoordinates), pyramidTextureCoordinates, GL_STATIC_DRAW);
-    glVertexAttribPointer(CG_ATTRIBUTE_TEXTURE0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
-    glEnableVertexAttribArray(CG_ATTRIBUTE_TEXTURE0);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    glBindVertexArray(0);
+    // The 12 vertices make 4 triangles.
+    pyramidMesh = addMesh(pyramidVertices, pyramidTextureCoordinates, 12, GL_TRIANGLES, 12);
 }
 
 void initializeCubeBuffers()
@@ -747,28 +506,37 @@ void initializeCubeBuffers()
         0.0f, 1.0f
     };
 
-    glGenVertexArrays(1, &vaoCube);
-    glBindVertexArray(vaoCube);
-
-    glGenBuffers(1, &vboCubePosition);
-    glBindBuffer(GL_ARRAY_BUFFER, vboCubePosition);
+    // Each face used to be a glDrawArrays() of a fan of 4 vertices, now 2 triangles each.
+    cubeMesh = addMesh(cubeVertices, cubeTextureCoordinates, 24, GL_TRIANGLE_FAN, 4);
+}
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeVertices), cubeVertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-    glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
+// Interleaves the positions and texture coordinates into a mesh of the pool, with elements for
+// the primitives of verticesPerPrimitive vertices each that glDrawArrays() drew them as.
+int addMesh(const GLfloat *positions, const GLfloat *textureCoordinates, int numberOfVertices, GLenum mode, int verticesPerPrimitive)
+{
+    MeshData mesh;
+    mesh.textureSize = 2;
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    for(int n = 0; n < numberOfVertices; n++)
+    {
+        mesh.vertices.insert(mesh.vertices.end(), positions + n * 3, positions + n * 3 + 3);
+        mesh.vertices.insert(mesh.vertices.end(), textureCoordinates + n * 2, textureCoordinates + n * 2 + 2);
+    }
 
-    glGenBuffers(1, &vboCubeTexture);
-    glBindBuffer(GL_ARRAY_BUFFER, vboCubeTexture);
+    for(int first = 0; first < numberOfVertices; first += verticesPerPrimitive)
+    {
+        DrawBatch::appendElements(mode, first, verticesPerPrimitive, &mesh.elements);
+    }
 
-    glBufferData(GL_ARRAY_BUFFER, sizeof(cubeTextureCoordinates), cubeTextureCoordinates, GL_STATIC_DRAW);
-    glVertexAttribPointer(CG_ATTRIBUTE_TEXTURE0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
-    glEnableVertexAttribArray(CG_ATTRIBUTE_TEXTURE0);
+    int handle = geometryPool.allocate(mesh);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if(handle == GeometryPool::INVALID)
+    {
+        fprintf(logFile, "Error: Unable to add a mesh to the geometry pool.\n");
+        platform.exit(EXIT_FAILURE);
+    }
 
-    glBindVertexArray(0);
+    return handle;
 }
 
 void update(void)
@@ -789,14 +557,33 @@ void update(void)
 
 void display(void)
 {
+    if(isDrawBatchEnabled)
+    {
+        streamBuffer.beginFrame();
+    }
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-    glUseProgram(shaderProgramObject);
+    stateCache.useProgram(shaderProgramObject);
+    stateCache.bindVertexArray(geometryPool.getVao());
 
+    // Stone on unit 0 and kundali on unit 1, every draw picks its own.
+    stateCache.activeTexture(GL_TEXTURE0);
+    stateCache.bindTexture(GL_TEXTURE_2D, textureStone);
+    stateCache.activeTexture(GL_TEXTURE1);
+    stateCache.bindTexture(GL_TEXTURE_2D, textureKundali);
+
+    // Both only record their draw, the pass is drawn by the one submit(). Without a pass they
+    // draw right away.
     drawPyramid();
     drawCube();
 
-    glUseProgram(0);
-    glXSwapBuffers(gDisplay, window);
+    if(isDrawBatchEnabled)
+    {
+        drawBatch.submit();
+        streamBuffer.endFrame();
+    }
+
+    stateCache.endFrame();
 }
 
 void drawPyramid()
@@ -817,27 +604,13 @@ void drawPyramid()
     // As we have model and view matrix combined, we just have to multiply projectionMatrix and modelViewMatrix
     modelViewProjectionMatrix = perspectiveProjectionMatrix * modelViewMatrix;
 
-    // Pass modelViewProjectionMatrix to vertex shader in 'mvpMatrix' variable defined in shader.
-    glUniformMatrix4fv(mvpUniform, 1, GL_FALSE, modelViewProjectionMatrix);
-
-    // Now bind the VAO to which we want to use
-    glBindVertexArray(vaoPyramid);
+    // Pass modelViewProjectionMatrix and the stone texture to the shaders in the draw data.
+    DrawData draw;
+    draw.mvpMatrix = modelViewProjectionMatrix;
+    draw.texture = 0;
 
-    // Enable 0th texture
-    glActiveTexture(GL_TEXTURE0);
-
-    // Bind with pyramid texture
-    glBindTexture(GL_TEXTURE_2D, textureStone);
-
-    // Enable 0th sampler.
-    glUniform1i(textureSamplerUniform, 0);
-
-    // Draw the pyramid
-    // 12 is number of vertices in the array i.e. element count in pyramidVertices divide by 3 (x, y, z) component
-    glDrawArrays(GL_TRIANGLES, 0, 12);
-
-    // unbind the vao
-    glBindVertexArray(0);
+    // Record the pyramid into the pass.
+    drawObject(pyramidMesh, draw);
 }
 
 void drawCube()
@@ -863,34 +636,27 @@ void drawCube()
     // As we have model and view matrix combined, we just have to multiply projectionMatrix and modelViewMatrix
     modelViewProjectionMatrix = perspectiveProjectionMatrix * modelViewMatrix;
 
-    // Pass modelViewProjectionMatrix to vertex shader in 'mvpMatrix' variable defined in shader.
-    glUniformMatrix4fv(mvpUniform, 1, GL_FALSE, modelViewProjectionMatrix);
-
-    // Now bind the VAO to which we want to use
-    glBindVertexArray(vaoCube);
-
-    // Enable 0th texture
-    glActiveTexture(GL_TEXTURE0);
-
-    // Bind with pyramid texture
-    glBindTexture(GL_TEXTURE_2D, textureKundali);
+    // Pass modelViewProjectionMatrix and the kundali texture to the shaders in the draw data.
+    DrawData draw;
+    draw.mvpMatrix = modelViewProjectionMatrix;
+    draw.texture = 1;
 
-    // Enable 0th sampler.
-    glUniform1i(textureSamplerUniform, 0);
+    // Record the cube, all six faces in one draw of the pass.
+    drawObject(cubeMesh, draw);
+}
 
-    // Draw the cube
-    // 4 is number of vertices in the array for each face
-    // i.e. element count in cubeVertices for each face divide by 3 (x, y, z) component
-    // 2nd parameter is the index from which we need to use vertices.
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    glDrawArrays(GL_TRIANGLE_FAN, 4, 4);
-    glDrawArrays(GL_TRIANGLE_FAN, 8, 4);
-    glDrawArrays(GL_TRIANGLE_FAN, 12, 4);
-    glDrawArrays(GL_TRIANGLE_FAN, 16, 4);
-    glDrawArrays(GL_TRIANGLE_FAN, 20, 4);
+// Records the draw into the pass, or without one draws it right away.
+void drawObject(int mesh, const DrawData& draw)
+{
+    if(isDrawBatchEnabled)
+    {
+        drawBatch.add(mesh, &draw);
+        return;
+    }
 
-    // unbind the vao
-    glBindVertexArray(0);
+    glUniformMatrix4fv(mvpUniform, 1, GL_FALSE, draw.mvpMatrix);
+    glUniform1i(drawTextureUniform, draw.texture);
+    geometryPool.draw(mesh);
 }
 
 bool loadGLTextures(GLuint *texture, const char *resourcePath)
@@ -934,63 +700,14 @@ void resize(int width, int height)
     perspectiveProjectionMatrix = vmath::perspective(45.0f, (GLfloat)width / (GLfloat)height, 1.0f, 100.0f);
 }
 
-void toggleFullscreen(bool isFullscreen)
-{
-    Atom wmStateNormal;
-    Atom wmStateFullscreen;
-    XEvent event = {0};
-
-    wmStateNormal = XInternAtom(gDisplay, "_NET_WM_STATE", False);
-    wmStateFullscreen = XInternAtom(gDisplay, "_NET_WM_STATE_FULLSCREEN", False);
-
-    memset(&event, 0, sizeof(event));
-    event.type = ClientMessage;
-    event.xclient.window = window;
-    event.xclient.message_type = wmStateNormal;
-    event.xclient.format = 32;
-    event.xclient.data.l[0] = isFullscreen ? 1 : 0;
-    event.xclient.data.l[1] = wmStateFullscreen;
-
-    XSendEvent(gDisplay, XRootWindow(gDisplay, visualInfo->screen), False, StructureNotifyMask, &event);
-}
-
 void cleanUp(void)
 {
-    if(vaoPyramid)
-    {
-        glDeleteVertexArrays(1, &vaoPyramid);
-        vaoPyramid = 0;
-    }
+    stateCache.log(logFile);
+    drawBatch.log(logFile, "Draw batch");
+    streamBuffer.log(logFile, "Stream buffer");
 
-    if(vboPyramidPosition)
-    {
-        glDeleteBuffers(1, &vboPyramidPosition);
-        vboPyramidPosition = 0;
-    }
-
-    if(vboPyramidTexture)
-    {
-        glDeleteBuffers(1, &vboPyramidTexture);
-        vboPyramidTexture = 0;
-    }
-
-    if(vaoCube)
-    {
-        glDeleteVertexArrays(1, &vaoCube);
-        vaoCube = 0;
-    }
-
-    if(vboCubePosition)
-    {
-        glDeleteBuffers(1, &vboCubePosition);
-        vboCubePosition = 0;
-    }
-
-    if(vboCubeTexture)
-    {
-        glDeleteBuffers(1, &vboCubeTexture);
-        vboCubeTexture = 0;
-    }
+    streamBuffer.destroy();
+    geometryPool.destroy();
 
     if(shaderProgramObject)
     {
@@ -1036,38 +753,4 @@ void cleanUp(void)
 		glDeleteTextures(1, &textureKundali);
 		textureKundali = 0;
     }
-
-    GLXContext currentContext = glXGetCurrentContext();
-
-    if(currentContext != NULL && currentContext == glxContext)
-    {
-        glXMakeCurrent(gDisplay, 0, 0);
-    }
-
-    if(glxContext)
-    {
-        glXDestroyContext(gDisplay, glxContext);
-    }
-
-    if(window)
-    {
-        XDestroyWindow(gDisplay, window);
-    }
-
-    if(colormap)
-    {
-        XFreeColormap(gDisplay, colormap);
-    }
-
-    if(visualInfo)
-    {
-        free(visualInfo);
-        visualInfo = NULL;
-    }
-
-    if(gDisplay)
-    {
-        XCloseDisplay(gDisplay);
-        gDisplay = NULL;
-    }
 }
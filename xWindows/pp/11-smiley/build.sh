@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o smiley smiley.cpp -lX11 -lGL -lGLU -lGLEW -lSOIL
+g++ -I../common -o smiley smiley.cpp -lX11 -lGL -lGLU -lGLEW -lEGL -lSOIL
@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o smileyTweaked smileyTweaked.cpp -lX11 -lGL -lGLU -lGLEW -lSOIL
+g++ -I../common -o smileyTweaked smileyTweaked.cpp -lX11 -lGL -lGLU -lGLEW -lEGL -lSOIL
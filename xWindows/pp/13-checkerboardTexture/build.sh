@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o checkerboardTexture checkerboardTexture.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o checkerboardTexture checkerboardTexture.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o rotatingCubeWithLight rotatingCubeWithLight.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o rotatingCubeWithLight rotatingCubeWithLight.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
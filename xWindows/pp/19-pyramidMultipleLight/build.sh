@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o pyramidMultipleLight pyramidMultipleLight.cpp -lX11 -lGL -lGLU -lGLEW
+g++ -I../common -o pyramidMultipleLight pyramidMultipleLight.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
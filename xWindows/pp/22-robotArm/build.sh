@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -I../common -o robotArm robotArm.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
@@ -0,0 +1,443 @@
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <math.h>
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include "vmath.h"
+#include "vmathMatrixStack.h"
+#include "primitives.h"
+#include "platform.h"
+
+bool isMatrixStackEnabled = true;
+
+enum
+{
+    CG_ATTRIBUTE_VERTEX_POSITION = 0,
+    CG_ATTRIBUTE_COLOR,
+    CG_ATTRIBUTE_NORMAL,
+    CG_ATTRIBUTE_TEXTURE0,
+};
+
+GLuint vertexShaderObject = 0;
+GLuint fragmentShaderObject = 0;
+GLuint shaderProgramObject = 0;
+
+PrimitiveLibrary primitives;
+int sphere = PrimitiveLibrary::INVALID;
+GLuint mvpMatrixUniform = 0;
+GLuint colorUniform = 0;
+
+vmath::mat4 perspectiveProjectionMatrix;
+vmath::MatrixStack matrixStack;
+
+GLint angleShoulder = 0;
+GLint angleElbow = 0;
+
+// Matrix multiplies done on the CPU in the last frame, and the last values written to the log.
+unsigned int multiplyCount = 0;
+unsigned int loggedMultiplyCount[2] = {0, 0};
+
+GLfloat armColor[] = {0.5f, 0.35f, 0.05f};
+
+FILE *logFile = NULL;
+
+Platform platform;
+
+void initialize(void);
+void listExtensions(void);
+void initializeVertexShader(void);
+void initializeFragmentShader(void);
+void initializeShaderProgram(void);
+void cleanUp(void);
+void keyPress(KeySym keySymbol, char character);
+void display(void);
+void drawRobotArmWithMatrixStack(void);
+void drawRobotArmWithTemporaries(void);
+void drawSphere(const vmath::mat4& mvpMatrix);
+void resize(int width, int height);
+
+int main(int argc, char **argv)
+{
+    logFile = fopen("debug.log", "w");
+    if(logFile == NULL)
+    {
+        fprintf(logFile, "Error: Unable to create log file.");
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(logFile, "---------- CG: OpenGL Debug Logs Start ----------\n");
+    fflush(logFile);
+
+    PlatformOptions options;
+    options.title = "CG - PP - Robot Arm";
+    options.logFile = logFile;
+
+    PlatformCallbacks callbacks = {initialize, resize, NULL, display, keyPress, cleanUp};
+    int status = platform.run(argc, argv, options, callbacks);
+
+    fprintf(logFile, "---------- CG: OpenGL Debug Logs End ----------\n");
+    fflush(logFile);
+    fclose(logFile);
+
+    return status;
+}
+
+void keyPress(KeySym, char character)
+{
+    switch(character)
+    {
+        case 'E':
+            angleElbow = (angleElbow + 3) % 360;
+        break;
+
+        case 'e':
+            angleElbow = (angleElbow - 3) % 360;
+        break;
+
+        case 'S':
+            angleShoulder = (angleShoulder + 3) % 360;
+        break;
+
+        case 's':
+            angleShoulder = (angleShoulder - 3) % 360;
+        break;
+
+        case 'M':
+        case 'm':
+            isMatrixStackEnabled = !isMatrixStackEnabled;
+        break;
+
+        default:
+        break;
+    }
+}
+
+void initialize(void)
+{
+    listExtensions();
+
+    // Initialize the shaders and shader program object.
+    initializeVertexShader();
+    initializeFragmentShader();
+    initializeShaderProgram();
+
+    // Same sphere as the fixed function version draws.
+    sphere = primitives.sphere(0.5f, 10, 10);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClearDepth(1.0f);
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glShadeModel(GL_SMOOTH);
+
+    perspectiveProjectionMatrix = vmath::mat4::identity();
+}
+
+void listExtensions()
+{
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+    fprintf(logFile, "Number of extensions: %d\n", extensionCount);
+    fflush(logFile);
+
+    for(int counter = 0; counter < extensionCount; ++counter)
+    {
+        fprintf(logFile, "%d] Extension name: %s\n", counter + 1, (const char*)glGetStringi(GL_EXTENSIONS, counter));
+        fflush(logFile);
+    }
+}
+
+void initializeVertexShader()
+{
+    vertexShaderObject = glCreateShader(GL_VERTEX_SHADER);
+
+    // The whole projection * view * model product comes from the CPU, so each vertex does a single
+    // matrix times vector multiply.
+    const GLchar *vertexShaderCode = "#version 450 core" \
+        "\n" \
+        "in vec4 vertexPosition;" \
+        "\n" \
+        "uniform mat4 mvpMatrix;" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   gl_Position = mvpMatrix * vertexPosition;" \
+        "}";
+
+    glShaderSource(vertexShaderObject, 1, (const char**)&vertexShaderCode, NULL);
+    glCompileShader(vertexShaderObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderCompileStatus = 0;
+    char *infoLog = NULL;
+
+    glGetShaderiv(vertexShaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
+
+    if(shaderCompileStatus == GL_FALSE)
+    {
+        glGetShaderiv(vertexShaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetShaderInfoLog(vertexShaderObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Vertex shader compilation log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+void initializeFragmentShader()
+{
+    fragmentShaderObject = glCreateShader(GL_FRAGMENT_SHADER);
+
+    const GLchar *fragmentShaderCode = "#version 450 core" \
+        "\n" \
+        "out vec4 fragmentColor;" \
+        "\n" \
+        "uniform vec3 color;" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   fragmentColor = vec4(color, 1.0);" \
+        "}";
+
+    glShaderSource(fragmentShaderObject, 1, (const char**)&fragmentShaderCode, NULL);
+    glCompileShader(fragmentShaderObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderCompileStatus = 0;
+    char *infoLog = NULL;
+
+    glGetShaderiv(fragmentShaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
+
+    if(shaderCompileStatus == GL_FALSE)
+    {
+        glGetShaderiv(fragmentShaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetShaderInfoLog(fragmentShaderObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Fragment shader compilation log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+void initializeShaderProgram()
+{
+    shaderProgramObject = glCreateProgram();
+    glAttachShader(shaderProgramObject, vertexShaderObject);
+    glAttachShader(shaderProgramObject, fragmentShaderObject);
+
+    // Bind the position attribute location before linking.
+    glBindAttribLocation(shaderProgramObject, CG_ATTRIBUTE_VERTEX_POSITION, "vertexPosition");
+
+    // Now link and check for error.
+    glLinkProgram(shaderProgramObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderProgramLinkStatus = 0;
+    char *infoLog = NULL;
+
+    glGetProgramiv(shaderProgramObject, GL_LINK_STATUS, &shaderProgramLinkStatus);
+
+    if(shaderProgramLinkStatus == GL_FALSE)
+    {
+        glGetProgramiv(shaderProgramObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetProgramInfoLog(shaderProgramObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Shader program link log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    // After linking get the value of mvpMatrix and color uniform location from the shader program.
+    mvpMatrixUniform = glGetUniformLocation(shaderProgramObject, "mvpMatrix");
+    colorUniform = glGetUniformLocation(shaderProgramObject, "color");
+}
+
+void display(void)
+{
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    glUseProgram(shaderProgramObject);
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glUniform3fv(colorUniform, 1, armColor);
+
+    if(isMatrixStackEnabled)
+    {
+        drawRobotArmWithMatrixStack();
+    }
+    else
+    {
+        drawRobotArmWithTemporaries();
+    }
+
+    // Log the multiplies per frame whenever they change for the current mode.
+    int mode = isMatrixStackEnabled ? 1 : 0;
+
+    if(multiplyCount != loggedMultiplyCount[mode])
+    {
+        fprintf(logFile, "Matrix multiplies per frame with %s: %u\n", isMatrixStackEnabled ? "matrix stack" : "temporaries", multiplyCount);
+        fflush(logFile);
+        loggedMultiplyCount[mode] = multiplyCount;
+    }
+
+    glUseProgram(0);
+}
+
+// Same hierarchy as the fixed function robotArm, with vmath::MatrixStack in place of
+// glPushMatrix()/glPopMatrix(). Translate, scale and the z axis rotations only touch columns of
+// the top matrix, so the full multiplies left are the two projection * model products.
+void drawRobotArmWithMatrixStack(void)
+{
+    matrixStack.reset();
+    matrixStack.setBase(perspectiveProjectionMatrix);
+    matrixStack.translate(0.0f, 0.0f, -12.0f);
+
+    // Push initial matrix.
+    matrixStack.push();
+
+    // Draw the shoulder
+    matrixStack.rotate((GLfloat)angleShoulder, 0.0f, 0.0f, 1.0f);
+    matrixStack.translate(1.0f, 0.0f, 0.0f);
+
+    // Push the shoulder transformation state.
+    matrixStack.push();
+    matrixStack.scale(2.0f, 0.5f, 1.0f);
+    drawSphere(matrixStack.combined());
+
+    // Pop back to shoulder transformation state.
+    matrixStack.pop();
+
+    // Draw the elbow
+    matrixStack.translate(1.0f, 0.0f, 0.0f);
+    matrixStack.rotate((GLfloat)angleElbow, 0.0f, 0.0f, 1.0f);
+    matrixStack.translate(1.0f, 0.0f, 0.0f);
+
+    // Push the elbow transformation state.
+    matrixStack.push();
+    matrixStack.scale(2.0f, 0.5f, 1.0f);
+    drawSphere(matrixStack.combined());
+
+    // Pop the elbow transformation state.
+    matrixStack.pop();
+
+    // Pop initial matrix.
+    matrixStack.pop();
+
+    multiplyCount = matrixStack.multiplyCount();
+}
+
+// The same hierarchy built the way the other pp samples build their model matrices: every part
+// starts again from the root with fresh vmath::mat4 temporaries.
+void drawRobotArmWithTemporaries(void)
+{
+    vmath::mat4 modelMatrix = vmath::mat4::identity();
+    vmath::mat4 viewMatrix = vmath::mat4::identity();
+
+    multiplyCount = 0;
+
+    // Upper arm.
+    modelMatrix = vmath::translate(0.0f, 0.0f, -12.0f);
+    modelMatrix = modelMatrix * vmath::rotate((GLfloat)angleShoulder, 0.0f, 0.0f, 1.0f);
+    modelMatrix = modelMatrix * vmath::translate(1.0f, 0.0f, 0.0f);
+    modelMatrix = modelMatrix * vmath::scale(2.0f, 0.5f, 1.0f);
+    drawSphere(perspectiveProjectionMatrix * viewMatrix * modelMatrix);
+    multiplyCount += 5;
+
+    // Forearm.
+    modelMatrix = vmath::translate(0.0f, 0.0f, -12.0f);
+    modelMatrix = modelMatrix * vmath::rotate((GLfloat)angleShoulder, 0.0f, 0.0f, 1.0f);
+    modelMatrix = modelMatrix * vmath::translate(1.0f, 0.0f, 0.0f);
+    modelMatrix = modelMatrix * vmath::translate(1.0f, 0.0f, 0.0f);
+    modelMatrix = modelMatrix * vmath::rotate((GLfloat)angleElbow, 0.0f, 0.0f, 1.0f);
+    modelMatrix = modelMatrix * vmath::translate(1.0f, 0.0f, 0.0f);
+    modelMatrix = modelMatrix * vmath::scale(2.0f, 0.5f, 1.0f);
+    drawSphere(perspectiveProjectionMatrix * viewMatrix * modelMatrix);
+    multiplyCount += 8;
+}
+
+void drawSphere(const vmath::mat4& mvpMatrix)
+{
+    glUniformMatrix4fv(mvpMatrixUniform, 1, GL_FALSE, mvpMatrix);
+
+    primitives.drawWithShader(sphere, CG_ATTRIBUTE_VERTEX_POSITION, -1, -1);
+}
+
+void resize(int width, int height)
+{
+    if(height == 0)
+    {
+        height = 1;
+    }
+
+    glViewport(0, 0, (GLsizei)width, (GLsizei)height);
+    perspectiveProjectionMatrix = vmath::perspective(45.0f, (GLfloat)width / (GLfloat)height, 1.0f, 100.0f);
+}
+
+void cleanUp(void)
+{
+    primitives.clear();
+
+    if(shaderProgramObject)
+    {
+        if(vertexShaderObject)
+        {
+            glDetachShader(shaderProgramObject, vertexShaderObject);
+        }
+
+        if(fragmentShaderObject)
+        {
+            glDetachShader(shaderProgramObject, fragmentShaderObject);
+        }
+    }
+
+    if(vertexShaderObject)
+    {
+        glDeleteShader(vertexShaderObject);
+        vertexShaderObject = 0;
+    }
+
+    if(fragmentShaderObject)
+    {
+        glDeleteShader(fragmentShaderObject);
+        fragmentShaderObject = 0;
+    }
+
+    if(shaderProgramObject)
+    {
+        glDeleteProgram(shaderProgramObject);
+        shaderProgramObject = 0;
+    }
+
+    glUseProgram(0);
+}
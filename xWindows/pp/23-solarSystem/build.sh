@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -I../common -o solarSystem solarSystem.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
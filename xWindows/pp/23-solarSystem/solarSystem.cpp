@@ -0,0 +1,568 @@
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <math.h>
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include "vmath.h"
+#include "vmathMatrixStack.h"
+#include "stateCache.h"
+#include "platform.h"
+
+bool isMatrixStackEnabled = true;
+
+enum
+{
+    CG_ATTRIBUTE_VERTEX_POSITION = 0,
+    CG_ATTRIBUTE_COLOR,
+    CG_ATTRIBUTE_NORMAL,
+    CG_ATTRIBUTE_TEXTURE0,
+};
+
+GLuint vertexShaderObject = 0;
+GLuint fragmentShaderObject = 0;
+GLuint shaderProgramObject = 0;
+
+GLuint vaoSun = 0;
+GLuint vboSunPosition = 0;
+GLuint vboSunElement = 0;
+GLsizei numberOfSunElements = 0;
+GLuint vaoEarth = 0;
+GLuint vboEarthPosition = 0;
+GLuint vboEarthElement = 0;
+GLsizei numberOfEarthElements = 0;
+GLuint mvpMatrixUniform = 0;
+GLuint colorUniform = 0;
+
+vmath::mat4 perspectiveProjectionMatrix;
+vmath::mat4 viewMatrix;
+vmath::MatrixStack matrixStack;
+
+// The program stays bound between frames and a sphere's VAO until the next sphere needs another.
+StateCache stateCache;
+
+GLint year = 0;
+GLint day = 0;
+
+// Matrix multiplies done on the CPU in the last frame, and the last values written to the log.
+unsigned int multiplyCount = 0;
+unsigned int loggedMultiplyCount[2] = {0, 0};
+
+GLfloat sunColor[] = {1.0f, 1.0f, 0.0f};
+GLfloat earthColor[] = {0.4f, 0.9f, 1.0f};
+
+FILE *logFile = NULL;
+
+Platform platform;
+
+void initialize(void);
+void listExtensions(void);
+void initializeVertexShader(void);
+void initializeFragmentShader(void);
+void initializeShaderProgram(void);
+void initializeSphereBuffers(GLuint *vao, GLuint *vboPosition, GLuint *vboElement, GLsizei *numberOfElements, GLfloat radius, int slices, int stacks);
+void cleanUp(void);
+void keyPress(KeySym keySymbol, char character);
+void display(void);
+void drawSolarSystemWithMatrixStack(void);
+void drawSolarSystemWithTemporaries(void);
+void drawSphere(GLuint vao, GLsizei numberOfElements, const vmath::mat4& mvpMatrix);
+void resize(int width, int height);
+
+int main(int argc, char **argv)
+{
+    logFile = fopen("debug.log", "w");
+    if(logFile == NULL)
+    {
+        fprintf(logFile, "Error: Unable to create log file.");
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(logFile, "---------- CG: OpenGL Debug Logs Start ----------\n");
+    fflush(logFile);
+
+    PlatformOptions options;
+    options.title = "CG - PP - Solar System";
+    options.logFile = logFile;
+
+    PlatformCallbacks callbacks = {initialize, resize, NULL, display, keyPress, cleanUp};
+    int status = platform.run(argc, argv, options, callbacks);
+
+    fprintf(logFile, "---------- CG: OpenGL Debug Logs End ----------\n");
+    fflush(logFile);
+    fclose(logFile);
+
+    return status;
+}
+
+void keyPress(KeySym, char character)
+{
+    switch(character)
+    {
+        case 'D':
+            day = (day + 6) % 360;
+        break;
+
+        case 'd':
+            day = (day - 3) % 360;
+        break;
+
+        case 'y':
+            year = (year + 3) % 360;
+        break;
+
+        case 'Y':
+            year = (year - 3) % 360;
+        break;
+
+        case 'M':
+        case 'm':
+            isMatrixStackEnabled = !isMatrixStackEnabled;
+        break;
+
+        default:
+        break;
+    }
+}
+
+void initialize(void)
+{
+    listExtensions();
+
+    // Initialize the shaders and shader program object.
+    initializeVertexShader();
+    initializeFragmentShader();
+    initializeShaderProgram();
+
+    // Same spheres as gluSphere(quadric, 0.75, 30, 30) and gluSphere(quadric, 0.2, 20, 20) in the
+    // fixed function version.
+    initializeSphereBuffers(&vaoSun, &vboSunPosition, &vboSunElement, &numberOfSunElements, 0.75f, 30, 30);
+    initializeSphereBuffers(&vaoEarth, &vboEarthPosition, &vboEarthElement, &numberOfEarthElements, 0.2f, 20, 20);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClearDepth(1.0f);
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glShadeModel(GL_SMOOTH);
+
+    perspectiveProjectionMatrix = vmath::mat4::identity();
+    viewMatrix = vmath::lookat(vmath::vec3(0.0f, 0.0f, 5.0f), vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
+}
+
+void listExtensions()
+{
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+    fprintf(logFile, "Number of extensions: %d\n", extensionCount);
+    fflush(logFile);
+
+    for(int counter = 0; counter < extensionCount; ++counter)
+    {
+        fprintf(logFile, "%d] Extension name: %s\n", counter + 1, (const char*)glGetStringi(GL_EXTENSIONS, counter));
+        fflush(logFile);
+    }
+}
+
+void initializeVertexShader()
+{
+    vertexShaderObject = glCreateShader(GL_VERTEX_SHADER);
+
+    // The whole projection * view * model product comes from the CPU, so each vertex does a single
+    // matrix times vector multiply.
+    const GLchar *vertexShaderCode = "#version 450 core" \
+        "\n" \
+        "in vec4 vertexPosition;" \
+        "\n" \
+        "uniform mat4 mvpMatrix;" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   gl_Position = mvpMatrix * vertexPosition;" \
+        "}";
+
+    glShaderSource(vertexShaderObject, 1, (const char**)&vertexShaderCode, NULL);
+    glCompileShader(vertexShaderObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderCompileStatus = 0;
+    char *infoLog = NULL;
+
+    glGetShaderiv(vertexShaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
+
+    if(shaderCompileStatus == GL_FALSE)
+    {
+        glGetShaderiv(vertexShaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetShaderInfoLog(vertexShaderObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Vertex shader compilation log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+void initializeFragmentShader()
+{
+    fragmentShaderObject = glCreateShader(GL_FRAGMENT_SHADER);
+
+    const GLchar *fragmentShaderCode = "#version 450 core" \
+        "\n" \
+        "out vec4 fragmentColor;" \
+        "\n" \
+        "uniform vec3 color;" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   fragmentColor = vec4(color, 1.0);" \
+        "}";
+
+    glShaderSource(fragmentShaderObject, 1, (const char**)&fragmentShaderCode, NULL);
+    glCompileShader(fragmentShaderObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderCompileStatus = 0;
+    char *infoLog = NULL;
+
+    glGetShaderiv(fragmentShaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
+
+    if(shaderCompileStatus == GL_FALSE)
+    {
+        glGetShaderiv(fragmentShaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetShaderInfoLog(fragmentShaderObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Fragment shader compilation log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+void initializeShaderProgram()
+{
+    shaderProgramObject = glCreateProgram();
+    glAttachShader(shaderProgramObject, vertexShaderObject);
+    glAttachShader(shaderProgramObject, fragmentShaderObject);
+
+    // Bind the position attribute location before linking.
+    glBindAttribLocation(shaderProgramObject, CG_ATTRIBUTE_VERTEX_POSITION, "vertexPosition");
+
+    // Now link and check for error.
+    glLinkProgram(shaderProgramObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderProgramLinkStatus = 0;
+    char *infoLog = NULL;
+
+    glGetProgramiv(shaderProgramObject, GL_LINK_STATUS, &shaderProgramLinkStatus);
+
+    if(shaderProgramLinkStatus == GL_FALSE)
+    {
+        glGetProgramiv(shaderProgramObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetProgramInfoLog(shaderProgramObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Shader program link log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    // After linking get the value of mvpMatrix and color uniform location from the shader program.
+    mvpMatrixUniform = glGetUniformLocation(shaderProgramObject, "mvpMatrix");
+    colorUniform = glGetUniformLocation(shaderProgramObject, "color");
+}
+
+// Builds the sphere gluSphere() would draw: poles on the z axis, slices around it and stacks from
+// +z to -z, as indexed triangles.
+void initializeSphereBuffers(GLuint *vao, GLuint *vboPosition, GLuint *vboElement, GLsizei *numberOfElements, GLfloat radius, int slices, int stacks)
+{
+    int numberOfVertices = (slices + 1) * (stacks + 1);
+    GLfloat *sphereVertices = (GLfloat *)malloc(numberOfVertices * 3 * sizeof(GLfloat));
+    GLushort *sphereElements = (GLushort *)malloc(slices * stacks * 6 * sizeof(GLushort));
+
+    if(sphereVertices == NULL || sphereElements == NULL)
+    {
+        fprintf(logFile, "Error: Unable to allocate memory for sphere.\n");
+        free(sphereVertices);
+        free(sphereElements);
+        platform.exit(EXIT_FAILURE);
+    }
+
+    for(int stack = 0; stack <= stacks; ++stack)
+    {
+        GLfloat rho = (GLfloat)M_PI * stack / stacks;
+
+        for(int slice = 0; slice <= slices; ++slice)
+        {
+            GLfloat theta = 2.0f * (GLfloat)M_PI * slice / slices;
+            GLfloat *vertex = sphereVertices + (stack * (slices + 1) + slice) * 3;
+
+            vertex[0] = sinf(theta) * sinf(rho) * radius;
+            vertex[1] = cosf(theta) * sinf(rho) * radius;
+            vertex[2] = cosf(rho) * radius;
+        }
+    }
+
+    GLsizei elementCount = 0;
+
+    for(int stack = 0; stack < stacks; ++stack)
+    {
+        for(int slice = 0; slice < slices; ++slice)
+        {
+            GLushort topLeft = (GLushort)(stack * (slices + 1) + slice);
+            GLushort bottomLeft = (GLushort)(topLeft + slices + 1);
+
+            sphereElements[elementCount++] = topLeft;
+            sphereElements[elementCount++] = bottomLeft;
+            sphereElements[elementCount++] = topLeft + 1;
+
+            sphereElements[elementCount++] = topLeft + 1;
+            sphereElements[elementCount++] = bottomLeft;
+            sphereElements[elementCount++] = bottomLeft + 1;
+        }
+    }
+
+    glGenVertexArrays(1, vao);
+    glBindVertexArray(*vao);
+
+    glGenBuffers(1, vboPosition);
+    glBindBuffer(GL_ARRAY_BUFFER, *vboPosition);
+
+    glBufferData(GL_ARRAY_BUFFER, numberOfVertices * 3 * sizeof(GLfloat), sphereVertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+    glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenBuffers(1, vboElement);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *vboElement);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, elementCount * sizeof(GLushort), sphereElements, GL_STATIC_DRAW);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    free(sphereVertices);
+    free(sphereElements);
+
+    *numberOfElements = elementCount;
+}
+
+void display(void)
+{
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    stateCache.useProgram(shaderProgramObject);
+
+    if(isMatrixStackEnabled)
+    {
+        drawSolarSystemWithMatrixStack();
+    }
+    else
+    {
+        drawSolarSystemWithTemporaries();
+    }
+
+    // Log the multiplies per frame whenever they change for the current mode.
+    int mode = isMatrixStackEnabled ? 1 : 0;
+
+    if(multiplyCount != loggedMultiplyCount[mode])
+    {
+        fprintf(logFile, "Matrix multiplies per frame with %s: %u\n", isMatrixStackEnabled ? "matrix stack" : "temporaries", multiplyCount);
+        fflush(logFile);
+        loggedMultiplyCount[mode] = multiplyCount;
+    }
+
+    stateCache.endFrame();
+}
+
+// Same hierarchy as the fixed function solarSystem, with vmath::MatrixStack in place of
+// glPushMatrix()/glPopMatrix(). All the rotations are about the x, y or z axis and only touch
+// columns of the top matrix, so the full multiplies left are projection * view and one
+// product per sphere.
+void drawSolarSystemWithMatrixStack(void)
+{
+    matrixStack.reset();
+    matrixStack.setBase(perspectiveProjectionMatrix * viewMatrix);
+
+    // Push initial matrix.
+    matrixStack.push();
+
+    // Rotate the sphere by 90 degree on x-axis
+    // because sphere created like gluSphere has the north-south poles on z-axis.
+    matrixStack.rotate(90.0f, 1.0f, 0.0f, 0.0f);
+
+    // Draw the sun
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glUniform3fv(colorUniform, 1, sunColor);
+    drawSphere(vaoSun, numberOfSunElements, matrixStack.combined());
+
+    // Pop back to initial state.
+    matrixStack.pop();
+
+    // Draw the earth
+    matrixStack.push();
+
+    matrixStack.rotate((GLfloat)year, 0.0f, 1.0f, 0.0f);
+    matrixStack.translate(1.5f, 0.0f, 0.0f);
+    matrixStack.rotate(90.0f, 1.0f, 0.0f, 0.0f);
+
+    // Rotate the earth by days on z-axis as we have rotated on x-axis.
+    matrixStack.rotate((GLfloat)day, 0.0f, 0.0f, 1.0f);
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    glUniform3fv(colorUniform, 1, earthColor);
+    drawSphere(vaoEarth, numberOfEarthElements, matrixStack.combined());
+
+    // Pop the earth transformation state.
+    matrixStack.pop();
+
+    // One more for projection * view.
+    multiplyCount = matrixStack.multiplyCount() + 1;
+}
+
+// The same hierarchy built the way the other pp samples build their model matrices: every sphere
+// starts again from the root with fresh vmath::mat4 temporaries.
+void drawSolarSystemWithTemporaries(void)
+{
+    vmath::mat4 modelMatrix = vmath::mat4::identity();
+
+    multiplyCount = 0;
+
+    // Sun.
+    modelMatrix = vmath::rotate(90.0f, 1.0f, 0.0f, 0.0f);
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glUniform3fv(colorUniform, 1, sunColor);
+    drawSphere(vaoSun, numberOfSunElements, perspectiveProjectionMatrix * viewMatrix * modelMatrix);
+    multiplyCount += 2;
+
+    // Earth.
+    modelMatrix = vmath::rotate((GLfloat)year, 0.0f, 1.0f, 0.0f);
+    modelMatrix = modelMatrix * vmath::translate(1.5f, 0.0f, 0.0f);
+    modelMatrix = modelMatrix * vmath::rotate(90.0f, 1.0f, 0.0f, 0.0f);
+    modelMatrix = modelMatrix * vmath::rotate((GLfloat)day, 0.0f, 0.0f, 1.0f);
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    glUniform3fv(colorUniform, 1, earthColor);
+    drawSphere(vaoEarth, numberOfEarthElements, perspectiveProjectionMatrix * viewMatrix * modelMatrix);
+    multiplyCount += 5;
+}
+
+void drawSphere(GLuint vao, GLsizei numberOfElements, const vmath::mat4& mvpMatrix)
+{
+    glUniformMatrix4fv(mvpMatrixUniform, 1, GL_FALSE, mvpMatrix);
+
+    stateCache.bindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, numberOfElements, GL_UNSIGNED_SHORT, NULL);
+}
+
+void resize(int width, int height)
+{
+    if(height == 0)
+    {
+        height = 1;
+    }
+
+    glViewport(0, 0, (GLsizei)width, (GLsizei)height);
+    perspectiveProjectionMatrix = vmath::perspective(45.0f, (GLfloat)width / (GLfloat)height, 1.0f, 100.0f);
+}
+
+void cleanUp(void)
+{
+    stateCache.log(logFile);
+
+    if(vaoSun)
+    {
+        glDeleteVertexArrays(1, &vaoSun);
+        vaoSun = 0;
+    }
+
+    if(vboSunPosition)
+    {
+        glDeleteBuffers(1, &vboSunPosition);
+        vboSunPosition = 0;
+    }
+
+    if(vboSunElement)
+    {
+        glDeleteBuffers(1, &vboSunElement);
+        vboSunElement = 0;
+    }
+
+    if(vaoEarth)
+    {
+        glDeleteVertexArrays(1, &vaoEarth);
+        vaoEarth = 0;
+    }
+
+    if(vboEarthPosition)
+    {
+        glDeleteBuffers(1, &vboEarthPosition);
+        vboEarthPosition = 0;
+    }
+
+    if(vboEarthElement)
+    {
+        glDeleteBuffers(1, &vboEarthElement);
+        vboEarthElement = 0;
+    }
+
+    if(shaderProgramObject)
+    {
+        if(vertexShaderObject)
+        {
+            glDetachShader(shaderProgramObject, vertexShaderObject);
+        }
+
+        if(fragmentShaderObject)
+        {
+            glDetachShader(shaderProgramObject, fragmentShaderObject);
+        }
+    }
+
+    if(vertexShaderObject)
+    {
+        glDeleteShader(vertexShaderObject);
+        vertexShaderObject = 0;
+    }
+
+    if(fragmentShaderObject)
+    {
+        glDeleteShader(fragmentShaderObject);
+        fragmentShaderObject = 0;
+    }
+
+    if(shaderProgramObject)
+    {
+        glDeleteProgram(shaderProgramObject);
+        shaderProgramObject = 0;
+    }
+
+    glUseProgram(0);
+}
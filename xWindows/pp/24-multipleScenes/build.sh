@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -I../common -o multipleScenes multipleScenes.cpp -lX11 -lGL -lGLU -lGLEW -lEGL
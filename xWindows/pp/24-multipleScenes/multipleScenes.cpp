@@ -0,0 +1,720 @@
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <math.h>
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include "vmath.h"
+#include "meshRegistry.h"
+#include "stateCache.h"
+#include "streamBuffer.h"
+#include "platform.h"
+
+enum
+{
+    CG_ATTRIBUTE_VERTEX_POSITION = 0,
+    CG_ATTRIBUTE_COLOR,
+    CG_ATTRIBUTE_NORMAL,
+    CG_ATTRIBUTE_TEXTURE0,
+};
+
+#define NUMBER_OF_SCENES 4
+#define MAX_SCENE_OBJECTS 9
+
+// One thing drawn in a scene. The mesh comes from generator(parameters), or when generatorName is
+// NULL from data the scene builds itself, and is placed by
+// rotate(angle * orbitSpeed, y) * translate(position) * rotate(angle * spinSpeed, spinAxis) * scale.
+struct SceneObject
+{
+    const char *generatorName;
+    MeshGenerator generator;
+    GLfloat parameters[3];
+    int numberOfParameters;
+    GLfloat position[3];
+    GLfloat spinAxis[3];
+    GLfloat spinSpeed;
+    GLfloat orbitSpeed;
+    GLfloat scale;
+    GLfloat color[3];
+    const RegisteredMesh *mesh;
+};
+
+// Each scene is written as if it were the only one, and asks for its meshes object by object.
+struct Scene
+{
+    const char *name;
+    int numberOfObjects;
+    SceneObject objects[MAX_SCENE_OBJECTS];
+    bool isLoaded;
+};
+
+#define SPHERE(slices, stacks) "sphere", generateSphereMesh, {1.0f, slices, stacks}, 3
+#define BALL "ball", generateSphereMesh, {1.0f, 20, 20}, 3
+#define CUBE "cube", generateCubeMesh, {1.0f}, 1
+#define PYRAMID "pyramid", generatePyramidMesh, {1.0f}, 1
+#define CUSTOM_CUBE NULL, generateCubeMesh, {1.0f}, 1
+
+Scene scenes[NUMBER_OF_SCENES] = {
+    {
+        "Solar system", 3,
+        {
+            {SPHERE(30, 30), {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 10.0f, 0.0f, 0.75f, {1.0f, 1.0f, 0.0f}, NULL},
+            {SPHERE(20, 20), {1.5f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 60.0f, 40.0f, 0.2f, {0.4f, 0.9f, 1.0f}, NULL},
+            {SPHERE(20, 20), {2.3f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 50.0f, 25.0f, 0.15f, {1.0f, 0.4f, 0.3f}, NULL}
+        },
+        false
+    },
+    {
+        "Pyramid and cube", 2,
+        {
+            {PYRAMID, {-1.3f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 60.0f, 0.0f, 0.8f, {1.0f, 0.5f, 0.0f}, NULL},
+            {CUSTOM_CUBE, {1.3f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, 60.0f, 0.0f, 0.5f, {0.3f, 0.6f, 1.0f}, NULL}
+        },
+        false
+    },
+    {
+        "Molecule", 5,
+        {
+            {SPHERE(10, 10), {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 20.0f, 0.0f, 0.6f, {0.8f, 0.8f, 0.8f}, NULL},
+            {SPHERE(20, 20), {1.2f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.0f, 30.0f, 0.3f, {1.0f, 0.2f, 0.2f}, NULL},
+            {SPHERE(20, 20), {-1.2f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.0f, 30.0f, 0.3f, {1.0f, 0.2f, 0.2f}, NULL},
+            {BALL, {0.0f, 0.0f, 1.2f}, {0.0f, 1.0f, 0.0f}, 0.0f, 30.0f, 0.3f, {0.2f, 0.4f, 1.0f}, NULL},
+            {BALL, {0.0f, 0.0f, -1.2f}, {0.0f, 1.0f, 0.0f}, 0.0f, 30.0f, 0.3f, {0.2f, 0.4f, 1.0f}, NULL}
+        },
+        false
+    },
+    {
+        "Shelf", 9,
+        {
+            {CUBE, {-1.2f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.9f, 0.9f, 0.2f}, NULL},
+            {PYRAMID, {0.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.2f, 0.9f, 0.4f}, NULL},
+            {CUBE, {1.2f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.9f, 0.9f, 0.2f}, NULL},
+            {PYRAMID, {-1.2f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.2f, 0.9f, 0.4f}, NULL},
+            {CUBE, {0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.9f, 0.9f, 0.2f}, NULL},
+            {PYRAMID, {1.2f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.2f, 0.9f, 0.4f}, NULL},
+            {CUBE, {-1.2f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.9f, 0.9f, 0.2f}, NULL},
+            {PYRAMID, {0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.2f, 0.9f, 0.4f}, NULL},
+            {CUBE, {1.2f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 30.0f, 0.0f, 0.35f, {0.9f, 0.9f, 0.2f}, NULL}
+        },
+        false
+    }
+};
+
+GLuint vertexShaderObject = 0;
+GLuint fragmentShaderObject = 0;
+GLuint shaderProgramObject = 0;
+
+// What an object hands the shaders, laid out like the std140 uniform block Object.
+struct ObjectBlock
+{
+    vmath::mat4 mvpMatrix;
+    vmath::mat4 modelViewMatrix;
+    GLfloat color[4];
+};
+
+#define OBJECT_BLOCK_BINDING 0
+
+// The object blocks of every scene, written anew each frame and bound by offset.
+StreamBuffer streamBuffer(NUMBER_OF_SCENES * MAX_SCENE_OBJECTS * 256);
+
+// Without buffer storage there is no stream buffer: the shaders take the matrices and color as
+// plain uniforms, set object by object.
+bool isStreamBufferEnabled = false;
+GLint mvpMatrixUniform = -1;
+GLint modelViewMatrixUniform = -1;
+GLint colorUniform = -1;
+
+// Position and normal meshes, room for 64K vertices and 256K elements in one VAO.
+GeometryPool geometryPool(CG_ATTRIBUTE_VERTEX_POSITION, CG_ATTRIBUTE_NORMAL, CG_ATTRIBUTE_TEXTURE0, 3, 3, 0, 65536, 262144);
+MeshRegistry meshRegistry(CG_ATTRIBUTE_VERTEX_POSITION, CG_ATTRIBUTE_NORMAL, CG_ATTRIBUTE_TEXTURE0, &geometryPool);
+
+// Program and VAO stay bound from frame to frame, each scene just asks for them again.
+StateCache stateCache;
+
+vmath::mat4 perspectiveProjectionMatrix;
+vmath::mat4 viewMatrix;
+
+GLfloat angle = 0.0f;
+
+FILE *logFile = NULL;
+
+Platform platform;
+
+void initialize(void);
+void listExtensions(void);
+void initializeVertexShader(void);
+void initializeFragmentShader(void);
+void initializeShaderProgram(void);
+int countGeneratorKeys(void);
+void loadScene(Scene *scene);
+void unloadScene(Scene *scene);
+void toggleScene(int index);
+void cleanUp(void);
+void keyPress(KeySym keySymbol, char character);
+void display(void);
+void drawScene(const Scene *scene, int x, int y, int width, int height);
+void resize(int width, int height);
+
+int main(int argc, char **argv)
+{
+    logFile = fopen("debug.log", "w");
+    if(logFile == NULL)
+    {
+        fprintf(logFile, "Error: Unable to create log file.");
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(logFile, "---------- CG: OpenGL Debug Logs Start ----------\n");
+    fflush(logFile);
+
+    PlatformOptions options;
+    options.title = "CG - PP - Multiple Scenes";
+    options.logFile = logFile;
+
+    PlatformCallbacks callbacks = {initialize, resize, NULL, display, keyPress, cleanUp};
+    int status = platform.run(argc, argv, options, callbacks);
+
+    fprintf(logFile, "---------- CG: OpenGL Debug Logs End ----------\n");
+    fflush(logFile);
+    fclose(logFile);
+
+    return status;
+}
+
+void keyPress(KeySym, char character)
+{
+    switch(character)
+    {
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+            toggleScene(character - '1');
+        break;
+
+        default:
+        break;
+    }
+}
+
+void initialize(void)
+{
+    listExtensions();
+
+    // The shaders depend on whether there is a stream buffer.
+    isStreamBufferEnabled = streamBuffer.create();
+
+    if(!isStreamBufferEnabled)
+    {
+        streamBuffer.destroy();
+        fprintf(logFile, "No stream buffer, it needs GL 4.4 or GL_ARB_buffer_storage. Setting uniforms object by object.\n");
+        fflush(logFile);
+    }
+
+    // Initialize the shaders and shader program object.
+    initializeVertexShader();
+    initializeFragmentShader();
+    initializeShaderProgram();
+
+    if(!geometryPool.create())
+    {
+        fprintf(logFile, "Error: Unable to create the geometry pool.\n");
+        platform.exit(EXIT_FAILURE);
+    }
+
+    // Every scene asks the registry for its own meshes, like a scene loaded on its own would.
+    for(int scene = 0; scene < NUMBER_OF_SCENES; scene++)
+    {
+        loadScene(&scenes[scene]);
+    }
+
+    // The blue atoms of the molecule ask for a "ball", the 20 x 20 sphere under another name. The
+    // first finds the sphere by content, the second has to find it by the alias without running
+    // the generator, so there is one run per distinct key.
+    if(meshRegistry.numberOfGenerations() != countGeneratorKeys())
+    {
+        fprintf(logFile, "Error: The registry ran %d generators for %d distinct keys.\n", meshRegistry.numberOfGenerations(), countGeneratorKeys());
+    }
+
+    meshRegistry.log(logFile, "All scenes loaded");
+    geometryPool.log(logFile, "Geometry pool");
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClearDepth(1.0f);
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glShadeModel(GL_SMOOTH);
+
+    perspectiveProjectionMatrix = vmath::mat4::identity();
+    viewMatrix = vmath::lookat(vmath::vec3(0.0f, 1.5f, 6.0f), vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
+}
+
+void listExtensions()
+{
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+    fprintf(logFile, "Number of extensions: %d\n", extensionCount);
+    fflush(logFile);
+
+    for(int counter = 0; counter < extensionCount; ++counter)
+    {
+        fprintf(logFile, "%d] Extension name: %s\n", counter + 1, (const char*)glGetStringi(GL_EXTENSIONS, counter));
+        fflush(logFile);
+    }
+}
+
+void initializeVertexShader()
+{
+    vertexShaderObject = glCreateShader(GL_VERTEX_SHADER);
+
+    // Models are only rotated, translated and uniformly scaled, so the model view matrix itself
+    // brings the normals to view space.
+    const GLchar *vertexShaderCode = "#version 450 core" \
+        "\n" \
+        "in vec4 vertexPosition;" \
+        "in vec3 vertexNormal;" \
+        "\n" \
+        "out vec3 viewNormal;" \
+        "\n" \
+        "layout(std140, binding = 0) uniform Object" \
+        "{" \
+        "   mat4 mvpMatrix;" \
+        "   mat4 modelViewMatrix;" \
+        "   vec4 color;" \
+        "};" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   viewNormal = mat3(modelViewMatrix) * vertexNormal;" \
+        "   gl_Position = mvpMatrix * vertexPosition;" \
+        "}";
+
+    const GLchar *objectVertexShaderCode = "#version 450 core" \
+        "\n" \
+        "in vec4 vertexPosition;" \
+        "in vec3 vertexNormal;" \
+        "\n" \
+        "out vec3 viewNormal;" \
+        "\n" \
+        "uniform mat4 mvpMatrix;" \
+        "uniform mat4 modelViewMatrix;" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   viewNormal = mat3(modelViewMatrix) * vertexNormal;" \
+        "   gl_Position = mvpMatrix * vertexPosition;" \
+        "}";
+
+    if(!isStreamBufferEnabled)
+    {
+        vertexShaderCode = objectVertexShaderCode;
+    }
+
+    glShaderSource(vertexShaderObject, 1, (const char**)&vertexShaderCode, NULL);
+    glCompileShader(vertexShaderObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderCompileStatus = 0;
+    char *infoLog = NULL;
+
+    glGetShaderiv(vertexShaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
+
+    if(shaderCompileStatus == GL_FALSE)
+    {
+        glGetShaderiv(vertexShaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetShaderInfoLog(vertexShaderObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Vertex shader compilation log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+void initializeFragmentShader()
+{
+    fragmentShaderObject = glCreateShader(GL_FRAGMENT_SHADER);
+
+    const GLchar *fragmentShaderCode = "#version 450 core" \
+        "\n" \
+        "in vec3 viewNormal;" \
+        "\n" \
+        "out vec4 fragmentColor;" \
+        "\n" \
+        "layout(std140, binding = 0) uniform Object" \
+        "{" \
+        "   mat4 mvpMatrix;" \
+        "   mat4 modelViewMatrix;" \
+        "   vec4 color;" \
+        "};" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   float diffuse = max(dot(normalize(viewNormal), normalize(vec3(0.5, 0.8, 1.0))), 0.0);" \
+        "   fragmentColor = vec4(color.rgb * (0.25 + 0.75 * diffuse), 1.0);" \
+        "}";
+
+    const GLchar *objectFragmentShaderCode = "#version 450 core" \
+        "\n" \
+        "in vec3 viewNormal;" \
+        "\n" \
+        "out vec4 fragmentColor;" \
+        "\n" \
+        "uniform vec3 color;" \
+        "\n" \
+        "void main(void)" \
+        "{" \
+        "   float diffuse = max(dot(normalize(viewNormal), normalize(vec3(0.5, 0.8, 1.0))), 0.0);" \
+        "   fragmentColor = vec4(color * (0.25 + 0.75 * diffuse), 1.0);" \
+        "}";
+
+    if(!isStreamBufferEnabled)
+    {
+        fragmentShaderCode = objectFragmentShaderCode;
+    }
+
+    glShaderSource(fragmentShaderObject, 1, (const char**)&fragmentShaderCode, NULL);
+    glCompileShader(fragmentShaderObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderCompileStatus = 0;
+    char *infoLog = NULL;
+
+    glGetShaderiv(fragmentShaderObject, GL_COMPILE_STATUS, &shaderCompileStatus);
+
+    if(shaderCompileStatus == GL_FALSE)
+    {
+        glGetShaderiv(fragmentShaderObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetShaderInfoLog(fragmentShaderObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Fragment shader compilation log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+void initializeShaderProgram()
+{
+    shaderProgramObject = glCreateProgram();
+    glAttachShader(shaderProgramObject, vertexShaderObject);
+    glAttachShader(shaderProgramObject, fragmentShaderObject);
+
+    // Bind the attribute locations the registry's VAOs use before linking.
+    glBindAttribLocation(shaderProgramObject, CG_ATTRIBUTE_VERTEX_POSITION, "vertexPosition");
+    glBindAttribLocation(shaderProgramObject, CG_ATTRIBUTE_NORMAL, "vertexNormal");
+
+    // Now link and check for error.
+    glLinkProgram(shaderProgramObject);
+
+    GLint infoLogLength = 0;
+    GLint shaderProgramLinkStatus = 0;
+    char *infoLog = NULL;
+
+    glGetProgramiv(shaderProgramObject, GL_LINK_STATUS, &shaderProgramLinkStatus);
+
+    if(shaderProgramLinkStatus == GL_FALSE)
+    {
+        glGetProgramiv(shaderProgramObject, GL_INFO_LOG_LENGTH, &infoLogLength);
+
+        if(infoLogLength > 0)
+        {
+            infoLog = (char *)malloc(infoLogLength);
+
+            if(infoLog != NULL)
+            {
+                GLsizei written = 0;
+                glGetProgramInfoLog(shaderProgramObject, infoLogLength, &written, infoLog);
+                fprintf(logFile, "CG: Shader program link log: %s\n", infoLog);
+                free(infoLog);
+                platform.exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    // After linking get the uniform locations the objects set without a stream buffer.
+    if(!isStreamBufferEnabled)
+    {
+        mvpMatrixUniform = glGetUniformLocation(shaderProgramObject, "mvpMatrix");
+        modelViewMatrixUniform = glGetUniformLocation(shaderProgramObject, "modelViewMatrix");
+        colorUniform = glGetUniformLocation(shaderProgramObject, "color");
+    }
+}
+
+// Generator names and parameters that differ from every object before, over all scenes.
+int countGeneratorKeys(void)
+{
+    int count = 0;
+
+    for(int n = 0; n < NUMBER_OF_SCENES * MAX_SCENE_OBJECTS; n++)
+    {
+        const SceneObject *object = &scenes[n / MAX_SCENE_OBJECTS].objects[n % MAX_SCENE_OBJECTS];
+        bool isNew = n % MAX_SCENE_OBJECTS < scenes[n / MAX_SCENE_OBJECTS].numberOfObjects && object->generatorName != NULL;
+
+        for(int k = 0; k < n && isNew; k++)
+        {
+            const SceneObject *before = &scenes[k / MAX_SCENE_OBJECTS].objects[k % MAX_SCENE_OBJECTS];
+
+            isNew = before->generatorName == NULL || strcmp(before->generatorName, object->generatorName) != 0 ||
+                memcmp(before->parameters, object->parameters, sizeof(GLfloat) * object->numberOfParameters) != 0;
+        }
+
+        count += isNew ? 1 : 0;
+    }
+
+    return count;
+}
+
+void loadScene(Scene *scene)
+{
+    for(int n = 0; n < scene->numberOfObjects; n++)
+    {
+        SceneObject *object = &scene->objects[n];
+
+        if(object->generatorName != NULL)
+        {
+            object->mesh = meshRegistry.acquire(object->generatorName, object->generator, object->parameters, object->numberOfParameters);
+        }
+        else
+        {
+            // Data built by the scene itself is matched by content, here the same cube as the
+            // generated one.
+            MeshData mesh;
+
+            if(object->generator(object->parameters, object->numberOfParameters, &mesh))
+            {
+                object->mesh = meshRegistry.acquire(mesh);
+            }
+        }
+
+        if(object->mesh == NULL)
+        {
+            fprintf(logFile, "Error: Unable to create mesh %d of scene %s.\n", n, scene->name);
+            platform.exit(EXIT_FAILURE);
+        }
+    }
+
+    scene->isLoaded = true;
+}
+
+void unloadScene(Scene *scene)
+{
+    for(int n = 0; n < scene->numberOfObjects; n++)
+    {
+        meshRegistry.release(scene->objects[n].mesh);
+        scene->objects[n].mesh = NULL;
+    }
+
+    scene->isLoaded = false;
+}
+
+void toggleScene(int index)
+{
+    char title[64];
+
+    if(scenes[index].isLoaded)
+    {
+        unloadScene(&scenes[index]);
+        snprintf(title, sizeof(title), "Unloaded %s", scenes[index].name);
+    }
+    else
+    {
+        loadScene(&scenes[index]);
+        snprintf(title, sizeof(title), "Loaded %s", scenes[index].name);
+    }
+
+    meshRegistry.log(logFile, title);
+    geometryPool.log(logFile, "Geometry pool");
+
+    // Loading binds the VAO and buffers of new meshes, unloading deletes them.
+    stateCache.invalidate();
+}
+
+void display(void)
+{
+    int windowWidth = platform.getWidth();
+    int windowHeight = platform.getHeight();
+    int halfWidth = windowWidth / 2;
+    int halfHeight = windowHeight / 2;
+
+    // Close the holes unloaded scenes leave, a little every frame.
+    if(geometryPool.defragment(64 * 1024) > 0)
+    {
+        geometryPool.log(logFile, "Geometry pool defragmented");
+    }
+
+    if(isStreamBufferEnabled)
+    {
+        streamBuffer.beginFrame();
+    }
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+    stateCache.useProgram(shaderProgramObject);
+
+    // Scenes in the quadrants, first one top left.
+    drawScene(&scenes[0], 0, halfHeight, halfWidth, windowHeight - halfHeight);
+    drawScene(&scenes[1], halfWidth, halfHeight, windowWidth - halfWidth, windowHeight - halfHeight);
+    drawScene(&scenes[2], 0, 0, halfWidth, halfHeight);
+    drawScene(&scenes[3], halfWidth, 0, windowWidth - halfWidth, halfHeight);
+
+    if(isStreamBufferEnabled)
+    {
+        streamBuffer.endFrame();
+    }
+
+    stateCache.endFrame();
+
+    angle += 0.5f;
+
+    if(angle >= 720.0f)
+    {
+        angle -= 720.0f;
+    }
+}
+
+void drawScene(const Scene *scene, int x, int y, int width, int height)
+{
+    if(!scene->isLoaded || width <= 0 || height <= 0)
+    {
+        return;
+    }
+
+    glViewport(x, y, (GLsizei)width, (GLsizei)height);
+    vmath::mat4 viewProjectionMatrix = perspectiveProjectionMatrix * viewMatrix;
+
+    // The blocks of all objects of the scene in one allocation, each at an offset the uniform
+    // buffer bindings accept.
+    GLintptr blockSize = 0;
+    GLintptr offset = 0;
+    unsigned char *blocks = NULL;
+
+    if(isStreamBufferEnabled)
+    {
+        blockSize = streamBuffer.getUniformAlignment();
+        blockSize = (sizeof(ObjectBlock) + blockSize - 1) / blockSize * blockSize;
+        blocks = (unsigned char *)streamBuffer.allocate(scene->numberOfObjects * blockSize, streamBuffer.getUniformAlignment(), &offset);
+
+        if(blocks == NULL)
+        {
+            return;
+        }
+    }
+
+    for(int n = 0; n < scene->numberOfObjects; n++)
+    {
+        const SceneObject *object = &scene->objects[n];
+        vmath::mat4 modelMatrix = vmath::rotate(angle * object->orbitSpeed / 60.0f, 0.0f, 1.0f, 0.0f) *
+            vmath::translate(object->position[0], object->position[1], object->position[2]) *
+            vmath::rotate(angle * object->spinSpeed / 60.0f, object->spinAxis[0], object->spinAxis[1], object->spinAxis[2]) *
+            vmath::scale(object->scale);
+
+        // Spheres from the registry have their poles on the z axis like gluSphere().
+        if(object->generator == generateSphereMesh)
+        {
+            modelMatrix = modelMatrix * vmath::rotate(90.0f, 1.0f, 0.0f, 0.0f);
+        }
+
+        if(isStreamBufferEnabled)
+        {
+            ObjectBlock *block = (ObjectBlock *)(blocks + n * blockSize);
+            block->mvpMatrix = viewProjectionMatrix * modelMatrix;
+            block->modelViewMatrix = viewMatrix * modelMatrix;
+            memcpy(block->color, object->color, sizeof(object->color));
+            block->color[3] = 1.0f;
+
+            // Not through stateCache, which never binds uniform buffers here.
+            glBindBufferRange(GL_UNIFORM_BUFFER, OBJECT_BLOCK_BINDING, streamBuffer.getBuffer(), offset + n * blockSize, sizeof(ObjectBlock));
+        }
+        else
+        {
+            glUniformMatrix4fv(mvpMatrixUniform, 1, GL_FALSE, viewProjectionMatrix * modelMatrix);
+            glUniformMatrix4fv(modelViewMatrixUniform, 1, GL_FALSE, viewMatrix * modelMatrix);
+            glUniform3fv(colorUniform, 1, object->color);
+        }
+
+        // Pooled meshes all share the pool's VAO, so only the first bind of a run reaches GL.
+        stateCache.bindVertexArray(object->mesh->vao);
+
+        if(object->mesh->poolMesh != GeometryPool::INVALID)
+        {
+            geometryPool.draw(object->mesh->poolMesh);
+        }
+        else
+        {
+            glDrawElements(GL_TRIANGLES, object->mesh->numberOfElements, object->mesh->elementType, NULL);
+        }
+    }
+}
+
+void resize(int width, int height)
+{
+    // Every scene gets a quarter of the window.
+    width = width / 2 > 0 ? width / 2 : 1;
+    height = height / 2 > 0 ? height / 2 : 1;
+
+    perspectiveProjectionMatrix = vmath::perspective(45.0f, (GLfloat)width / (GLfloat)height, 1.0f, 100.0f);
+}
+
+void cleanUp(void)
+{
+    stateCache.log(logFile);
+    streamBuffer.log(logFile, "Stream buffer");
+    streamBuffer.destroy();
+
+    // The registry and the pool delete their buffers while the context is still current.
+    meshRegistry.clear();
+    geometryPool.destroy();
+
+    if(shaderProgramObject)
+    {
+        if(vertexShaderObject)
+        {
+            glDetachShader(shaderProgramObject, vertexShaderObject);
+        }
+
+        if(fragmentShaderObject)
+        {
+            glDetachShader(shaderProgramObject, fragmentShaderObject);
+        }
+    }
+
+    if(vertexShaderObject)
+    {
+        glDeleteShader(vertexShaderObject);
+        vertexShaderObject = 0;
+    }
+
+    if(fragmentShaderObject)
+    {
+        glDeleteShader(fragmentShaderObject);
+        fragmentShaderObject = 0;
+    }
+
+    if(shaderProgramObject)
+    {
+        glDeleteProgram(shaderProgramObject);
+        shaderProgramObject = 0;
+    }
+
+    glUseProgram(0);
+}
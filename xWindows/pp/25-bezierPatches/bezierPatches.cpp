@@ -0,0 +1,951 @@
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <memory.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+#include "vmath.h"
+#include "bezierTessellator.h"
+#include "programBatch.h"
+#include "streamBuffer.h"
+#include "platform.h"
+
+enum
+{
+    CG_ATTRIBUTE_VERTEX_POSITION = 0,
+    CG_ATTRIBUTE_COLOR,
+    CG_ATTRIBUTE_NORMAL,
+    CG_ATTRIBUTE_TEXTURE0,
+};
+
+// A GRID_SIZE x GRID_SIZE grid of bicubic patches making up a rolling terrain GRID_SIZE units wide.
+#define GRID_SIZE 16
+
+// Triangle counts and timings are averaged over FRAMES_PER_LOG frames and written to debug.log.
+#define FRAMES_PER_LOG 100
+
+// Programs come from programBatch and stay 0 until they are linked.
+GLuint shaderProgramObject = 0;
+GLuint shaderProgramObjectFlat = 0;
+GLuint shaderProgramObjectTessellation = 0;
+
+GLuint mvpMatrixUniform = 0;
+GLuint modelViewMatrixUniform = 0;
+GLuint colorUniform = 0;
+
+GLuint mvpMatrixUniformFlat = 0;
+GLuint colorUniformFlat = 0;
+
+GLuint mvpMatrixUniformTessellation = 0;
+GLuint modelViewMatrixUniformTessellation = 0;
+GLuint colorUniformTessellation = 0;
+GLuint viewportSizeUniformTessellation = 0;
+GLuint toleranceUniformTessellation = 0;
+
+// Triangles from the CPU tessellator, read from streamBuffer at the offset of the frame.
+GLuint vaoSurface = 0;
+
+// Patch boundaries as line strips from the CPU tessellator, from streamBuffer as well.
+GLuint vaoBoundaries = 0;
+
+// Vertex buffer binding points of the two VAOs above.
+#define SURFACE_BINDING 0
+#define BOUNDARY_BINDING 0
+
+// What the CPU tessellator makes each frame, just under 1 MB at the finest tolerance in the
+// default window, grown when a frame needs more.
+StreamBuffer streamBuffer(1024 * 1024);
+
+// Without buffer storage or vertex attrib bindings there is no stream buffer: the VAOs above read
+// these plain buffers, specified anew with glBufferData() every frame.
+bool isStreamBufferEnabled = false;
+GLuint vboSurface = 0;
+GLuint vboSurfaceElement = 0;
+GLuint vboBoundaries = 0;
+
+// The control points themselves, 16 per patch, for the tessellation shaders.
+GLuint vaoPatches = 0;
+GLuint vboPatches = 0;
+
+GLuint primitivesQuery = 0;
+
+// Attribute locations bound before linking, part of the program cache keys as well.
+const ProgramAttribute surfaceAttributes[] = {{CG_ATTRIBUTE_VERTEX_POSITION, "vertexPosition"}, {CG_ATTRIBUTE_NORMAL, "vertexNormal"}};
+const ProgramAttribute patchAttributes[] = {{CG_ATTRIBUTE_VERTEX_POSITION, "vertexPosition"}};
+
+ProgramCache programCache;
+ProgramBatch programBatch(&programCache);
+
+int surfaceProgram = -1;
+int flatProgram = -1;
+int tessellationProgram = -1;
+bool areProgramsDone = false;
+
+// Unlit, for the surface and the boundaries until the lit program is linked.
+const GLchar *vertexShaderCodeFlat = "#version 450 core" \
+    "\n" \
+    "in vec4 vertexPosition;" \
+    "\n" \
+    "uniform mat4 mvpMatrix;" \
+    "\n" \
+    "void main(void)" \
+    "{" \
+    "   gl_Position = mvpMatrix * vertexPosition;" \
+    "}";
+
+const GLchar *fragmentShaderCodeFlat = "#version 450 core" \
+    "\n" \
+    "out vec4 fragmentColor;" \
+    "\n" \
+    "uniform vec3 color;" \
+    "\n" \
+    "void main(void)" \
+    "{" \
+    "   fragmentColor = vec4(color, 1.0);" \
+    "}";
+
+// The surface is not transformed, so the model view matrix itself brings the normals to view
+// space.
+const GLchar *vertexShaderCode = "#version 450 core" \
+    "\n" \
+    "in vec4 vertexPosition;" \
+    "in vec3 vertexNormal;" \
+    "\n" \
+    "out vec3 viewNormal;" \
+    "\n" \
+    "uniform mat4 mvpMatrix;" \
+    "uniform mat4 modelViewMatrix;" \
+    "\n" \
+    "void main(void)" \
+    "{" \
+    "   viewNormal = mat3(modelViewMatrix) * vertexNormal;" \
+    "   gl_Position = mvpMatrix * vertexPosition;" \
+    "}";
+
+// Shared by both programs, so both paths shade the same way.
+const GLchar *fragmentShaderCode = "#version 450 core" \
+    "\n" \
+    "in vec3 viewNormal;" \
+    "\n" \
+    "out vec4 fragmentColor;" \
+    "\n" \
+    "uniform vec3 color;" \
+    "\n" \
+    "void main(void)" \
+    "{" \
+    "   float diffuse = max(dot(normalize(viewNormal), normalize(vec3(0.5, 0.8, 1.0))), 0.0);" \
+    "   fragmentColor = vec4(color * (0.25 + 0.75 * diffuse), 1.0);" \
+    "}";
+
+const GLchar *vertexShaderCodeTessellation = "#version 450 core" \
+    "\n" \
+    "in vec4 vertexPosition;" \
+    "\n" \
+    "void main(void)" \
+    "{" \
+    "   gl_Position = vertexPosition;" \
+    "}";
+
+// The same levels BezierTessellator picks: power of two levels from the largest second
+// difference of the control points in pixels, each edge from its own four points.
+const GLchar *tessellationControlShaderCode = "#version 450 core" \
+    "\n" \
+    "layout(vertices = 16) out;" \
+    "\n" \
+    "uniform mat4 mvpMatrix;" \
+    "uniform vec2 viewportSize;" \
+    "uniform float tolerance;" \
+    "\n" \
+    "vec2 screen[16];" \
+    "\n" \
+    "float secondDifference(int p0, int p1, int p2, int p3)" \
+    "{" \
+    "   return max(length(screen[p0] - 2.0 * screen[p1] + screen[p2]), length(screen[p1] - 2.0 * screen[p2] + screen[p3]));" \
+    "}" \
+    "\n" \
+    "float level(float difference)" \
+    "{" \
+    "   float segments = clamp(ceil(sqrt(0.75 * difference / tolerance)), 1.0, 64.0);" \
+    "   return exp2(ceil(log2(segments)));" \
+    "}" \
+    "\n" \
+    "void main(void)" \
+    "{" \
+    "   gl_out[gl_InvocationID].gl_Position = gl_in[gl_InvocationID].gl_Position;" \
+    "\n" \
+    "   if(gl_InvocationID == 0)" \
+    "   {" \
+    "       bool isVisible = true;" \
+    "\n" \
+    "       for(int n = 0; n < 16; n++)" \
+    "       {" \
+    "           vec4 clip = mvpMatrix * gl_in[n].gl_Position;" \
+    "           isVisible = isVisible && clip.w > 1.0e-4;" \
+    "           screen[n] = clip.xy / max(clip.w, 1.0e-4) * 0.5 * viewportSize;" \
+    "       }" \
+    "\n" \
+    "       float alongU[4];" \
+    "       float alongV[4];" \
+    "\n" \
+    "       for(int n = 0; n < 4; n++)" \
+    "       {" \
+    "           alongU[n] = isVisible ? secondDifference(n * 4, n * 4 + 1, n * 4 + 2, n * 4 + 3) : 1.0e30;" \
+    "           alongV[n] = isVisible ? secondDifference(n, n + 4, n + 8, n + 12) : 1.0e30;" \
+    "       }" \
+    "\n" \
+    "       gl_TessLevelOuter[0] = level(alongV[0]);" \
+    "       gl_TessLevelOuter[1] = level(alongU[0]);" \
+    "       gl_TessLevelOuter[2] = level(alongV[3]);" \
+    "       gl_TessLevelOuter[3] = level(alongU[3]);" \
+    "       gl_TessLevelInner[0] = level(max(max(alongU[0], alongU[1]), max(alongU[2], alongU[3])));" \
+    "       gl_TessLevelInner[1] = level(max(max(alongV[0], alongV[1]), max(alongV[2], alongV[3])));" \
+    "   }" \
+    "}";
+
+const GLchar *tessellationEvaluationShaderCode = "#version 450 core" \
+    "\n" \
+    "layout(quads, equal_spacing, ccw) in;" \
+    "\n" \
+    "out vec3 viewNormal;" \
+    "\n" \
+    "uniform mat4 mvpMatrix;" \
+    "uniform mat4 modelViewMatrix;" \
+    "\n" \
+    "/* Bernstein polynomials at t and their derivatives */" \
+    "void bernstein(float t, out vec4 b, out vec4 d)" \
+    "{" \
+    "   float s = 1.0 - t;" \
+    "   b = vec4(s * s * s, 3.0 * s * s * t, 3.0 * s * t * t, t * t * t);" \
+    "   d = vec4(-3.0 * s * s, 3.0 * s * s - 6.0 * s * t, 6.0 * s * t - 3.0 * t * t, 3.0 * t * t);" \
+    "}" \
+    "\n" \
+    "void main(void)" \
+    "{" \
+    "   vec4 bu, du, bv, dv;" \
+    "   bernstein(gl_TessCoord.x, bu, du);" \
+    "   bernstein(gl_TessCoord.y, bv, dv);" \
+    "\n" \
+    "   vec3 position = vec3(0.0);" \
+    "   vec3 tangentU = vec3(0.0);" \
+    "   vec3 tangentV = vec3(0.0);" \
+    "\n" \
+    "   for(int row = 0; row < 4; row++)" \
+    "   {" \
+    "       for(int column = 0; column < 4; column++)" \
+    "       {" \
+    "           vec3 point = gl_in[row * 4 + column].gl_Position.xyz;" \
+    "           position += bv[row] * bu[column] * point;" \
+    "           tangentU += bv[row] * du[column] * point;" \
+    "           tangentV += dv[row] * bu[column] * point;" \
+    "       }" \
+    "   }" \
+    "\n" \
+    "   viewNormal = mat3(modelViewMatrix) * cross(tangentU, tangentV);" \
+    "   gl_Position = mvpMatrix * vec4(position, 1.0);" \
+    "}";
+
+std::vector<BezierPatch> patches;
+std::vector<BezierCurve> boundaries;
+std::vector<GLfloat> surfaceVertices;
+std::vector<GLuint> surfaceElements;
+std::vector<GLfloat> boundaryVertices;
+std::vector<GLint> boundaryFirsts;
+std::vector<GLsizei> boundaryCounts;
+
+BezierTessellator tessellator;
+
+bool isTessellationShaderUsed = false;
+bool isWireframe = false;
+bool areBoundariesShown = true;
+GLfloat tolerance = 0.5f;
+
+vmath::mat4 perspectiveProjectionMatrix;
+
+GLfloat angle = 0.0f;
+
+int framesSinceLog = 0;
+double tessellationSeconds = 0.0;
+long long streamedBytes = 0;
+double lastFrameTime = 0.0;
+double frameSeconds = 0.0;
+
+FILE *logFile = NULL;
+
+Platform platform;
+
+void initialize(void);
+void listExtensions(void);
+void initializePrograms(void);
+void pollPrograms(void);
+void initializeUniforms(void);
+void initializeUniformsTessellation(void);
+void initializePatches(void);
+void initializeBuffers(void);
+float terrainHeight(float x, float z);
+double now(void);
+void cleanUp(void);
+void keyPress(KeySym keySymbol, char character);
+void display(void);
+void useSurfaceProgram(const vmath::mat4& mvpMatrix, const vmath::mat4& modelViewMatrix, GLfloat red, GLfloat green, GLfloat blue);
+void drawWithTessellator(const vmath::mat4& mvpMatrix, const vmath::mat4& modelViewMatrix);
+void drawWithTessellationShader(const vmath::mat4& mvpMatrix, const vmath::mat4& modelViewMatrix);
+void drawBoundaries(const vmath::mat4& mvpMatrix, const vmath::mat4& modelViewMatrix);
+void logFrameStatistics(void);
+void resize(int width, int height);
+
+int main(int argc, char **argv)
+{
+    logFile = fopen("debug.log", "w");
+    if(logFile == NULL)
+    {
+        fprintf(logFile, "Error: Unable to create log file.");
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(logFile, "---------- CG: OpenGL Debug Logs Start ----------\n");
+    fflush(logFile);
+
+    PlatformOptions options;
+    options.title = "CG - PP - Bezier Patches";
+    options.logFile = logFile;
+
+    PlatformCallbacks callbacks = {initialize, resize, NULL, display, keyPress, cleanUp};
+    int status = platform.run(argc, argv, options, callbacks);
+
+    fprintf(logFile, "---------- CG: OpenGL Debug Logs End ----------\n");
+    fflush(logFile);
+    fclose(logFile);
+
+    return status;
+}
+
+void keyPress(KeySym keySymbol, char character)
+{
+    switch(keySymbol)
+    {
+        case XK_Up:
+            tolerance = tolerance > 0.125f ? tolerance * 0.5f : tolerance;
+            framesSinceLog = 0;
+        break;
+
+        case XK_Down:
+            tolerance = tolerance < 8.0f ? tolerance * 2.0f : tolerance;
+            framesSinceLog = 0;
+        break;
+
+        default:
+        break;
+    }
+
+    switch(character)
+    {
+        case 'T':
+        case 't':
+            // Without tessellation shaders the CPU tessellator is all there is.
+            isTessellationShaderUsed = !isTessellationShaderUsed && tessellationProgram >= 0 && programBatch.getStatus(tessellationProgram) != PROGRAM_FAILED;
+            framesSinceLog = 0;
+        break;
+
+        case 'W':
+        case 'w':
+            isWireframe = !isWireframe;
+        break;
+
+        case 'B':
+        case 'b':
+            areBoundariesShown = !areBoundariesShown;
+        break;
+
+        default:
+        break;
+    }
+}
+
+void initialize(void)
+{
+    listExtensions();
+
+    initializePrograms();
+
+    initializePatches();
+    initializeBuffers();
+
+    glGenQueries(1, &primitivesQuery);
+
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClearDepth(1.0f);
+
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glShadeModel(GL_SMOOTH);
+
+    // Keeps the surface behind the boundary lines drawn on top of it.
+    glPolygonOffset(1.0f, 1.0f);
+
+    perspectiveProjectionMatrix = vmath::mat4::identity();
+
+    fprintf(logFile, "CPU tessellator with %d threads.\n", tessellator.threadCount());
+}
+
+void listExtensions()
+{
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+
+    fprintf(logFile, "Number of extensions: %d\n", extensionCount);
+    fflush(logFile);
+
+    for(int counter = 0; counter < extensionCount; ++counter)
+    {
+        fprintf(logFile, "%d] Extension name: %s\n", counter + 1, (const char*)glGetStringi(GL_EXTENSIONS, counter));
+        fflush(logFile);
+    }
+}
+
+// All programs are submitted together and only the flat one is waited for, the others are picked
+// up by pollPrograms() as they are linked.
+void initializePrograms(void)
+{
+    const ProgramStage flatStages[] = {{GL_VERTEX_SHADER, vertexShaderCodeFlat}, {GL_FRAGMENT_SHADER, fragmentShaderCodeFlat}};
+    const ProgramStage surfaceStages[] = {{GL_VERTEX_SHADER, vertexShaderCode}, {GL_FRAGMENT_SHADER, fragmentShaderCode}};
+    const ProgramStage tessellationStages[] = {{GL_VERTEX_SHADER, vertexShaderCodeTessellation}, {GL_TESS_CONTROL_SHADER, tessellationControlShaderCode}, {GL_TESS_EVALUATION_SHADER, tessellationEvaluationShaderCode}, {GL_FRAGMENT_SHADER, fragmentShaderCode}};
+
+    flatProgram = programBatch.add("Flat program", flatStages, 2, patchAttributes, sizeof(patchAttributes) / sizeof(patchAttributes[0]));
+    surfaceProgram = programBatch.add("Surface program", surfaceStages, 2, surfaceAttributes, sizeof(surfaceAttributes) / sizeof(surfaceAttributes[0]));
+
+    // The tessellation shaders only where they exist.
+    if(GLEW_VERSION_4_0 || GLEW_ARB_tessellation_shader)
+    {
+        tessellationProgram = programBatch.add("Tessellation program", tessellationStages, 4, patchAttributes, sizeof(patchAttributes) / sizeof(patchAttributes[0]));
+    }
+    else
+    {
+        fprintf(logFile, "Tessellation shaders are not available, only the CPU tessellator is used.\n");
+    }
+
+    programBatch.submit(logFile);
+
+    if(programBatch.wait(flatProgram) != PROGRAM_READY)
+    {
+        platform.exit(EXIT_FAILURE);
+    }
+
+    shaderProgramObjectFlat = programBatch.getProgram(flatProgram);
+    mvpMatrixUniformFlat = glGetUniformLocation(shaderProgramObjectFlat, "mvpMatrix");
+    colorUniformFlat = glGetUniformLocation(shaderProgramObjectFlat, "color");
+
+    pollPrograms();
+}
+
+// Takes the programs the batch has finished since the last frame, never waits for the driver.
+void pollPrograms(void)
+{
+    if(areProgramsDone)
+    {
+        return;
+    }
+
+    areProgramsDone = programBatch.poll();
+
+    if(programBatch.getStatus(surfaceProgram) == PROGRAM_FAILED)
+    {
+        platform.exit(EXIT_FAILURE);
+    }
+
+    if(shaderProgramObject == 0 && programBatch.getStatus(surfaceProgram) == PROGRAM_READY)
+    {
+        shaderProgramObject = programBatch.getProgram(surfaceProgram);
+        initializeUniforms();
+    }
+
+    if(tessellationProgram >= 0 && shaderProgramObjectTessellation == 0 && programBatch.getStatus(tessellationProgram) == PROGRAM_READY)
+    {
+        shaderProgramObjectTessellation = programBatch.getProgram(tessellationProgram);
+        initializeUniformsTessellation();
+    }
+
+    // Without tessellation shaders that link the CPU tessellator takes over for good.
+    if(tessellationProgram >= 0 && programBatch.getStatus(tessellationProgram) == PROGRAM_FAILED)
+    {
+        isTessellationShaderUsed = false;
+    }
+
+    if(areProgramsDone)
+    {
+        programBatch.log(logFile, "Programs");
+        programCache.log(logFile, "Program cache");
+    }
+}
+
+void initializeUniforms()
+{
+    // After linking get the value of mvpMatrix, modelViewMatrix and color uniform location from the shader program.
+    mvpMatrixUniform = glGetUniformLocation(shaderProgramObject, "mvpMatrix");
+    modelViewMatrixUniform = glGetUniformLocation(shaderProgramObject, "modelViewMatrix");
+    colorUniform = glGetUniformLocation(shaderProgramObject, "color");
+}
+
+void initializeUniformsTessellation()
+{
+    mvpMatrixUniformTessellation = glGetUniformLocation(shaderProgramObjectTessellation, "mvpMatrix");
+    modelViewMatrixUniformTessellation = glGetUniformLocation(shaderProgramObjectTessellation, "modelViewMatrix");
+    colorUniformTessellation = glGetUniformLocation(shaderProgramObjectTessellation, "color");
+    viewportSizeUniformTessellation = glGetUniformLocation(shaderProgramObjectTessellation, "viewportSize");
+    toleranceUniformTessellation = glGetUniformLocation(shaderProgramObjectTessellation, "tolerance");
+}
+
+float terrainHeight(float x, float z)
+{
+    return 0.8f * sinf(0.9f * x) * cosf(0.7f * z) + 0.3f * sinf(2.3f * x + 1.7f * z);
+}
+
+void initializePatches(void)
+{
+    // One control net for the whole terrain, so neighbouring patches share their edge points. u
+    // goes along +x and v along -z, which makes dS/du x dS/dv point up.
+    const int netSize = GRID_SIZE * 3 + 1;
+    std::vector<GLfloat> net(netSize * netSize * 3);
+
+    for(int row = 0; row < netSize; row++)
+    {
+        for(int column = 0; column < netSize; column++)
+        {
+            GLfloat *point = &net[(row * netSize + column) * 3];
+
+            point[0] = (GLfloat)column / 3.0f - GRID_SIZE * 0.5f;
+            point[2] = GRID_SIZE * 0.5f - (GLfloat)row / 3.0f;
+            point[1] = terrainHeight(point[0], point[2]);
+        }
+    }
+
+    for(int patchRow = 0; patchRow < GRID_SIZE; patchRow++)
+    {
+        for(int patchColumn = 0; patchColumn < GRID_SIZE; patchColumn++)
+        {
+            BezierPatch patch;
+
+            for(int row = 0; row < 4; row++)
+            {
+                for(int column = 0; column < 4; column++)
+                {
+                    memcpy(patch.points[row][column], &net[((patchRow * 3 + row) * netSize + patchColumn * 3 + column) * 3], 3 * sizeof(GLfloat));
+                }
+            }
+
+            patches.push_back(patch);
+        }
+    }
+
+    // Every patch edge once, along the rows of the net and then along its columns.
+    for(int line = 0; line <= GRID_SIZE; line++)
+    {
+        for(int span = 0; span < GRID_SIZE; span++)
+        {
+            BezierCurve alongRow;
+            BezierCurve alongColumn;
+
+            for(int point = 0; point < 4; point++)
+            {
+                memcpy(alongRow.points[point], &net[(line * 3 * netSize + span * 3 + point) * 3], 3 * sizeof(GLfloat));
+                memcpy(alongColumn.points[point], &net[((span * 3 + point) * netSize + line * 3) * 3], 3 * sizeof(GLfloat));
+            }
+
+            boundaries.push_back(alongRow);
+            boundaries.push_back(alongColumn);
+        }
+    }
+}
+
+void initializeBuffers(void)
+{
+    // The VAOs bind the stream buffer by offset, which needs glBindVertexBuffer().
+    isStreamBufferEnabled = (GLEW_VERSION_4_3 || GLEW_ARB_vertex_attrib_binding) && streamBuffer.create();
+
+    if(!isStreamBufferEnabled)
+    {
+        streamBuffer.destroy();
+        fprintf(logFile, "No stream buffer, it needs GL 4.4 or GL_ARB_buffer_storage and GL 4.3 or GL_ARB_vertex_attrib_binding. Specifying the buffers every frame.\n");
+        fflush(logFile);
+    }
+
+    // Surface from the CPU tessellator, position and normal interleaved. With a stream buffer only
+    // the format is set here, the buffer and offset are bound every frame.
+    glGenVertexArrays(1, &vaoSurface);
+    glBindVertexArray(vaoSurface);
+
+    if(isStreamBufferEnabled)
+    {
+        glVertexAttribFormat(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0);
+        glVertexAttribBinding(CG_ATTRIBUTE_VERTEX_POSITION, SURFACE_BINDING);
+        glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
+        glVertexAttribFormat(CG_ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat));
+        glVertexAttribBinding(CG_ATTRIBUTE_NORMAL, SURFACE_BINDING);
+        glEnableVertexAttribArray(CG_ATTRIBUTE_NORMAL);
+    }
+    else
+    {
+        glGenBuffers(1, &vboSurface);
+        glBindBuffer(GL_ARRAY_BUFFER, vboSurface);
+
+        glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, BezierTessellator::FLOATS_PER_VERTEX * sizeof(GLfloat), NULL);
+        glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
+        glVertexAttribPointer(CG_ATTRIBUTE_NORMAL, 3, GL_FLOAT, GL_FALSE, BezierTessellator::FLOATS_PER_VERTEX * sizeof(GLfloat), (void *)(3 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(CG_ATTRIBUTE_NORMAL);
+
+        glGenBuffers(1, &vboSurfaceElement);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboSurfaceElement);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    // Boundary lines, with one normal facing the light for all of them.
+    glGenVertexArrays(1, &vaoBoundaries);
+    glBindVertexArray(vaoBoundaries);
+
+    if(isStreamBufferEnabled)
+    {
+        glVertexAttribFormat(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0);
+        glVertexAttribBinding(CG_ATTRIBUTE_VERTEX_POSITION, BOUNDARY_BINDING);
+        glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
+    }
+    else
+    {
+        glGenBuffers(1, &vboBoundaries);
+        glBindBuffer(GL_ARRAY_BUFFER, vboBoundaries);
+
+        glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+        glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Control points for the tessellation shaders, uploaded once.
+    glGenVertexArrays(1, &vaoPatches);
+    glBindVertexArray(vaoPatches);
+
+    glGenBuffers(1, &vboPatches);
+    glBindBuffer(GL_ARRAY_BUFFER, vboPatches);
+    glBufferData(GL_ARRAY_BUFFER, patches.size() * sizeof(BezierPatch), &patches[0], GL_STATIC_DRAW);
+
+    glVertexAttribPointer(CG_ATTRIBUTE_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+    glEnableVertexAttribArray(CG_ATTRIBUTE_VERTEX_POSITION);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+double now(void)
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (double)time.tv_sec + (double)time.tv_nsec * 1.0e-9;
+}
+
+void display(void)
+{
+    double frameStart = now();
+
+    if(lastFrameTime > 0.0)
+    {
+        frameSeconds += frameStart - lastFrameTime;
+    }
+
+    lastFrameTime = frameStart;
+
+    pollPrograms();
+
+    if(isStreamBufferEnabled)
+    {
+        streamBuffer.beginFrame();
+    }
+
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    vmath::mat4 modelViewMatrix = vmath::lookat(vmath::vec3(0.0f, 6.0f, 14.0f), vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f)) *
+        vmath::rotate(angle, 0.0f, 1.0f, 0.0f);
+    vmath::mat4 mvpMatrix = perspectiveProjectionMatrix * modelViewMatrix;
+
+    glPolygonMode(GL_FRONT_AND_BACK, isWireframe ? GL_LINE : GL_FILL);
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glBeginQuery(GL_PRIMITIVES_GENERATED, primitivesQuery);
+
+    // The CPU tessellator stands in for the tessellation shaders until they are linked.
+    if(isTessellationShaderUsed && shaderProgramObjectTessellation != 0)
+    {
+        drawWithTessellationShader(mvpMatrix, modelViewMatrix);
+    }
+    else
+    {
+        drawWithTessellator(mvpMatrix, modelViewMatrix);
+    }
+
+    glEndQuery(GL_PRIMITIVES_GENERATED);
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    if(areBoundariesShown)
+    {
+        drawBoundaries(mvpMatrix, modelViewMatrix);
+    }
+
+    if(isStreamBufferEnabled)
+    {
+        streamBuffer.endFrame();
+        streamedBytes += streamBuffer.getBytesLastFrame();
+    }
+
+    logFrameStatistics();
+
+    angle += 0.1f;
+
+    if(angle >= 360.0f)
+    {
+        angle -= 360.0f;
+    }
+}
+
+// The lit program once it is linked, the flat one before.
+void useSurfaceProgram(const vmath::mat4& mvpMatrix, const vmath::mat4& modelViewMatrix, GLfloat red, GLfloat green, GLfloat blue)
+{
+    if(shaderProgramObject != 0)
+    {
+        glUseProgram(shaderProgramObject);
+        glUniformMatrix4fv(mvpMatrixUniform, 1, GL_FALSE, mvpMatrix);
+        glUniformMatrix4fv(modelViewMatrixUniform, 1, GL_FALSE, modelViewMatrix);
+        glUniform3f(colorUniform, red, green, blue);
+    }
+    else
+    {
+        glUseProgram(shaderProgramObjectFlat);
+        glUniformMatrix4fv(mvpMatrixUniformFlat, 1, GL_FALSE, mvpMatrix);
+        glUniform3f(colorUniformFlat, red, green, blue);
+    }
+}
+
+void drawWithTessellator(const vmath::mat4& mvpMatrix, const vmath::mat4& modelViewMatrix)
+{
+    double start = now();
+
+    tessellator.setView(mvpMatrix, platform.getWidth(), platform.getHeight());
+    tessellator.setTolerance(tolerance);
+    tessellator.tessellatePatches(&patches[0], (int)patches.size(), &surfaceVertices, &surfaceElements);
+
+    GLsizeiptr verticesSize = surfaceVertices.size() * sizeof(GLfloat);
+    GLsizeiptr elementsSize = surfaceElements.size() * sizeof(GLuint);
+    GLintptr offset = 0;
+
+    if(isStreamBufferEnabled)
+    {
+        // Vertices and elements share one allocation, the elements right behind the vertices.
+        unsigned char *data = (unsigned char *)streamBuffer.allocate(verticesSize + elementsSize, sizeof(GLfloat), &offset);
+
+        if(data == NULL)
+        {
+            return;
+        }
+
+        memcpy(data, &surfaceVertices[0], verticesSize);
+        memcpy(data + verticesSize, &surfaceElements[0], elementsSize);
+
+        glBindVertexArray(vaoSurface);
+        glBindVertexBuffer(SURFACE_BINDING, streamBuffer.getBuffer(), offset, BezierTessellator::FLOATS_PER_VERTEX * sizeof(GLfloat));
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, streamBuffer.getBuffer());
+        offset += verticesSize;
+    }
+    else
+    {
+        // The sizes change with the view, so the buffers are specified anew instead of updated.
+        glBindBuffer(GL_ARRAY_BUFFER, vboSurface);
+        glBufferData(GL_ARRAY_BUFFER, verticesSize, &surfaceVertices[0], GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glBindVertexArray(vaoSurface);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, elementsSize, &surfaceElements[0], GL_STREAM_DRAW);
+        streamedBytes += verticesSize + elementsSize;
+    }
+
+    tessellationSeconds += now() - start;
+
+    useSurfaceProgram(mvpMatrix, modelViewMatrix, 0.3f, 0.8f, 0.4f);
+
+    glDrawElements(GL_TRIANGLES, (GLsizei)surfaceElements.size(), GL_UNSIGNED_INT, (void *)offset);
+
+    glBindVertexArray(0);
+    glUseProgram(0);
+}
+
+void drawWithTessellationShader(const vmath::mat4& mvpMatrix, const vmath::mat4& modelViewMatrix)
+{
+    glUseProgram(shaderProgramObjectTessellation);
+    glUniformMatrix4fv(mvpMatrixUniformTessellation, 1, GL_FALSE, mvpMatrix);
+    glUniformMatrix4fv(modelViewMatrixUniformTessellation, 1, GL_FALSE, modelViewMatrix);
+    glUniform3f(colorUniformTessellation, 0.3f, 0.8f, 0.4f);
+    glUniform2f(viewportSizeUniformTessellation, (GLfloat)platform.getWidth(), (GLfloat)platform.getHeight());
+    glUniform1f(toleranceUniformTessellation, tolerance);
+
+    glBindVertexArray(vaoPatches);
+    glPatchParameteri(GL_PATCH_VERTICES, 16);
+    glDrawArrays(GL_PATCHES, 0, (GLsizei)patches.size() * 16);
+    glBindVertexArray(0);
+
+    glUseProgram(0);
+}
+
+void drawBoundaries(const vmath::mat4& mvpMatrix, const vmath::mat4& modelViewMatrix)
+{
+    boundaryVertices.clear();
+    boundaryFirsts.clear();
+    boundaryCounts.clear();
+
+    tessellator.setView(mvpMatrix, platform.getWidth(), platform.getHeight());
+    tessellator.setTolerance(tolerance);
+    tessellator.tessellateCurves(&boundaries[0], (int)boundaries.size(), &boundaryVertices, &boundaryFirsts, &boundaryCounts);
+
+    GLsizeiptr verticesSize = boundaryVertices.size() * sizeof(GLfloat);
+    GLintptr offset = 0;
+
+    if(isStreamBufferEnabled)
+    {
+        void *data = streamBuffer.allocate(verticesSize, sizeof(GLfloat), &offset);
+
+        if(data == NULL)
+        {
+            return;
+        }
+
+        memcpy(data, &boundaryVertices[0], verticesSize);
+    }
+    else
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vboBoundaries);
+        glBufferData(GL_ARRAY_BUFFER, verticesSize, &boundaryVertices[0], GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        streamedBytes += verticesSize;
+    }
+
+    useSurfaceProgram(mvpMatrix, modelViewMatrix, 0.1f, 0.2f, 0.1f);
+    glVertexAttrib3f(CG_ATTRIBUTE_NORMAL, 0.0f, 1.0f, 0.0f);
+
+    // The firsts count from the start of the strips, which the binding offset puts at offset.
+    glBindVertexArray(vaoBoundaries);
+
+    if(isStreamBufferEnabled)
+    {
+        glBindVertexBuffer(BOUNDARY_BINDING, streamBuffer.getBuffer(), offset, 3 * sizeof(GLfloat));
+    }
+
+    glMultiDrawArrays(GL_LINE_STRIP, &boundaryFirsts[0], &boundaryCounts[0], (GLsizei)boundaryCounts.size());
+    glBindVertexArray(0);
+
+    glUseProgram(0);
+}
+
+void logFrameStatistics(void)
+{
+    framesSinceLog++;
+
+    if(framesSinceLog < FRAMES_PER_LOG)
+    {
+        return;
+    }
+
+    // Reading the query waits for the frame, which only happens once per log.
+    GLuint triangles = 0;
+    glGetQueryObjectuiv(primitivesQuery, GL_QUERY_RESULT, &triangles);
+
+    if(isTessellationShaderUsed && shaderProgramObjectTessellation != 0)
+    {
+        fprintf(logFile, "Tessellation shader, %.3f pixels: %u triangles, %.2f ms per frame.\n", tolerance, triangles, frameSeconds * 1000.0 / FRAMES_PER_LOG);
+    }
+    else
+    {
+        fprintf(logFile, "CPU tessellator, %.3f pixels: %u triangles, %.2f ms tessellating and uploading, %lld bytes streamed, %.2f ms per frame.\n", tolerance, triangles, tessellationSeconds * 1000.0 / FRAMES_PER_LOG, streamedBytes / FRAMES_PER_LOG, frameSeconds * 1000.0 / FRAMES_PER_LOG);
+    }
+
+    fflush(logFile);
+
+    framesSinceLog = 0;
+    tessellationSeconds = 0.0;
+    streamedBytes = 0;
+    frameSeconds = 0.0;
+}
+
+void resize(int width, int height)
+{
+    if(height == 0)
+    {
+        height = 1;
+    }
+
+    glViewport(0, 0, (GLsizei)width, (GLsizei)height);
+    perspectiveProjectionMatrix = vmath::perspective(45.0f, (GLfloat)width / (GLfloat)height, 0.1f, 100.0f);
+}
+
+void cleanUp(void)
+{
+    if(primitivesQuery)
+    {
+        glDeleteQueries(1, &primitivesQuery);
+        primitivesQuery = 0;
+    }
+
+    if(vaoSurface)
+    {
+        glDeleteVertexArrays(1, &vaoSurface);
+        vaoSurface = 0;
+    }
+
+    if(vaoBoundaries)
+    {
+        glDeleteVertexArrays(1, &vaoBoundaries);
+        vaoBoundaries = 0;
+    }
+
+    if(vboSurface)
+    {
+        glDeleteBuffers(1, &vboSurface);
+        vboSurface = 0;
+    }
+
+    if(vboSurfaceElement)
+    {
+        glDeleteBuffers(1, &vboSurfaceElement);
+        vboSurfaceElement = 0;
+    }
+
+    if(vboBoundaries)
+    {
+        glDeleteBuffers(1, &vboBoundaries);
+        vboBoundaries = 0;
+    }
+
+    streamBuffer.log(logFile, "Stream buffer");
+    streamBuffer.destroy();
+
+    if(vaoPatches)
+    {
+        glDeleteVertexArrays(1, &vaoPatches);
+        vaoPatches = 0;
+    }
+
+    if(vboPatches)
+    {
+        glDeleteBuffers(1, &vboPatches);
+        vboPatches = 0;
+    }
+
+    // The batch deletes the programs, linked or not.
+    programBatch.destroy();
+    shaderProgramObject = 0;
+    shaderProgramObjectFlat = 0;
+    shaderProgramObjectTessellation = 0;
+
+    glUseProgram(0);
+}
@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "vmath.h"
+#include "bezierTessellator.h"
+#include "benchmark.h"
+
+// A 32 x 32 grid of bicubic patches making up a rolling terrain 32 units wide, seen in a 1280 x 720
+// viewport from 20 units away, so near patches get much finer levels than the far ones.
+#define GRID_SIZE 32
+#define WIDTH 1280
+#define HEIGHT 720
+#define NUMBER_OF_CURVES 10000
+
+std::vector<BezierPatch> patches;
+std::vector<BezierCurve> curves;
+std::vector<float> vertices;
+std::vector<unsigned int> elements;
+std::vector<float> referenceVertices;
+
+float terrainHeight(float x, float z);
+void initializeData(void);
+void evaluateReference(const BezierPatch& patch, float u, float v, float *position, float *normal);
+int tessellateReference(BezierTessellator& levels);
+void printError(BezierTessellator& levels);
+void measurePatches(float tolerance);
+void measureCurves(void);
+
+int main(void)
+{
+    BezierTessellator pool;
+
+#if defined(__AVX2__)
+    printf("Bezier tessellation, AVX2 build, %d patches, %d x %d pixels, %d hardware threads.\n", GRID_SIZE * GRID_SIZE, WIDTH, HEIGHT, pool.threadCount());
+#else
+    printf("Bezier tessellation, scalar fallback build, %d patches, %d x %d pixels, %d hardware threads.\n", GRID_SIZE * GRID_SIZE, WIDTH, HEIGHT, pool.threadCount());
+#endif
+
+    initializeData();
+
+    measurePatches(2.0f);
+    measurePatches(0.5f);
+    measureCurves();
+
+    return EXIT_SUCCESS;
+}
+
+float terrainHeight(float x, float z)
+{
+    return 0.8f * sinf(0.9f * x) * cosf(0.7f * z) + 0.3f * sinf(2.3f * x + 1.7f * z);
+}
+
+void initializeData(void)
+{
+    // A control net shared along the patch edges, u going along +x and v along -z.
+    const int netSize = GRID_SIZE * 3 + 1;
+    std::vector<float> net(netSize * netSize * 3);
+
+    for (int row = 0; row < netSize; row++)
+    {
+        for (int column = 0; column < netSize; column++)
+        {
+            float *point = &net[(row * netSize + column) * 3];
+
+            point[0] = (float)column / 3.0f - GRID_SIZE * 0.5f;
+            point[2] = GRID_SIZE * 0.5f - (float)row / 3.0f;
+            point[1] = terrainHeight(point[0], point[2]);
+        }
+    }
+
+    for (int patchRow = 0; patchRow < GRID_SIZE; patchRow++)
+    {
+        for (int patchColumn = 0; patchColumn < GRID_SIZE; patchColumn++)
+        {
+            BezierPatch patch;
+
+            for (int row = 0; row < 4; row++)
+            {
+                for (int column = 0; column < 4; column++)
+                {
+                    const float *point = &net[((patchRow * 3 + row) * netSize + patchColumn * 3 + column) * 3];
+
+                    patch.points[row][column][0] = point[0];
+                    patch.points[row][column][1] = point[1];
+                    patch.points[row][column][2] = point[2];
+                }
+            }
+
+            patches.push_back(patch);
+        }
+    }
+
+    srand(1337);
+
+    // Curves the size of the one in the tessellation shader samples, somewhere in front of the eye.
+    for (int n = 0; n < NUMBER_OF_CURVES; n++)
+    {
+        BezierCurve curve;
+
+        for (int point = 0; point < 4; point++)
+        {
+            curve.points[point][0] = (float)(rand() % 2001 - 1000) / 100.0f;
+            curve.points[point][1] = (float)(rand() % 2001 - 1000) / 500.0f;
+            curve.points[point][2] = (float)(rand() % 2001 - 1000) / 100.0f;
+        }
+
+        curves.push_back(curve);
+    }
+}
+
+// Plain de Casteljau evaluation, one vertex at a time.
+void evaluateReference(const BezierPatch& patch, float u, float v, float *position, float *normal)
+{
+    float rows[4][3];
+    float rowTangents[4][3];
+    float columns[4][3];
+
+    for (int row = 0; row < 4; row++)
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            float a = patch.points[row][0][axis] + (patch.points[row][1][axis] - patch.points[row][0][axis]) * u;
+            float b = patch.points[row][1][axis] + (patch.points[row][2][axis] - patch.points[row][1][axis]) * u;
+            float c = patch.points[row][2][axis] + (patch.points[row][3][axis] - patch.points[row][2][axis]) * u;
+            float d = a + (b - a) * u;
+            float e = b + (c - b) * u;
+
+            rows[row][axis] = d + (e - d) * u;
+            rowTangents[row][axis] = 3.0f * (e - d);
+        }
+    }
+
+    // Position and dS/du along v through the rows, dS/dv from the last step of the column.
+    for (int axis = 0; axis < 3; axis++)
+    {
+        for (int pass = 0; pass < 2; pass++)
+        {
+            float (*source)[3] = pass == 0 ? rows : rowTangents;
+            float a = source[0][axis] + (source[1][axis] - source[0][axis]) * v;
+            float b = source[1][axis] + (source[2][axis] - source[1][axis]) * v;
+            float c = source[2][axis] + (source[3][axis] - source[2][axis]) * v;
+            float d = a + (b - a) * v;
+            float e = b + (c - b) * v;
+
+            columns[pass][axis] = d + (e - d) * v;
+
+            if (pass == 0)
+            {
+                columns[2][axis] = 3.0f * (e - d);
+            }
+        }
+    }
+
+    vmath::vec3 normalVector = vmath::normalize(vmath::cross(vmath::vec3(columns[1][0], columns[1][1], columns[1][2]), vmath::vec3(columns[2][0], columns[2][1], columns[2][2])));
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        position[axis] = columns[0][axis];
+        normal[axis] = normalVector[axis];
+    }
+}
+
+// The same grids as the last tessellatePatches() of levels, returns the number of vertices.
+int tessellateReference(BezierTessellator& levels)
+{
+    float *vertex = &referenceVertices[0];
+
+    for (int patch = 0; patch < (int)patches.size(); patch++)
+    {
+        int uLevel = 0;
+        int vLevel = 0;
+
+        levels.getPatchLevels(patch, &uLevel, &vLevel);
+
+        for (int j = 0; j <= vLevel; j++)
+        {
+            for (int i = 0; i <= uLevel; i++)
+            {
+                evaluateReference(patches[patch], (float)i / (float)uLevel, (float)j / (float)vLevel, vertex, vertex + 3);
+                vertex += BezierTessellator::FLOATS_PER_VERTEX;
+            }
+        }
+    }
+
+    return (int)((vertex - &referenceVertices[0]) / BezierTessellator::FLOATS_PER_VERTEX);
+}
+
+// Interior vertices only, the boundary ones are moved onto the edge polylines on purpose.
+void printError(BezierTessellator& levels)
+{
+    float maxPositionError = 0.0f;
+    float maxNormalError = 0.0f;
+    const float *vertex = &vertices[0];
+    const float *reference = &referenceVertices[0];
+
+    for (int patch = 0; patch < (int)patches.size(); patch++)
+    {
+        int uLevel = 0;
+        int vLevel = 0;
+
+        levels.getPatchLevels(patch, &uLevel, &vLevel);
+
+        for (int j = 0; j <= vLevel; j++)
+        {
+            for (int i = 0; i <= uLevel; i++)
+            {
+                if (i > 0 && j > 0 && i < uLevel && j < vLevel)
+                {
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        maxPositionError = fmaxf(maxPositionError, fabsf(vertex[axis] - reference[axis]));
+                        maxNormalError = fmaxf(maxNormalError, fabsf(vertex[axis + 3] - reference[axis + 3]));
+                    }
+                }
+
+                vertex += BezierTessellator::FLOATS_PER_VERTEX;
+                reference += BezierTessellator::FLOATS_PER_VERTEX;
+            }
+        }
+    }
+
+    printf("%-36s max difference from scalar: position %.3e, normal %.3e\n", "", maxPositionError, maxNormalError);
+}
+
+void measurePatches(float tolerance)
+{
+    BezierTessellator single(1);
+    BezierTessellator pool;
+    vmath::mat4 mvpMatrix = vmath::perspective(45.0f, (float)WIDTH / (float)HEIGHT, 0.1f, 100.0f) *
+                            vmath::lookat(vmath::vec3(0.0f, 6.0f, 20.0f), vmath::vec3(0.0f, 0.0f, 0.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
+    char title[96];
+    char name[64];
+    double ns = 0.0;
+
+    single.setView(mvpMatrix, WIDTH, HEIGHT);
+    single.setTolerance(tolerance);
+    pool.setView(mvpMatrix, WIDTH, HEIGHT);
+    pool.setTolerance(tolerance);
+
+    single.tessellatePatches(&patches[0], (int)patches.size(), &vertices, &elements);
+
+    int numberOfVertices = (int)(vertices.size() / BezierTessellator::FLOATS_PER_VERTEX);
+    referenceVertices.resize(vertices.size());
+
+    snprintf(title, sizeof(title), "Patches at %.1f pixels: %d vertices, %d triangles (per vertex)", tolerance, numberOfVertices, (int)(elements.size() / 3));
+    benchmarkPrintHeader(title, false);
+
+    ns = benchmarkRun([&]() {
+        tessellateReference(single);
+        benchmarkKeep(referenceVertices[0]);
+    }, numberOfVertices);
+    benchmarkPrintRow("de Casteljau, scalar", ns);
+
+    ns = benchmarkRun([&]() {
+        single.tessellatePatches(&patches[0], (int)patches.size(), &vertices, &elements);
+        benchmarkKeep(vertices[0]);
+    }, numberOfVertices);
+    benchmarkPrintRow("8 wide Horner, 1 thread", ns);
+    printError(single);
+
+    ns = benchmarkRun([&]() {
+        pool.tessellatePatches(&patches[0], (int)patches.size(), &vertices, &elements);
+        benchmarkKeep(vertices[0]);
+    }, numberOfVertices);
+    snprintf(name, sizeof(name), "8 wide Horner, thread pool of %d", pool.threadCount());
+    benchmarkPrintRow(name, ns);
+    printError(pool);
+}
+
+void measureCurves(void)
+{
+    BezierTessellator tessellator(1);
+    std::vector<float> points((BEZIER_MAXIMUM_SEGMENTS + 1) * 3);
+    std::vector<int> firsts;
+    std::vector<int> counts;
+    char title[96];
+    double ns = 0.0;
+
+    tessellator.setView(vmath::perspective(45.0f, (float)WIDTH / (float)HEIGHT, 0.1f, 100.0f) * vmath::translate(0.0f, 0.0f, -25.0f), WIDTH, HEIGHT);
+
+    vertices.clear();
+    tessellator.tessellateCurves(&curves[0], NUMBER_OF_CURVES, &vertices, &firsts, &counts);
+
+    int numberOfPoints = (int)(vertices.size() / 3);
+
+    snprintf(title, sizeof(title), "%d curves at 0.5 pixels: %d points (per point)", NUMBER_OF_CURVES, numberOfPoints);
+    benchmarkPrintHeader(title, false);
+
+    // Each point straight from the Bernstein polynomials.
+    ns = benchmarkRun([&]() {
+        for (int curve = 0; curve < NUMBER_OF_CURVES; curve++)
+        {
+            const BezierCurve& c = curves[curve];
+            int segments = counts[curve] - 1;
+
+            for (int point = 0; point <= segments; point++)
+            {
+                float t = (float)point / (float)segments;
+                float s = 1.0f - t;
+                float b0 = s * s * s;
+                float b1 = 3.0f * s * s * t;
+                float b2 = 3.0f * s * t * t;
+                float b3 = t * t * t;
+
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    points[point * 3 + axis] = b0 * c.points[0][axis] + b1 * c.points[1][axis] + b2 * c.points[2][axis] + b3 * c.points[3][axis];
+                }
+            }
+
+            benchmarkKeep(points[0]);
+        }
+    }, numberOfPoints);
+    benchmarkPrintRow("Bernstein, scalar", ns);
+
+    ns = benchmarkRun([&]() {
+        for (int curve = 0; curve < NUMBER_OF_CURVES; curve++)
+        {
+            BezierTessellator::evaluateCurve(curves[curve], counts[curve] - 1, &points[0]);
+            benchmarkKeep(points[0]);
+        }
+    }, numberOfPoints);
+    benchmarkPrintRow("forward differencing", ns);
+
+    ns = benchmarkRun([&]() {
+        vertices.clear();
+        firsts.clear();
+        counts.clear();
+        tessellator.tessellateCurves(&curves[0], NUMBER_OF_CURVES, &vertices, &firsts, &counts);
+        benchmarkKeep(vertices[0]);
+    }, numberOfPoints);
+    benchmarkPrintRow("adaptive levels and line strips", ns);
+}
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -O2 -mavx2 -mfma -pthread -I../../common -o bezierTessellation bezierTessellation.cpp
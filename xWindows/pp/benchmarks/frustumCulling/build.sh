@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -O2 -mavx2 -mfma -I../../common -o frustumCulling frustumCulling.cpp
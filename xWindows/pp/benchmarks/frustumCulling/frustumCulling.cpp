@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "vmath.h"
+#include "vmathFrustum.h"
+#include "benchmark.h"
+
+// Objects per run, a multiple of 8, scattered through a 200 unit cube around the camera so that
+// roughly one in eight ends up inside the frustum.
+#define NUMBER_OF_OBJECTS 65536
+#define NUMBER_OF_BLOCKS (NUMBER_OF_OBJECTS / 8)
+
+std::vector<vmath::vec3> centers;
+std::vector<vmath::vec3> extents;
+std::vector<float> radii;
+std::vector<vmath::sphere8> sphereBlocks;
+std::vector<vmath::aabb8> boxBlocks;
+std::vector<unsigned char> scalarVisibility;
+std::vector<unsigned char> blockVisibility;
+
+float randomFloat(float low, float high);
+void initializeData(void);
+int countVisible(const std::vector<unsigned char>& visibility);
+int countMismatches(void);
+
+int main(void)
+{
+#if defined(__AVX__)
+    printf("Frustum culling, AVX build, %d objects per run.\n", NUMBER_OF_OBJECTS);
+#else
+    printf("Frustum culling, scalar fallback build, %d objects per run.\n", NUMBER_OF_OBJECTS);
+#endif
+
+    initializeData();
+
+    vmath::mat4 projection = vmath::perspective(45.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+    vmath::mat4 view = vmath::lookat(vmath::vec3(0.0f, 2.0f, 5.0f), vmath::vec3(0.0f, 0.0f, -10.0f), vmath::vec3(0.0f, 1.0f, 0.0f));
+    vmath::Frustum frustum(projection * view);
+    double ns = 0.0;
+
+    benchmarkPrintHeader("Culling (per object)", false);
+
+    ns = benchmarkRun([&]() {
+        vmath::Frustum f(projection * view);
+        benchmarkKeep(f);
+    }, 1.0);
+    benchmarkPrintRow("Frustum from view projection", ns);
+
+    // Spheres.
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_OBJECTS; i++)
+        {
+            scalarVisibility[i] = frustum.isSphereVisible(centers[i], radii[i]) ? 1 : 0;
+        }
+        benchmarkKeep(scalarVisibility[0]);
+    }, NUMBER_OF_OBJECTS);
+    benchmarkPrintRow("sphere scalar", ns);
+
+    ns = benchmarkRun([&]() {
+        frustum.cullSpheres(&sphereBlocks[0], NUMBER_OF_BLOCKS, &blockVisibility[0]);
+        benchmarkKeep(blockVisibility[0]);
+    }, NUMBER_OF_OBJECTS);
+    benchmarkPrintRow("sphere 8 wide", ns);
+    printf("%-36s visible %d of %d, %d differ from scalar\n", "", countVisible(scalarVisibility), NUMBER_OF_OBJECTS, countMismatches());
+
+    // Boxes.
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_OBJECTS; i++)
+        {
+            scalarVisibility[i] = frustum.isBoxVisible(centers[i], extents[i]) ? 1 : 0;
+        }
+        benchmarkKeep(scalarVisibility[0]);
+    }, NUMBER_OF_OBJECTS);
+    benchmarkPrintRow("aabb scalar", ns);
+
+    ns = benchmarkRun([&]() {
+        frustum.cullBoxes(&boxBlocks[0], NUMBER_OF_BLOCKS, &blockVisibility[0]);
+        benchmarkKeep(blockVisibility[0]);
+    }, NUMBER_OF_OBJECTS);
+    benchmarkPrintRow("aabb 8 wide", ns);
+    printf("%-36s visible %d of %d, %d differ from scalar\n", "", countVisible(scalarVisibility), NUMBER_OF_OBJECTS, countMismatches());
+
+    return EXIT_SUCCESS;
+}
+
+float randomFloat(float low, float high)
+{
+    return low + (high - low) * ((float)rand() / (float)RAND_MAX);
+}
+
+void initializeData(void)
+{
+    centers.resize(NUMBER_OF_OBJECTS);
+    extents.resize(NUMBER_OF_OBJECTS);
+    radii.resize(NUMBER_OF_OBJECTS);
+    sphereBlocks.resize(NUMBER_OF_BLOCKS);
+    boxBlocks.resize(NUMBER_OF_BLOCKS);
+    scalarVisibility.resize(NUMBER_OF_OBJECTS);
+    blockVisibility.resize(NUMBER_OF_BLOCKS);
+
+    srand(1337);
+
+    for (int i = 0; i < NUMBER_OF_OBJECTS; i++)
+    {
+        centers[i] = vmath::vec3(randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f), randomFloat(-100.0f, 100.0f));
+        extents[i] = vmath::vec3(randomFloat(0.1f, 2.0f), randomFloat(0.1f, 2.0f), randomFloat(0.1f, 2.0f));
+        radii[i] = vmath::length(extents[i]);
+
+        vmath::sphere8& sphere = sphereBlocks[i / 8];
+        vmath::aabb8& box = boxBlocks[i / 8];
+        int lane = i % 8;
+
+        sphere.x[lane] = centers[i][0];
+        sphere.y[lane] = centers[i][1];
+        sphere.z[lane] = centers[i][2];
+        sphere.radius[lane] = radii[i];
+
+        box.centerX[lane] = centers[i][0];
+        box.centerY[lane] = centers[i][1];
+        box.centerZ[lane] = centers[i][2];
+        box.extentX[lane] = extents[i][0];
+        box.extentY[lane] = extents[i][1];
+        box.extentZ[lane] = extents[i][2];
+    }
+}
+
+int countVisible(const std::vector<unsigned char>& visibility)
+{
+    int count = 0;
+
+    for (size_t i = 0; i < visibility.size(); i++)
+    {
+        count += visibility[i] ? 1 : 0;
+    }
+
+    return count;
+}
+
+// Objects where the 8 wide result disagrees with the scalar one. Only objects touching a plane
+// within rounding can differ, when the 8 wide kernel is built with FMA.
+int countMismatches(void)
+{
+    int count = 0;
+
+    for (int i = 0; i < NUMBER_OF_OBJECTS; i++)
+    {
+        bool blockVisible = (blockVisibility[i / 8] >> (i % 8)) & 1;
+
+        if (blockVisible != (scalarVisibility[i] != 0))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "vmath.h"
+#include "vmathQuaternionBatch.h"
+#include "benchmark.h"
+
+// Number of quaternions per run, a multiple of 8 that fits comfortably in L2 so that the numbers
+// show the cost of the math rather than memory bandwidth.
+#define NUMBER_OF_QUATERNIONS 16384
+#define NUMBER_OF_BLOCKS (NUMBER_OF_QUATERNIONS / 8)
+
+struct QuaternionD
+{
+    double x, y, z, w;
+};
+
+std::vector<vmath::quaternion> sourceA;
+std::vector<vmath::quaternion> sourceB;
+std::vector<float> factors;
+
+std::vector<vmath::quaternion8> blocksA;
+std::vector<vmath::quaternion8> blocksB;
+std::vector<vmath::quaternion8> blocksResult;
+
+void initializeData(void);
+QuaternionD toDouble(const vmath::quaternion& q);
+QuaternionD nlerpReference(const QuaternionD& a, const QuaternionD& b, double t);
+QuaternionD slerpReference(const QuaternionD& a, const QuaternionD& b, double t);
+double angleBetween(const QuaternionD& a, float x, float y, float z, float w);
+void measureInterpolation(void);
+void measureConversion(void);
+
+int main(void)
+{
+#if defined(__AVX__)
+    printf("Quaternion batch kernels, AVX build, %d quaternions per run.\n", NUMBER_OF_QUATERNIONS);
+#else
+    printf("Quaternion batch kernels, scalar fallback build, %d quaternions per run.\n", NUMBER_OF_QUATERNIONS);
+#endif
+
+    initializeData();
+    measureInterpolation();
+    measureConversion();
+
+    return EXIT_SUCCESS;
+}
+
+void initializeData(void)
+{
+    sourceA.resize(NUMBER_OF_QUATERNIONS);
+    sourceB.resize(NUMBER_OF_QUATERNIONS);
+    factors.resize(NUMBER_OF_QUATERNIONS);
+    blocksA.resize(NUMBER_OF_BLOCKS);
+    blocksB.resize(NUMBER_OF_BLOCKS);
+    blocksResult.resize(NUMBER_OF_BLOCKS);
+
+    srand(1337);
+
+    for (int i = 0; i < NUMBER_OF_QUATERNIONS; i++)
+    {
+        float a[4];
+        float b[4];
+
+        for (int n = 0; n < 4; n++)
+        {
+            a[n] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+            b[n] = (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+        }
+
+        // Every fourth pair is nearly identical to cover the nlerp fallback inside slerp.
+        if (i % 4 == 0)
+        {
+            for (int n = 0; n < 4; n++)
+            {
+                b[n] = a[n] + ((float)rand() / (float)RAND_MAX - 0.5f) * 1.0e-3f;
+            }
+        }
+
+        sourceA[i] = vmath::normalize(vmath::quaternion(a[0], a[1], a[2], a[3]));
+        sourceB[i] = vmath::normalize(vmath::quaternion(b[0], b[1], b[2], b[3]));
+        factors[i] = (float)rand() / (float)RAND_MAX;
+    }
+
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::loadQuaternion8(&sourceA[i * 8], blocksA[i]);
+        vmath::loadQuaternion8(&sourceB[i * 8], blocksB[i]);
+    }
+}
+
+QuaternionD toDouble(const vmath::quaternion& q)
+{
+    QuaternionD result = { q[0], q[1], q[2], q[3] };
+    return result;
+}
+
+QuaternionD nlerpReference(const QuaternionD& a, const QuaternionD& b, double t)
+{
+    double d = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    double s = d < 0.0 ? -t : t;
+    QuaternionD q = { (1.0 - t) * a.x + s * b.x, (1.0 - t) * a.y + s * b.y, (1.0 - t) * a.z + s * b.z, (1.0 - t) * a.w + s * b.w };
+    double length = sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+    QuaternionD result = { q.x / length, q.y / length, q.z / length, q.w / length };
+    return result;
+}
+
+QuaternionD slerpReference(const QuaternionD& a, const QuaternionD& b, double t)
+{
+    double d = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    double sign = d < 0.0 ? -1.0 : 1.0;
+    d = fmin(d * sign, 1.0);
+
+    if (d > 0.9999999)
+    {
+        return nlerpReference(a, b, t);
+    }
+
+    double theta = acos(d);
+    double wa = sin((1.0 - t) * theta) / sin(theta);
+    double wb = sign * sin(t * theta) / sin(theta);
+    QuaternionD result = { wa * a.x + wb * b.x, wa * a.y + wb * b.y, wa * a.z + wb * b.z, wa * a.w + wb * b.w };
+    return result;
+}
+
+// Rotation angle between the reference and a float result, in radians. Measured from the chord
+// between the two unit quaternions since acos of their dot product loses all precision near 1.
+double angleBetween(const QuaternionD& a, float x, float y, float z, float w)
+{
+    double sign = (a.x * x + a.y * y + a.z * z + a.w * w) < 0.0 ? -1.0 : 1.0;
+    double dx = a.x - sign * x;
+    double dy = a.y - sign * y;
+    double dz = a.z - sign * z;
+    double dw = a.w - sign * w;
+    double chord = sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+    return 4.0 * asin(fmin(chord * 0.5, 1.0));
+}
+
+void measureInterpolation(void)
+{
+    std::vector<vmath::quaternion> scalarResult(NUMBER_OF_QUATERNIONS);
+    double ns = 0.0;
+    double maxUlp = 0.0;
+    double maxAngle = 0.0;
+
+    benchmarkPrintHeader("Interpolation (per quaternion)");
+
+    // Scalar nlerp and slerp, one quaternion at a time.
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_QUATERNIONS; i++)
+        {
+            scalarResult[i] = vmath::nlerp(sourceA[i], sourceB[i], factors[i]);
+        }
+        benchmarkKeep(scalarResult[0]);
+    }, NUMBER_OF_QUATERNIONS);
+    benchmarkPrintRow("nlerp scalar", ns, -1.0);
+
+    ns = benchmarkRun([&]() {
+        vmath::nlerpBatch(&blocksA[0], &blocksB[0], &factors[0], &blocksResult[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(blocksResult[0]);
+    }, NUMBER_OF_QUATERNIONS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_QUATERNIONS; i++)
+    {
+        QuaternionD reference = nlerpReference(toDouble(sourceA[i]), toDouble(sourceB[i]), factors[i]);
+        const vmath::quaternion8& block = blocksResult[i / 8];
+        int lane = i % 8;
+
+        maxUlp = fmax(maxUlp, benchmarkUlpError(block.x[lane], reference.x));
+        maxUlp = fmax(maxUlp, benchmarkUlpError(block.y[lane], reference.y));
+        maxUlp = fmax(maxUlp, benchmarkUlpError(block.z[lane], reference.z));
+        maxUlp = fmax(maxUlp, benchmarkUlpError(block.w[lane], reference.w));
+    }
+    benchmarkPrintRow("nlerp batch", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_QUATERNIONS; i++)
+        {
+            scalarResult[i] = vmath::slerp(sourceA[i], sourceB[i], factors[i]);
+        }
+        benchmarkKeep(scalarResult[0]);
+    }, NUMBER_OF_QUATERNIONS);
+    benchmarkPrintRow("slerp scalar", ns, -1.0);
+
+    for (int mode = vmath::SLERP_EXACT; mode <= vmath::SLERP_FAST; mode++)
+    {
+        ns = benchmarkRun([&]() {
+            vmath::slerpBatch(&blocksA[0], &blocksB[0], &factors[0], &blocksResult[0], NUMBER_OF_BLOCKS, (vmath::slerpMode)mode);
+            benchmarkKeep(blocksResult[0]);
+        }, NUMBER_OF_QUATERNIONS);
+
+        maxUlp = 0.0;
+        maxAngle = 0.0;
+        for (int i = 0; i < NUMBER_OF_QUATERNIONS; i++)
+        {
+            QuaternionD reference = slerpReference(toDouble(sourceA[i]), toDouble(sourceB[i]), factors[i]);
+            const vmath::quaternion8& block = blocksResult[i / 8];
+            int lane = i % 8;
+
+            maxUlp = fmax(maxUlp, benchmarkUlpError(block.x[lane], reference.x));
+            maxUlp = fmax(maxUlp, benchmarkUlpError(block.y[lane], reference.y));
+            maxUlp = fmax(maxUlp, benchmarkUlpError(block.z[lane], reference.z));
+            maxUlp = fmax(maxUlp, benchmarkUlpError(block.w[lane], reference.w));
+            maxAngle = fmax(maxAngle, angleBetween(reference, block.x[lane], block.y[lane], block.z[lane], block.w[lane]));
+        }
+
+        benchmarkPrintRow(mode == vmath::SLERP_EXACT ? "slerp batch exact" : "slerp batch fast", ns, maxUlp);
+        printf("%-36s max angle error %.3e radians\n", "", maxAngle);
+    }
+}
+
+void measureConversion(void)
+{
+    std::vector<vmath::mat4> matrices(NUMBER_OF_QUATERNIONS);
+    std::vector<float> matrices3x4(NUMBER_OF_QUATERNIONS * 12);
+    double ns = 0.0;
+    double maxUlp = 0.0;
+
+    benchmarkPrintHeader("Quaternion to matrix (per quaternion)");
+
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_QUATERNIONS; i++)
+        {
+            vmath::quaternionToMatrix(sourceA[i], matrices[i]);
+        }
+        benchmarkKeep(matrices[0]);
+    }, NUMBER_OF_QUATERNIONS);
+    benchmarkPrintRow("quaternionToMatrix scalar", ns, -1.0);
+
+    ns = benchmarkRun([&]() {
+        vmath::quaternionToMatrixBatch(&blocksA[0], &matrices[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(matrices[0]);
+    }, NUMBER_OF_QUATERNIONS);
+
+    // Compare against quaternionToMatrix evaluated in double precision.
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_QUATERNIONS; i++)
+    {
+        vmath::dquaternion q(sourceA[i][0], sourceA[i][1], sourceA[i][2], sourceA[i][3]);
+        vmath::dmat4 reference = q.asMatrix();
+
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                maxUlp = fmax(maxUlp, benchmarkUlpError(matrices[i][column][row], reference[column][row]));
+            }
+        }
+    }
+    benchmarkPrintRow("quaternionToMatrixBatch mat4", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        vmath::quaternionToMatrix3x4Batch(&blocksA[0], (float (*)[12])&matrices3x4[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(matrices3x4[0]);
+    }, NUMBER_OF_QUATERNIONS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_QUATERNIONS; i++)
+    {
+        vmath::dquaternion q(sourceA[i][0], sourceA[i][1], sourceA[i][2], sourceA[i][3]);
+        vmath::dmat4 reference = q.asMatrix();
+
+        for (int row = 0; row < 3; row++)
+        {
+            for (int column = 0; column < 4; column++)
+            {
+                maxUlp = fmax(maxUlp, benchmarkUlpError(matrices3x4[i * 12 + row * 4 + column], reference[column][row]));
+            }
+        }
+    }
+    benchmarkPrintRow("quaternionToMatrix3x4Batch", ns, maxUlp);
+}
@@ -0,0 +1,203 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "vmath.h"
+#include "vmathSkinning.h"
+#include "benchmark.h"
+
+// A crowd of 16 characters with 65536 vertices and 64 joints each would be 1M vertices, so that
+// is the size of one run. All vertices share one palette here, which only makes the gathers a
+// little more cache friendly than a real crowd.
+#define NUMBER_OF_VERTICES (1024 * 1024)
+#define NUMBER_OF_BLOCKS (NUMBER_OF_VERTICES / 8)
+#define NUMBER_OF_JOINTS 64
+
+std::vector<vmath::vec3x8> positions;
+std::vector<vmath::vec3x8> normals;
+std::vector<vmath::skinInfluences8> influences;
+std::vector<vmath::vec3x8> skinnedPositions;
+std::vector<vmath::vec3x8> skinnedNormals;
+std::vector<vmath::vec3> referencePositions;
+std::vector<vmath::vec3> referenceNormals;
+
+vmath::mat4 joints[NUMBER_OF_JOINTS];
+float matrixPalette[NUMBER_OF_JOINTS][12];
+float dualQuaternionPalette[NUMBER_OF_JOINTS][8];
+
+float randomFloat(float low, float high);
+void initializeData(void);
+void skinReference(vmath::skinningMode mode);
+void printError(void);
+void measure(const char *title, vmath::skinningMode mode, vmath::SkinningThreadPool& pool);
+
+int main(void)
+{
+    vmath::SkinningThreadPool pool;
+
+#if defined(__AVX2__)
+    printf("Skinning, AVX2 build, %d vertices per run, %d joints, %d hardware threads.\n", NUMBER_OF_VERTICES, NUMBER_OF_JOINTS, pool.threadCount());
+#else
+    printf("Skinning, scalar fallback build, %d vertices per run, %d joints, %d hardware threads.\n", NUMBER_OF_VERTICES, NUMBER_OF_JOINTS, pool.threadCount());
+#endif
+
+    initializeData();
+
+    measure("Linear blend skinning (per vertex)", vmath::SKINNING_LINEAR_BLEND, pool);
+    measure("Dual quaternion skinning (per vertex)", vmath::SKINNING_DUAL_QUATERNION, pool);
+
+    return EXIT_SUCCESS;
+}
+
+float randomFloat(float low, float high)
+{
+    return low + (high - low) * ((float)rand() / (float)RAND_MAX);
+}
+
+void initializeData(void)
+{
+    positions.resize(NUMBER_OF_BLOCKS);
+    normals.resize(NUMBER_OF_BLOCKS);
+    influences.resize(NUMBER_OF_BLOCKS);
+    skinnedPositions.resize(NUMBER_OF_BLOCKS);
+    skinnedNormals.resize(NUMBER_OF_BLOCKS);
+    referencePositions.resize(NUMBER_OF_VERTICES);
+    referenceNormals.resize(NUMBER_OF_VERTICES);
+
+    srand(1337);
+
+    // Rigid joints, so both modes apply to the same matrices.
+    for (int j = 0; j < NUMBER_OF_JOINTS; j++)
+    {
+        vmath::vec3 axis = vmath::normalize(vmath::vec3(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f)));
+
+        joints[j] = vmath::translate(randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f), randomFloat(-2.0f, 2.0f)) *
+                    vmath::rotate(randomFloat(-90.0f, 90.0f), axis[0], axis[1], axis[2]);
+    }
+
+    vmath::buildMatrixPalette(joints, NUMBER_OF_JOINTS, matrixPalette);
+    vmath::buildDualQuaternionPalette(joints, NUMBER_OF_JOINTS, dualQuaternionPalette);
+
+    for (int i = 0; i < NUMBER_OF_VERTICES; i++)
+    {
+        vmath::vec3x8& position = positions[i / 8];
+        vmath::vec3x8& normal = normals[i / 8];
+        vmath::skinInfluences8& influence = influences[i / 8];
+        int lane = i % 8;
+
+        vmath::vec3 n = vmath::normalize(vmath::vec3(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f)));
+
+        position.x[lane] = randomFloat(-1.0f, 1.0f);
+        position.y[lane] = randomFloat(-1.0f, 1.0f);
+        position.z[lane] = randomFloat(-1.0f, 1.0f);
+        normal.x[lane] = n[0];
+        normal.y[lane] = n[1];
+        normal.z[lane] = n[2];
+
+        // Neighbouring joints, weights falling off like they do along a limb.
+        int root = rand() % (NUMBER_OF_JOINTS - vmath::SKINNING_INFLUENCES);
+        float total = 0.0f;
+
+        for (int k = 0; k < vmath::SKINNING_INFLUENCES; k++)
+        {
+            influence.joint[k][lane] = root + k;
+            influence.weight[k][lane] = randomFloat(0.0f, 1.0f) / (float)(k + 1);
+            total += influence.weight[k][lane];
+        }
+
+        for (int k = 0; k < vmath::SKINNING_INFLUENCES; k++)
+        {
+            influence.weight[k][lane] /= total;
+        }
+    }
+}
+
+// Scalar version over all vertices, also the reference the batch results are checked against.
+void skinReference(vmath::skinningMode mode)
+{
+    for (int i = 0; i < NUMBER_OF_VERTICES; i++)
+    {
+        const vmath::vec3x8& position = positions[i / 8];
+        const vmath::vec3x8& normal = normals[i / 8];
+        const vmath::skinInfluences8& influence = influences[i / 8];
+        int lane = i % 8;
+        int vertexJoints[vmath::SKINNING_INFLUENCES];
+        float vertexWeights[vmath::SKINNING_INFLUENCES];
+
+        for (int k = 0; k < vmath::SKINNING_INFLUENCES; k++)
+        {
+            vertexJoints[k] = influence.joint[k][lane];
+            vertexWeights[k] = influence.weight[k][lane];
+        }
+
+        vmath::vec3 p(position.x[lane], position.y[lane], position.z[lane]);
+        vmath::vec3 n(normal.x[lane], normal.y[lane], normal.z[lane]);
+
+        if (mode == vmath::SKINNING_DUAL_QUATERNION)
+        {
+            vmath::skinDualQuaternion(p, n, vertexJoints, vertexWeights, dualQuaternionPalette, referencePositions[i], referenceNormals[i]);
+        }
+        else
+        {
+            vmath::skinLinearBlend(p, n, vertexJoints, vertexWeights, matrixPalette, referencePositions[i], referenceNormals[i]);
+        }
+    }
+}
+
+void printError(void)
+{
+    float maxPositionError = 0.0f;
+    float maxNormalError = 0.0f;
+
+    for (int i = 0; i < NUMBER_OF_VERTICES; i++)
+    {
+        const vmath::vec3x8& position = skinnedPositions[i / 8];
+        const vmath::vec3x8& normal = skinnedNormals[i / 8];
+        int lane = i % 8;
+
+        maxPositionError = fmaxf(maxPositionError, vmath::length(vmath::vec3(position.x[lane], position.y[lane], position.z[lane]) - referencePositions[i]));
+        maxNormalError = fmaxf(maxNormalError, vmath::length(vmath::vec3(normal.x[lane], normal.y[lane], normal.z[lane]) - referenceNormals[i]));
+    }
+
+    printf("%-36s max difference from scalar: position %.3e, normal %.3e\n", "", maxPositionError, maxNormalError);
+}
+
+void measure(const char *title, vmath::skinningMode mode, vmath::SkinningThreadPool& pool)
+{
+    vmath::skinningJob job;
+    double ns = 0.0;
+    char name[64];
+
+    job.positions = &positions[0];
+    job.normals = &normals[0];
+    job.influences = &influences[0];
+    job.matrixPalette = matrixPalette;
+    job.dualQuaternionPalette = dualQuaternionPalette;
+    job.skinnedPositions = &skinnedPositions[0];
+    job.skinnedNormals = &skinnedNormals[0];
+    job.count = NUMBER_OF_BLOCKS;
+
+    benchmarkPrintHeader(title, false);
+
+    ns = benchmarkRun([&]() {
+        skinReference(mode);
+        benchmarkKeep(referencePositions[0]);
+    }, NUMBER_OF_VERTICES);
+    benchmarkPrintRow("scalar", ns);
+
+    ns = benchmarkRun([&]() {
+        vmath::skinBatch(job, mode, 0, job.count);
+        benchmarkKeep(skinnedPositions[0]);
+    }, NUMBER_OF_VERTICES);
+    benchmarkPrintRow("8 wide, 1 thread", ns);
+    printError();
+
+    ns = benchmarkRun([&]() {
+        pool.run(job, mode);
+        benchmarkKeep(skinnedPositions[0]);
+    }, NUMBER_OF_VERTICES);
+    snprintf(name, sizeof(name), "8 wide, thread pool of %d", pool.threadCount());
+    benchmarkPrintRow(name, ns);
+    printError();
+}
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -O2 -I../../common -o suballocator suballocator.cpp
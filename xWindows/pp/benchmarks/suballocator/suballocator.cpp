@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <map>
+#include <vector>
+
+#include "tlsfAllocator.h"
+#include "benchmark.h"
+
+// Allocation churn like a GeometryPool sees it: a live set of meshes of 24 to 4096 vertices, and
+// every operation frees a random one and allocates a new one of random size. The buffer is sized
+// for the live set at about 75% occupancy, so the allocators have to reuse the holes they leave.
+#define MINIMUM_SIZE 24
+#define MAXIMUM_SIZE 4096
+#define OPERATIONS_PER_CALL 10000
+
+// The usual alternative: free ranges in an offset ordered map, first fit by walking it from the
+// start, merged with their neighbours on release.
+class FirstFitAllocator
+{
+public:
+    explicit FirstFitAllocator(unsigned int capacity)
+    {
+        freeRanges[0] = capacity;
+    }
+
+    // Returns the offset, or ~0u when nothing fits.
+    unsigned int allocate(unsigned int size)
+    {
+        for (std::map<unsigned int, unsigned int>::iterator range = freeRanges.begin(); range != freeRanges.end(); ++range)
+        {
+            if (range->second >= size)
+            {
+                unsigned int offset = range->first;
+                unsigned int rest = range->second - size;
+
+                freeRanges.erase(range);
+
+                if (rest > 0)
+                {
+                    freeRanges[offset + size] = rest;
+                }
+
+                return offset;
+            }
+        }
+
+        return ~0u;
+    }
+
+    void release(unsigned int offset, unsigned int size)
+    {
+        std::map<unsigned int, unsigned int>::iterator next = freeRanges.lower_bound(offset);
+
+        if (next != freeRanges.end() && offset + size == next->first)
+        {
+            size += next->second;
+            next = freeRanges.erase(next);
+        }
+
+        if (next != freeRanges.begin())
+        {
+            std::map<unsigned int, unsigned int>::iterator previous = next;
+            --previous;
+
+            if (previous->first + previous->second == offset)
+            {
+                previous->second += size;
+                return;
+            }
+        }
+
+        freeRanges[offset] = size;
+    }
+
+    size_t numberOfFreeRanges(void) const
+    {
+        return freeRanges.size();
+    }
+
+private:
+    std::map<unsigned int, unsigned int> freeRanges;
+};
+
+struct Allocation
+{
+    unsigned int offset;
+    unsigned int size;
+    int handle;
+};
+
+unsigned int randomSize(void);
+void measure(int live);
+
+int main(void)
+{
+    printf("Suballocation churn, sizes %d to %d units, about 75%% occupancy.\n", MINIMUM_SIZE, MAXIMUM_SIZE);
+
+    for (int live = 1000; live <= 100000; live *= 10)
+    {
+        measure(live);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+unsigned int randomSize(void)
+{
+    return MINIMUM_SIZE + (unsigned int)rand() % (MAXIMUM_SIZE - MINIMUM_SIZE + 1);
+}
+
+void measure(int live)
+{
+    char title[64];
+    unsigned int capacity = (unsigned int)live * (MINIMUM_SIZE + MAXIMUM_SIZE) / 2 * 4 / 3;
+    std::vector<Allocation> allocations;
+    long failures = 0;
+    double ns = 0.0;
+
+    snprintf(title, sizeof(title), "%d live allocations (per free and allocate)", live);
+    benchmarkPrintHeader(title, false);
+
+    // First fit, limited to a smaller live set because every allocate walks the free ranges.
+    if (live <= 10000)
+    {
+        FirstFitAllocator firstFit(capacity);
+
+        srand(1337);
+        allocations.clear();
+
+        while ((int)allocations.size() < live)
+        {
+            Allocation allocation = { 0, randomSize(), 0 };
+            allocation.offset = firstFit.allocate(allocation.size);
+            allocations.push_back(allocation);
+        }
+
+        failures = 0;
+        ns = benchmarkRun([&]() {
+            for (int n = 0; n < OPERATIONS_PER_CALL; n++)
+            {
+                Allocation& allocation = allocations[(unsigned int)rand() % allocations.size()];
+
+                if (allocation.offset != ~0u)
+                {
+                    firstFit.release(allocation.offset, allocation.size);
+                }
+
+                allocation.size = randomSize();
+                allocation.offset = firstFit.allocate(allocation.size);
+                failures += allocation.offset == ~0u;
+            }
+        }, OPERATIONS_PER_CALL);
+
+        benchmarkPrintRow("first fit, ordered free list", ns);
+        printf("%37s%zu free ranges, %ld failed allocations\n", "", firstFit.numberOfFreeRanges(), failures);
+    }
+
+    TlsfAllocator tlsf(capacity);
+
+    srand(1337);
+    allocations.clear();
+
+    while ((int)allocations.size() < live)
+    {
+        Allocation allocation = { 0, randomSize(), 0 };
+        allocation.handle = tlsf.allocate(allocation.size);
+        allocations.push_back(allocation);
+    }
+
+    failures = 0;
+    ns = benchmarkRun([&]() {
+        for (int n = 0; n < OPERATIONS_PER_CALL; n++)
+        {
+            Allocation& allocation = allocations[(unsigned int)rand() % allocations.size()];
+
+            tlsf.release(allocation.handle);
+            allocation.size = randomSize();
+            allocation.handle = tlsf.allocate(allocation.size);
+            failures += allocation.handle == TlsfAllocator::INVALID;
+        }
+    }, OPERATIONS_PER_CALL);
+
+    benchmarkPrintRow("TLSF", ns);
+    printf("%37s%ld failed allocations, fragmentation %.3f, largest free range %u of %u\n", "", failures, tlsf.fragmentation(), tlsf.largestFreeRange(), tlsf.freeUnits());
+
+    // Compaction the way GeometryPool::defragment() does it: keep moving the last allocation into
+    // a lower hole until the allocator has none that fits.
+    int moves = 0;
+    unsigned long long unitsMoved = 0;
+    double start = benchmarkNow();
+
+    for (;;)
+    {
+        int block = tlsf.highestAllocation();
+        int target = block != TlsfAllocator::INVALID ? tlsf.allocate(tlsf.sizeOf(block)) : TlsfAllocator::INVALID;
+
+        if (target == TlsfAllocator::INVALID)
+        {
+            break;
+        }
+
+        if (tlsf.offsetOf(target) > tlsf.offsetOf(block))
+        {
+            tlsf.release(target);
+            break;
+        }
+
+        unitsMoved += tlsf.sizeOf(block);
+        tlsf.release(block);
+        moves++;
+    }
+
+    double seconds = benchmarkNow() - start;
+
+    benchmarkPrintRow("TLSF compaction step", moves > 0 ? seconds * 1.0e9 / moves : 0.0);
+    printf("%37s%d moves, %llu units moved, fragmentation %.3f, largest free range %u of %u\n", "", moves, unitsMoved, tlsf.fragmentation(), tlsf.largestFreeRange(), tlsf.freeUnits());
+}
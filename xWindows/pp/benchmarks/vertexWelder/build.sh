@@ -0,0 +1,3 @@
+#!/bin/bash
+
+g++ -O2 -I../../common -o vertexWelder vertexWelder.cpp
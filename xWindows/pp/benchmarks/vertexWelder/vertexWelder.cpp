@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "vertexWelder.h"
+#include "benchmark.h"
+
+// Triangle soups of up to 10M vertices, each the grid of a wavy surface written out as two
+// triangles per quad, so every interior vertex shows up six times. Position, normal and texture
+// coordinates like the sphere builders weld.
+#define FLOATS_PER_VERTEX 8
+#define EPSILON 0.00001f
+#define LARGEST_SOUP (10 * 1000 * 1000)
+#define LARGEST_SCAN (100 * 1000)
+
+std::vector<float> soup;
+std::vector<unsigned int> indices;
+std::vector<unsigned int> scanIndices;
+
+void buildSoup(int count);
+int weldByScan(int count, std::vector<float>& welded);
+void measure(int count);
+
+int main(void)
+{
+    printf("Vertex welding, %d floats per vertex, epsilon %g.\n", FLOATS_PER_VERTEX, EPSILON);
+
+    soup.resize((size_t)LARGEST_SOUP * FLOATS_PER_VERTEX);
+    indices.resize(LARGEST_SOUP);
+    scanIndices.resize(LARGEST_SCAN);
+
+    benchmarkPrintHeader("Welding (per soup vertex)", false);
+
+    for (int count = 1000; count <= LARGEST_SOUP; count *= 10)
+    {
+        measure(count);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Each copy of a grid vertex is moved by up to a quarter of epsilon, so welding has to go by the
+// epsilon and can't rely on exact equality, and copies regularly land in different hash cells.
+void buildSoup(int count)
+{
+    int quads = (int)ceil(sqrt(count / 6.0));
+    float step = 1.0f / (float)quads;
+    int corners[6][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 0 }, { 1, 1 }, { 0, 1 } };
+    int written = 0;
+
+    srand(1337);
+
+    for (int row = 0; row < quads && written < count; row++)
+    {
+        for (int column = 0; column < quads && written < count; column++)
+        {
+            for (int k = 0; k < 6 && written < count; k++)
+            {
+                float u = (float)(column + corners[k][0]) * step;
+                float v = (float)(row + corners[k][1]) * step;
+                float height = 0.1f * sinf(u * 20.0f) * cosf(v * 20.0f);
+                float dx = -2.0f * cosf(u * 20.0f) * cosf(v * 20.0f);
+                float dz = 2.0f * sinf(u * 20.0f) * sinf(v * 20.0f);
+                float length = sqrtf(dx * dx + 1.0f + dz * dz);
+                float values[FLOATS_PER_VERTEX] = { u, height, v, -dx / length, 1.0f / length, -dz / length, u, v };
+                float *vertex = &soup[(size_t)written * FLOATS_PER_VERTEX];
+
+                for (int i = 0; i < FLOATS_PER_VERTEX; i++)
+                {
+                    vertex[i] = values[i] + EPSILON * 0.25f * ((float)rand() / (float)RAND_MAX - 0.5f);
+                }
+
+                written++;
+            }
+        }
+    }
+}
+
+// What Sphere::addTriangle() did: compare against every vertex so far.
+int weldByScan(int count, std::vector<float>& welded)
+{
+    int weldedCount = 0;
+
+    welded.resize((size_t)count * FLOATS_PER_VERTEX);
+
+    for (int n = 0; n < count; n++)
+    {
+        const float *vertex = &soup[(size_t)n * FLOATS_PER_VERTEX];
+        int j = 0;
+
+        for (j = 0; j < weldedCount; j++)
+        {
+            const float *other = &welded[(size_t)j * FLOATS_PER_VERTEX];
+            int i = 0;
+
+            while (i < FLOATS_PER_VERTEX && fabsf(other[i] - vertex[i]) < EPSILON)
+            {
+                i++;
+            }
+
+            if (i == FLOATS_PER_VERTEX)
+            {
+                break;
+            }
+        }
+
+        if (j == weldedCount)
+        {
+            memcpy(&welded[(size_t)j * FLOATS_PER_VERTEX], vertex, sizeof(float) * FLOATS_PER_VERTEX);
+            weldedCount++;
+        }
+
+        scanIndices[n] = j;
+    }
+
+    return weldedCount;
+}
+
+void measure(int count)
+{
+    char name[64];
+    int weldedCount = 0;
+    double ns = 0.0;
+
+    buildSoup(count);
+
+    if (count <= LARGEST_SCAN)
+    {
+        std::vector<float> welded;
+
+        ns = benchmarkRun([&]() {
+            weldedCount = weldByScan(count, welded);
+            benchmarkKeep(scanIndices[0]);
+        }, count);
+        snprintf(name, sizeof(name), "scan, %d", count);
+        benchmarkPrintRow(name, ns);
+    }
+
+    // A new welder per run, so growing the arrays is part of the measurement.
+    ns = benchmarkRun([&]() {
+        VertexWelder welder(FLOATS_PER_VERTEX, EPSILON);
+        welder.addAll(&soup[0], count, &indices[0]);
+        weldedCount = welder.getVertexCount();
+        benchmarkKeep(indices[0]);
+    }, count);
+    snprintf(name, sizeof(name), "spatial hash, %d", count);
+    benchmarkPrintRow(name, ns);
+
+    if (count <= LARGEST_SCAN)
+    {
+        int differences = 0;
+
+        for (int n = 0; n < count; n++)
+        {
+            differences += indices[n] != scanIndices[n];
+        }
+
+        printf("%-36s welded to %d vertices, %d indices differ from scan\n", "", weldedCount, differences);
+    }
+    else
+    {
+        printf("%-36s welded to %d vertices\n", "", weldedCount);
+    }
+}
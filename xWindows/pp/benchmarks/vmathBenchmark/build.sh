@@ -0,0 +1,7 @@
+#!/bin/bash
+
+# Pass the directory of another vmath.h copy to measure that one instead of common/vmath.h,
+# e.g. ./build.sh ../../09-pyramidAndCubeRotation
+VMATH_DIR=${1:-../../common}
+
+g++ -O2 -mavx2 -mfma -I$VMATH_DIR -I../../common -DVMATH_SOURCE=\"$VMATH_DIR\" -o vmathBenchmark vmathBenchmark.cpp
@@ -0,0 +1,629 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+// vmath.h is included first so that the copy picked by build.sh wins over common/vmath.h.
+#include "vmath.h"
+#include "vmathSimdOps.h"
+#include "vmathQuaternionBatch.h"
+#include "benchmark.h"
+
+#ifndef VMATH_SOURCE
+#define VMATH_SOURCE "../../common"
+#endif
+
+// Number of inputs per run, a multiple of 8. Small enough to stay in L1/L2 so that the numbers
+// show the cost of the math rather than memory bandwidth.
+#define NUMBER_OF_ITEMS 4096
+#define NUMBER_OF_BLOCKS (NUMBER_OF_ITEMS / 8)
+
+std::vector<vmath::mat4> matricesA;
+std::vector<vmath::mat4> matricesB;
+std::vector<vmath::mat4> matricesResult;
+std::vector<vmath::vec4> vectors4;
+std::vector<vmath::vec4> vectors4Result;
+std::vector<vmath::vec3> vectorsA;
+std::vector<vmath::vec3> vectorsB;
+std::vector<vmath::vec3> vectorsResult;
+std::vector<vmath::vec3x8> vectorBlocksA;
+std::vector<vmath::vec3x8> vectorBlocksB;
+std::vector<vmath::vec3x8> vectorBlocksResult;
+std::vector<vmath::quaternion> quaternionsA;
+std::vector<vmath::quaternion> quaternionsB;
+std::vector<vmath::quaternion> quaternionsResult;
+std::vector<vmath::quaternion8> quaternionBlocksA;
+std::vector<vmath::quaternion8> quaternionBlocksB;
+std::vector<vmath::quaternion8> quaternionBlocksResult;
+std::vector<float> angles;
+std::vector<float> factors;
+
+float randomFloat(float low, float high);
+void initializeData(void);
+vmath::dmat4 toDouble(const vmath::mat4& m);
+vmath::dvec3 toDouble(const vmath::vec3& v);
+vmath::dquaternion toDouble(const vmath::quaternion& q);
+double matrixUlpError(const vmath::mat4& m, const vmath::dmat4& reference);
+double vectorUlpError(const float *v, const double *reference, int size);
+void measureMatrices(void);
+void measureConstruction(void);
+void measureVectors(void);
+void measureQuaternions(void);
+
+int main(void)
+{
+#if defined(__AVX__)
+    printf("vmath benchmark, AVX build, vmath.h from %s, %d items per run.\n", VMATH_SOURCE, NUMBER_OF_ITEMS);
+#else
+    printf("vmath benchmark, scalar fallback build, vmath.h from %s, %d items per run.\n", VMATH_SOURCE, NUMBER_OF_ITEMS);
+#endif
+    printf("Max ULP is measured against the same operation evaluated in double precision.\n");
+
+    initializeData();
+    measureMatrices();
+    measureConstruction();
+    measureVectors();
+    measureQuaternions();
+
+    return EXIT_SUCCESS;
+}
+
+float randomFloat(float low, float high)
+{
+    return low + (high - low) * ((float)rand() / (float)RAND_MAX);
+}
+
+void initializeData(void)
+{
+    srand(1337);
+
+    matricesA.resize(NUMBER_OF_ITEMS);
+    matricesB.resize(NUMBER_OF_ITEMS);
+    matricesResult.resize(NUMBER_OF_ITEMS);
+    vectors4.resize(NUMBER_OF_ITEMS);
+    vectors4Result.resize(NUMBER_OF_ITEMS);
+    vectorsA.resize(NUMBER_OF_ITEMS);
+    vectorsB.resize(NUMBER_OF_ITEMS);
+    vectorsResult.resize(NUMBER_OF_ITEMS);
+    vectorBlocksA.resize(NUMBER_OF_BLOCKS);
+    vectorBlocksB.resize(NUMBER_OF_BLOCKS);
+    vectorBlocksResult.resize(NUMBER_OF_BLOCKS);
+    quaternionsA.resize(NUMBER_OF_ITEMS);
+    quaternionsB.resize(NUMBER_OF_ITEMS);
+    quaternionsResult.resize(NUMBER_OF_ITEMS);
+    quaternionBlocksA.resize(NUMBER_OF_BLOCKS);
+    quaternionBlocksB.resize(NUMBER_OF_BLOCKS);
+    quaternionBlocksResult.resize(NUMBER_OF_BLOCKS);
+    angles.resize(NUMBER_OF_ITEMS);
+    factors.resize(NUMBER_OF_ITEMS);
+
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                matricesA[i][column][row] = randomFloat(-1.0f, 1.0f);
+                matricesB[i][column][row] = randomFloat(-1.0f, 1.0f);
+            }
+        }
+
+        vectors4[i] = vmath::vec4(randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f), 1.0f);
+        vectorsA[i] = vmath::vec3(randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f));
+        vectorsB[i] = vmath::vec3(randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f), randomFloat(-10.0f, 10.0f));
+
+        quaternionsA[i] = vmath::normalize(vmath::quaternion(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f)));
+        quaternionsB[i] = vmath::normalize(vmath::quaternion(randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f), randomFloat(-1.0f, 1.0f)));
+
+        angles[i] = randomFloat(-360.0f, 360.0f);
+        factors[i] = randomFloat(0.0f, 1.0f);
+    }
+
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::loadVec3x8(&vectorsA[i * 8], vectorBlocksA[i]);
+        vmath::loadVec3x8(&vectorsB[i * 8], vectorBlocksB[i]);
+        vmath::loadQuaternion8(&quaternionsA[i * 8], quaternionBlocksA[i]);
+        vmath::loadQuaternion8(&quaternionsB[i * 8], quaternionBlocksB[i]);
+    }
+}
+
+vmath::dmat4 toDouble(const vmath::mat4& m)
+{
+    vmath::dmat4 result;
+
+    for (int column = 0; column < 4; column++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            result[column][row] = m[column][row];
+        }
+    }
+
+    return result;
+}
+
+vmath::dvec3 toDouble(const vmath::vec3& v)
+{
+    return vmath::dvec3(v[0], v[1], v[2]);
+}
+
+vmath::dquaternion toDouble(const vmath::quaternion& q)
+{
+    return vmath::dquaternion(q[0], q[1], q[2], q[3]);
+}
+
+double matrixUlpError(const vmath::mat4& m, const vmath::dmat4& reference)
+{
+    double maxUlp = 0.0;
+
+    for (int column = 0; column < 4; column++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            maxUlp = fmax(maxUlp, benchmarkUlpError(m[column][row], reference[column][row]));
+        }
+    }
+
+    return maxUlp;
+}
+
+double vectorUlpError(const float *v, const double *reference, int size)
+{
+    double maxUlp = 0.0;
+
+    for (int n = 0; n < size; n++)
+    {
+        maxUlp = fmax(maxUlp, benchmarkUlpError(v[n], reference[n]));
+    }
+
+    return maxUlp;
+}
+
+void measureMatrices(void)
+{
+    double ns = 0.0;
+    double maxUlp = 0.0;
+
+    benchmarkPrintHeader("Matrix operations (per matrix)");
+
+    // mat4 * mat4
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            matricesResult[i] = matricesA[i] * matricesB[i];
+        }
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], toDouble(matricesA[i]) * toDouble(matricesB[i])));
+    }
+    benchmarkPrintRow("mat4 * mat4 scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            vmath::multiplySimd(matricesA[i], matricesB[i], matricesResult[i]);
+        }
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], toDouble(matricesA[i]) * toDouble(matricesB[i])));
+    }
+    benchmarkPrintRow("mat4 * mat4 simd", ns, maxUlp);
+
+    // vec4 * mat4
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            vectors4Result[i] = vectors4[i] * matricesA[i];
+        }
+        benchmarkKeep(vectors4Result[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dvec4 v(vectors4[i][0], vectors4[i][1], vectors4[i][2], vectors4[i][3]);
+        vmath::dvec4 reference = v * toDouble(matricesA[i]);
+        maxUlp = fmax(maxUlp, vectorUlpError(vectors4Result[i], reference, 4));
+    }
+    benchmarkPrintRow("vec4 * mat4 scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            vmath::multiplySimd(vectors4[i], matricesA[i], vectors4Result[i]);
+        }
+        benchmarkKeep(vectors4Result[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dvec4 v(vectors4[i][0], vectors4[i][1], vectors4[i][2], vectors4[i][3]);
+        vmath::dvec4 reference = v * toDouble(matricesA[i]);
+        maxUlp = fmax(maxUlp, vectorUlpError(vectors4Result[i], reference, 4));
+    }
+    benchmarkPrintRow("vec4 * mat4 simd", ns, maxUlp);
+
+    // Transpose, exact in both variants.
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            matricesResult[i] = matricesA[i].transpose();
+        }
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], toDouble(matricesA[i]).transpose()));
+    }
+    benchmarkPrintRow("transpose scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            vmath::transposeSimd(matricesA[i], matricesResult[i]);
+        }
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], toDouble(matricesA[i]).transpose()));
+    }
+    benchmarkPrintRow("transpose simd", ns, maxUlp);
+}
+
+void measureConstruction(void)
+{
+    double ns = 0.0;
+    double maxUlp = 0.0;
+
+    benchmarkPrintHeader("Matrix construction (per matrix, scalar only)");
+
+    // rotate(angle, axis), with the reference using the exact degree to radian factor.
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            vmath::vec3 axis = vmath::normalize(vectorsA[i]);
+            matricesResult[i] = vmath::rotate(angles[i], axis[0], axis[1], axis[2]);
+        }
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::vec3 axis = vmath::normalize(vectorsA[i]);
+        double x = axis[0];
+        double y = axis[1];
+        double z = axis[2];
+        double radians = (double)angles[i] * M_PI / 180.0;
+        double c = cos(radians);
+        double s = sin(radians);
+        double omc = 1.0 - c;
+
+        vmath::dmat4 reference;
+        reference[0] = vmath::dvec4(x * x * omc + c, y * x * omc + z * s, x * z * omc - y * s, 0.0);
+        reference[1] = vmath::dvec4(x * y * omc - z * s, y * y * omc + c, y * z * omc + x * s, 0.0);
+        reference[2] = vmath::dvec4(x * z * omc + y * s, y * z * omc - x * s, z * z * omc + c, 0.0);
+        reference[3] = vmath::dvec4(0.0, 0.0, 0.0, 1.0);
+
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], reference));
+    }
+    benchmarkPrintRow("rotate", ns, maxUlp);
+
+    // perspective(fovy, aspect, near, far)
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            matricesResult[i] = vmath::perspective(30.0f + factors[i] * 60.0f, 0.5f + factors[i], 0.1f, 100.0f);
+        }
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        double fovy = 30.0f + factors[i] * 60.0f;
+        double aspect = 0.5f + factors[i];
+        double n = 0.1f;
+        double f = 100.0f;
+        double q = 1.0 / tan(fovy * 0.5 * M_PI / 180.0);
+
+        vmath::dmat4 reference;
+        reference[0] = vmath::dvec4(q / aspect, 0.0, 0.0, 0.0);
+        reference[1] = vmath::dvec4(0.0, q, 0.0, 0.0);
+        reference[2] = vmath::dvec4(0.0, 0.0, (n + f) / (n - f), -1.0);
+        reference[3] = vmath::dvec4(0.0, 0.0, (2.0 * n * f) / (n - f), 0.0);
+
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], reference));
+    }
+    benchmarkPrintRow("perspective", ns, maxUlp);
+
+    // lookat(eye, center, up)
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            matricesResult[i] = vmath::lookat(vectorsA[i], vectorsB[i], vmath::vec3(0.0f, 1.0f, 0.0f));
+        }
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dmat4 reference = vmath::lookat(toDouble(vectorsA[i]), toDouble(vectorsB[i]), vmath::dvec3(0.0, 1.0, 0.0));
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], reference));
+    }
+    benchmarkPrintRow("lookat", ns, maxUlp);
+}
+
+void measureVectors(void)
+{
+    double ns = 0.0;
+    double maxUlp = 0.0;
+
+    benchmarkPrintHeader("Vector operations (per vector)");
+
+    // normalize(vec3)
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            vectorsResult[i] = vmath::normalize(vectorsA[i]);
+        }
+        benchmarkKeep(vectorsResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dvec3 reference = vmath::normalize(toDouble(vectorsA[i]));
+        maxUlp = fmax(maxUlp, vectorUlpError(vectorsResult[i], reference, 3));
+    }
+    benchmarkPrintRow("normalize scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        vmath::normalizeBatch(&vectorBlocksA[0], &vectorBlocksResult[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(vectorBlocksResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::storeVec3x8(vectorBlocksResult[i], &vectorsResult[i * 8]);
+    }
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dvec3 reference = vmath::normalize(toDouble(vectorsA[i]));
+        maxUlp = fmax(maxUlp, vectorUlpError(vectorsResult[i], reference, 3));
+    }
+    benchmarkPrintRow("normalize batch", ns, maxUlp);
+
+    // cross(vec3, vec3)
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            vectorsResult[i] = vmath::cross(vectorsA[i], vectorsB[i]);
+        }
+        benchmarkKeep(vectorsResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dvec3 reference = vmath::cross(toDouble(vectorsA[i]), toDouble(vectorsB[i]));
+        maxUlp = fmax(maxUlp, vectorUlpError(vectorsResult[i], reference, 3));
+    }
+    benchmarkPrintRow("cross scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        vmath::crossBatch(&vectorBlocksA[0], &vectorBlocksB[0], &vectorBlocksResult[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(vectorBlocksResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::storeVec3x8(vectorBlocksResult[i], &vectorsResult[i * 8]);
+    }
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dvec3 reference = vmath::cross(toDouble(vectorsA[i]), toDouble(vectorsB[i]));
+        maxUlp = fmax(maxUlp, vectorUlpError(vectorsResult[i], reference, 3));
+    }
+    benchmarkPrintRow("cross batch", ns, maxUlp);
+}
+
+void measureQuaternions(void)
+{
+    double ns = 0.0;
+    double maxUlp = 0.0;
+    double reference[4];
+
+    benchmarkPrintHeader("Quaternion operations (per quaternion)");
+
+    // Quaternion product.
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            quaternionsResult[i] = quaternionsA[i] * quaternionsB[i];
+        }
+        benchmarkKeep(quaternionsResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dquaternion q = toDouble(quaternionsA[i]) * toDouble(quaternionsB[i]);
+        for (int n = 0; n < 4; n++)
+        {
+            maxUlp = fmax(maxUlp, benchmarkUlpError(quaternionsResult[i][n], q[n]));
+        }
+    }
+    benchmarkPrintRow("quaternion * quaternion scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        vmath::multiplyBatch(&quaternionBlocksA[0], &quaternionBlocksB[0], &quaternionBlocksResult[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(quaternionBlocksResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::storeQuaternion8(quaternionBlocksResult[i], &quaternionsResult[i * 8]);
+    }
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dquaternion q = toDouble(quaternionsA[i]) * toDouble(quaternionsB[i]);
+        for (int n = 0; n < 4; n++)
+        {
+            maxUlp = fmax(maxUlp, benchmarkUlpError(quaternionsResult[i][n], q[n]));
+        }
+    }
+    benchmarkPrintRow("quaternion * quaternion batch", ns, maxUlp);
+
+    // Normalize, on the unnormalized products so that there is something to do.
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        quaternionsB[i] = quaternionsA[i] * 3.0f;
+    }
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::loadQuaternion8(&quaternionsB[i * 8], quaternionBlocksB[i]);
+    }
+
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            quaternionsResult[i] = vmath::normalize(quaternionsB[i]);
+        }
+        benchmarkKeep(quaternionsResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dquaternion q = vmath::normalize(toDouble(quaternionsB[i]));
+        for (int n = 0; n < 4; n++)
+        {
+            maxUlp = fmax(maxUlp, benchmarkUlpError(quaternionsResult[i][n], q[n]));
+        }
+    }
+    benchmarkPrintRow("quaternion normalize scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        vmath::normalizeBatch(&quaternionBlocksB[0], &quaternionBlocksResult[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(quaternionBlocksResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::storeQuaternion8(quaternionBlocksResult[i], &quaternionsResult[i * 8]);
+    }
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dquaternion q = vmath::normalize(toDouble(quaternionsB[i]));
+        for (int n = 0; n < 4; n++)
+        {
+            maxUlp = fmax(maxUlp, benchmarkUlpError(quaternionsResult[i][n], q[n]));
+        }
+    }
+    benchmarkPrintRow("quaternion normalize batch", ns, maxUlp);
+
+    // Quaternion to matrix.
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            vmath::quaternionToMatrix(quaternionsA[i], matricesResult[i]);
+        }
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], toDouble(quaternionsA[i]).asMatrix()));
+    }
+    benchmarkPrintRow("quaternionToMatrix scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        vmath::quaternionToMatrixBatch(&quaternionBlocksA[0], &matricesResult[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(matricesResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        maxUlp = fmax(maxUlp, matrixUlpError(matricesResult[i], toDouble(quaternionsA[i]).asMatrix()));
+    }
+    benchmarkPrintRow("quaternionToMatrix batch", ns, maxUlp);
+
+    // Slerp between the original pairs, compared against slerp in double precision.
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        quaternionsB[i] = vmath::normalize(quaternionsB[i] * quaternionsA[(i + 1) % NUMBER_OF_ITEMS]);
+    }
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::loadQuaternion8(&quaternionsB[i * 8], quaternionBlocksB[i]);
+    }
+
+    ns = benchmarkRun([&]() {
+        for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+        {
+            quaternionsResult[i] = vmath::slerp(quaternionsA[i], quaternionsB[i], factors[i]);
+        }
+        benchmarkKeep(quaternionsResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dquaternion q = vmath::slerp(toDouble(quaternionsA[i]), toDouble(quaternionsB[i]), (double)factors[i]);
+        for (int n = 0; n < 4; n++)
+        {
+            reference[n] = q[n];
+        }
+        maxUlp = fmax(maxUlp, vectorUlpError(&quaternionsResult[i][0], reference, 4));
+    }
+    benchmarkPrintRow("slerp scalar", ns, maxUlp);
+
+    ns = benchmarkRun([&]() {
+        vmath::slerpBatch(&quaternionBlocksA[0], &quaternionBlocksB[0], &factors[0], &quaternionBlocksResult[0], NUMBER_OF_BLOCKS);
+        benchmarkKeep(quaternionBlocksResult[0]);
+    }, NUMBER_OF_ITEMS);
+
+    for (int i = 0; i < NUMBER_OF_BLOCKS; i++)
+    {
+        vmath::storeQuaternion8(quaternionBlocksResult[i], &quaternionsResult[i * 8]);
+    }
+
+    maxUlp = 0.0;
+    for (int i = 0; i < NUMBER_OF_ITEMS; i++)
+    {
+        vmath::dquaternion q = vmath::slerp(toDouble(quaternionsA[i]), toDouble(quaternionsB[i]), (double)factors[i]);
+        for (int n = 0; n < 4; n++)
+        {
+            reference[n] = q[n];
+        }
+        maxUlp = fmax(maxUlp, vectorUlpError(&quaternionsResult[i][0], reference, 4));
+    }
+    benchmarkPrintRow("slerp batch", ns, maxUlp);
+}
@@ -0,0 +1,110 @@
+#ifndef __BENCHMARK_H__
+#define __BENCHMARK_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// Small helpers shared by the programs in xWindows/pp/benchmarks.
+
+static inline double benchmarkNow(void)
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1.0e-9;
+}
+
+// Keeps the compiler from optimizing away a result that is otherwise unused.
+template <typename T>
+static inline void benchmarkKeep(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs body() repeatedly until at least minimumSeconds have passed and returns the best
+// nanoseconds per operation over five such rounds, body() performing operationsPerCall operations.
+template <typename Body>
+static inline double benchmarkRun(Body body, double operationsPerCall, double minimumSeconds = 0.05)
+{
+    double best = 1.0e30;
+
+    for (int round = 0; round < 5; round++)
+    {
+        long calls = 0;
+        double start = benchmarkNow();
+        double elapsed = 0.0;
+
+        do
+        {
+            body();
+            calls++;
+            elapsed = benchmarkNow() - start;
+        } while (elapsed < minimumSeconds);
+
+        double nsPerOperation = elapsed * 1.0e9 / ((double)calls * operationsPerCall);
+
+        if (nsPerOperation < best)
+        {
+            best = nsPerOperation;
+        }
+    }
+
+    return best;
+}
+
+// Distance in units in the last place between a float result and a double precision reference.
+static inline double benchmarkUlpError(float value, double reference)
+{
+    float rounded = (float)reference;
+    float ulp = nextafterf(fabsf(rounded), INFINITY) - fabsf(rounded);
+
+    // Results that should be zero are compared against the smallest normal ulp around 1.0 instead,
+    // otherwise any rounding noise would show up as millions of denormal ulps.
+    if (ulp < 1.0e-7f)
+    {
+        ulp = 1.0e-7f;
+    }
+
+    return fabs((double)value - reference) / (double)ulp;
+}
+
+// Tables of timings only, where an error means nothing, leave out the Max ULP column and print
+// their rows without one.
+static inline void benchmarkPrintHeader(const char *title, bool hasUlpColumn = true)
+{
+    printf("\n%s\n", title);
+
+    if (hasUlpColumn)
+    {
+        printf("%-36s %12s %14s %12s\n", "Operation", "ns/op", "Mop/s", "Max ULP");
+        printf("------------------------------------------------------------------------------\n");
+    }
+    else
+    {
+        printf("%-36s %12s %14s\n", "Operation", "ns/op", "Mop/s");
+        printf("-----------------------------------------------------------------\n");
+    }
+}
+
+// A row of a table with the Max ULP column, "-" when maxUlp is negative.
+static inline void benchmarkPrintRow(const char *name, double nsPerOperation, double maxUlp)
+{
+    if (maxUlp < 0.0)
+    {
+        printf("%-36s %12.3f %14.2f %12s\n", name, nsPerOperation, 1.0e3 / nsPerOperation, "-");
+    }
+    else
+    {
+        printf("%-36s %12.3f %14.2f %12.2f\n", name, nsPerOperation, 1.0e3 / nsPerOperation, maxUlp);
+    }
+}
+
+// A row of a table without it.
+static inline void benchmarkPrintRow(const char *name, double nsPerOperation)
+{
+    printf("%-36s %12.3f %14.2f\n", name, nsPerOperation, 1.0e3 / nsPerOperation);
+}
+
+#endif /* __BENCHMARK_H__ */
@@ -0,0 +1,614 @@
+#ifndef __BEZIER_TESSELLATOR_H__
+#define __BEZIER_TESSELLATOR_H__
+
+#include <math.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+#include "vmath.h"
+#include "vmathSimd.h"
+
+// Cubic Bezier curves and bicubic Bezier patches tessellated on the CPU into plain vertex and
+// element arrays, for when tessellation shaders are missing or slower than doing it up front.
+//
+// Segment counts adapt to the screen: with n segments a cubic is off from its polyline by at most
+// 3/4 * M / n^2, where M is the largest second difference of its control points in pixels, so n
+// is the smallest count keeping that under the tolerance set with setTolerance().
+//
+// Patches take a power of two level per direction, at least the level of each edge curve. Every
+// boundary vertex is put on the polyline of its edge at the edge's own level, which only depends
+// on the four control points of that edge, so two patches sharing an edge meet without cracks
+// whatever their interior levels. Vertices are evaluated eight at a time with vmath::float8 by
+// Horner's rule on the power basis form of the patch, curves by forward differencing. Large
+// patch sets are split across worker threads that live as long as the tessellator.
+
+#define BEZIER_MAXIMUM_SEGMENTS 64
+
+// Four control points, x y z each.
+struct BezierCurve
+{
+    float points[4][3];
+};
+
+// Sixteen control points in four rows along u, the rows going along v. Normals point along
+// dS/du x dS/dv.
+struct BezierPatch
+{
+    float points[4][4][3];
+};
+
+class BezierTessellator
+{
+public:
+    // Floats per patch vertex: position, then normal.
+    enum
+    {
+        FLOATS_PER_VERTEX = 6
+    };
+
+    // threadCount counts the calling thread, 0 means one per hardware thread.
+    explicit BezierTessellator(int threadCount = 0)
+    {
+        if(threadCount <= 0)
+        {
+            threadCount = (int)std::thread::hardware_concurrency();
+        }
+
+        threads = threadCount > 1 ? threadCount : 1;
+        generation = 0;
+        pending = 0;
+        isStopping = false;
+        tolerance = 0.5f;
+        width = 1;
+        height = 1;
+        mvpMatrix = vmath::mat4::identity();
+
+        currentPatches = NULL;
+        currentCount = 0;
+        currentPhase = PHASE_LEVELS;
+        currentVertices = NULL;
+        currentElements = NULL;
+
+        for(int n = 1; n < threads; n++)
+        {
+            workers.push_back(std::thread(&BezierTessellator::workerMain, this, n));
+        }
+    }
+
+    ~BezierTessellator()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopping = true;
+            generation++;
+        }
+
+        wakeUp.notify_all();
+
+        for(size_t n = 0; n < workers.size(); n++)
+        {
+            workers[n].join();
+        }
+    }
+
+    // The projection the error is measured in: control points go through mvpMatrix into a
+    // viewport of width by height pixels.
+    void setView(const vmath::mat4& mvpMatrix, int width, int height)
+    {
+        this->mvpMatrix = mvpMatrix;
+        this->width = width > 0 ? width : 1;
+        this->height = height > 0 ? height : 1;
+    }
+
+    // Largest distance in pixels allowed between a curve and its polyline.
+    void setTolerance(float pixels)
+    {
+        tolerance = pixels > 0.01f ? pixels : 0.01f;
+    }
+
+    float getTolerance(void) const
+    {
+        return tolerance;
+    }
+
+    int threadCount(void) const
+    {
+        return threads;
+    }
+
+    // Segments curve needs on screen, 1 to BEZIER_MAXIMUM_SEGMENTS.
+    int getCurveSegments(const BezierCurve& curve) const
+    {
+        float screen[4][2];
+        bool isVisible = true;
+
+        for(int point = 0; point < 4; point++)
+        {
+            isVisible = project(curve.points[point], screen[point]) && isVisible;
+        }
+
+        return isVisible ? segmentsFor(secondDifference(screen[0], screen[1], screen[2], screen[3])) : BEZIER_MAXIMUM_SEGMENTS;
+    }
+
+    // Writes segments + 1 points, 3 floats each, from t = 0 to t = 1 by forward differencing.
+    static void evaluateCurve(const BezierCurve& curve, int segments, float *points)
+    {
+        float h = 1.0f / (float)segments;
+
+        for(int axis = 0; axis < 3; axis++)
+        {
+            float a[4];
+            powerBasis(curve.points[0][axis], curve.points[1][axis], curve.points[2][axis], curve.points[3][axis], a);
+
+            // p(t) = a0 + a1 t + a2 t^2 + a3 t^3 and its first three forward differences at 0.
+            float p = a[0];
+            float d1 = a[3] * h * h * h + a[2] * h * h + a[1] * h;
+            float d2 = 6.0f * a[3] * h * h * h + 2.0f * a[2] * h * h;
+            float d3 = 6.0f * a[3] * h * h * h;
+
+            for(int point = 0; point <= segments; point++)
+            {
+                points[point * 3 + axis] = p;
+                p += d1;
+                d1 += d2;
+                d2 += d3;
+            }
+
+            // The last point is the end point exactly, whatever rounding built up on the way.
+            points[segments * 3 + axis] = curve.points[3][axis];
+        }
+    }
+
+    // Appends each curve as a line strip of 3 float vertices, with its first vertex and vertex
+    // count, ready for glMultiDrawArrays(GL_LINE_STRIP, ...).
+    void tessellateCurves(const BezierCurve *curves, int count, std::vector<float> *vertices, std::vector<int> *firsts, std::vector<int> *counts) const
+    {
+        for(int curve = 0; curve < count; curve++)
+        {
+            int segments = getCurveSegments(curves[curve]);
+            size_t first = vertices->size();
+
+            vertices->resize(first + (segments + 1) * 3);
+            evaluateCurve(curves[curve], segments, &(*vertices)[first]);
+
+            firsts->push_back((int)(first / 3));
+            counts->push_back(segments + 1);
+        }
+    }
+
+    // Replaces vertices (FLOATS_PER_VERTEX floats each) and elements (triangles, counter
+    // clockwise around the normal) with the tessellation of all patches.
+    void tessellatePatches(const BezierPatch *patches, int count, std::vector<float> *vertices, std::vector<unsigned int> *elements)
+    {
+        levels.resize(count);
+        run(patches, count, PHASE_LEVELS, NULL, NULL);
+
+        unsigned int numberOfVertices = 0;
+        unsigned int numberOfElements = 0;
+
+        for(int patch = 0; patch < count; patch++)
+        {
+            levels[patch].firstVertex = numberOfVertices;
+            levels[patch].firstElement = numberOfElements;
+            numberOfVertices += (levels[patch].u + 1) * (levels[patch].v + 1);
+            numberOfElements += levels[patch].u * levels[patch].v * 6;
+        }
+
+        vertices->resize((size_t)numberOfVertices * FLOATS_PER_VERTEX);
+        elements->resize(numberOfElements);
+
+        if(count > 0)
+        {
+            run(patches, count, PHASE_VERTICES, &(*vertices)[0], &(*elements)[0]);
+        }
+    }
+
+    // Levels the last tessellatePatches() used for patch, along u and along v.
+    void getPatchLevels(int patch, int *u, int *v) const
+    {
+        *u = levels[patch].u;
+        *v = levels[patch].v;
+    }
+
+private:
+    enum Phase
+    {
+        PHASE_LEVELS,
+        PHASE_VERTICES
+    };
+
+    // Edges in the order bottom (v = 0), right (u = 1), top (v = 1), left (u = 0).
+    struct PatchLevels
+    {
+        int u;
+        int v;
+        int edges[4];
+        unsigned int firstVertex;
+        unsigned int firstElement;
+    };
+
+    vmath::mat4 mvpMatrix;
+    int width;
+    int height;
+    float tolerance;
+    std::vector<PatchLevels> levels;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+    const BezierPatch *currentPatches;
+    int currentCount;
+    Phase currentPhase;
+    float *currentVertices;
+    unsigned int *currentElements;
+    unsigned int generation;
+    int pending;
+    int threads;
+    bool isStopping;
+
+    // Coefficients of the same cubic as a0 + a1 t + a2 t^2 + a3 t^3.
+    static void powerBasis(float p0, float p1, float p2, float p3, float *a)
+    {
+        a[0] = p0;
+        a[1] = 3.0f * (p1 - p0);
+        a[2] = 3.0f * (p0 - 2.0f * p1 + p2);
+        a[3] = -p0 + 3.0f * (p1 - p2) + p3;
+    }
+
+    // Pixel position of point, false when it is behind the eye.
+    bool project(const float *point, float *screen) const
+    {
+        // m[column][row], like OpenGL.
+        const vmath::mat4& m = mvpMatrix;
+        float x = m[0][0] * point[0] + m[1][0] * point[1] + m[2][0] * point[2] + m[3][0];
+        float y = m[0][1] * point[0] + m[1][1] * point[1] + m[2][1] * point[2] + m[3][1];
+        float w = m[0][3] * point[0] + m[1][3] * point[1] + m[2][3] * point[2] + m[3][3];
+
+        if(w <= 1.0e-4f)
+        {
+            return false;
+        }
+
+        screen[0] = x / w * 0.5f * (float)width;
+        screen[1] = y / w * 0.5f * (float)height;
+        return true;
+    }
+
+    static float secondDifference(const float *s0, const float *s1, const float *s2, const float *s3)
+    {
+        float ax = s0[0] - 2.0f * s1[0] + s2[0];
+        float ay = s0[1] - 2.0f * s1[1] + s2[1];
+        float bx = s1[0] - 2.0f * s2[0] + s3[0];
+        float by = s1[1] - 2.0f * s2[1] + s3[1];
+        float a = ax * ax + ay * ay;
+        float b = bx * bx + by * by;
+
+        return sqrtf(a > b ? a : b);
+    }
+
+    int segmentsFor(float secondDifference) const
+    {
+        float segments = ceilf(sqrtf(0.75f * secondDifference / tolerance));
+
+        if(segments < 1.0f)
+        {
+            return 1;
+        }
+
+        return segments < (float)BEZIER_MAXIMUM_SEGMENTS ? (int)segments : BEZIER_MAXIMUM_SEGMENTS;
+    }
+
+    static int nextPowerOfTwo(int value)
+    {
+        int power = 1;
+
+        while(power < value)
+        {
+            power <<= 1;
+        }
+
+        return power;
+    }
+
+    void computeLevels(const BezierPatch& patch, PatchLevels *level) const
+    {
+        float screen[4][4][2];
+        bool isVisible = true;
+
+        for(int row = 0; row < 4; row++)
+        {
+            for(int column = 0; column < 4; column++)
+            {
+                isVisible = project(patch.points[row][column], screen[row][column]) && isVisible;
+            }
+        }
+
+        // A patch crossing the eye plane has no meaningful screen size, so it gets the most.
+        if(!isVisible)
+        {
+            level->u = BEZIER_MAXIMUM_SEGMENTS;
+            level->v = BEZIER_MAXIMUM_SEGMENTS;
+
+            for(int edge = 0; edge < 4; edge++)
+            {
+                level->edges[edge] = BEZIER_MAXIMUM_SEGMENTS;
+            }
+
+            return;
+        }
+
+        float alongU[4];
+        float alongV[4];
+
+        for(int n = 0; n < 4; n++)
+        {
+            alongU[n] = secondDifference(screen[n][0], screen[n][1], screen[n][2], screen[n][3]);
+            alongV[n] = secondDifference(screen[0][n], screen[1][n], screen[2][n], screen[3][n]);
+        }
+
+        level->edges[0] = nextPowerOfTwo(segmentsFor(alongU[0]));
+        level->edges[1] = nextPowerOfTwo(segmentsFor(alongV[3]));
+        level->edges[2] = nextPowerOfTwo(segmentsFor(alongU[3]));
+        level->edges[3] = nextPowerOfTwo(segmentsFor(alongV[0]));
+
+        // The interior rows and columns include the edges, so these are never below them.
+        float maximumU = alongU[0];
+        float maximumV = alongV[0];
+
+        for(int n = 1; n < 4; n++)
+        {
+            maximumU = alongU[n] > maximumU ? alongU[n] : maximumU;
+            maximumV = alongV[n] > maximumV ? alongV[n] : maximumV;
+        }
+
+        level->u = nextPowerOfTwo(segmentsFor(maximumU));
+        level->v = nextPowerOfTwo(segmentsFor(maximumV));
+    }
+
+    // Evaluates the grid of one patch into its range of vertices and elements.
+    void tessellatePatch(const BezierPatch& patch, const PatchLevels& level, float *vertices, unsigned int *elements) const
+    {
+        // coefficients[l][k][axis] multiplies v^l u^k.
+        float coefficients[4][4][3];
+
+        for(int axis = 0; axis < 3; axis++)
+        {
+            float rows[4][4];
+
+            for(int row = 0; row < 4; row++)
+            {
+                powerBasis(patch.points[row][0][axis], patch.points[row][1][axis], patch.points[row][2][axis], patch.points[row][3][axis], rows[row]);
+            }
+
+            for(int k = 0; k < 4; k++)
+            {
+                float a[4];
+                powerBasis(rows[0][k], rows[1][k], rows[2][k], rows[3][k], a);
+
+                for(int l = 0; l < 4; l++)
+                {
+                    coefficients[l][k][axis] = a[l];
+                }
+            }
+        }
+
+        const int columns = level.u + 1;
+        const vmath::float8 laneOffsets = vmath::float8::loadUnaligned(laneIndices());
+        alignas(32) float out[6][8];
+
+        for(int j = 0; j <= level.v; j++)
+        {
+            float v = (float)j / (float)level.v;
+
+            // The row at this v is a cubic in u, and so is the derivative along v.
+            vmath::float8 a[4][3];
+            vmath::float8 d[4][3];
+
+            for(int k = 0; k < 4; k++)
+            {
+                for(int axis = 0; axis < 3; axis++)
+                {
+                    const float c0 = coefficients[0][k][axis];
+                    const float c1 = coefficients[1][k][axis];
+                    const float c2 = coefficients[2][k][axis];
+                    const float c3 = coefficients[3][k][axis];
+
+                    a[k][axis] = vmath::float8(((c3 * v + c2) * v + c1) * v + c0);
+                    d[k][axis] = vmath::float8((3.0f * c3 * v + 2.0f * c2) * v + c1);
+                }
+            }
+
+            for(int i = 0; i < columns; i += 8)
+            {
+                const vmath::float8 u = (laneOffsets + vmath::float8((float)i)) * vmath::float8(1.0f / (float)level.u);
+                vmath::float8 position[3];
+                vmath::float8 tangentU[3];
+                vmath::float8 tangentV[3];
+
+                for(int axis = 0; axis < 3; axis++)
+                {
+                    position[axis] = vmath::madd(vmath::madd(vmath::madd(a[3][axis], u, a[2][axis]), u, a[1][axis]), u, a[0][axis]);
+                    tangentU[axis] = vmath::madd(vmath::madd(a[3][axis] * vmath::float8(3.0f), u, a[2][axis] * vmath::float8(2.0f)), u, a[1][axis]);
+                    tangentV[axis] = vmath::madd(vmath::madd(vmath::madd(d[3][axis], u, d[2][axis]), u, d[1][axis]), u, d[0][axis]);
+                }
+
+                vmath::float8 nx = tangentU[1] * tangentV[2] - tangentU[2] * tangentV[1];
+                vmath::float8 ny = tangentU[2] * tangentV[0] - tangentU[0] * tangentV[2];
+                vmath::float8 nz = tangentU[0] * tangentV[1] - tangentU[1] * tangentV[0];
+                vmath::float8 inverseLength = vmath::float8(1.0f) / vmath::sqrt(vmath::max(nx * nx + ny * ny + nz * nz, vmath::float8(1.0e-20f)));
+
+                position[0].store(out[0]);
+                position[1].store(out[1]);
+                position[2].store(out[2]);
+                (nx * inverseLength).store(out[3]);
+                (ny * inverseLength).store(out[4]);
+                (nz * inverseLength).store(out[5]);
+
+                int lanes = columns - i < 8 ? columns - i : 8;
+
+                for(int lane = 0; lane < lanes; lane++)
+                {
+                    float *vertex = vertices + ((size_t)j * columns + i + lane) * FLOATS_PER_VERTEX;
+
+                    for(int value = 0; value < FLOATS_PER_VERTEX; value++)
+                    {
+                        vertex[value] = out[value][lane];
+                    }
+                }
+            }
+        }
+
+        snapEdges(patch, level, vertices);
+
+        unsigned int first = level.firstVertex;
+
+        for(int j = 0; j < level.v; j++)
+        {
+            for(int i = 0; i < level.u; i++)
+            {
+                unsigned int bottomLeft = first + j * columns + i;
+                unsigned int topLeft = bottomLeft + columns;
+
+                *elements++ = bottomLeft;
+                *elements++ = bottomLeft + 1;
+                *elements++ = topLeft + 1;
+
+                *elements++ = bottomLeft;
+                *elements++ = topLeft + 1;
+                *elements++ = topLeft;
+            }
+        }
+    }
+
+    // Moves the boundary vertices onto the polyline of their edge at the edge level.
+    void snapEdges(const BezierPatch& patch, const PatchLevels& level, float *vertices) const
+    {
+        float polyline[(BEZIER_MAXIMUM_SEGMENTS + 1) * 3];
+        const int columns = level.u + 1;
+
+        for(int edge = 0; edge < 4; edge++)
+        {
+            BezierCurve curve;
+            bool isAlongU = edge == 0 || edge == 2;
+            int fixed = edge == 0 || edge == 3 ? 0 : 3;
+
+            for(int point = 0; point < 4; point++)
+            {
+                const float *control = isAlongU ? patch.points[fixed][point] : patch.points[point][fixed];
+                curve.points[point][0] = control[0];
+                curve.points[point][1] = control[1];
+                curve.points[point][2] = control[2];
+            }
+
+            int segments = level.edges[edge];
+            int count = isAlongU ? level.u : level.v;
+
+            evaluateCurve(curve, segments, polyline);
+
+            for(int n = 0; n <= count; n++)
+            {
+                // count is a multiple of segments, both being powers of two.
+                int step = n * segments;
+                int segment = step / count;
+                float t = (float)(step - segment * count) / (float)count;
+                int index = isAlongU ? (fixed == 0 ? 0 : level.v) * columns + n : n * columns + (fixed == 0 ? 0 : level.u);
+                float *position = vertices + (size_t)index * FLOATS_PER_VERTEX;
+
+                for(int axis = 0; axis < 3; axis++)
+                {
+                    float start = polyline[segment * 3 + axis];
+                    position[axis] = segment < segments ? start + (polyline[(segment + 1) * 3 + axis] - start) * t : start;
+                }
+            }
+        }
+    }
+
+    static const float *laneIndices(void)
+    {
+        static const float indices[8] = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+        return indices;
+    }
+
+    // Runs phase over all patches, the calling thread taking the first share.
+    void run(const BezierPatch *patches, int count, Phase phase, float *vertices, unsigned int *elements)
+    {
+        currentPatches = patches;
+        currentCount = count;
+        currentPhase = phase;
+        currentVertices = vertices;
+        currentElements = elements;
+
+        // Waking the workers costs more than a few patches take.
+        if(threads == 1 || count < threads * 4)
+        {
+            runRange(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = threads - 1;
+            generation++;
+        }
+
+        wakeUp.notify_all();
+        runShare(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return pending == 0; });
+    }
+
+    void runShare(int index)
+    {
+        runRange(currentCount * index / threads, currentCount * (index + 1) / threads);
+    }
+
+    void runRange(int first, int last)
+    {
+        for(int patch = first; patch < last; patch++)
+        {
+            if(currentPhase == PHASE_LEVELS)
+            {
+                computeLevels(currentPatches[patch], &levels[patch]);
+            }
+            else
+            {
+                const PatchLevels& level = levels[patch];
+                tessellatePatch(currentPatches[patch], level, currentVertices + (size_t)level.firstVertex * FLOATS_PER_VERTEX, currentElements + level.firstElement);
+            }
+        }
+    }
+
+    void workerMain(int index)
+    {
+        unsigned int seenGeneration = 0;
+
+        for(;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [&]() { return generation != seenGeneration; });
+                seenGeneration = generation;
+
+                if(isStopping)
+                {
+                    return;
+                }
+            }
+
+            runShare(index);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending--;
+            }
+
+            finished.notify_one();
+        }
+    }
+};
+
+#endif /* __BEZIER_TESSELLATOR_H__ */
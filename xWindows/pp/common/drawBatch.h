@@ -0,0 +1,217 @@
+#ifndef __DRAW_BATCH_H__
+#define __DRAW_BATCH_H__
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <GL/glew.h>
+
+#include "geometryPool.h"
+#include "streamBuffer.h"
+
+// A pass of draws from a GeometryPool submitted with a single glMultiDrawElementsIndirect().
+// add() records a draw command for a pool mesh together with a fixed size block of per draw data,
+// submit() writes the blocks and the commands of the pass into a StreamBuffer, binds the blocks as
+// a shader storage buffer and the commands as the indirect buffer and makes the one call. The
+// shaders find the block of their draw as draws[gl_DrawIDARB], from GL_ARB_shader_draw_parameters
+// (gl_DrawID from GLSL 4.60 on), so what used to be a uniform set between draws, a matrix or which
+// texture to sample, comes from the block instead.
+//
+// All draws of a pass share the pool's VAO, the program and the bound textures, and are triangle
+// lists. appendElements() turns what a sample used to draw with glDrawArrays(), triangles, fans or
+// strips, into elements of the same triangles in the same order for a mesh of the pool. The block
+// size has to be a multiple of 16 bytes so that an array of them has the std430 layout.
+//
+// The pool's VAO has to be bound for submit(). The indirect buffer and the storage buffer binding
+// are bound directly, not through a StateCache. add() keeps the mesh handle and submit() looks up
+// where the mesh is, so the pool may be defragmented in between.
+
+struct DrawElementsIndirectCommand
+{
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+class DrawBatch
+{
+public:
+    DrawBatch(GeometryPool *pool, StreamBuffer *streamBuffer, GLsizeiptr drawDataSize, GLuint drawDataBinding)
+    {
+        this->pool = pool;
+        this->streamBuffer = streamBuffer;
+        this->drawDataSize = drawDataSize;
+        this->drawDataBinding = drawDataBinding;
+        storageAlignment = 256;
+
+        passes = 0;
+        draws = 0;
+        triangles = 0;
+    }
+
+    // Needs GL 4.3 or GL_ARB_multi_draw_indirect and GL_ARB_shader_draw_parameters.
+    bool create(void)
+    {
+        if(!GLEW_VERSION_4_3 && !GLEW_ARB_multi_draw_indirect)
+        {
+            return false;
+        }
+
+        if(!GLEW_VERSION_4_6 && !GLEW_ARB_shader_draw_parameters)
+        {
+            return false;
+        }
+
+        GLint alignment = 0;
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        storageAlignment = alignment > 0 ? alignment : 256;
+
+        return true;
+    }
+
+    // Elements for vertices first to first + count - 1 as mode draws them, GL_TRIANGLES,
+    // GL_TRIANGLE_FAN or GL_TRIANGLE_STRIP, appended as a triangle list. False for other modes.
+    static bool appendElements(GLenum mode, GLuint first, GLuint count, std::vector<GLuint> *elements)
+    {
+        switch(mode)
+        {
+            case GL_TRIANGLES:
+                for(GLuint n = 0; n + 2 < count; n += 3)
+                {
+                    appendTriangle(first + n, first + n + 1, first + n + 2, elements);
+                }
+            break;
+
+            case GL_TRIANGLE_FAN:
+                for(GLuint n = 1; n + 1 < count; n++)
+                {
+                    appendTriangle(first, first + n, first + n + 1, elements);
+                }
+            break;
+
+            // Every other triangle is flipped to keep the winding of the first.
+            case GL_TRIANGLE_STRIP:
+                for(GLuint n = 0; n + 2 < count; n++)
+                {
+                    if(n % 2 == 0)
+                    {
+                        appendTriangle(first + n, first + n + 1, first + n + 2, elements);
+                    }
+                    else
+                    {
+                        appendTriangle(first + n + 1, first + n, first + n + 2, elements);
+                    }
+                }
+            break;
+
+            default:
+                return false;
+        }
+
+        return true;
+    }
+
+    // Records a draw of a pool mesh. drawData is copied, drawDataSize bytes of it. Returns the
+    // gl_DrawIDARB the draw will see.
+    int add(int mesh, const void *drawData)
+    {
+        meshes.push_back(mesh);
+
+        size_t size = drawDatas.size();
+        drawDatas.resize(size + drawDataSize);
+        memcpy(&drawDatas[size], drawData, drawDataSize);
+
+        return (int)meshes.size() - 1;
+    }
+
+    // Draws everything added since the last submit() with one call, with the pool bound.
+    void submit(void)
+    {
+        if(meshes.empty())
+        {
+            return;
+        }
+
+        // The ranges as they are now, after whatever defragment() moved since add().
+        commands.resize(meshes.size());
+
+        for(size_t n = 0; n < meshes.size(); n++)
+        {
+            commands[n].count = (GLuint)pool->numberOfElements(meshes[n]);
+            commands[n].instanceCount = 1;
+            commands[n].firstIndex = pool->firstElement(meshes[n]);
+            commands[n].baseVertex = pool->baseVertex(meshes[n]);
+            commands[n].baseInstance = 0;
+        }
+
+        // The blocks first at an offset the storage buffer binding accepts, the commands behind.
+        GLsizeiptr dataSize = (GLsizeiptr)drawDatas.size();
+        GLsizeiptr commandsSize = (GLsizeiptr)(commands.size() * sizeof(DrawElementsIndirectCommand));
+        GLintptr offset = 0;
+        unsigned char *data = (unsigned char *)streamBuffer->allocate(dataSize + commandsSize, storageAlignment, &offset);
+
+        if(data != NULL)
+        {
+            memcpy(data, &drawDatas[0], dataSize);
+            memcpy(data + dataSize, &commands[0], commandsSize);
+
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, drawDataBinding, streamBuffer->getBuffer(), offset, dataSize);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, streamBuffer->getBuffer());
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, (const GLvoid *)(offset + dataSize), (GLsizei)commands.size(), 0);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+            ++passes;
+            draws += commands.size();
+
+            for(size_t n = 0; n < commands.size(); n++)
+            {
+                triangles += commands[n].count / 3;
+            }
+        }
+
+        meshes.clear();
+        commands.clear();
+        drawDatas.clear();
+    }
+
+    void log(FILE *file, const char *title) const
+    {
+        if(file == NULL || passes == 0)
+        {
+            return;
+        }
+
+        fprintf(file, "%s: %lld passes, %.1f draws and %.1f triangles per glMultiDrawElementsIndirect().\n", title, passes, (double)draws / passes, (double)triangles / passes);
+        fflush(file);
+    }
+
+private:
+    GeometryPool *pool;
+    StreamBuffer *streamBuffer;
+    GLsizeiptr drawDataSize;
+    GLuint drawDataBinding;
+    GLint storageAlignment;
+
+    std::vector<int> meshes;
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<unsigned char> drawDatas;
+
+    long long passes;
+    long long draws;
+    long long triangles;
+
+    static void appendTriangle(GLuint first, GLuint second, GLuint third, std::vector<GLuint> *elements)
+    {
+        elements->push_back(first);
+        elements->push_back(second);
+        elements->push_back(third);
+    }
+
+    // Refers to the pool and the stream buffer.
+    DrawBatch(const DrawBatch&);
+    DrawBatch& operator=(const DrawBatch&);
+};
+
+#endif /* __DRAW_BATCH_H__ */
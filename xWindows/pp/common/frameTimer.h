@@ -0,0 +1,409 @@
+#ifndef __FRAME_TIMER_H__
+#define __FRAME_TIMER_H__
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <GL/glx.h>
+#endif
+
+// Per frame timing of the main loop. The CPU side is split into the phases the loop goes through,
+// taken with clock_gettime(CLOCK_MONOTONIC) at every phase boundary, and the GPU side is the time
+// a GL_TIME_ELAPSED query measures around display().
+//
+// There are two queries, used by alternate frames. A query is read back only when its frame comes
+// round again, two frames after it was issued, and only if GL_QUERY_RESULT_AVAILABLE says it is
+// done, so the loop never waits for the GPU; a result still pending then is dropped and counted,
+// as is one too long to be real.
+//
+// Every phase keeps a histogram with logarithmic buckets, 64 per decade from 0.1 us to 10 s, so
+// percentiles are within 4% for any frame rate and memory stays the same however long it runs.
+// The maximum is kept exactly. finish() drains the queries, and writeCsv() and log() report
+// frames, mean, p50, p90, p99 and max per phase in milliseconds.
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
+
+#define FRAME_TIMER_BUCKETS_PER_DECADE 64
+#define FRAME_TIMER_DECADES 8
+#define FRAME_TIMER_BUCKETS (FRAME_TIMER_BUCKETS_PER_DECADE * FRAME_TIMER_DECADES)
+#define FRAME_TIMER_SMALLEST_SECONDS 1.0e-7
+#define FRAME_TIMER_LONGEST_SECONDS 10.0
+#define FRAME_TIMER_QUERIES 2
+
+enum
+{
+    FRAME_PHASE_EVENTS = 0,
+    FRAME_PHASE_UPDATE,
+    FRAME_PHASE_DISPLAY,
+    FRAME_PHASE_SWAP,
+    FRAME_PHASE_FRAME,
+    FRAME_PHASE_GPU,
+    FRAME_PHASE_COUNT
+};
+
+typedef void (APIENTRY *FrameTimerGenQueriesProc)(GLsizei count, GLuint *queries);
+typedef void (APIENTRY *FrameTimerDeleteQueriesProc)(GLsizei count, const GLuint *queries);
+typedef void (APIENTRY *FrameTimerBeginQueryProc)(GLenum target, GLuint query);
+typedef void (APIENTRY *FrameTimerEndQueryProc)(GLenum target);
+typedef void (APIENTRY *FrameTimerGetQueryObjectivProc)(GLuint query, GLenum name, GLint *value);
+typedef void (APIENTRY *FrameTimerGetQueryObjectui64vProc)(GLuint query, GLenum name, unsigned long long *value);
+
+class FrameHistogram
+{
+public:
+    FrameHistogram(void)
+    {
+        clear();
+    }
+
+    void clear(void)
+    {
+        memset(buckets, 0, sizeof(buckets));
+        count = 0;
+        sum = 0.0;
+        maximum = 0.0;
+    }
+
+    void add(double seconds)
+    {
+        int bucket = 0;
+
+        if(seconds > FRAME_TIMER_SMALLEST_SECONDS)
+        {
+            bucket = (int)(log10(seconds / FRAME_TIMER_SMALLEST_SECONDS) * FRAME_TIMER_BUCKETS_PER_DECADE);
+            bucket = bucket < FRAME_TIMER_BUCKETS ? bucket : FRAME_TIMER_BUCKETS - 1;
+        }
+
+        buckets[bucket]++;
+        count++;
+        sum += seconds;
+        maximum = seconds > maximum ? seconds : maximum;
+    }
+
+    // Upper edge of the bucket holding the given fraction of the samples, never above the maximum.
+    double percentile(double fraction) const
+    {
+        if(count == 0)
+        {
+            return 0.0;
+        }
+
+        long long rank = (long long)ceil(fraction * (double)count);
+        long long seen = 0;
+
+        for(int bucket = 0; bucket < FRAME_TIMER_BUCKETS; bucket++)
+        {
+            seen += buckets[bucket];
+
+            if(seen >= rank)
+            {
+                double upper = FRAME_TIMER_SMALLEST_SECONDS * pow(10.0, (double)(bucket + 1) / FRAME_TIMER_BUCKETS_PER_DECADE);
+                return upper < maximum ? upper : maximum;
+            }
+        }
+
+        return maximum;
+    }
+
+    long long getCount(void) const
+    {
+        return count;
+    }
+
+    double getMean(void) const
+    {
+        return count > 0 ? sum / (double)count : 0.0;
+    }
+
+    double getMaximum(void) const
+    {
+        return maximum;
+    }
+
+private:
+    long long buckets[FRAME_TIMER_BUCKETS];
+    long long count;
+    double sum;
+    double maximum;
+};
+
+class FrameTimer
+{
+public:
+    FrameTimer(void)
+    {
+        areFunctionsLoaded = false;
+        genQueries = NULL;
+        memset(queries, 0, sizeof(queries));
+        memset(isQueryPending, 0, sizeof(isQueryPending));
+        frame = 0;
+        droppedQueries = 0;
+        frameStart = 0.0;
+        phaseStart = 0.0;
+    }
+
+    static double now(void)
+    {
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return (double)time.tv_sec + (double)time.tv_nsec * 1.0e-9;
+    }
+
+    // Starts the frame and its first phase.
+    void beginFrame(void)
+    {
+        frameStart = now();
+        phaseStart = frameStart;
+    }
+
+    // Ends the phase running since the last call or beginFrame(), and starts the next one.
+    void endPhase(int phase)
+    {
+        double time = now();
+        histograms[phase].add(time - phaseStart);
+        phaseStart = time;
+    }
+
+    void endFrame(void)
+    {
+        histograms[FRAME_PHASE_FRAME].add(now() - frameStart);
+        frame++;
+    }
+
+    // Brackets the GL work to time on the GPU. Needs a current context.
+    void beginGpu(void)
+    {
+        loadFunctions();
+
+        if(genQueries == NULL)
+        {
+            return;
+        }
+
+        int query = frame % FRAME_TIMER_QUERIES;
+
+        if(isQueryPending[query])
+        {
+            collect(query, false);
+        }
+
+        beginQuery(GL_TIME_ELAPSED, queries[query]);
+    }
+
+    void endGpu(void)
+    {
+        if(genQueries == NULL)
+        {
+            return;
+        }
+
+        endQuery(GL_TIME_ELAPSED);
+        isQueryPending[frame % FRAME_TIMER_QUERIES] = true;
+    }
+
+    // Waits for the queries still in flight and deletes them. Needs the context they were made in.
+    void finish(void)
+    {
+        if(genQueries == NULL)
+        {
+            return;
+        }
+
+        for(int query = 0; query < FRAME_TIMER_QUERIES; query++)
+        {
+            if(isQueryPending[query])
+            {
+                collect(query, true);
+            }
+        }
+
+        deleteQueries(FRAME_TIMER_QUERIES, queries);
+        memset(queries, 0, sizeof(queries));
+        genQueries = NULL;
+    }
+
+    const FrameHistogram &getHistogram(int phase) const
+    {
+        return histograms[phase];
+    }
+
+    long long getDroppedQueries(void) const
+    {
+        return droppedQueries;
+    }
+
+    bool writeCsv(const char *fileName) const
+    {
+        FILE *file = fopen(fileName, "w");
+
+        if(file == NULL)
+        {
+            return false;
+        }
+
+        fprintf(file, "phase,frames,mean_ms,p50_ms,p90_ms,p99_ms,max_ms\n");
+
+        for(int phase = 0; phase < FRAME_PHASE_COUNT; phase++)
+        {
+            const FrameHistogram &histogram = histograms[phase];
+
+            fprintf(file, "%s,%lld,%.4f,%.4f,%.4f,%.4f,%.4f\n", getPhaseName(phase), histogram.getCount(),
+                histogram.getMean() * 1000.0, histogram.percentile(0.5) * 1000.0, histogram.percentile(0.9) * 1000.0,
+                histogram.percentile(0.99) * 1000.0, histogram.getMaximum() * 1000.0);
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    void log(FILE *logFile) const
+    {
+        if(logFile == NULL)
+        {
+            return;
+        }
+
+        fprintf(logFile, "Frame times in ms over %lld frames:\n", histograms[FRAME_PHASE_FRAME].getCount());
+        fprintf(logFile, "    %-8s %8s %8s %8s %8s %8s\n", "phase", "mean", "p50", "p90", "p99", "max");
+
+        for(int phase = 0; phase < FRAME_PHASE_COUNT; phase++)
+        {
+            const FrameHistogram &histogram = histograms[phase];
+
+            fprintf(logFile, "    %-8s %8.3f %8.3f %8.3f %8.3f %8.3f\n", getPhaseName(phase), histogram.getMean() * 1000.0,
+                histogram.percentile(0.5) * 1000.0, histogram.percentile(0.9) * 1000.0, histogram.percentile(0.99) * 1000.0,
+                histogram.getMaximum() * 1000.0);
+        }
+
+        if(droppedQueries > 0)
+        {
+            fprintf(logFile, "    %lld GPU queries were not ready in time or invalid and are left out.\n", droppedQueries);
+        }
+
+        fflush(logFile);
+    }
+
+    static const char *getPhaseName(int phase)
+    {
+        static const char *names[FRAME_PHASE_COUNT] = {"events", "update", "display", "swap", "frame", "gpu"};
+        return names[phase];
+    }
+
+private:
+    FrameHistogram histograms[FRAME_PHASE_COUNT];
+    GLuint queries[FRAME_TIMER_QUERIES];
+    bool isQueryPending[FRAME_TIMER_QUERIES];
+    long long frame;
+    long long droppedQueries;
+    double frameStart;
+    double phaseStart;
+
+    bool areFunctionsLoaded;
+    FrameTimerGenQueriesProc genQueries;
+    FrameTimerDeleteQueriesProc deleteQueries;
+    FrameTimerBeginQueryProc beginQuery;
+    FrameTimerEndQueryProc endQuery;
+    FrameTimerGetQueryObjectivProc getQueryObjectiv;
+    FrameTimerGetQueryObjectui64vProc getQueryObjectui64v;
+
+    static void *getProcAddress(const char *name)
+    {
+#ifdef _WIN32
+        void *address = (void *)wglGetProcAddress(name);
+
+        // wglGetProcAddress() may return small values instead of NULL for missing functions.
+        if((ptrdiff_t)address >= -1 && (ptrdiff_t)address <= 3)
+        {
+            return NULL;
+        }
+
+        return address;
+#else
+        return (void *)glXGetProcAddressARB((const GLubyte *)name);
+#endif
+    }
+
+    // Needs a current context, so it is done on the first frame instead of in the constructor.
+    void loadFunctions(void)
+    {
+        if(areFunctionsLoaded)
+        {
+            return;
+        }
+
+        areFunctionsLoaded = true;
+
+        // Timer queries are core in OpenGL 3.3, before that they need GL_ARB_timer_query.
+        const char *version = (const char *)glGetString(GL_VERSION);
+        int major = version != NULL ? version[0] - '0' : 1;
+        int minor = version != NULL && version[1] == '.' ? version[2] - '0' : 1;
+
+        if(major < 3 || (major == 3 && minor < 3))
+        {
+            return;
+        }
+
+        genQueries = (FrameTimerGenQueriesProc)getProcAddress("glGenQueries");
+        deleteQueries = (FrameTimerDeleteQueriesProc)getProcAddress("glDeleteQueries");
+        beginQuery = (FrameTimerBeginQueryProc)getProcAddress("glBeginQuery");
+        endQuery = (FrameTimerEndQueryProc)getProcAddress("glEndQuery");
+        getQueryObjectiv = (FrameTimerGetQueryObjectivProc)getProcAddress("glGetQueryObjectiv");
+        getQueryObjectui64v = (FrameTimerGetQueryObjectui64vProc)getProcAddress("glGetQueryObjectui64v");
+
+        if(genQueries == NULL || deleteQueries == NULL || beginQuery == NULL || endQuery == NULL || getQueryObjectiv == NULL || getQueryObjectui64v == NULL)
+        {
+            genQueries = NULL;
+            return;
+        }
+
+        genQueries(FRAME_TIMER_QUERIES, queries);
+    }
+
+    void collect(int query, bool canWait)
+    {
+        GLint isAvailable = GL_TRUE;
+
+        if(!canWait)
+        {
+            getQueryObjectiv(queries[query], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+        }
+
+        unsigned long long nanoseconds = 0;
+
+        if(isAvailable)
+        {
+            getQueryObjectui64v(queries[query], GL_QUERY_RESULT, &nanoseconds);
+        }
+
+        // Some drivers return a timestamp instead for the very first query, nothing takes 10 s.
+        double seconds = (double)nanoseconds * 1.0e-9;
+
+        if(isAvailable && seconds < FRAME_TIMER_LONGEST_SECONDS)
+        {
+            histograms[FRAME_PHASE_GPU].add(seconds);
+        }
+        else
+        {
+            droppedQueries++;
+        }
+
+        isQueryPending[query] = false;
+    }
+};
+
+#endif /* __FRAME_TIMER_H__ */
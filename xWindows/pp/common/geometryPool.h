@@ -0,0 +1,372 @@
+#ifndef __GEOMETRY_POOL_H__
+#define __GEOMETRY_POOL_H__
+
+#include <stdio.h>
+#include <vector>
+#include <GL/glew.h>
+
+#include "meshData.h"
+#include "tlsfAllocator.h"
+
+// Static meshes sharing one vertex buffer, one element buffer and one VAO. Every mesh gets a range
+// of each buffer from a TlsfAllocator and its elements stay relative to its first vertex, so it is
+// drawn with glDrawElementsBaseVertex() and nothing needs rebinding between meshes. All meshes
+// have the vertex layout given to the constructor and 32 bit elements.
+//
+// Freed ranges leave holes. defragment() moves the mesh at the end of a buffer down into a hole
+// with glCopyBufferSubData(), a bounded number of bytes per call, so calling it once a frame
+// compacts the buffers in the background. Mesh handles stay the same when a mesh moves.
+class GeometryPool
+{
+public:
+    enum
+    {
+        INVALID = -1
+    };
+
+    // Capacities are in vertices and elements, nothing is allocated until create().
+    GeometryPool(GLuint positionLocation, GLuint normalLocation, GLuint textureLocation, int positionSize, int normalSize, int textureSize, unsigned int vertexCapacity, unsigned int elementCapacity)
+    {
+        this->positionLocation = positionLocation;
+        this->normalLocation = normalLocation;
+        this->textureLocation = textureLocation;
+        this->positionSize = positionSize;
+        this->normalSize = normalSize;
+        this->textureSize = textureSize;
+        this->vertexCapacity = vertexCapacity;
+        this->elementCapacity = elementCapacity;
+        stride = (positionSize + normalSize + textureSize) * sizeof(GLfloat);
+        vao = 0;
+        vboVertex = 0;
+        vboElement = 0;
+        bytesMoved = 0;
+    }
+
+    ~GeometryPool()
+    {
+        destroy();
+    }
+
+    // Creates the buffers and the VAO, needs the GL context to be current.
+    bool create(void)
+    {
+        destroy();
+
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+
+        glGenBuffers(1, &vboVertex);
+        glBindBuffer(GL_ARRAY_BUFFER, vboVertex);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertexCapacity * stride, NULL, GL_STATIC_DRAW);
+
+        glVertexAttribPointer(positionLocation, positionSize, GL_FLOAT, GL_FALSE, stride, NULL);
+        glEnableVertexAttribArray(positionLocation);
+
+        if(normalSize > 0)
+        {
+            glVertexAttribPointer(normalLocation, normalSize, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)(positionSize * sizeof(GLfloat)));
+            glEnableVertexAttribArray(normalLocation);
+        }
+
+        if(textureSize > 0)
+        {
+            glVertexAttribPointer(textureLocation, textureSize, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)((positionSize + normalSize) * sizeof(GLfloat)));
+            glEnableVertexAttribArray(textureLocation);
+        }
+
+        glGenBuffers(1, &vboElement);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vboElement);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)elementCapacity * sizeof(GLuint), NULL, GL_STATIC_DRAW);
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        if(glGetError() == GL_OUT_OF_MEMORY)
+        {
+            destroy();
+            return false;
+        }
+
+        vertexAllocator.reset(vertexCapacity);
+        elementAllocator.reset(elementCapacity);
+
+        return true;
+    }
+
+    // Deletes the GL objects and forgets every mesh.
+    void destroy(void)
+    {
+        if(vao)
+        {
+            glDeleteVertexArrays(1, &vao);
+            vao = 0;
+        }
+
+        if(vboVertex)
+        {
+            glDeleteBuffers(1, &vboVertex);
+            vboVertex = 0;
+        }
+
+        if(vboElement)
+        {
+            glDeleteBuffers(1, &vboElement);
+            vboElement = 0;
+        }
+
+        meshes.clear();
+        unusedMeshes.clear();
+        vertexAllocator.reset(0);
+        elementAllocator.reset(0);
+    }
+
+    // Copies mesh into the buffers and returns its handle, INVALID when its layout is not the
+    // pool's or either buffer has no range large enough.
+    int allocate(const MeshData& mesh)
+    {
+        if(vao == 0 || !hasLayoutOf(mesh) || mesh.vertices.empty() || mesh.elements.empty())
+        {
+            return INVALID;
+        }
+
+        int vertexBlock = vertexAllocator.allocate(mesh.numberOfVertices());
+
+        if(vertexBlock == TlsfAllocator::INVALID)
+        {
+            return INVALID;
+        }
+
+        int elementBlock = elementAllocator.allocate((unsigned int)mesh.elements.size());
+
+        if(elementBlock == TlsfAllocator::INVALID)
+        {
+            vertexAllocator.release(vertexBlock);
+            return INVALID;
+        }
+
+        // The copy targets leave the element buffer binding of whatever VAO is bound alone.
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vboVertex);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)vertexAllocator.offsetOf(vertexBlock) * stride, mesh.vertices.size() * sizeof(GLfloat), mesh.vertices.data());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, vboElement);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)elementAllocator.offsetOf(elementBlock) * sizeof(GLuint), mesh.elements.size() * sizeof(GLuint), mesh.elements.data());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        int handle = 0;
+
+        if(!unusedMeshes.empty())
+        {
+            handle = unusedMeshes.back();
+            unusedMeshes.pop_back();
+        }
+        else
+        {
+            handle = (int)meshes.size();
+            meshes.push_back(PoolMesh());
+        }
+
+        meshes[handle].vertexBlock = vertexBlock;
+        meshes[handle].elementBlock = elementBlock;
+        meshes[handle].numberOfElements = (GLsizei)mesh.elements.size();
+        vertexAllocator.setOwner(vertexBlock, handle);
+        elementAllocator.setOwner(elementBlock, handle);
+
+        return handle;
+    }
+
+    void release(int mesh)
+    {
+        if(!isValid(mesh))
+        {
+            return;
+        }
+
+        vertexAllocator.release(meshes[mesh].vertexBlock);
+        elementAllocator.release(meshes[mesh].elementBlock);
+        meshes[mesh].vertexBlock = INVALID;
+        meshes[mesh].elementBlock = INVALID;
+        unusedMeshes.push_back(mesh);
+    }
+
+    // Binds the one VAO every mesh is drawn with.
+    void bind(void) const
+    {
+        glBindVertexArray(vao);
+    }
+
+    // Draws a mesh, with the pool bound.
+    void draw(int mesh, GLenum mode = GL_TRIANGLES) const
+    {
+        glDrawElementsBaseVertex(mode, meshes[mesh].numberOfElements, GL_UNSIGNED_INT, (const GLvoid *)((size_t)elementAllocator.offsetOf(meshes[mesh].elementBlock) * sizeof(GLuint)), (GLint)vertexAllocator.offsetOf(meshes[mesh].vertexBlock));
+    }
+
+    GLuint getVao(void) const
+    {
+        return vao;
+    }
+
+    GLsizei numberOfElements(int mesh) const
+    {
+        return meshes[mesh].numberOfElements;
+    }
+
+    // Where draw() finds a mesh, for indirect draw commands. Both change when defragment() moves
+    // the mesh.
+    GLuint firstElement(int mesh) const
+    {
+        return (GLuint)elementAllocator.offsetOf(meshes[mesh].elementBlock);
+    }
+
+    GLint baseVertex(int mesh) const
+    {
+        return (GLint)vertexAllocator.offsetOf(meshes[mesh].vertexBlock);
+    }
+
+    // Reads a mesh back from the buffers.
+    bool readBack(int mesh, MeshData *data) const
+    {
+        if(!isValid(mesh))
+        {
+            return false;
+        }
+
+        int vertexBlock = meshes[mesh].vertexBlock;
+        int elementBlock = meshes[mesh].elementBlock;
+
+        data->positionSize = positionSize;
+        data->normalSize = normalSize;
+        data->textureSize = textureSize;
+        data->vertices.resize((size_t)vertexAllocator.sizeOf(vertexBlock) * stride / sizeof(GLfloat));
+        data->elements.resize(elementAllocator.sizeOf(elementBlock));
+
+        glBindBuffer(GL_COPY_READ_BUFFER, vboVertex);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, (GLintptr)vertexAllocator.offsetOf(vertexBlock) * stride, data->vertices.size() * sizeof(GLfloat), data->vertices.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, vboElement);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, (GLintptr)elementAllocator.offsetOf(elementBlock) * sizeof(GLuint), data->elements.size() * sizeof(GLuint), data->elements.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        return true;
+    }
+
+    bool hasLayoutOf(const MeshData& mesh) const
+    {
+        return mesh.positionSize == positionSize && mesh.normalSize == normalSize && mesh.textureSize == textureSize;
+    }
+
+    // Moves meshes from the end of the buffers into holes further down until about maxBytes have
+    // been copied or nothing more can move. Returns the bytes copied.
+    size_t defragment(size_t maxBytes)
+    {
+        size_t moved = 0;
+
+        while(moved < maxBytes)
+        {
+            size_t step = moveDown(&vertexAllocator, vboVertex, stride, true) + moveDown(&elementAllocator, vboElement, sizeof(GLuint), false);
+
+            if(step == 0)
+            {
+                break;
+            }
+
+            moved += step;
+        }
+
+        bytesMoved += moved;
+
+        return moved;
+    }
+
+    void log(FILE *file, const char *title) const
+    {
+        fprintf(file, "%s: %u of %u vertices and %u of %u elements in use, fragmentation %.2f and %.2f, %zu bytes moved so far\n", title,
+            vertexAllocator.usedUnits(), vertexCapacity, elementAllocator.usedUnits(), elementCapacity,
+            vertexAllocator.fragmentation(), elementAllocator.fragmentation(), bytesMoved);
+        fflush(file);
+    }
+
+private:
+    struct PoolMesh
+    {
+        int vertexBlock;
+        int elementBlock;
+        GLsizei numberOfElements;
+    };
+
+    GLuint positionLocation;
+    GLuint normalLocation;
+    GLuint textureLocation;
+    int positionSize;
+    int normalSize;
+    int textureSize;
+    GLsizei stride;
+    unsigned int vertexCapacity;
+    unsigned int elementCapacity;
+    GLuint vao;
+    GLuint vboVertex;
+    GLuint vboElement;
+    size_t bytesMoved;
+    TlsfAllocator vertexAllocator;
+    TlsfAllocator elementAllocator;
+    std::vector<PoolMesh> meshes;
+    std::vector<int> unusedMeshes;
+
+    bool isValid(int mesh) const
+    {
+        return mesh >= 0 && mesh < (int)meshes.size() && meshes[mesh].vertexBlock != INVALID;
+    }
+
+    // Moves the last range of a buffer to a lower free range if the allocator has one that fits.
+    // Both ranges are live at the time of the copy, so they never overlap.
+    size_t moveDown(TlsfAllocator *allocator, GLuint buffer, size_t unitBytes, bool isVertex)
+    {
+        int block = allocator->highestAllocation();
+
+        if(block == TlsfAllocator::INVALID)
+        {
+            return 0;
+        }
+
+        int target = allocator->allocate(allocator->sizeOf(block));
+
+        if(target == TlsfAllocator::INVALID)
+        {
+            return 0;
+        }
+
+        if(allocator->offsetOf(target) > allocator->offsetOf(block))
+        {
+            allocator->release(target);
+            return 0;
+        }
+
+        size_t bytes = (size_t)allocator->sizeOf(block) * unitBytes;
+        int mesh = allocator->ownerOf(block);
+
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)allocator->offsetOf(block) * unitBytes, (GLintptr)allocator->offsetOf(target) * unitBytes, bytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        allocator->setOwner(target, mesh);
+
+        if(isVertex)
+        {
+            meshes[mesh].vertexBlock = target;
+        }
+        else
+        {
+            meshes[mesh].elementBlock = target;
+        }
+
+        allocator->release(block);
+
+        return bytes;
+    }
+
+    // Owns GL objects.
+    GeometryPool(const GeometryPool&);
+    GeometryPool& operator=(const GeometryPool&);
+};
+
+#endif /* __GEOMETRY_POOL_H__ */
@@ -0,0 +1,309 @@
+#ifndef __LINE_BATCH_H__
+#define __LINE_BATCH_H__
+
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+
+#ifndef _WIN32
+#include <GL/glx.h>
+#endif
+
+// Colored 2D lines, circles and points gathered once into a single vertex buffer and drawn from
+// there every frame, instead of glBegin()/glEnd() loops that recompute every vertex every frame.
+//
+// Everything is stored as plain GL_LINES or GL_POINTS, circles as the segments of their loop, so
+// all that needs a draw of its own is a change of line width or point size. Consecutive adds
+// with the same primitive and width share one range, and a graph paper with a circle on it comes
+// down to one draw for the thick axes and one for everything else, in the order it was added.
+// Circles take their corners from a cosine and sine table made once per number of points and
+// shared by every circle with that many.
+//
+// Vertices are x, y and r, g, b, drawn through the fixed function vertex and color arrays with
+// the current matrices. Buffer functions are looked up from the context on first use, so this
+// works with plain gl.h; without buffer objects (OpenGL 1.1) the arrays are drawn from client
+// memory.
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_STATIC_DRAW 0x88E4
+#endif
+
+#define LINE_BATCH_PI 3.14159265358979f
+#define LINE_BATCH_FLOATS_PER_VERTEX 5
+
+typedef void (APIENTRY *LineBatchGenBuffersProc)(GLsizei count, GLuint *buffers);
+typedef void (APIENTRY *LineBatchDeleteBuffersProc)(GLsizei count, const GLuint *buffers);
+typedef void (APIENTRY *LineBatchBindBufferProc)(GLenum target, GLuint buffer);
+typedef void (APIENTRY *LineBatchBufferDataProc)(GLenum target, ptrdiff_t size, const void *data, GLenum usage);
+
+class LineBatch
+{
+public:
+    LineBatch(void)
+    {
+        areFunctionsLoaded = false;
+        genBuffers = NULL;
+        deleteBuffers = NULL;
+        bindBuffer = NULL;
+        bufferData = NULL;
+        vertexBuffer = 0;
+        isUploaded = false;
+    }
+
+    void line(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, const GLfloat *color, GLfloat width)
+    {
+        addVertex(x1, y1, color);
+        addVertex(x2, y2, color);
+        addRange(GL_LINES, width, 2);
+    }
+
+    // Closed circle of numberOfPoints corners, the first one on the positive x axis.
+    void circle(GLfloat centerX, GLfloat centerY, GLfloat radius, int numberOfPoints, const GLfloat *color, GLfloat width)
+    {
+        const GLfloat *table = getCircleTable(numberOfPoints);
+
+        for(int point = 0; point < numberOfPoints; point++)
+        {
+            int next = point + 1 < numberOfPoints ? point + 1 : 0;
+
+            addVertex(centerX + table[point * 2] * radius, centerY + table[point * 2 + 1] * radius, color);
+            addVertex(centerX + table[next * 2] * radius, centerY + table[next * 2 + 1] * radius, color);
+        }
+
+        addRange(GL_LINES, width, numberOfPoints * 2);
+    }
+
+    // Only the corners of the same circle, as points of size pixels.
+    void pointCircle(GLfloat centerX, GLfloat centerY, GLfloat radius, int numberOfPoints, const GLfloat *color, GLfloat size)
+    {
+        const GLfloat *table = getCircleTable(numberOfPoints);
+
+        for(int point = 0; point < numberOfPoints; point++)
+        {
+            addVertex(centerX + table[point * 2] * radius, centerY + table[point * 2 + 1] * radius, color);
+        }
+
+        addRange(GL_POINTS, size, numberOfPoints);
+    }
+
+    // Draws everything added so far, uploading it first if anything was added since the last draw.
+    // Leaves the line width and point size at those of the last range.
+    void draw(void)
+    {
+        if(vertices.empty())
+        {
+            return;
+        }
+
+        if(!isUploaded)
+        {
+            upload();
+        }
+
+        const GLfloat *pointer = vertexBuffer != 0 ? NULL : &vertices[0];
+        GLsizei stride = LINE_BATCH_FLOATS_PER_VERTEX * sizeof(GLfloat);
+
+        if(vertexBuffer != 0)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        }
+
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(2, GL_FLOAT, stride, pointer);
+        glColorPointer(3, GL_FLOAT, stride, pointer + 2);
+
+        for(size_t range = 0; range < ranges.size(); range++)
+        {
+            if(ranges[range].mode == GL_POINTS)
+            {
+                glPointSize(ranges[range].width);
+            }
+            else
+            {
+                glLineWidth(ranges[range].width);
+            }
+
+            glDrawArrays(ranges[range].mode, ranges[range].first, ranges[range].count);
+        }
+
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+
+        if(vertexBuffer != 0)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    int numberOfDraws(void) const
+    {
+        return (int)ranges.size();
+    }
+
+    int numberOfVertices(void) const
+    {
+        return (int)(vertices.size() / LINE_BATCH_FLOATS_PER_VERTEX);
+    }
+
+    // Deletes the buffer and everything added. Needs the context it was made in to be current.
+    void clear(void)
+    {
+        if(vertexBuffer != 0)
+        {
+            deleteBuffers(1, &vertexBuffer);
+            vertexBuffer = 0;
+        }
+
+        vertices.clear();
+        ranges.clear();
+        isUploaded = false;
+    }
+
+private:
+    struct Range
+    {
+        GLenum mode;
+        GLfloat width;
+        GLint first;
+        GLsizei count;
+    };
+
+    struct CircleTable
+    {
+        int numberOfPoints;
+        std::vector<GLfloat> cosSin;
+    };
+
+    std::vector<GLfloat> vertices;
+    std::vector<Range> ranges;
+    std::vector<CircleTable> circleTables;
+    GLuint vertexBuffer;
+    bool isUploaded;
+
+    bool areFunctionsLoaded;
+    LineBatchGenBuffersProc genBuffers;
+    LineBatchDeleteBuffersProc deleteBuffers;
+    LineBatchBindBufferProc bindBuffer;
+    LineBatchBufferDataProc bufferData;
+
+    static void *getProcAddress(const char *name)
+    {
+#ifdef _WIN32
+        void *address = (void *)wglGetProcAddress(name);
+
+        // wglGetProcAddress() may return small values instead of NULL for missing functions.
+        if((ptrdiff_t)address >= -1 && (ptrdiff_t)address <= 3)
+        {
+            return NULL;
+        }
+
+        return address;
+#else
+        return (void *)glXGetProcAddressARB((const GLubyte *)name);
+#endif
+    }
+
+    // Needs a current context, so it is done on the first upload instead of in the constructor.
+    void loadFunctions(void)
+    {
+        if(areFunctionsLoaded)
+        {
+            return;
+        }
+
+        areFunctionsLoaded = true;
+        genBuffers = (LineBatchGenBuffersProc)getProcAddress("glGenBuffers");
+        deleteBuffers = (LineBatchDeleteBuffersProc)getProcAddress("glDeleteBuffers");
+        bindBuffer = (LineBatchBindBufferProc)getProcAddress("glBindBuffer");
+        bufferData = (LineBatchBufferDataProc)getProcAddress("glBufferData");
+
+        // glGetString() says whether the context really has them, glXGetProcAddressARB() returns
+        // an address for any name.
+        const char *version = (const char *)glGetString(GL_VERSION);
+        int major = version != NULL ? version[0] - '0' : 1;
+        int minor = version != NULL && version[1] == '.' ? version[2] - '0' : 1;
+
+        if((major == 1 && minor < 5) || genBuffers == NULL || deleteBuffers == NULL || bindBuffer == NULL || bufferData == NULL)
+        {
+            genBuffers = NULL;
+        }
+    }
+
+    void upload(void)
+    {
+        loadFunctions();
+        isUploaded = true;
+
+        if(genBuffers == NULL)
+        {
+            return;
+        }
+
+        if(vertexBuffer == 0)
+        {
+            genBuffers(1, &vertexBuffer);
+        }
+
+        bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+        bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(vertices.size() * sizeof(GLfloat)), &vertices[0], GL_STATIC_DRAW);
+        bindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    const GLfloat *getCircleTable(int numberOfPoints)
+    {
+        for(size_t table = 0; table < circleTables.size(); table++)
+        {
+            if(circleTables[table].numberOfPoints == numberOfPoints)
+            {
+                return &circleTables[table].cosSin[0];
+            }
+        }
+
+        CircleTable table;
+        table.numberOfPoints = numberOfPoints;
+        table.cosSin.resize(numberOfPoints * 2);
+
+        for(int point = 0; point < numberOfPoints; point++)
+        {
+            GLfloat angle = 2.0f * LINE_BATCH_PI * (GLfloat)point / (GLfloat)numberOfPoints;
+
+            table.cosSin[point * 2] = cosf(angle);
+            table.cosSin[point * 2 + 1] = sinf(angle);
+        }
+
+        circleTables.push_back(table);
+        return &circleTables.back().cosSin[0];
+    }
+
+    void addVertex(GLfloat x, GLfloat y, const GLfloat *color)
+    {
+        GLfloat vertex[LINE_BATCH_FLOATS_PER_VERTEX] = {x, y, color[0], color[1], color[2]};
+        vertices.insert(vertices.end(), vertex, vertex + LINE_BATCH_FLOATS_PER_VERTEX);
+    }
+
+    // Extends the last range when it draws the same way, so draws only split where they must.
+    void addRange(GLenum mode, GLfloat width, GLsizei count)
+    {
+        GLint first = (GLint)(vertices.size() / LINE_BATCH_FLOATS_PER_VERTEX) - count;
+
+        if(!ranges.empty() && ranges.back().mode == mode && ranges.back().width == width)
+        {
+            ranges.back().count += count;
+        }
+        else
+        {
+            Range range = {mode, width, first, count};
+            ranges.push_back(range);
+        }
+
+        isUploaded = false;
+    }
+};
+
+#endif /* __LINE_BATCH_H__ */
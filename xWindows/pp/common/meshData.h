@@ -0,0 +1,36 @@
+#ifndef __MESH_DATA_H__
+#define __MESH_DATA_H__
+
+#include <vector>
+#include <GL/glew.h>
+
+// Interleaved vertices, each positionSize position floats followed by normalSize normal floats and
+// textureSize texture coordinate floats, plus triangle elements. The sizes may be 0 except for the
+// position.
+struct MeshData
+{
+    std::vector<GLfloat> vertices;
+    std::vector<GLuint> elements;
+    int positionSize;
+    int normalSize;
+    int textureSize;
+
+    MeshData()
+    {
+        positionSize = 3;
+        normalSize = 0;
+        textureSize = 0;
+    }
+
+    int floatsPerVertex(void) const
+    {
+        return positionSize + normalSize + textureSize;
+    }
+
+    int numberOfVertices(void) const
+    {
+        return floatsPerVertex() > 0 ? (int)vertices.size() / floatsPerVertex() : 0;
+    }
+};
+
+#endif /* __MESH_DATA_H__ */
@@ -0,0 +1,621 @@
+#ifndef __MESH_REGISTRY_H__
+#define __MESH_REGISTRY_H__
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <GL/glew.h>
+
+#include "meshData.h"
+#include "geometryPool.h"
+
+// What a registry hands out: a VAO with the vertex and element buffers attached, ready for
+// glDrawElements(GL_TRIANGLES, numberOfElements, elementType, NULL), or for a mesh living in the
+// registry's GeometryPool the pool's VAO and poolMesh to draw with GeometryPool::draw(). Owned by
+// the registry, valid until the last release().
+struct RegisteredMesh
+{
+    GLuint vao;
+    GLuint vboVertex;
+    GLuint vboElement;
+    int poolMesh;
+    GLsizei numberOfElements;
+    GLenum elementType;
+    size_t bytes;
+    int references;
+    unsigned long long contentHash;
+    std::vector<std::string> keys;
+};
+
+// Fills mesh from parameters and returns false if it can't.
+typedef bool (*MeshGenerator)(const GLfloat *parameters, int numberOfParameters, MeshData *mesh);
+
+// Reference counted meshes shared between everything that draws with one GL context. A mesh is
+// asked for either by generator name and parameters, or by its data, in which case it is keyed by a
+// hash of the content. Both ways end up in the same content map, so a sphere built by hand that
+// matches a generated one is still uploaded once. Every generator name and parameters that led to a
+// mesh stays a key of it, so asking again under any of them, not just the first, skips the
+// generator. The GL objects and the keys go when the last user releases the mesh.
+class MeshRegistry
+{
+public:
+    // Attribute locations the VAOs feed, usually CG_ATTRIBUTE_VERTEX_POSITION and friends. With a
+    // pool, meshes in the pool's layout go into the pool while it has room, the rest get buffers of
+    // their own.
+    MeshRegistry(GLuint positionLocation, GLuint normalLocation, GLuint textureLocation, GeometryPool *pool = NULL)
+    {
+        this->positionLocation = positionLocation;
+        this->normalLocation = normalLocation;
+        this->textureLocation = textureLocation;
+        this->pool = pool;
+        generations = 0;
+        uploads = 0;
+    }
+
+    ~MeshRegistry()
+    {
+        clear();
+    }
+
+    // Mesh from generator(parameters), generated and uploaded only if no live mesh has the same
+    // generator name and parameters, or the same content. NULL if generation fails.
+    const RegisteredMesh *acquire(const char *generatorName, MeshGenerator generator, const GLfloat *parameters, int numberOfParameters)
+    {
+        std::string key = makeKey(generatorName, parameters, numberOfParameters);
+        std::unordered_map<std::string, RegisteredMesh *>::iterator found = meshesByKey.find(key);
+
+        if(found != meshesByKey.end())
+        {
+            found->second->references++;
+            return found->second;
+        }
+
+        MeshData mesh;
+
+        generations++;
+
+        if(!generator(parameters, numberOfParameters, &mesh))
+        {
+            return NULL;
+        }
+
+        // A mesh found by content gets this key next to the ones it already has.
+        RegisteredMesh *registered = acquireContent(mesh);
+
+        if(registered != NULL)
+        {
+            registered->keys.push_back(key);
+            meshesByKey[key] = registered;
+        }
+
+        return registered;
+    }
+
+    // Mesh with exactly this data, uploaded only if no live mesh has the same content.
+    const RegisteredMesh *acquire(const MeshData& mesh)
+    {
+        return acquireContent(mesh);
+    }
+
+    void release(const RegisteredMesh *mesh)
+    {
+        if(mesh == NULL)
+        {
+            return;
+        }
+
+        RegisteredMesh *registered = const_cast<RegisteredMesh *>(mesh);
+
+        if(--registered->references > 0)
+        {
+            return;
+        }
+
+        for(size_t n = 0; n < registered->keys.size(); n++)
+        {
+            meshesByKey.erase(registered->keys[n]);
+        }
+
+        std::vector<RegisteredMesh *>& bucket = meshesByContent[registered->contentHash];
+
+        for(size_t n = 0; n < bucket.size(); n++)
+        {
+            if(bucket[n] == registered)
+            {
+                bucket.erase(bucket.begin() + n);
+                break;
+            }
+        }
+
+        if(bucket.empty())
+        {
+            meshesByContent.erase(registered->contentHash);
+        }
+
+        destroy(registered);
+    }
+
+    // Deletes every mesh, whatever its reference count. Needs the GL context to be current.
+    void clear(void)
+    {
+        for(std::unordered_map<unsigned long long, std::vector<RegisteredMesh *> >::iterator bucket = meshesByContent.begin(); bucket != meshesByContent.end(); ++bucket)
+        {
+            for(size_t n = 0; n < bucket->second.size(); n++)
+            {
+                destroy(bucket->second[n]);
+            }
+        }
+
+        meshesByContent.clear();
+        meshesByKey.clear();
+    }
+
+    // Bytes of vertex and element buffers the registry holds on the GPU.
+    size_t residentBytes(void) const
+    {
+        size_t bytes = 0;
+
+        for(std::unordered_map<unsigned long long, std::vector<RegisteredMesh *> >::const_iterator bucket = meshesByContent.begin(); bucket != meshesByContent.end(); ++bucket)
+        {
+            for(size_t n = 0; n < bucket->second.size(); n++)
+            {
+                bytes += bucket->second[n]->bytes;
+            }
+        }
+
+        return bytes;
+    }
+
+    // Bytes the same users would hold with a private copy each.
+    size_t requestedBytes(void) const
+    {
+        size_t bytes = 0;
+
+        for(std::unordered_map<unsigned long long, std::vector<RegisteredMesh *> >::const_iterator bucket = meshesByContent.begin(); bucket != meshesByContent.end(); ++bucket)
+        {
+            for(size_t n = 0; n < bucket->second.size(); n++)
+            {
+                bytes += bucket->second[n]->bytes * bucket->second[n]->references;
+            }
+        }
+
+        return bytes;
+    }
+
+    // requestedBytes() / residentBytes(), 1.0 when nothing is shared.
+    double deduplicationRatio(void) const
+    {
+        size_t resident = residentBytes();
+        return resident > 0 ? (double)requestedBytes() / (double)resident : 1.0;
+    }
+
+    int numberOfMeshes(void) const
+    {
+        int count = 0;
+
+        for(std::unordered_map<unsigned long long, std::vector<RegisteredMesh *> >::const_iterator bucket = meshesByContent.begin(); bucket != meshesByContent.end(); ++bucket)
+        {
+            count += (int)bucket->second.size();
+        }
+
+        return count;
+    }
+
+    // Number of generator calls since the registry was created, one per key that was not live.
+    int numberOfGenerations(void) const
+    {
+        return generations;
+    }
+
+    // Number of meshes uploaded since the registry was created.
+    int numberOfUploads(void) const
+    {
+        return uploads;
+    }
+
+    void log(FILE *file, const char *title) const
+    {
+        fprintf(file, "%s: %d meshes, %d generator runs and %d uploads so far, %zu bytes resident, %zu bytes requested, deduplication ratio %.2f\n", title, numberOfMeshes(), generations, uploads, residentBytes(), requestedBytes(), deduplicationRatio());
+        fflush(file);
+    }
+
+private:
+    GLuint positionLocation;
+    GLuint normalLocation;
+    GLuint textureLocation;
+    GeometryPool *pool;
+    int generations;
+    int uploads;
+    std::unordered_map<std::string, RegisteredMesh *> meshesByKey;
+    std::unordered_map<unsigned long long, std::vector<RegisteredMesh *> > meshesByContent;
+
+    // Parameters go in as their bits, so 0.5 and 0.50000001 are different meshes.
+    static std::string makeKey(const char *generatorName, const GLfloat *parameters, int numberOfParameters)
+    {
+        std::string key = generatorName;
+        char bits[16];
+
+        for(int n = 0; n < numberOfParameters; n++)
+        {
+            unsigned int value = 0;
+            memcpy(&value, &parameters[n], sizeof(value));
+            snprintf(bits, sizeof(bits), ":%08x", value);
+            key += bits;
+        }
+
+        return key;
+    }
+
+    // 64 bit FNV-1a over the layout, the vertices and the elements.
+    static unsigned long long hashContent(const MeshData& mesh)
+    {
+        unsigned long long hash = 14695981039346656037ULL;
+        const int layout[3] = { mesh.positionSize, mesh.normalSize, mesh.textureSize };
+        const void *parts[3] = { layout, mesh.vertices.data(), mesh.elements.data() };
+        size_t sizes[3] = { sizeof(layout), mesh.vertices.size() * sizeof(GLfloat), mesh.elements.size() * sizeof(GLuint) };
+
+        for(int part = 0; part < 3; part++)
+        {
+            const unsigned char *bytes = (const unsigned char *)parts[part];
+
+            for(size_t n = 0; n < sizes[part]; n++)
+            {
+                hash = (hash ^ bytes[n]) * 1099511628211ULL;
+            }
+        }
+
+        return hash;
+    }
+
+    static bool isSameContent(const MeshData& a, const MeshData& b)
+    {
+        return a.positionSize == b.positionSize && a.normalSize == b.normalSize && a.textureSize == b.textureSize &&
+            a.vertices == b.vertices && a.elements == b.elements;
+    }
+
+    RegisteredMesh *acquireContent(const MeshData& mesh)
+    {
+        if(mesh.positionSize <= 0 || mesh.vertices.empty() || mesh.elements.empty())
+        {
+            return NULL;
+        }
+
+        unsigned long long hash = hashContent(mesh);
+        std::vector<RegisteredMesh *>& bucket = meshesByContent[hash];
+
+        // Hash collisions are compared against the data read back from the buffers, the registry
+        // keeps no CPU copy.
+        for(size_t n = 0; n < bucket.size(); n++)
+        {
+            MeshData resident;
+
+            if(readBack(bucket[n], mesh, &resident) && isSameContent(mesh, resident))
+            {
+                bucket[n]->references++;
+                return bucket[n];
+            }
+        }
+
+        RegisteredMesh *registered = upload(mesh);
+
+        if(registered == NULL)
+        {
+            if(bucket.empty())
+            {
+                meshesByContent.erase(hash);
+            }
+
+            return NULL;
+        }
+
+        registered->contentHash = hash;
+        bucket.push_back(registered);
+
+        return registered;
+    }
+
+    RegisteredMesh *upload(const MeshData& mesh)
+    {
+        RegisteredMesh *registered = new RegisteredMesh();
+        int numberOfVertices = mesh.numberOfVertices();
+        GLsizei stride = mesh.floatsPerVertex() * sizeof(GLfloat);
+        size_t elementBytes = 0;
+
+        registered->numberOfElements = (GLsizei)mesh.elements.size();
+        registered->references = 1;
+        registered->contentHash = 0;
+        registered->poolMesh = pool != NULL ? pool->allocate(mesh) : GeometryPool::INVALID;
+
+        if(registered->poolMesh != GeometryPool::INVALID)
+        {
+            registered->vao = pool->getVao();
+            registered->elementType = GL_UNSIGNED_INT;
+            registered->bytes = mesh.vertices.size() * sizeof(GLfloat) + mesh.elements.size() * sizeof(GLuint);
+            uploads++;
+
+            return registered;
+        }
+
+        glGenVertexArrays(1, &registered->vao);
+        glBindVertexArray(registered->vao);
+
+        glGenBuffers(1, &registered->vboVertex);
+        glBindBuffer(GL_ARRAY_BUFFER, registered->vboVertex);
+        glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(GLfloat), mesh.vertices.data(), GL_STATIC_DRAW);
+
+        glVertexAttribPointer(positionLocation, mesh.positionSize, GL_FLOAT, GL_FALSE, stride, NULL);
+        glEnableVertexAttribArray(positionLocation);
+
+        if(mesh.normalSize > 0)
+        {
+            glVertexAttribPointer(normalLocation, mesh.normalSize, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)(mesh.positionSize * sizeof(GLfloat)));
+            glEnableVertexAttribArray(normalLocation);
+        }
+
+        if(mesh.textureSize > 0)
+        {
+            glVertexAttribPointer(textureLocation, mesh.textureSize, GL_FLOAT, GL_FALSE, stride, (const GLvoid *)((mesh.positionSize + mesh.normalSize) * sizeof(GLfloat)));
+            glEnableVertexAttribArray(textureLocation);
+        }
+
+        glGenBuffers(1, &registered->vboElement);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, registered->vboElement);
+
+        // 16 bit elements whenever they are enough.
+        if(numberOfVertices <= 65536)
+        {
+            std::vector<GLushort> shortElements(mesh.elements.begin(), mesh.elements.end());
+
+            elementBytes = shortElements.size() * sizeof(GLushort);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, elementBytes, shortElements.data(), GL_STATIC_DRAW);
+            registered->elementType = GL_UNSIGNED_SHORT;
+        }
+        else
+        {
+            elementBytes = mesh.elements.size() * sizeof(GLuint);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, elementBytes, mesh.elements.data(), GL_STATIC_DRAW);
+            registered->elementType = GL_UNSIGNED_INT;
+        }
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        if(glGetError() == GL_OUT_OF_MEMORY)
+        {
+            destroy(registered);
+            return NULL;
+        }
+
+        registered->bytes = mesh.vertices.size() * sizeof(GLfloat) + elementBytes;
+        uploads++;
+
+        return registered;
+    }
+
+    // Reads a resident mesh back in the layout of like, only ever needed on a hash collision.
+    bool readBack(const RegisteredMesh *registered, const MeshData& like, MeshData *mesh) const
+    {
+        if(registered->poolMesh != GeometryPool::INVALID)
+        {
+            return pool->hasLayoutOf(like) && pool->readBack(registered->poolMesh, mesh);
+        }
+
+        size_t elementSize = registered->elementType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+        size_t vertexBytes = registered->bytes - registered->numberOfElements * elementSize;
+
+        if(vertexBytes != like.vertices.size() * sizeof(GLfloat) || (size_t)registered->numberOfElements != like.elements.size())
+        {
+            return false;
+        }
+
+        mesh->positionSize = like.positionSize;
+        mesh->normalSize = like.normalSize;
+        mesh->textureSize = like.textureSize;
+        mesh->vertices.resize(like.vertices.size());
+        mesh->elements.resize(registered->numberOfElements);
+
+        glBindBuffer(GL_COPY_READ_BUFFER, registered->vboVertex);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, vertexBytes, mesh->vertices.data());
+
+        glBindBuffer(GL_COPY_READ_BUFFER, registered->vboElement);
+
+        if(registered->elementType == GL_UNSIGNED_SHORT)
+        {
+            std::vector<GLushort> shortElements(registered->numberOfElements);
+            glGetBufferSubData(GL_COPY_READ_BUFFER, 0, shortElements.size() * sizeof(GLushort), shortElements.data());
+            mesh->elements.assign(shortElements.begin(), shortElements.end());
+        }
+        else
+        {
+            glGetBufferSubData(GL_COPY_READ_BUFFER, 0, mesh->elements.size() * sizeof(GLuint), mesh->elements.data());
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        return true;
+    }
+
+    void destroy(RegisteredMesh *registered)
+    {
+        if(registered->poolMesh != GeometryPool::INVALID)
+        {
+            pool->release(registered->poolMesh);
+            delete registered;
+            return;
+        }
+
+        if(registered->vao)
+        {
+            glDeleteVertexArrays(1, &registered->vao);
+        }
+
+        if(registered->vboVertex)
+        {
+            glDeleteBuffers(1, &registered->vboVertex);
+        }
+
+        if(registered->vboElement)
+        {
+            glDeleteBuffers(1, &registered->vboElement);
+        }
+
+        delete registered;
+    }
+};
+
+// Generators for the usual primitives, all with position and normal. Parameters are listed with
+// each.
+
+// gluSphere(quadric, radius, slices, stacks): poles on the z axis. Parameters radius, slices, stacks.
+static inline bool generateSphereMesh(const GLfloat *parameters, int numberOfParameters, MeshData *mesh)
+{
+    if(numberOfParameters != 3 || parameters[0] <= 0.0f || parameters[1] < 3.0f || parameters[2] < 2.0f)
+    {
+        return false;
+    }
+
+    GLfloat radius = parameters[0];
+    int slices = (int)parameters[1];
+    int stacks = (int)parameters[2];
+
+    mesh->positionSize = 3;
+    mesh->normalSize = 3;
+    mesh->textureSize = 0;
+    mesh->vertices.clear();
+    mesh->elements.clear();
+
+    for(int stack = 0; stack <= stacks; ++stack)
+    {
+        GLfloat rho = (GLfloat)M_PI * stack / stacks;
+
+        for(int slice = 0; slice <= slices; ++slice)
+        {
+            GLfloat theta = 2.0f * (GLfloat)M_PI * slice / slices;
+            GLfloat normal[3] = { sinf(theta) * sinf(rho), cosf(theta) * sinf(rho), cosf(rho) };
+
+            mesh->vertices.push_back(normal[0] * radius);
+            mesh->vertices.push_back(normal[1] * radius);
+            mesh->vertices.push_back(normal[2] * radius);
+            mesh->vertices.push_back(normal[0]);
+            mesh->vertices.push_back(normal[1]);
+            mesh->vertices.push_back(normal[2]);
+        }
+    }
+
+    for(int stack = 0; stack < stacks; ++stack)
+    {
+        for(int slice = 0; slice < slices; ++slice)
+        {
+            GLuint topLeft = stack * (slices + 1) + slice;
+            GLuint bottomLeft = topLeft + slices + 1;
+            GLuint triangles[6] = { topLeft, bottomLeft, topLeft + 1, topLeft + 1, bottomLeft, bottomLeft + 1 };
+
+            mesh->elements.insert(mesh->elements.end(), triangles, triangles + 6);
+        }
+    }
+
+    return true;
+}
+
+// Cube from -size to size on every axis, 4 vertices per face. Parameter size.
+static inline bool generateCubeMesh(const GLfloat *parameters, int numberOfParameters, MeshData *mesh)
+{
+    if(numberOfParameters != 1 || parameters[0] <= 0.0f)
+    {
+        return false;
+    }
+
+    // Normal, then the two axes spanning the face, counter clockwise seen from outside.
+    static const GLfloat faces[6][3][3] =
+    {
+        { { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f } },
+        { { 0.0f, -1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } },
+        { { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } },
+        { { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } },
+        { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } },
+        { { -1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f } }
+    };
+    static const GLfloat corners[4][2] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { 1.0f, 1.0f }, { -1.0f, 1.0f } };
+
+    GLfloat size = parameters[0];
+
+    mesh->positionSize = 3;
+    mesh->normalSize = 3;
+    mesh->textureSize = 0;
+    mesh->vertices.clear();
+    mesh->elements.clear();
+
+    for(int face = 0; face < 6; face++)
+    {
+        for(int corner = 0; corner < 4; corner++)
+        {
+            for(int k = 0; k < 3; k++)
+            {
+                mesh->vertices.push_back((faces[face][0][k] + faces[face][1][k] * corners[corner][0] + faces[face][2][k] * corners[corner][1]) * size);
+            }
+
+            mesh->vertices.insert(mesh->vertices.end(), faces[face][0], faces[face][0] + 3);
+        }
+
+        GLuint first = face * 4;
+        GLuint triangles[6] = { first, first + 1, first + 2, first, first + 2, first + 3 };
+
+        mesh->elements.insert(mesh->elements.end(), triangles, triangles + 6);
+    }
+
+    return true;
+}
+
+// The pyramid of the pyramid samples scaled by size: apex at (0, size, 0), base at y = -size, four
+// sides and no base. Parameter size.
+static inline bool generatePyramidMesh(const GLfloat *parameters, int numberOfParameters, MeshData *mesh)
+{
+    if(numberOfParameters != 1 || parameters[0] <= 0.0f)
+    {
+        return false;
+    }
+
+    static const GLfloat base[5][2] = { { -1.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, -1.0f }, { -1.0f, -1.0f }, { -1.0f, 1.0f } };
+    GLfloat size = parameters[0];
+
+    mesh->positionSize = 3;
+    mesh->normalSize = 3;
+    mesh->textureSize = 0;
+    mesh->vertices.clear();
+    mesh->elements.clear();
+
+    for(int face = 0; face < 4; face++)
+    {
+        GLfloat a[3] = { base[face][0], -1.0f, base[face][1] };
+        GLfloat b[3] = { base[face + 1][0], -1.0f, base[face + 1][1] };
+        GLfloat e1[3] = { a[0], a[1] - 1.0f, a[2] };
+        GLfloat e2[3] = { b[0], b[1] - 1.0f, b[2] };
+        GLfloat normal[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+        GLfloat length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        const GLfloat apex[3] = { 0.0f, 1.0f, 0.0f };
+        const GLfloat *points[3] = { apex, a, b };
+
+        for(int corner = 0; corner < 3; corner++)
+        {
+            for(int k = 0; k < 3; k++)
+            {
+                mesh->vertices.push_back(points[corner][k] * size);
+            }
+
+            for(int k = 0; k < 3; k++)
+            {
+                mesh->vertices.push_back(normal[k] / length);
+            }
+
+            mesh->elements.push_back(face * 3 + corner);
+        }
+    }
+
+    return true;
+}
+
+#endif /* __MESH_REGISTRY_H__ */
@@ -0,0 +1,815 @@
+#ifndef __PATH_TESSELLATOR_H__
+#define __PATH_TESSELLATOR_H__
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+#ifndef _WIN32
+#include <GL/glx.h>
+#endif
+
+// 2D paths of lines, arcs and circles, tessellated once into a vertex and an element buffer as
+// hairlines, thick strokes, filled polygons or dots, and drawn from there for as long as the
+// tessellator lives. Symbols and letters that used to be sent with glBegin()/glEnd() every frame
+// are built once in initialize(), and animated scenes only change the matrices they are drawn
+// with.
+//
+// A Path only records its commands and their parameters, an arc is its center, radius, angles
+// and number of segments, not its points. The commands, the kind of geometry and the stroke width
+// are the key of a shape: asking again for the same path returns the handle made the first time
+// without tessellating anything, so a draw function may rebuild a path every frame as long as its
+// parameters do not change.
+//
+// Every point carries the color set last on the path, and colors are interpolated along lines
+// and across triangles. Hairlines are GL_LINES drawn at the current glLineWidth(), dots GL_POINTS
+// at the current glPointSize(); thick strokes are triangles, with mitered joins that turn into
+// bevels past PATH_MITER_LIMIT times the half width and butt ends on open subpaths. Fills close
+// every subpath and fill it on its own, convex ones as a fan and the others by ear clipping, so
+// holes are not supported.
+//
+// Vertices are x, y and r, g, b, drawn through the fixed function vertex and color arrays with
+// the current matrices. Buffer functions are looked up from the context on first use, so this
+// works with plain gl.h; without buffer objects (OpenGL 1.1) the arrays are drawn from client
+// memory.
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STATIC_DRAW 0x88E4
+#endif
+
+#define PATH_PI 3.14159265358979f
+#define PATH_FLOATS_PER_VERTEX 5
+#define PATH_MITER_LIMIT 4.0f
+
+typedef void (APIENTRY *PathGenBuffersProc)(GLsizei count, GLuint *buffers);
+typedef void (APIENTRY *PathDeleteBuffersProc)(GLsizei count, const GLuint *buffers);
+typedef void (APIENTRY *PathBindBufferProc)(GLenum target, GLuint buffer);
+typedef void (APIENTRY *PathBufferDataProc)(GLenum target, ptrdiff_t size, const void *data, GLenum usage);
+
+// Commands of a 2D outline, made of subpaths that each start with moveTo(), arc() or circle().
+class Path
+{
+public:
+    Path(void)
+    {
+        clear();
+    }
+
+    void clear(void)
+    {
+        commands.clear();
+        isSubpathOpen = false;
+    }
+
+    // Color of the points added from now on, white until set.
+    void setColor(GLfloat red, GLfloat green, GLfloat blue)
+    {
+        GLfloat command[] = {(GLfloat)COLOR, red, green, blue};
+        commands.insert(commands.end(), command, command + 4);
+    }
+
+    void setColor(const GLfloat *color)
+    {
+        setColor(color[0], color[1], color[2]);
+    }
+
+    void moveTo(GLfloat x, GLfloat y)
+    {
+        GLfloat command[] = {(GLfloat)MOVE, x, y};
+        commands.insert(commands.end(), command, command + 3);
+        isSubpathOpen = true;
+    }
+
+    // Starts a subpath at the point when there is none yet.
+    void lineTo(GLfloat x, GLfloat y)
+    {
+        if(!isSubpathOpen)
+        {
+            moveTo(x, y);
+            return;
+        }
+
+        GLfloat command[] = {(GLfloat)LINE, x, y};
+        commands.insert(commands.end(), command, command + 3);
+    }
+
+    // numberOfSegments lines from startAngle to endAngle, in radians counter clockwise from the
+    // positive x axis. Continues the current subpath with a line to the start of the arc, or
+    // starts a subpath there.
+    void arc(GLfloat centerX, GLfloat centerY, GLfloat radius, GLfloat startAngle, GLfloat endAngle, int numberOfSegments)
+    {
+        GLfloat command[] = {(GLfloat)ARC, centerX, centerY, radius, startAngle, endAngle, (GLfloat)numberOfSegments};
+        commands.insert(commands.end(), command, command + 7);
+        isSubpathOpen = true;
+    }
+
+    // Closed subpath of numberOfPoints corners, the first one on the positive x axis.
+    void circle(GLfloat centerX, GLfloat centerY, GLfloat radius, int numberOfPoints)
+    {
+        GLfloat command[] = {(GLfloat)CIRCLE, centerX, centerY, radius, (GLfloat)numberOfPoints};
+        commands.insert(commands.end(), command, command + 5);
+        isSubpathOpen = false;
+    }
+
+    // Joins the last point of the subpath back to its first.
+    void close(void)
+    {
+        if(isSubpathOpen)
+        {
+            commands.push_back((GLfloat)CLOSE);
+            isSubpathOpen = false;
+        }
+    }
+
+private:
+    friend class PathTessellator;
+
+    enum Command
+    {
+        COLOR,
+        MOVE,
+        LINE,
+        ARC,
+        CIRCLE,
+        CLOSE
+    };
+
+    std::vector<GLfloat> commands;
+    bool isSubpathOpen;
+};
+
+// Work done by the tessellator, either since the last resetFrameStatistics() or in total.
+struct PathStatistics
+{
+    unsigned int tessellations;
+    unsigned int cacheHits;
+    unsigned int draws;
+    unsigned int verticesDrawn;
+};
+
+class PathTessellator
+{
+public:
+    enum
+    {
+        INVALID = -1
+    };
+
+    PathTessellator(void)
+    {
+        areFunctionsLoaded = false;
+        genBuffers = NULL;
+        deleteBuffers = NULL;
+        bindBuffer = NULL;
+        bufferData = NULL;
+
+        resetStatistics(&frameStatistics);
+        resetStatistics(&totalStatistics);
+    }
+
+    // Every line of the path as GL_LINES, drawn at the current glLineWidth().
+    int hairline(const Path& path)
+    {
+        return get(HAIRLINE, 0.0f, path);
+    }
+
+    // Every line of the path as triangles width units wide, centered on the line.
+    int stroke(const Path& path, GLfloat width)
+    {
+        return get(STROKE, width, path);
+    }
+
+    // Every subpath closed and filled with triangles.
+    int fill(const Path& path)
+    {
+        return get(FILL, 0.0f, path);
+    }
+
+    // Every point of the path as GL_POINTS, drawn at the current glPointSize().
+    int dots(const Path& path)
+    {
+        return get(DOTS, 0.0f, path);
+    }
+
+    void draw(int shape)
+    {
+        if(shape < 0 || shape >= (int)shapes.size() || shapes[shape].numberOfElements == 0)
+        {
+            return;
+        }
+
+        Shape& geometry = shapes[shape];
+        const GLfloat *vertices = geometry.vertexBuffer != 0 ? NULL : &geometry.vertices[0];
+        const GLuint *elements = geometry.elementBuffer != 0 ? NULL : &geometry.elements[0];
+        GLsizei stride = PATH_FLOATS_PER_VERTEX * sizeof(GLfloat);
+
+        if(geometry.vertexBuffer != 0)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, geometry.vertexBuffer);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.elementBuffer);
+        }
+
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(2, GL_FLOAT, stride, vertices);
+        glColorPointer(3, GL_FLOAT, stride, vertices + 2);
+
+        glDrawElements(geometry.mode, geometry.numberOfElements, GL_UNSIGNED_INT, elements);
+
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+
+        if(geometry.vertexBuffer != 0)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, 0);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+
+        frameStatistics.draws++;
+        totalStatistics.draws++;
+        frameStatistics.verticesDrawn += (unsigned int)geometry.numberOfElements;
+        totalStatistics.verticesDrawn += (unsigned int)geometry.numberOfElements;
+    }
+
+    int numberOfShapes(void) const
+    {
+        return (int)shapes.size();
+    }
+
+    // Deletes the buffers of every shape. Needs the context they were made in to be current.
+    void clear(void)
+    {
+        for(size_t shape = 0; shape < shapes.size(); shape++)
+        {
+            if(shapes[shape].vertexBuffer != 0)
+            {
+                deleteBuffers(1, &shapes[shape].vertexBuffer);
+                deleteBuffers(1, &shapes[shape].elementBuffer);
+            }
+        }
+
+        shapes.clear();
+    }
+
+    // Call at the start of a frame, getFrameStatistics() then counts the work of that frame only.
+    void resetFrameStatistics(void)
+    {
+        resetStatistics(&frameStatistics);
+    }
+
+    const PathStatistics& getFrameStatistics(void) const
+    {
+        return frameStatistics;
+    }
+
+    const PathStatistics& getTotalStatistics(void) const
+    {
+        return totalStatistics;
+    }
+
+private:
+    enum Kind
+    {
+        HAIRLINE,
+        STROKE,
+        FILL,
+        DOTS
+    };
+
+    struct Shape
+    {
+        Kind kind;
+        GLfloat width;
+        unsigned int hash;
+        std::vector<GLfloat> commands;
+        GLenum mode;
+        GLsizei numberOfElements;
+        GLuint vertexBuffer;
+        GLuint elementBuffer;
+
+        // Only kept when there are no buffer objects to draw from.
+        std::vector<GLfloat> vertices;
+        std::vector<GLuint> elements;
+    };
+
+    // Points of one subpath, x, y, r, g, b each.
+    struct Subpath
+    {
+        std::vector<GLfloat> points;
+        bool isClosed;
+    };
+
+    std::vector<Shape> shapes;
+    PathStatistics frameStatistics;
+    PathStatistics totalStatistics;
+
+    bool areFunctionsLoaded;
+    PathGenBuffersProc genBuffers;
+    PathDeleteBuffersProc deleteBuffers;
+    PathBindBufferProc bindBuffer;
+    PathBufferDataProc bufferData;
+
+    static void resetStatistics(PathStatistics *statistics)
+    {
+        statistics->tessellations = 0;
+        statistics->cacheHits = 0;
+        statistics->draws = 0;
+        statistics->verticesDrawn = 0;
+    }
+
+    static void *getProcAddress(const char *name)
+    {
+#ifdef _WIN32
+        void *address = (void *)wglGetProcAddress(name);
+
+        // wglGetProcAddress() may return small values instead of NULL for missing functions.
+        if((ptrdiff_t)address >= -1 && (ptrdiff_t)address <= 3)
+        {
+            return NULL;
+        }
+
+        return address;
+#else
+        return (void *)glXGetProcAddressARB((const GLubyte *)name);
+#endif
+    }
+
+    // Needs a current context, so it is done on the first tessellation instead of in the constructor.
+    void loadFunctions(void)
+    {
+        if(areFunctionsLoaded)
+        {
+            return;
+        }
+
+        areFunctionsLoaded = true;
+        genBuffers = (PathGenBuffersProc)getProcAddress("glGenBuffers");
+        deleteBuffers = (PathDeleteBuffersProc)getProcAddress("glDeleteBuffers");
+        bindBuffer = (PathBindBufferProc)getProcAddress("glBindBuffer");
+        bufferData = (PathBufferDataProc)getProcAddress("glBufferData");
+
+        // glGetString() says whether the context really has them, glXGetProcAddressARB() returns
+        // an address for any name.
+        const char *version = (const char *)glGetString(GL_VERSION);
+        int major = version != NULL ? version[0] - '0' : 1;
+        int minor = version != NULL && version[1] == '.' ? version[2] - '0' : 1;
+
+        if((major == 1 && minor < 5) || genBuffers == NULL || deleteBuffers == NULL || bindBuffer == NULL || bufferData == NULL)
+        {
+            genBuffers = NULL;
+        }
+    }
+
+    // FNV-1a over the bytes of the key, only to skip most comparisons of whole command lists.
+    static unsigned int hashKey(Kind kind, GLfloat width, const std::vector<GLfloat>& commands)
+    {
+        unsigned int hash = 2166136261u;
+        const unsigned char *bytes = commands.empty() ? NULL : (const unsigned char *)&commands[0];
+        size_t numberOfBytes = commands.size() * sizeof(GLfloat);
+        unsigned char header[sizeof(int) + sizeof(GLfloat)];
+        int kindValue = (int)kind;
+
+        memcpy(header, &kindValue, sizeof(int));
+        memcpy(header + sizeof(int), &width, sizeof(GLfloat));
+
+        for(size_t byte = 0; byte < sizeof(header); byte++)
+        {
+            hash = (hash ^ header[byte]) * 16777619u;
+        }
+
+        for(size_t byte = 0; byte < numberOfBytes; byte++)
+        {
+            hash = (hash ^ bytes[byte]) * 16777619u;
+        }
+
+        return hash;
+    }
+
+    int get(Kind kind, GLfloat width, const Path& path)
+    {
+        unsigned int hash = hashKey(kind, width, path.commands);
+
+        for(size_t shape = 0; shape < shapes.size(); shape++)
+        {
+            const Shape& candidate = shapes[shape];
+
+            if(candidate.hash == hash && candidate.kind == kind && candidate.width == width && candidate.commands == path.commands)
+            {
+                frameStatistics.cacheHits++;
+                totalStatistics.cacheHits++;
+                return (int)shape;
+            }
+        }
+
+        std::vector<Subpath> subpaths;
+        std::vector<GLfloat> vertices;
+        std::vector<GLuint> elements;
+        GLenum mode = GL_TRIANGLES;
+
+        flatten(path.commands, &subpaths);
+
+        for(size_t subpath = 0; subpath < subpaths.size(); subpath++)
+        {
+            const Subpath& outline = subpaths[subpath];
+            GLuint first = (GLuint)(vertices.size() / PATH_FLOATS_PER_VERTEX);
+            int numberOfPoints = (int)(outline.points.size() / PATH_FLOATS_PER_VERTEX);
+
+            switch(kind)
+            {
+                case HAIRLINE:
+                    mode = GL_LINES;
+                    vertices.insert(vertices.end(), outline.points.begin(), outline.points.end());
+
+                    for(int point = 0; point + 1 < numberOfPoints; point++)
+                    {
+                        elements.push_back(first + point);
+                        elements.push_back(first + point + 1);
+                    }
+
+                    if(outline.isClosed && numberOfPoints > 2)
+                    {
+                        elements.push_back(first + numberOfPoints - 1);
+                        elements.push_back(first);
+                    }
+                break;
+
+                case STROKE:
+                    addStroke(outline, width * 0.5f, &vertices, &elements);
+                break;
+
+                case FILL:
+                    vertices.insert(vertices.end(), outline.points.begin(), outline.points.end());
+                    addFill(outline, first, &elements);
+                break;
+
+                case DOTS:
+                    mode = GL_POINTS;
+                    vertices.insert(vertices.end(), outline.points.begin(), outline.points.end());
+
+                    for(int point = 0; point < numberOfPoints; point++)
+                    {
+                        elements.push_back(first + point);
+                    }
+                break;
+            }
+        }
+
+        return add(kind, width, hash, path.commands, mode, &vertices, &elements);
+    }
+
+    static void addPoint(Subpath *subpath, GLfloat x, GLfloat y, const GLfloat *color)
+    {
+        GLfloat point[PATH_FLOATS_PER_VERTEX] = {x, y, color[0], color[1], color[2]};
+        subpath->points.insert(subpath->points.end(), point, point + PATH_FLOATS_PER_VERTEX);
+    }
+
+    // Turns the commands into subpaths of points.
+    static void flatten(const std::vector<GLfloat>& commands, std::vector<Subpath> *subpaths)
+    {
+        GLfloat color[] = {1.0f, 1.0f, 1.0f};
+        bool isSubpathOpen = false;
+        size_t command = 0;
+
+        while(command < commands.size())
+        {
+            const GLfloat *values = &commands[command];
+
+            switch((int)values[0])
+            {
+                case Path::COLOR:
+                    color[0] = values[1];
+                    color[1] = values[2];
+                    color[2] = values[3];
+                    command += 4;
+                break;
+
+                case Path::MOVE:
+                    subpaths->push_back(Subpath());
+                    subpaths->back().isClosed = false;
+                    addPoint(&subpaths->back(), values[1], values[2], color);
+                    isSubpathOpen = true;
+                    command += 3;
+                break;
+
+                case Path::LINE:
+                    addPoint(&subpaths->back(), values[1], values[2], color);
+                    command += 3;
+                break;
+
+                case Path::ARC:
+                {
+                    int numberOfSegments = (int)values[6] > 0 ? (int)values[6] : 1;
+
+                    if(!isSubpathOpen)
+                    {
+                        subpaths->push_back(Subpath());
+                        subpaths->back().isClosed = false;
+                        isSubpathOpen = true;
+                    }
+
+                    for(int segment = 0; segment <= numberOfSegments; segment++)
+                    {
+                        GLfloat angle = values[4] + (values[5] - values[4]) * (GLfloat)segment / (GLfloat)numberOfSegments;
+                        addPoint(&subpaths->back(), values[1] + cosf(angle) * values[3], values[2] + sinf(angle) * values[3], color);
+                    }
+
+                    command += 7;
+                }
+                break;
+
+                case Path::CIRCLE:
+                {
+                    int numberOfPoints = (int)values[4];
+
+                    subpaths->push_back(Subpath());
+                    subpaths->back().isClosed = true;
+                    isSubpathOpen = false;
+
+                    for(int point = 0; point < numberOfPoints; point++)
+                    {
+                        GLfloat angle = 2.0f * PATH_PI * (GLfloat)point / (GLfloat)numberOfPoints;
+                        addPoint(&subpaths->back(), values[1] + cosf(angle) * values[3], values[2] + sinf(angle) * values[3], color);
+                    }
+
+                    command += 5;
+                }
+                break;
+
+                case Path::CLOSE:
+                    subpaths->back().isClosed = true;
+                    isSubpathOpen = false;
+                    command += 1;
+                break;
+
+                default:
+                    return;
+            }
+        }
+    }
+
+    static void addVertex(std::vector<GLfloat> *vertices, GLfloat x, GLfloat y, const GLfloat *color)
+    {
+        GLfloat vertex[PATH_FLOATS_PER_VERTEX] = {x, y, color[0], color[1], color[2]};
+        vertices->insert(vertices->end(), vertex, vertex + PATH_FLOATS_PER_VERTEX);
+    }
+
+    // Left and right edge of the stroke at point, as a quad per segment. At a joint the two quads
+    // share their corners along the miter, or keep their own square ends and get a bevel triangle
+    // on each side when the miter would be longer than PATH_MITER_LIMIT half widths.
+    static void addStroke(const Subpath& subpath, GLfloat halfWidth, std::vector<GLfloat> *vertices, std::vector<GLuint> *elements)
+    {
+        std::vector<GLfloat> points;
+        int numberOfPoints = 0;
+
+        // Repeated points have no direction, so they are dropped first.
+        for(size_t point = 0; point < subpath.points.size(); point += PATH_FLOATS_PER_VERTEX)
+        {
+            const GLfloat *current = &subpath.points[point];
+
+            if(numberOfPoints > 0 && current[0] == points[points.size() - 5] && current[1] == points[points.size() - 4])
+            {
+                continue;
+            }
+
+            points.insert(points.end(), current, current + PATH_FLOATS_PER_VERTEX);
+            numberOfPoints++;
+        }
+
+        bool isClosed = subpath.isClosed && numberOfPoints > 2;
+
+        if(isClosed && points[0] == points[(numberOfPoints - 1) * 5] && points[1] == points[(numberOfPoints - 1) * 5 + 1])
+        {
+            numberOfPoints--;
+        }
+
+        int numberOfSegments = isClosed ? numberOfPoints : numberOfPoints - 1;
+
+        if(numberOfSegments < 1 || halfWidth <= 0.0f)
+        {
+            return;
+        }
+
+        // Unit normal, to the left of each segment.
+        std::vector<GLfloat> normals(numberOfSegments * 2);
+
+        for(int segment = 0; segment < numberOfSegments; segment++)
+        {
+            const GLfloat *start = &points[segment * 5];
+            const GLfloat *end = &points[((segment + 1) % numberOfPoints) * 5];
+            GLfloat dx = end[0] - start[0];
+            GLfloat dy = end[1] - start[1];
+            GLfloat length = sqrtf(dx * dx + dy * dy);
+
+            normals[segment * 2] = -dy / length;
+            normals[segment * 2 + 1] = dx / length;
+        }
+
+        for(int segment = 0; segment < numberOfSegments; segment++)
+        {
+            int endPoint = (segment + 1) % numberOfPoints;
+            const GLfloat *ends[] = {&points[segment * 5], &points[endPoint * 5]};
+            const GLfloat *normal = &normals[segment * 2];
+            GLuint first = (GLuint)(vertices->size() / PATH_FLOATS_PER_VERTEX);
+
+            for(int side = 0; side < 2; side++)
+            {
+                // The segment before the start of this one, or after its end.
+                int neighbour = side == 0 ? segment - 1 : segment + 1;
+                bool hasNeighbour = isClosed || (neighbour >= 0 && neighbour < numberOfSegments);
+                GLfloat offset[] = {normal[0] * halfWidth, normal[1] * halfWidth};
+
+                if(hasNeighbour)
+                {
+                    const GLfloat *other = &normals[((neighbour + numberOfSegments) % numberOfSegments) * 2];
+                    GLfloat miter[] = {normal[0] + other[0], normal[1] + other[1]};
+                    GLfloat scale = miter[0] * normal[0] + miter[1] * normal[1];
+
+                    // scale is 1 + cos of the turn, the miter is halfWidth * sqrt(2 / scale) long.
+                    if(scale > 2.0f / (PATH_MITER_LIMIT * PATH_MITER_LIMIT))
+                    {
+                        offset[0] = miter[0] * halfWidth / scale;
+                        offset[1] = miter[1] * halfWidth / scale;
+                    }
+                    else if(side == 1)
+                    {
+                        addBevel(ends[1], normal, other, halfWidth, vertices, elements);
+                    }
+                }
+
+                addVertex(vertices, ends[side][0] + offset[0], ends[side][1] + offset[1], ends[side] + 2);
+                addVertex(vertices, ends[side][0] - offset[0], ends[side][1] - offset[1], ends[side] + 2);
+            }
+
+            // first and first + 1 are left and right at the start, first + 2 and first + 3 at the end.
+            GLuint quad[] = {first, first + 1, first + 3, first, first + 3, first + 2};
+            elements->insert(elements->end(), quad, quad + 6);
+        }
+    }
+
+    // Fills the wedge between the square ends of two segments meeting at point, on both sides
+    // since only one of them is outside the turn.
+    static void addBevel(const GLfloat *point, const GLfloat *normal, const GLfloat *nextNormal, GLfloat halfWidth, std::vector<GLfloat> *vertices, std::vector<GLuint> *elements)
+    {
+        GLuint first = (GLuint)(vertices->size() / PATH_FLOATS_PER_VERTEX);
+
+        addVertex(vertices, point[0], point[1], point + 2);
+
+        for(int side = 1; side >= -1; side -= 2)
+        {
+            addVertex(vertices, point[0] + normal[0] * halfWidth * side, point[1] + normal[1] * halfWidth * side, point + 2);
+            addVertex(vertices, point[0] + nextNormal[0] * halfWidth * side, point[1] + nextNormal[1] * halfWidth * side, point + 2);
+        }
+
+        GLuint wedges[] = {first, first + 1, first + 2, first, first + 4, first + 3};
+        elements->insert(elements->end(), wedges, wedges + 6);
+    }
+
+    static GLfloat cross(const GLfloat *origin, const GLfloat *a, const GLfloat *b)
+    {
+        return (a[0] - origin[0]) * (b[1] - origin[1]) - (a[1] - origin[1]) * (b[0] - origin[0]);
+    }
+
+    // Triangles of the subpath as a polygon, whose points are already in the vertices at first.
+    // Convex polygons are a fan, others are clipped one ear at a time.
+    static void addFill(const Subpath& subpath, GLuint first, std::vector<GLuint> *elements)
+    {
+        int numberOfPoints = (int)(subpath.points.size() / PATH_FLOATS_PER_VERTEX);
+
+        if(numberOfPoints < 3)
+        {
+            return;
+        }
+
+        const GLfloat *points = &subpath.points[0];
+        GLfloat area = 0.0f;
+        bool hasLeftTurns = false;
+        bool hasRightTurns = false;
+
+        for(int point = 0; point < numberOfPoints; point++)
+        {
+            const GLfloat *current = points + point * 5;
+            const GLfloat *next = points + ((point + 1) % numberOfPoints) * 5;
+            GLfloat turn = cross(current, next, points + ((point + 2) % numberOfPoints) * 5);
+
+            area += current[0] * next[1] - next[0] * current[1];
+            hasLeftTurns = hasLeftTurns || turn > 0.0f;
+            hasRightTurns = hasRightTurns || turn < 0.0f;
+        }
+
+        if(!(hasLeftTurns && hasRightTurns))
+        {
+            for(int point = 1; point + 1 < numberOfPoints; point++)
+            {
+                GLuint triangle[] = {first, first + point, first + point + 1};
+                elements->insert(elements->end(), triangle, triangle + 3);
+            }
+
+            return;
+        }
+
+        // Ears are found walking counter clockwise, so clockwise outlines are walked backwards.
+        std::vector<int> remaining(numberOfPoints);
+
+        for(int point = 0; point < numberOfPoints; point++)
+        {
+            remaining[point] = area > 0.0f ? point : numberOfPoints - 1 - point;
+        }
+
+        int misses = 0;
+        int corner = 0;
+
+        while(remaining.size() > 3 && misses < (int)remaining.size())
+        {
+            int count = (int)remaining.size();
+            int previous = remaining[(corner + count - 1) % count];
+            int current = remaining[corner % count];
+            int next = remaining[(corner + 1) % count];
+            const GLfloat *a = points + previous * 5;
+            const GLfloat *b = points + current * 5;
+            const GLfloat *c = points + next * 5;
+            bool isEar = cross(a, b, c) > 0.0f;
+
+            for(int other = 0; other < count && isEar; other++)
+            {
+                const GLfloat *p = points + remaining[other] * 5;
+
+                if(remaining[other] == previous || remaining[other] == current || remaining[other] == next)
+                {
+                    continue;
+                }
+
+                isEar = !(cross(a, b, p) >= 0.0f && cross(b, c, p) >= 0.0f && cross(c, a, p) >= 0.0f);
+            }
+
+            if(isEar)
+            {
+                GLuint triangle[] = {first + previous, first + current, first + next};
+                elements->insert(elements->end(), triangle, triangle + 3);
+                remaining.erase(remaining.begin() + corner % count);
+                misses = 0;
+            }
+            else
+            {
+                corner++;
+                misses++;
+            }
+
+            corner %= (int)remaining.size();
+        }
+
+        // Only a degenerate outline runs out of ears, the rest of it is left out.
+        if(remaining.size() == 3)
+        {
+            GLuint triangle[] = {first + remaining[0], first + remaining[1], first + remaining[2]};
+            elements->insert(elements->end(), triangle, triangle + 3);
+        }
+    }
+
+    int add(Kind kind, GLfloat width, unsigned int hash, const std::vector<GLfloat>& commands, GLenum mode, std::vector<GLfloat> *vertices, std::vector<GLuint> *elements)
+    {
+        loadFunctions();
+
+        Shape shape;
+        shape.kind = kind;
+        shape.width = width;
+        shape.hash = hash;
+        shape.commands = commands;
+        shape.mode = mode;
+        shape.numberOfElements = (GLsizei)elements->size();
+        shape.vertexBuffer = 0;
+        shape.elementBuffer = 0;
+
+        frameStatistics.tessellations++;
+        totalStatistics.tessellations++;
+
+        if(genBuffers != NULL && !elements->empty())
+        {
+            genBuffers(1, &shape.vertexBuffer);
+            bindBuffer(GL_ARRAY_BUFFER, shape.vertexBuffer);
+            bufferData(GL_ARRAY_BUFFER, (ptrdiff_t)(vertices->size() * sizeof(GLfloat)), &(*vertices)[0], GL_STATIC_DRAW);
+            bindBuffer(GL_ARRAY_BUFFER, 0);
+
+            genBuffers(1, &shape.elementBuffer);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, shape.elementBuffer);
+            bufferData(GL_ELEMENT_ARRAY_BUFFER, (ptrdiff_t)(elements->size() * sizeof(GLuint)), &(*elements)[0], GL_STATIC_DRAW);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        else
+        {
+            shape.vertices.swap(*vertices);
+            shape.elements.swap(*elements);
+        }
+
+        shapes.push_back(shape);
+        return (int)shapes.size() - 1;
+    }
+};
+
+#endif /* __PATH_TESSELLATOR_H__ */
@@ -0,0 +1,1081 @@
+#ifndef __PLATFORM_H__
+#define __PLATFORM_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/XKBlib.h>
+#include <X11/keysym.h>
+#include <GL/gl.h>
+#include <GL/glx.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "frameTimer.h"
+
+// The window, the GLX context and the event loop every XWindows sample used to carry a copy of.
+// A sample fills PlatformCallbacks with its own functions and hands them to Platform::run(),
+// which opens the window, makes the context current, calls initialize() and then update() and
+// display() once per frame until Esc or the close button, swapping buffers after each display().
+// Esc quits and F toggles full-screen before keyPress() sees the key.
+//
+// Choosing a frame buffer configuration used to mean a glXGetVisualFromFBConfig() call and a log
+// entry for every one the server has, on every launch. The chosen configuration and visual IDs
+// are now kept in $XDG_CACHE_HOME/realTimeRendering.fbconfig (~/.cache without it), one line per
+// display, screen and request, and the next launch asks GLX for that one configuration by ID.
+// A cached entry that no longer matches (new driver, other server) is walked again and replaced.
+//
+// The context is 4.5 compatibility with the old 1.0 fallback, made once for the window. Swap
+// interval, MSAA samples and sRGB come from PlatformOptions and can be overridden with
+// --swap-interval N, --samples N and --srgb on the command line. The swap interval is left to the
+// driver unless a sample or --swap-interval asks for one. When GL/glew.h is included
+// before this header, GLEW is initialized as soon as the context is current.
+//
+// Every frame is timed with FrameTimer, CPU time for the events, update, display and swap phases
+// and GPU time for display(). Percentiles are logged on exit and written to frameTimes.csv, or
+// the file --timing-csv names. The time initialize() took is logged once it returns.
+//
+// --headless --frames N --size WxH needs no X server and no GPU: the context comes from EGL,
+// surfaceless where Mesa offers it and on a 1x1 pbuffer otherwise, and every frame is drawn into
+// a WxH framebuffer object bound in place of the window. The same update() and display() run N
+// times, each frame followed by glFinish() in place of the swap so its time includes rendering,
+// and the frame time percentiles are printed as well. MSAA is used there only when --samples
+// asks for it, so runs on different machines draw the same pixels. Link -lEGL.
+
+#ifndef GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB
+#define GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB 0x20B2
+#endif
+
+#ifndef GL_FRAMEBUFFER_SRGB
+#define GL_FRAMEBUFFER_SRGB 0x8DB9
+#endif
+
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#define GL_RENDERBUFFER 0x8D41
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#define GL_DEPTH_STENCIL_ATTACHMENT 0x821A
+#define GL_DEPTH24_STENCIL8 0x88F0
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+
+#ifndef GL_SRGB8_ALPHA8
+#define GL_SRGB8_ALPHA8 0x8C43
+#endif
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+#define PLATFORM_CACHE_FILE_NAME "realTimeRendering.fbconfig"
+#define PLATFORM_MAX_CACHE_LINES 64
+#define PLATFORM_CACHE_LINE_LENGTH 256
+#define PLATFORM_CACHE_KEY_LENGTH 128
+#define PLATFORM_CACHE_PATH_LENGTH PATH_MAX
+
+// Most samples the server offers, the old choice.
+#define PLATFORM_MOST_SAMPLES -1
+
+// Leaves the swap interval to the driver and the user's settings. Any other value, negative ones
+// asking GLX_EXT_swap_control_tear for adaptive sync included, is set.
+#define PLATFORM_DRIVER_SWAP_INTERVAL INT_MIN
+
+#define PLATFORM_DEFAULT_HEADLESS_FRAMES 100
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+typedef GLXContext (*PlatformCreateContextAttribsProc)(Display *display, GLXFBConfig fbConfig, GLXContext sharedContext, Bool direct, const int *attributes);
+typedef void (*PlatformSwapIntervalEXTProc)(Display *display, GLXDrawable drawable, int interval);
+typedef int (*PlatformSwapIntervalMESAProc)(unsigned int interval);
+typedef EGLDisplay (*PlatformGetPlatformDisplayProc)(EGLenum platform, void *nativeDisplay, const EGLint *attributes);
+typedef void (APIENTRY *PlatformGenObjectsProc)(GLsizei count, GLuint *objects);
+typedef void (APIENTRY *PlatformDeleteObjectsProc)(GLsizei count, const GLuint *objects);
+typedef void (APIENTRY *PlatformBindObjectProc)(GLenum target, GLuint object);
+typedef void (APIENTRY *PlatformRenderbufferStorageMultisampleProc)(GLenum target, GLsizei samples, GLenum format, GLsizei width, GLsizei height);
+typedef void (APIENTRY *PlatformFramebufferRenderbufferProc)(GLenum target, GLenum attachment, GLenum renderbufferTarget, GLuint renderbuffer);
+typedef GLenum (APIENTRY *PlatformCheckFramebufferStatusProc)(GLenum target);
+
+// Any of them may be NULL. All but keyPress() are called with the context current.
+struct PlatformCallbacks
+{
+    void (*initialize)(void);
+    void (*resize)(int width, int height);
+    void (*update)(void);
+    void (*display)(void);
+    void (*keyPress)(KeySym keySymbol, char character);
+    void (*cleanup)(void);
+};
+
+struct PlatformOptions
+{
+    const char *title;
+    int width;
+    int height;
+
+    // 0 presents as fast as possible, 1 waits for every vertical blank, and
+    // PLATFORM_DRIVER_SWAP_INTERVAL makes no swap control call at all.
+    int swapInterval;
+
+    // 0 for none, N for at least N, PLATFORM_MOST_SAMPLES for as many as there are.
+    int samples;
+    bool isSrgb;
+
+    // Where the choices and failures are logged, nothing is logged when NULL.
+    FILE *logFile;
+
+    // Draws frames frames into a framebuffer object without a window, see above.
+    bool isHeadless;
+    int frames;
+
+    // Where the frame time percentiles go on exit.
+    const char *timingFileName;
+
+    PlatformOptions(void)
+    {
+        title = "CG - PP";
+        width = 800;
+        height = 600;
+        swapInterval = PLATFORM_DRIVER_SWAP_INTERVAL;
+        samples = PLATFORM_MOST_SAMPLES;
+        isSrgb = false;
+        logFile = NULL;
+        isHeadless = false;
+        frames = PLATFORM_DEFAULT_HEADLESS_FRAMES;
+        timingFileName = "frameTimes.csv";
+    }
+};
+
+class Platform
+{
+public:
+    Platform(void)
+    {
+        memset(&callbacks, 0, sizeof(callbacks));
+        display = NULL;
+        visualInfo = NULL;
+        colormap = 0;
+        window = 0;
+        glxContext = NULL;
+        eglDisplay = EGL_NO_DISPLAY;
+        eglContext = EGL_NO_CONTEXT;
+        eglSurface = EGL_NO_SURFACE;
+        framebuffer = 0;
+        colorRenderbuffer = 0;
+        depthRenderbuffer = 0;
+        initializeSeconds = 0.0;
+        width = 0;
+        height = 0;
+        isFullscreen = false;
+        isDone = false;
+    }
+
+    // Parses the command line into options, runs the sample until it quits and cleans up.
+    // Returns EXIT_SUCCESS, failures exit from exit() on the way.
+    int run(int argc, char **argv, const PlatformOptions &requested, const PlatformCallbacks &sampleCallbacks)
+    {
+        options = requested;
+        callbacks = sampleCallbacks;
+        parseArguments(argc, argv);
+
+        width = options.width;
+        height = options.height;
+
+        if(options.isHeadless)
+        {
+            createHeadlessContext();
+            createFramebuffer();
+        }
+        else
+        {
+            createWindow();
+            createContext();
+        }
+
+        // Startup as the sample sees it, shader compiles and uploads included.
+        double initializeStart = FrameTimer::now();
+
+        if(callbacks.initialize != NULL)
+        {
+            callbacks.initialize();
+        }
+
+        initializeSeconds = FrameTimer::now() - initializeStart;
+
+        if(options.logFile != NULL)
+        {
+            fprintf(options.logFile, "initialize() took %.3f ms.\n", initializeSeconds * 1000.0);
+            fflush(options.logFile);
+        }
+
+        if(callbacks.resize != NULL)
+        {
+            callbacks.resize(width, height);
+        }
+
+        XEvent event;
+
+        for(int frame = 0; options.isHeadless ? frame < options.frames : !isDone; ++frame)
+        {
+            frameTimer.beginFrame();
+
+            while(!options.isHeadless && XPending(display))
+            {
+                XNextEvent(display, &event);
+                handleEvent(&event);
+            }
+
+            frameTimer.endPhase(FRAME_PHASE_EVENTS);
+            renderFrame();
+            frameTimer.endFrame();
+        }
+
+        reportTiming();
+        destroy();
+        return EXIT_SUCCESS;
+    }
+
+    // Cleans up the sample and the window and exits, for failures anywhere after run().
+    void exit(int status)
+    {
+        destroy();
+        ::exit(status);
+    }
+
+    void quit(void)
+    {
+        isDone = true;
+    }
+
+    int getWidth(void) const
+    {
+        return width;
+    }
+
+    int getHeight(void) const
+    {
+        return height;
+    }
+
+private:
+    PlatformOptions options;
+    PlatformCallbacks callbacks;
+
+    Display *display;
+    XVisualInfo *visualInfo;
+    Colormap colormap;
+    Window window;
+    GLXFBConfig glxFBConfig;
+    GLXContext glxContext;
+
+    EGLDisplay eglDisplay;
+    EGLContext eglContext;
+    EGLSurface eglSurface;
+    GLuint framebuffer;
+    GLuint colorRenderbuffer;
+    GLuint depthRenderbuffer;
+    PlatformDeleteObjectsProc deleteFramebuffers;
+    PlatformDeleteObjectsProc deleteRenderbuffers;
+
+    FrameTimer frameTimer;
+    double initializeSeconds;
+
+    int width;
+    int height;
+    bool isFullscreen;
+    bool isDone;
+
+    void log(const char *message, const char *detail = "")
+    {
+        if(options.logFile != NULL)
+        {
+            fprintf(options.logFile, "%s%s\n", message, detail);
+            fflush(options.logFile);
+        }
+    }
+
+    void parseArguments(int argc, char **argv)
+    {
+        for(int argument = 1; argument < argc; ++argument)
+        {
+            bool hasValue = argument + 1 < argc;
+
+            if(strcmp(argv[argument], "--srgb") == 0)
+            {
+                options.isSrgb = true;
+            }
+            else if(strcmp(argv[argument], "--samples") == 0 && hasValue)
+            {
+                options.samples = atoi(argv[++argument]);
+            }
+            else if(strcmp(argv[argument], "--swap-interval") == 0 && hasValue)
+            {
+                options.swapInterval = atoi(argv[++argument]);
+            }
+            else if(strcmp(argv[argument], "--headless") == 0)
+            {
+                options.isHeadless = true;
+            }
+            else if(strcmp(argv[argument], "--timing-csv") == 0 && hasValue)
+            {
+                options.timingFileName = argv[++argument];
+            }
+            else if(strcmp(argv[argument], "--frames") == 0 && hasValue)
+            {
+                options.frames = atoi(argv[++argument]);
+            }
+            else if(strcmp(argv[argument], "--size") == 0 && hasValue)
+            {
+                int sizeWidth = 0;
+                int sizeHeight = 0;
+
+                if(sscanf(argv[++argument], "%dx%d", &sizeWidth, &sizeHeight) == 2 && sizeWidth > 0 && sizeHeight > 0)
+                {
+                    options.width = sizeWidth;
+                    options.height = sizeHeight;
+                }
+            }
+        }
+    }
+
+    void createWindow(void)
+    {
+        display = XOpenDisplay(NULL);
+
+        if(display == NULL)
+        {
+            log("Error: Unable to open X display.");
+            exit(EXIT_FAILURE);
+        }
+
+        int defaultScreen = XDefaultScreen(display);
+
+        if(!chooseCachedFBConfig(defaultScreen) && !chooseFBConfig(defaultScreen))
+        {
+            log("Error: Unable to get valid frame buffer configurations.");
+            exit(EXIT_FAILURE);
+        }
+
+        visualInfo = glXGetVisualFromFBConfig(display, glxFBConfig);
+
+        if(visualInfo == NULL)
+        {
+            log("Error: Unable to choose visual.");
+            exit(EXIT_FAILURE);
+        }
+
+        XSetWindowAttributes windowAttributes;
+        windowAttributes.border_pixel = 0;
+        windowAttributes.border_pixmap = 0;
+        windowAttributes.background_pixel = BlackPixel(display, defaultScreen);
+        windowAttributes.background_pixmap = 0;
+        windowAttributes.colormap = XCreateColormap(display, XRootWindow(display, visualInfo->screen), visualInfo->visual, AllocNone);
+        windowAttributes.event_mask = ExposureMask | VisibilityChangeMask | ButtonPressMask | KeyPressMask | PointerMotionMask | StructureNotifyMask;
+
+        int styleMask = CWBorderPixel | CWBackPixel | CWEventMask | CWColormap;
+        colormap = windowAttributes.colormap;
+
+        window = XCreateWindow(display, XRootWindow(display, visualInfo->screen), 0, 0, width, height, 0, visualInfo->depth, InputOutput, visualInfo->visual, styleMask, &windowAttributes);
+
+        if(!window)
+        {
+            log("Error: Failed to create main window.");
+            exit(EXIT_FAILURE);
+        }
+
+        XStoreName(display, window, options.title);
+
+        Atom windowManagerDelete = XInternAtom(display, "WM_DELETE_WINDOW", True);
+        XSetWMProtocols(display, window, &windowManagerDelete, 1);
+        XMapWindow(display, window);
+    }
+
+    int getAttribute(GLXFBConfig fbConfig, int attribute)
+    {
+        int value = 0;
+        glXGetFBConfigAttrib(display, fbConfig, attribute, &value);
+        return value;
+    }
+
+    // A truncated path names some other file and a truncated key matches other requests, so
+    // either one means no cache.
+    static bool isPrinted(int length, size_t size)
+    {
+        return length >= 0 && (size_t)length < size;
+    }
+
+    bool getCachePath(char *path, size_t size)
+    {
+        const char *cacheHome = getenv("XDG_CACHE_HOME");
+        const char *home = getenv("HOME");
+
+        if(cacheHome != NULL && cacheHome[0] != '\0')
+        {
+            return isPrinted(snprintf(path, size, "%s/%s", cacheHome, PLATFORM_CACHE_FILE_NAME), size);
+        }
+        else if(home != NULL && home[0] != '\0')
+        {
+            char directory[PLATFORM_CACHE_PATH_LENGTH];
+
+            if(!isPrinted(snprintf(directory, sizeof(directory), "%s/.cache", home), sizeof(directory)))
+            {
+                return false;
+            }
+
+            mkdir(directory, 0700);
+            return isPrinted(snprintf(path, size, "%s/%s", directory, PLATFORM_CACHE_FILE_NAME), size);
+        }
+
+        return false;
+    }
+
+    // What the cached line is for, everything before the two IDs.
+    bool getCacheKey(int screen, char *key, size_t size)
+    {
+        return isPrinted(snprintf(key, size, "%s %d %d %d", DisplayString(display), screen, options.samples, options.isSrgb ? 1 : 0), size);
+    }
+
+    bool chooseCachedFBConfig(int screen)
+    {
+        char path[PLATFORM_CACHE_PATH_LENGTH];
+        char key[PLATFORM_CACHE_KEY_LENGTH];
+        char line[PLATFORM_CACHE_LINE_LENGTH];
+        int fbConfigId = 0;
+        int visualId = 0;
+
+        FILE *cacheFile = getCachePath(path, sizeof(path)) && getCacheKey(screen, key, sizeof(key)) ? fopen(path, "r") : NULL;
+
+        if(cacheFile == NULL)
+        {
+            return false;
+        }
+
+        size_t keyLength = strlen(key);
+
+        while(fgets(line, sizeof(line), cacheFile) != NULL)
+        {
+            if(strncmp(line, key, keyLength) == 0 && line[keyLength] == ' ')
+            {
+                sscanf(line + keyLength, " %x %x", &fbConfigId, &visualId);
+            }
+        }
+
+        fclose(cacheFile);
+
+        if(fbConfigId == 0)
+        {
+            return false;
+        }
+
+        // All other attributes are ignored when GLX_FBCONFIG_ID is given.
+        int attributes[] = {GLX_FBCONFIG_ID, fbConfigId, None};
+        int numberOfFBConfigs = 0;
+        GLXFBConfig *fbConfigs = glXChooseFBConfig(display, screen, attributes, &numberOfFBConfigs);
+
+        if(fbConfigs == NULL || numberOfFBConfigs < 1)
+        {
+            return false;
+        }
+
+        GLXFBConfig fbConfig = fbConfigs[0];
+        XFree(fbConfigs);
+
+        if(getAttribute(fbConfig, GLX_VISUAL_ID) != visualId || !isUsable(fbConfig))
+        {
+            log("Cached frame buffer configuration is stale, choosing again.");
+            return false;
+        }
+
+        glxFBConfig = fbConfig;
+
+        if(options.logFile != NULL)
+        {
+            fprintf(options.logFile, "Cached frame buffer configuration 0x%x, visual ID 0x%x, samples %d.\n", fbConfigId, visualId, getAttribute(fbConfig, GLX_SAMPLES));
+            fflush(options.logFile);
+        }
+
+        return true;
+    }
+
+    // Checks what glXChooseFBConfig() would have checked, for configurations taken by ID.
+    bool isUsable(GLXFBConfig fbConfig)
+    {
+        int samples = getAttribute(fbConfig, GLX_SAMPLE_BUFFERS) ? getAttribute(fbConfig, GLX_SAMPLES) : 0;
+
+        return getAttribute(fbConfig, GLX_DOUBLEBUFFER) && getAttribute(fbConfig, GLX_DEPTH_SIZE) >= 24
+            && (getAttribute(fbConfig, GLX_DRAWABLE_TYPE) & GLX_WINDOW_BIT) != 0
+            && (options.samples <= 0 || samples >= options.samples)
+            && (options.samples != 0 || samples == 0)
+            && (!options.isSrgb || getAttribute(fbConfig, GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB));
+    }
+
+    bool chooseFBConfig(int screen)
+    {
+        int frameBufferAttributes[32] = {
+            GLX_RED_SIZE, 8,
+            GLX_GREEN_SIZE, 8,
+            GLX_BLUE_SIZE, 8,
+            GLX_ALPHA_SIZE, 8,
+            GLX_DEPTH_SIZE, 24,
+            GLX_STENCIL_SIZE, 8,
+            GLX_DOUBLEBUFFER, True,
+            GLX_X_RENDERABLE, True,
+            GLX_X_VISUAL_TYPE, GLX_TRUE_COLOR,
+            GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+            GLX_RENDER_TYPE, GLX_RGBA_BIT,
+            None
+        };
+
+        int count = 22;
+
+        if(options.samples > 0)
+        {
+            frameBufferAttributes[count++] = GLX_SAMPLE_BUFFERS;
+            frameBufferAttributes[count++] = 1;
+            frameBufferAttributes[count++] = GLX_SAMPLES;
+            frameBufferAttributes[count++] = options.samples;
+        }
+
+        if(options.isSrgb)
+        {
+            frameBufferAttributes[count++] = GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB;
+            frameBufferAttributes[count++] = True;
+        }
+
+        frameBufferAttributes[count] = None;
+
+        int numberOfFBConfigs = 0;
+        GLXFBConfig *fbConfigs = glXChooseFBConfig(display, screen, frameBufferAttributes, &numberOfFBConfigs);
+
+        if(fbConfigs == NULL)
+        {
+            return false;
+        }
+
+        // Attributes alone are enough to choose, the visual is only fetched for the chosen one.
+        // glXChooseFBConfig() sorts fewer samples first, so the first usable one is the smallest.
+        int best = -1;
+        int bestSamples = -1;
+
+        for(int counter = 0; counter < numberOfFBConfigs; ++counter)
+        {
+            if(getAttribute(fbConfigs[counter], GLX_VISUAL_ID) == 0 || !isUsable(fbConfigs[counter]))
+            {
+                continue;
+            }
+
+            int samples = getAttribute(fbConfigs[counter], GLX_SAMPLE_BUFFERS) ? getAttribute(fbConfigs[counter], GLX_SAMPLES) : 0;
+
+            if(best < 0 || (options.samples == PLATFORM_MOST_SAMPLES && samples > bestSamples))
+            {
+                best = counter;
+                bestSamples = samples;
+            }
+        }
+
+        if(best >= 0)
+        {
+            glxFBConfig = fbConfigs[best];
+        }
+
+        XFree(fbConfigs);
+
+        if(best < 0)
+        {
+            return false;
+        }
+
+        int fbConfigId = getAttribute(glxFBConfig, GLX_FBCONFIG_ID);
+        int visualId = getAttribute(glxFBConfig, GLX_VISUAL_ID);
+
+        if(options.logFile != NULL)
+        {
+            fprintf(options.logFile, "Chose frame buffer configuration 0x%x of %d, visual ID 0x%x, samples %d.\n", fbConfigId, numberOfFBConfigs, visualId, bestSamples);
+            fflush(options.logFile);
+        }
+
+        storeCachedFBConfig(screen, fbConfigId, visualId);
+        return true;
+    }
+
+    // Rewrites the cache with this request's line replaced, keeping those of other requests.
+    void storeCachedFBConfig(int screen, int fbConfigId, int visualId)
+    {
+        char path[PLATFORM_CACHE_PATH_LENGTH];
+        char key[PLATFORM_CACHE_KEY_LENGTH];
+        static char lines[PLATFORM_MAX_CACHE_LINES][PLATFORM_CACHE_LINE_LENGTH];
+        int numberOfLines = 0;
+
+        if(!getCachePath(path, sizeof(path)) || !getCacheKey(screen, key, sizeof(key)))
+        {
+            return;
+        }
+
+        size_t keyLength = strlen(key);
+        FILE *cacheFile = fopen(path, "r");
+
+        if(cacheFile != NULL)
+        {
+            while(numberOfLines < PLATFORM_MAX_CACHE_LINES - 1 && fgets(lines[numberOfLines], PLATFORM_CACHE_LINE_LENGTH, cacheFile) != NULL)
+            {
+                if(strncmp(lines[numberOfLines], key, keyLength) != 0 || lines[numberOfLines][keyLength] != ' ')
+                {
+                    ++numberOfLines;
+                }
+            }
+
+            fclose(cacheFile);
+        }
+
+        snprintf(lines[numberOfLines++], PLATFORM_CACHE_LINE_LENGTH, "%s %x %x\n", key, fbConfigId, visualId);
+        cacheFile = fopen(path, "w");
+
+        if(cacheFile == NULL)
+        {
+            return;
+        }
+
+        for(int line = 0; line < numberOfLines; ++line)
+        {
+            fputs(lines[line], cacheFile);
+        }
+
+        fclose(cacheFile);
+    }
+
+    void createContext(void)
+    {
+        PlatformCreateContextAttribsProc createContextAttribs = (PlatformCreateContextAttribsProc)glXGetProcAddressARB((const GLubyte *)"glXCreateContextAttribsARB");
+
+        if(createContextAttribs == NULL)
+        {
+            log("Error: Unable to get glXCreateContextAttribsARBProc address.");
+            exit(EXIT_FAILURE);
+        }
+
+        int attributes[] = {
+            GLX_CONTEXT_MAJOR_VERSION_ARB, 4,
+            GLX_CONTEXT_MINOR_VERSION_ARB, 5,
+            GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_COMPATIBILITY_PROFILE_BIT_ARB,
+            None
+        };
+
+        glxContext = createContextAttribs(display, glxFBConfig, 0, True, attributes);
+
+        if(glxContext == NULL)
+        {
+            log("Failed to get GLX Context for OpenGL version 4.5, using old version.");
+
+            // When a context version below 3.0 is requested, implementation will return
+            // the newest context version compatible with OpenGL version less than 3.0
+            int oldAttributes[] = {
+                GLX_CONTEXT_MAJOR_VERSION_ARB, 1,
+                GLX_CONTEXT_MINOR_VERSION_ARB, 0,
+                None
+            };
+
+            glxContext = createContextAttribs(display, glxFBConfig, 0, True, oldAttributes);
+        }
+        else
+        {
+            log("GLX Context for OpenGL version 4.5 is created.");
+        }
+
+        if(glxContext == NULL)
+        {
+            log("Error: Unable to create GLX context.");
+            exit(EXIT_FAILURE);
+        }
+
+        log(glXIsDirect(display, glxContext) ? "Direct GLX rendering context is used, hardware rendering is available." : "Indirect GLX rendering context is used.");
+        glXMakeCurrent(display, window, glxContext);
+
+        initializeContext();
+        setSwapInterval();
+    }
+
+    // What both the window and the headless context need once they are current.
+    void initializeContext(void)
+    {
+#ifdef __glew_h__
+        GLenum glewError = glewInit();
+
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        // GLEW loads the GL functions before it looks for the GLX display an EGL context has not.
+        if(glewError == GLEW_ERROR_NO_GLX_DISPLAY && options.isHeadless)
+        {
+            glewError = GLEW_OK;
+        }
+#endif
+
+        if(glewError != GLEW_OK)
+        {
+            log("Cannot initialize GLEW, Error: ", (const char *)glewGetErrorString(glewError));
+            exit(EXIT_FAILURE);
+        }
+#endif
+
+        if(options.isSrgb)
+        {
+            glEnable(GL_FRAMEBUFFER_SRGB);
+        }
+    }
+
+    void createHeadlessContext(void)
+    {
+        const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        bool isSurfaceless = false;
+
+        if(clientExtensions != NULL && strstr(clientExtensions, "EGL_MESA_platform_surfaceless") != NULL)
+        {
+            PlatformGetPlatformDisplayProc getPlatformDisplay = (PlatformGetPlatformDisplayProc)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+            if(getPlatformDisplay != NULL)
+            {
+                eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+                isSurfaceless = eglDisplay != EGL_NO_DISPLAY;
+            }
+        }
+
+        if(eglDisplay == EGL_NO_DISPLAY)
+        {
+            eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+
+        if(eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, NULL, NULL) || !eglBindAPI(EGL_OPENGL_API))
+        {
+            log("Error: Unable to initialize EGL.");
+            exit(EXIT_FAILURE);
+        }
+
+        // Surfaceless configurations need not have any surface type, the rest need pbuffers.
+        EGLint configAttributes[] = {
+            EGL_SURFACE_TYPE, isSurfaceless ? 0 : EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_NONE
+        };
+
+        EGLConfig config;
+        EGLint numberOfConfigs = 0;
+
+        if(!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &numberOfConfigs) || numberOfConfigs < 1)
+        {
+            log("Error: Unable to get an EGL configuration for OpenGL.");
+            exit(EXIT_FAILURE);
+        }
+
+        EGLint attributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 4,
+            EGL_CONTEXT_MINOR_VERSION, 5,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+            EGL_NONE
+        };
+
+        eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, attributes);
+
+        if(eglContext == EGL_NO_CONTEXT)
+        {
+            log("Failed to get EGL Context for OpenGL version 4.5, using old version.");
+            eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, NULL);
+        }
+        else
+        {
+            log("EGL Context for OpenGL version 4.5 is created.");
+        }
+
+        if(eglContext == EGL_NO_CONTEXT)
+        {
+            log("Error: Unable to create EGL context.");
+            exit(EXIT_FAILURE);
+        }
+
+        const char *extensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+
+        if(extensions == NULL || strstr(extensions, "EGL_KHR_surfaceless_context") == NULL)
+        {
+            EGLint pbufferAttributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+            eglSurface = eglCreatePbufferSurface(eglDisplay, config, pbufferAttributes);
+        }
+
+        if(!eglMakeCurrent(eglDisplay, eglSurface, eglSurface, eglContext))
+        {
+            log("Error: Unable to make the EGL context current.");
+            exit(EXIT_FAILURE);
+        }
+
+        log("Headless EGL rendering context is used, renderer: ", (const char *)glGetString(GL_RENDERER));
+        initializeContext();
+    }
+
+    // The window the sample would have drawn to, bound for good before initialize().
+    void createFramebuffer(void)
+    {
+        PlatformGenObjectsProc genFramebuffers = (PlatformGenObjectsProc)eglGetProcAddress("glGenFramebuffers");
+        PlatformGenObjectsProc genRenderbuffers = (PlatformGenObjectsProc)eglGetProcAddress("glGenRenderbuffers");
+        PlatformBindObjectProc bindFramebuffer = (PlatformBindObjectProc)eglGetProcAddress("glBindFramebuffer");
+        PlatformBindObjectProc bindRenderbuffer = (PlatformBindObjectProc)eglGetProcAddress("glBindRenderbuffer");
+        PlatformRenderbufferStorageMultisampleProc renderbufferStorageMultisample = (PlatformRenderbufferStorageMultisampleProc)eglGetProcAddress("glRenderbufferStorageMultisample");
+        PlatformFramebufferRenderbufferProc framebufferRenderbuffer = (PlatformFramebufferRenderbufferProc)eglGetProcAddress("glFramebufferRenderbuffer");
+        PlatformCheckFramebufferStatusProc checkFramebufferStatus = (PlatformCheckFramebufferStatusProc)eglGetProcAddress("glCheckFramebufferStatus");
+        deleteFramebuffers = (PlatformDeleteObjectsProc)eglGetProcAddress("glDeleteFramebuffers");
+        deleteRenderbuffers = (PlatformDeleteObjectsProc)eglGetProcAddress("glDeleteRenderbuffers");
+
+        if(genFramebuffers == NULL || renderbufferStorageMultisample == NULL || checkFramebufferStatus == NULL)
+        {
+            log("Error: Framebuffer objects are not available.");
+            exit(EXIT_FAILURE);
+        }
+
+        GLsizei samples = options.samples > 0 ? options.samples : 0;
+
+        genRenderbuffers(1, &colorRenderbuffer);
+        bindRenderbuffer(GL_RENDERBUFFER, colorRenderbuffer);
+        renderbufferStorageMultisample(GL_RENDERBUFFER, samples, options.isSrgb ? GL_SRGB8_ALPHA8 : GL_RGBA8, width, height);
+
+        genRenderbuffers(1, &depthRenderbuffer);
+        bindRenderbuffer(GL_RENDERBUFFER, depthRenderbuffer);
+        renderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH24_STENCIL8, width, height);
+        bindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        genFramebuffers(1, &framebuffer);
+        bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRenderbuffer);
+        framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRenderbuffer);
+
+        if(checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            log("Error: Headless framebuffer is incomplete.");
+            exit(EXIT_FAILURE);
+        }
+
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+    }
+
+    void renderFrame(void)
+    {
+        if(callbacks.update != NULL)
+        {
+            callbacks.update();
+        }
+
+        frameTimer.endPhase(FRAME_PHASE_UPDATE);
+        frameTimer.beginGpu();
+
+        if(callbacks.display != NULL)
+        {
+            callbacks.display();
+        }
+
+        frameTimer.endGpu();
+        frameTimer.endPhase(FRAME_PHASE_DISPLAY);
+
+        // Headless there is nothing to swap, waiting for the frame stands in for it so that its
+        // time includes rendering.
+        if(options.isHeadless)
+        {
+            glFinish();
+        }
+        else
+        {
+            glXSwapBuffers(display, window);
+        }
+
+        frameTimer.endPhase(FRAME_PHASE_SWAP);
+    }
+
+    void reportTiming(void)
+    {
+        frameTimer.finish();
+        frameTimer.log(options.logFile);
+
+        if(!frameTimer.writeCsv(options.timingFileName))
+        {
+            log("Unable to write frame times to ", options.timingFileName);
+        }
+
+        if(options.isHeadless)
+        {
+            const FrameHistogram &frames = frameTimer.getHistogram(FRAME_PHASE_FRAME);
+            const FrameHistogram &gpu = frameTimer.getHistogram(FRAME_PHASE_GPU);
+
+            printf("%s: %lld frames at %dx%d, %.1f frames per second\n", options.title, frames.getCount(), width, height, frames.getMean() > 0.0 ? 1.0 / frames.getMean() : 0.0);
+            printf("    initialize ms %.3f\n", initializeSeconds * 1000.0);
+            printf("    frame ms p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n", frames.percentile(0.5) * 1000.0, frames.percentile(0.9) * 1000.0, frames.percentile(0.99) * 1000.0, frames.getMaximum() * 1000.0);
+            printf("    gpu ms   p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n", gpu.percentile(0.5) * 1000.0, gpu.percentile(0.9) * 1000.0, gpu.percentile(0.99) * 1000.0, gpu.getMaximum() * 1000.0);
+        }
+    }
+
+    void setSwapInterval(void)
+    {
+        if(options.swapInterval == PLATFORM_DRIVER_SWAP_INTERVAL)
+        {
+            return;
+        }
+
+        const char *extensions = glXQueryExtensionsString(display, DefaultScreen(display));
+
+        if(extensions != NULL && strstr(extensions, "GLX_EXT_swap_control") != NULL)
+        {
+            PlatformSwapIntervalEXTProc swapInterval = (PlatformSwapIntervalEXTProc)glXGetProcAddressARB((const GLubyte *)"glXSwapIntervalEXT");
+            swapInterval(display, window, options.swapInterval);
+        }
+        else if(extensions != NULL && strstr(extensions, "GLX_MESA_swap_control") != NULL)
+        {
+            PlatformSwapIntervalMESAProc swapInterval = (PlatformSwapIntervalMESAProc)glXGetProcAddressARB((const GLubyte *)"glXSwapIntervalMESA");
+            swapInterval((unsigned int)options.swapInterval);
+        }
+        else
+        {
+            log("No GLX swap control, keeping the driver's swap interval.");
+        }
+    }
+
+    void handleEvent(XEvent *event)
+    {
+        KeySym keySymbol;
+        char asciiChars[32] = {0};
+
+        switch(event->type)
+        {
+            case KeyPress:
+                keySymbol = XkbKeycodeToKeysym(display, event->xkey.keycode, 0, 0);
+                XLookupString(&event->xkey, asciiChars, sizeof(asciiChars), NULL, NULL);
+
+                if(keySymbol == XK_Escape)
+                {
+                    isDone = true;
+                }
+                else if(asciiChars[0] == 'F' || asciiChars[0] == 'f')
+                {
+                    isFullscreen = !isFullscreen;
+                    toggleFullscreen();
+                }
+                else if(callbacks.keyPress != NULL)
+                {
+                    callbacks.keyPress(keySymbol, asciiChars[0]);
+                }
+            break;
+
+            case ConfigureNotify: // Window configuration change, like resize.
+                width = event->xconfigure.width;
+                height = event->xconfigure.height;
+
+                if(callbacks.resize != NULL)
+                {
+                    callbacks.resize(width, height);
+                }
+            break;
+
+            case ClientMessage: // Window close button.
+                isDone = true;
+            break;
+
+            default:
+            break;
+        }
+    }
+
+    void toggleFullscreen(void)
+    {
+        XEvent event;
+        memset(&event, 0, sizeof(event));
+
+        event.type = ClientMessage;
+        event.xclient.window = window;
+        event.xclient.message_type = XInternAtom(display, "_NET_WM_STATE", False);
+        event.xclient.format = 32;
+        event.xclient.data.l[0] = isFullscreen ? 1 : 0;
+        event.xclient.data.l[1] = XInternAtom(display, "_NET_WM_STATE_FULLSCREEN", False);
+
+        XSendEvent(display, XRootWindow(display, visualInfo->screen), False, StructureNotifyMask, &event);
+    }
+
+    // Safe to call more than once, and from the sample's own failure paths inside its callbacks.
+    void destroy(void)
+    {
+        bool isCurrent = (glxContext != NULL && glXGetCurrentContext() == glxContext) || (eglContext != EGL_NO_CONTEXT && eglGetCurrentContext() == eglContext);
+
+        if(isCurrent)
+        {
+            void (*cleanup)(void) = callbacks.cleanup;
+            callbacks.cleanup = NULL;
+
+            if(cleanup != NULL)
+            {
+                cleanup();
+            }
+        }
+
+        if(isCurrent && framebuffer != 0)
+        {
+            deleteFramebuffers(1, &framebuffer);
+            deleteRenderbuffers(1, &colorRenderbuffer);
+            deleteRenderbuffers(1, &depthRenderbuffer);
+            framebuffer = 0;
+        }
+
+        if(eglDisplay != EGL_NO_DISPLAY)
+        {
+            eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+            if(eglContext != EGL_NO_CONTEXT)
+            {
+                eglDestroyContext(eglDisplay, eglContext);
+                eglContext = EGL_NO_CONTEXT;
+            }
+
+            if(eglSurface != EGL_NO_SURFACE)
+            {
+                eglDestroySurface(eglDisplay, eglSurface);
+                eglSurface = EGL_NO_SURFACE;
+            }
+
+            eglTerminate(eglDisplay);
+            eglDisplay = EGL_NO_DISPLAY;
+        }
+
+        if(isCurrent && glxContext != NULL)
+        {
+            glXMakeCurrent(display, 0, 0);
+        }
+
+        if(glxContext != NULL)
+        {
+            glXDestroyContext(display, glxContext);
+            glxContext = NULL;
+        }
+
+        if(window)
+        {
+            XDestroyWindow(display, window);
+            window = 0;
+        }
+
+        if(colormap)
+        {
+            XFreeColormap(display, colormap);
+            colormap = 0;
+        }
+
+        if(visualInfo != NULL)
+        {
+            XFree(visualInfo);
+            visualInfo = NULL;
+        }
+
+        if(display != NULL)
+        {
+            XCloseDisplay(display);
+            display = NULL;
+        }
+    }
+};
+
+#endif /* __PLATFORM_H__ */
@@ -0,0 +1,702 @@
+#ifndef __PRIMITIVES_H__
+#define __PRIMITIVES_H__
+
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+
+#ifndef _WIN32
+#include <GL/glx.h>
+#endif
+
+// Sphere, cylinder, disk, torus and cube, tessellated once into a vertex and an element buffer
+// and drawn from there for as long as the library lives. Asking again for a primitive with the
+// same parameters returns the handle made the first time, so the create functions are cheap
+// enough to call from a draw function, but they are meant to be called once from initialize().
+//
+// Shapes match their GLU and GLUT counterparts: gluSphere(), gluCylinder() and gluDisk() have the
+// z axis as their axis, glutSolidTorus() lies in the xy plane and glutSolidCube() is centered on
+// the origin. Vertices are interleaved position, normal and texture coordinates, triangles are
+// counter clockwise seen from outside.
+//
+// draw() sets up the fixed function vertex, normal and texture coordinate arrays, drawWithShader()
+// the generic attributes at the locations given, through a vertex array object when the context
+// has them. Buffer functions are looked up from the context on first use, so this works with
+// plain gl.h; without buffer objects (OpenGL 1.1) the arrays are drawn from client memory.
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STATIC_DRAW 0x88E4
+#endif
+
+#define PRIMITIVES_PI 3.14159265358979f
+#define PRIMITIVE_FLOATS_PER_VERTEX 8
+
+typedef void (APIENTRY *PrimitiveGenBuffersProc)(GLsizei count, GLuint *buffers);
+typedef void (APIENTRY *PrimitiveDeleteBuffersProc)(GLsizei count, const GLuint *buffers);
+typedef void (APIENTRY *PrimitiveBindBufferProc)(GLenum target, GLuint buffer);
+typedef void (APIENTRY *PrimitiveBufferDataProc)(GLenum target, ptrdiff_t size, const void *data, GLenum usage);
+typedef void (APIENTRY *PrimitiveGenVertexArraysProc)(GLsizei count, GLuint *arrays);
+typedef void (APIENTRY *PrimitiveDeleteVertexArraysProc)(GLsizei count, const GLuint *arrays);
+typedef void (APIENTRY *PrimitiveBindVertexArrayProc)(GLuint array);
+typedef void (APIENTRY *PrimitiveVertexAttribPointerProc)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer);
+typedef void (APIENTRY *PrimitiveEnableVertexAttribArrayProc)(GLuint index);
+
+// Work done by the library, either since the last resetFrameStatistics() or in total.
+struct PrimitiveStatistics
+{
+    unsigned int tessellations;
+    unsigned int buffersCreated;
+    unsigned int bytesUploaded;
+    unsigned int draws;
+    unsigned int trianglesDrawn;
+};
+
+class PrimitiveLibrary
+{
+public:
+    enum
+    {
+        INVALID = -1
+    };
+
+    PrimitiveLibrary(void)
+    {
+        areFunctionsLoaded = false;
+        genBuffers = NULL;
+        deleteBuffers = NULL;
+        bindBuffer = NULL;
+        bufferData = NULL;
+        genVertexArrays = NULL;
+        deleteVertexArrays = NULL;
+        bindVertexArray = NULL;
+        vertexAttribPointer = NULL;
+        enableVertexAttribArray = NULL;
+        disableVertexAttribArray = NULL;
+
+        resetStatistics(&frameStatistics);
+        resetStatistics(&totalStatistics);
+    }
+
+    // Same parameters as gluSphere().
+    int sphere(GLfloat radius, GLint slices, GLint stacks)
+    {
+        GLfloat key[] = {radius, (GLfloat)slices, (GLfloat)stacks};
+        int primitive = find(SPHERE, key);
+
+        if(primitive != INVALID)
+        {
+            return primitive;
+        }
+
+        std::vector<GLfloat> vertices;
+        std::vector<GLuint> elements;
+
+        for(int stack = 0; stack <= stacks; stack++)
+        {
+            GLfloat rho = PRIMITIVES_PI * (GLfloat)stack / (GLfloat)stacks;
+
+            for(int slice = 0; slice <= slices; slice++)
+            {
+                GLfloat theta = 2.0f * PRIMITIVES_PI * (GLfloat)slice / (GLfloat)slices;
+                GLfloat normal[] = {-sinf(theta) * sinf(rho), cosf(theta) * sinf(rho), cosf(rho)};
+
+                addVertex(&vertices, normal[0] * radius, normal[1] * radius, normal[2] * radius, normal, (GLfloat)slice / (GLfloat)slices, 1.0f - (GLfloat)stack / (GLfloat)stacks);
+            }
+        }
+
+        addGrid(&elements, 0, slices, stacks);
+        return add(SPHERE, key, &vertices, &elements);
+    }
+
+    // Same parameters as gluCylinder(), open at both ends.
+    int cylinder(GLfloat baseRadius, GLfloat topRadius, GLfloat height, GLint slices, GLint stacks)
+    {
+        GLfloat key[] = {baseRadius, topRadius, height, (GLfloat)slices, (GLfloat)stacks};
+        int primitive = find(CYLINDER, key);
+
+        if(primitive != INVALID)
+        {
+            return primitive;
+        }
+
+        std::vector<GLfloat> vertices;
+        std::vector<GLuint> elements;
+
+        // The side leans in by the radius difference over the height, and so does its normal.
+        GLfloat slope = height != 0.0f ? (baseRadius - topRadius) / height : 0.0f;
+        GLfloat normalScale = 1.0f / sqrtf(1.0f + slope * slope);
+
+        // Rows from the top down, so the grid winds the same way as the sphere's.
+        for(int stack = stacks; stack >= 0; stack--)
+        {
+            GLfloat t = (GLfloat)stack / (GLfloat)stacks;
+            GLfloat radius = baseRadius + (topRadius - baseRadius) * t;
+
+            for(int slice = 0; slice <= slices; slice++)
+            {
+                GLfloat theta = 2.0f * PRIMITIVES_PI * (GLfloat)slice / (GLfloat)slices;
+                GLfloat normal[] = {-sinf(theta) * normalScale, cosf(theta) * normalScale, slope * normalScale};
+
+                addVertex(&vertices, -sinf(theta) * radius, cosf(theta) * radius, height * t, normal, (GLfloat)slice / (GLfloat)slices, t);
+            }
+        }
+
+        addGrid(&elements, 0, slices, stacks);
+        return add(CYLINDER, key, &vertices, &elements);
+    }
+
+    // Same parameters as gluDisk(), facing +z.
+    int disk(GLfloat innerRadius, GLfloat outerRadius, GLint slices, GLint loops)
+    {
+        GLfloat key[] = {innerRadius, outerRadius, (GLfloat)slices, (GLfloat)loops};
+        int primitive = find(DISK, key);
+
+        if(primitive != INVALID)
+        {
+            return primitive;
+        }
+
+        std::vector<GLfloat> vertices;
+        std::vector<GLuint> elements;
+        GLfloat normal[] = {0.0f, 0.0f, 1.0f};
+
+        // Rings from the inside out, so the grid faces +z.
+        for(int loop = 0; loop <= loops; loop++)
+        {
+            GLfloat radius = innerRadius + (outerRadius - innerRadius) * (GLfloat)loop / (GLfloat)loops;
+
+            for(int slice = 0; slice <= slices; slice++)
+            {
+                GLfloat theta = 2.0f * PRIMITIVES_PI * (GLfloat)slice / (GLfloat)slices;
+                GLfloat x = -sinf(theta) * radius;
+                GLfloat y = cosf(theta) * radius;
+
+                addVertex(&vertices, x, y, 0.0f, normal, 0.5f + x / (2.0f * outerRadius), 0.5f + y / (2.0f * outerRadius));
+            }
+        }
+
+        addGrid(&elements, 0, slices, loops);
+        return add(DISK, key, &vertices, &elements);
+    }
+
+    // Same parameters as glutSolidTorus(): innerRadius is the tube, outerRadius the ring.
+    int torus(GLfloat innerRadius, GLfloat outerRadius, GLint sides, GLint rings)
+    {
+        GLfloat key[] = {innerRadius, outerRadius, (GLfloat)sides, (GLfloat)rings};
+        int primitive = find(TORUS, key);
+
+        if(primitive != INVALID)
+        {
+            return primitive;
+        }
+
+        std::vector<GLfloat> vertices;
+        std::vector<GLuint> elements;
+
+        // Rows go around the tube from the inside over the top, columns around the ring.
+        for(int side = sides; side >= 0; side--)
+        {
+            GLfloat phi = 2.0f * PRIMITIVES_PI * (GLfloat)side / (GLfloat)sides;
+
+            for(int ring = 0; ring <= rings; ring++)
+            {
+                GLfloat theta = 2.0f * PRIMITIVES_PI * (GLfloat)ring / (GLfloat)rings;
+                GLfloat normal[] = {cosf(theta) * cosf(phi), sinf(theta) * cosf(phi), sinf(phi)};
+                GLfloat distance = outerRadius + innerRadius * cosf(phi);
+
+                addVertex(&vertices, cosf(theta) * distance, sinf(theta) * distance, innerRadius * sinf(phi), normal, (GLfloat)ring / (GLfloat)rings, (GLfloat)side / (GLfloat)sides);
+            }
+        }
+
+        addGrid(&elements, 0, rings, sides);
+        return add(TORUS, key, &vertices, &elements);
+    }
+
+    // Same parameters as glutSolidCube(), one normal per face.
+    int cube(GLfloat size)
+    {
+        GLfloat key[] = {size};
+        int primitive = find(CUBE, key);
+
+        if(primitive != INVALID)
+        {
+            return primitive;
+        }
+
+        // Normal, then two axes across the face whose cross product is the normal.
+        static const GLfloat faces[6][9] = {
+            { 1.0f,  0.0f,  0.0f,    0.0f, 1.0f, 0.0f,    0.0f, 0.0f, 1.0f},
+            {-1.0f,  0.0f,  0.0f,    0.0f, 0.0f, 1.0f,    0.0f, 1.0f, 0.0f},
+            { 0.0f,  1.0f,  0.0f,    0.0f, 0.0f, 1.0f,    1.0f, 0.0f, 0.0f},
+            { 0.0f, -1.0f,  0.0f,    1.0f, 0.0f, 0.0f,    0.0f, 0.0f, 1.0f},
+            { 0.0f,  0.0f,  1.0f,    1.0f, 0.0f, 0.0f,    0.0f, 1.0f, 0.0f},
+            { 0.0f,  0.0f, -1.0f,    0.0f, 1.0f, 0.0f,    1.0f, 0.0f, 0.0f}
+        };
+        static const GLfloat corners[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+
+        std::vector<GLfloat> vertices;
+        std::vector<GLuint> elements;
+        GLfloat half = size * 0.5f;
+
+        for(int face = 0; face < 6; face++)
+        {
+            const GLfloat *normal = faces[face];
+            const GLfloat *u = faces[face] + 3;
+            const GLfloat *v = faces[face] + 6;
+            GLuint first = (GLuint)(vertices.size() / PRIMITIVE_FLOATS_PER_VERTEX);
+
+            for(int corner = 0; corner < 4; corner++)
+            {
+                GLfloat a = corners[corner][0];
+                GLfloat b = corners[corner][1];
+
+                addVertex(&vertices,
+                    (normal[0] + a * u[0] + b * v[0]) * half,
+                    (normal[1] + a * u[1] + b * v[1]) * half,
+                    (normal[2] + a * u[2] + b * v[2]) * half,
+                    normal, (a + 1.0f) * 0.5f, (b + 1.0f) * 0.5f);
+            }
+
+            GLuint quad[] = {first, first + 1, first + 2, first, first + 2, first + 3};
+            elements.insert(elements.end(), quad, quad + 6);
+        }
+
+        return add(CUBE, key, &vertices, &elements);
+    }
+
+    // Draws through the fixed function vertex, normal and texture coordinate arrays.
+    void draw(int primitive)
+    {
+        if(primitive < 0 || primitive >= (int)primitives.size())
+        {
+            return;
+        }
+
+        Primitive& shape = primitives[primitive];
+        const GLfloat *vertices = shape.vertexBuffer != 0 ? NULL : &shape.vertices[0];
+        const GLuint *elements = shape.elementBuffer != 0 ? NULL : &shape.elements[0];
+        GLsizei stride = PRIMITIVE_FLOATS_PER_VERTEX * sizeof(GLfloat);
+
+        if(shape.vertexBuffer != 0)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, shape.vertexBuffer);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, shape.elementBuffer);
+        }
+
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_NORMAL_ARRAY);
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glVertexPointer(3, GL_FLOAT, stride, vertices);
+        glNormalPointer(GL_FLOAT, stride, vertices + 3);
+        glTexCoordPointer(2, GL_FLOAT, stride, vertices + 6);
+
+        glDrawElements(GL_TRIANGLES, shape.numberOfElements, GL_UNSIGNED_INT, elements);
+
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_NORMAL_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+
+        if(shape.vertexBuffer != 0)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, 0);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+
+        countDraw(shape);
+    }
+
+    // Draws through generic attributes, skipping the ones whose location is -1. The vertex array
+    // object is made on the first draw and made again only if the locations change.
+    void drawWithShader(int primitive, GLint positionLocation, GLint normalLocation, GLint textureLocation)
+    {
+        if(primitive < 0 || primitive >= (int)primitives.size() || vertexAttribPointer == NULL)
+        {
+            return;
+        }
+
+        Primitive& shape = primitives[primitive];
+        GLint locations[] = {positionLocation, normalLocation, textureLocation};
+        bool isVaoCurrent = shape.vertexArray != 0;
+
+        for(int attribute = 0; attribute < 3; attribute++)
+        {
+            isVaoCurrent = isVaoCurrent && shape.vertexArrayLocations[attribute] == locations[attribute];
+        }
+
+        if(!isVaoCurrent && genVertexArrays != NULL && shape.vertexBuffer != 0)
+        {
+            if(shape.vertexArray == 0)
+            {
+                genVertexArrays(1, &shape.vertexArray);
+            }
+
+            bindVertexArray(shape.vertexArray);
+            setAttributePointers(shape, locations, true);
+            bindVertexArray(0);
+
+            for(int attribute = 0; attribute < 3; attribute++)
+            {
+                shape.vertexArrayLocations[attribute] = locations[attribute];
+            }
+        }
+
+        if(shape.vertexArray != 0)
+        {
+            bindVertexArray(shape.vertexArray);
+            glDrawElements(GL_TRIANGLES, shape.numberOfElements, GL_UNSIGNED_INT, NULL);
+            bindVertexArray(0);
+        }
+        else
+        {
+            setAttributePointers(shape, locations, true);
+            glDrawElements(GL_TRIANGLES, shape.numberOfElements, GL_UNSIGNED_INT, shape.elementBuffer != 0 ? NULL : &shape.elements[0]);
+            setAttributePointers(shape, locations, false);
+        }
+
+        countDraw(shape);
+    }
+
+    GLsizei numberOfElements(int primitive) const
+    {
+        return primitives[primitive].numberOfElements;
+    }
+
+    int numberOfPrimitives(void) const
+    {
+        return (int)primitives.size();
+    }
+
+    // Deletes the buffers of every primitive. Needs the context they were made in to be current.
+    void clear(void)
+    {
+        for(size_t primitive = 0; primitive < primitives.size(); primitive++)
+        {
+            Primitive& shape = primitives[primitive];
+
+            if(shape.vertexArray != 0)
+            {
+                deleteVertexArrays(1, &shape.vertexArray);
+            }
+
+            if(shape.vertexBuffer != 0)
+            {
+                deleteBuffers(1, &shape.vertexBuffer);
+                deleteBuffers(1, &shape.elementBuffer);
+            }
+        }
+
+        primitives.clear();
+    }
+
+    // Call at the start of a frame, getFrameStatistics() then counts the work of that frame only.
+    void resetFrameStatistics(void)
+    {
+        resetStatistics(&frameStatistics);
+    }
+
+    const PrimitiveStatistics& getFrameStatistics(void) const
+    {
+        return frameStatistics;
+    }
+
+    const PrimitiveStatistics& getTotalStatistics(void) const
+    {
+        return totalStatistics;
+    }
+
+private:
+    enum Type
+    {
+        SPHERE,
+        CYLINDER,
+        DISK,
+        TORUS,
+        CUBE
+    };
+
+    enum
+    {
+        MAXIMUM_KEY_LENGTH = 5
+    };
+
+    struct Primitive
+    {
+        Type type;
+        GLfloat key[MAXIMUM_KEY_LENGTH];
+        GLsizei numberOfElements;
+        GLuint vertexBuffer;
+        GLuint elementBuffer;
+        GLuint vertexArray;
+        GLint vertexArrayLocations[3];
+
+        // Only kept when there are no buffer objects to draw from.
+        std::vector<GLfloat> vertices;
+        std::vector<GLuint> elements;
+    };
+
+    std::vector<Primitive> primitives;
+    PrimitiveStatistics frameStatistics;
+    PrimitiveStatistics totalStatistics;
+
+    bool areFunctionsLoaded;
+    PrimitiveGenBuffersProc genBuffers;
+    PrimitiveDeleteBuffersProc deleteBuffers;
+    PrimitiveBindBufferProc bindBuffer;
+    PrimitiveBufferDataProc bufferData;
+    PrimitiveGenVertexArraysProc genVertexArrays;
+    PrimitiveDeleteVertexArraysProc deleteVertexArrays;
+    PrimitiveBindVertexArrayProc bindVertexArray;
+    PrimitiveVertexAttribPointerProc vertexAttribPointer;
+    PrimitiveEnableVertexAttribArrayProc enableVertexAttribArray;
+    PrimitiveEnableVertexAttribArrayProc disableVertexAttribArray;
+
+    static void resetStatistics(PrimitiveStatistics *statistics)
+    {
+        statistics->tessellations = 0;
+        statistics->buffersCreated = 0;
+        statistics->bytesUploaded = 0;
+        statistics->draws = 0;
+        statistics->trianglesDrawn = 0;
+    }
+
+    static void *getProcAddress(const char *name)
+    {
+#ifdef _WIN32
+        void *address = (void *)wglGetProcAddress(name);
+
+        // wglGetProcAddress() may return small values instead of NULL for missing functions.
+        if((ptrdiff_t)address >= -1 && (ptrdiff_t)address <= 3)
+        {
+            return NULL;
+        }
+
+        return address;
+#else
+        return (void *)glXGetProcAddressARB((const GLubyte *)name);
+#endif
+    }
+
+    // Needs a current context, so it is done on the first create instead of in the constructor.
+    void loadFunctions(void)
+    {
+        if(areFunctionsLoaded)
+        {
+            return;
+        }
+
+        areFunctionsLoaded = true;
+        genBuffers = (PrimitiveGenBuffersProc)getProcAddress("glGenBuffers");
+        deleteBuffers = (PrimitiveDeleteBuffersProc)getProcAddress("glDeleteBuffers");
+        bindBuffer = (PrimitiveBindBufferProc)getProcAddress("glBindBuffer");
+        bufferData = (PrimitiveBufferDataProc)getProcAddress("glBufferData");
+        vertexAttribPointer = (PrimitiveVertexAttribPointerProc)getProcAddress("glVertexAttribPointer");
+        enableVertexAttribArray = (PrimitiveEnableVertexAttribArrayProc)getProcAddress("glEnableVertexAttribArray");
+        disableVertexAttribArray = (PrimitiveEnableVertexAttribArrayProc)getProcAddress("glDisableVertexAttribArray");
+
+        // glGetString() says whether the context really has them, glXGetProcAddressARB() returns
+        // an address for any name.
+        const char *version = (const char *)glGetString(GL_VERSION);
+        int major = version != NULL ? version[0] - '0' : 1;
+        int minor = version != NULL && version[1] == '.' ? version[2] - '0' : 1;
+
+        if(major == 1 && minor < 5)
+        {
+            genBuffers = NULL;
+        }
+
+        if(major < 2)
+        {
+            vertexAttribPointer = NULL;
+        }
+
+        if(major >= 3)
+        {
+            genVertexArrays = (PrimitiveGenVertexArraysProc)getProcAddress("glGenVertexArrays");
+            deleteVertexArrays = (PrimitiveDeleteVertexArraysProc)getProcAddress("glDeleteVertexArrays");
+            bindVertexArray = (PrimitiveBindVertexArrayProc)getProcAddress("glBindVertexArray");
+        }
+
+        if(genBuffers == NULL || deleteBuffers == NULL || bindBuffer == NULL || bufferData == NULL)
+        {
+            genBuffers = NULL;
+        }
+
+        if(genVertexArrays == NULL || deleteVertexArrays == NULL || bindVertexArray == NULL)
+        {
+            genVertexArrays = NULL;
+        }
+    }
+
+    int keyLength(Type type) const
+    {
+        switch(type)
+        {
+            case SPHERE: return 3;
+            case CYLINDER: return 5;
+            case DISK: return 4;
+            case TORUS: return 4;
+            case CUBE: return 1;
+        }
+
+        return 0;
+    }
+
+    int find(Type type, const GLfloat *key) const
+    {
+        for(size_t primitive = 0; primitive < primitives.size(); primitive++)
+        {
+            if(primitives[primitive].type != type)
+            {
+                continue;
+            }
+
+            bool isSame = true;
+
+            for(int value = 0; value < keyLength(type); value++)
+            {
+                isSame = isSame && primitives[primitive].key[value] == key[value];
+            }
+
+            if(isSame)
+            {
+                return (int)primitive;
+            }
+        }
+
+        return INVALID;
+    }
+
+    static void addVertex(std::vector<GLfloat> *vertices, GLfloat x, GLfloat y, GLfloat z, const GLfloat *normal, GLfloat s, GLfloat t)
+    {
+        GLfloat vertex[PRIMITIVE_FLOATS_PER_VERTEX] = {x, y, z, normal[0], normal[1], normal[2], s, t};
+        vertices->insert(vertices->end(), vertex, vertex + PRIMITIVE_FLOATS_PER_VERTEX);
+    }
+
+    // Two triangles per cell of a grid of rows + 1 by columns + 1 vertices, row by row.
+    static void addGrid(std::vector<GLuint> *elements, GLuint first, int columns, int rows)
+    {
+        for(int row = 0; row < rows; row++)
+        {
+            for(int column = 0; column < columns; column++)
+            {
+                GLuint topLeft = first + row * (columns + 1) + column;
+                GLuint bottomLeft = topLeft + columns + 1;
+                GLuint cell[] = {topLeft, bottomLeft, topLeft + 1, topLeft + 1, bottomLeft, bottomLeft + 1};
+
+                elements->insert(elements->end(), cell, cell + 6);
+            }
+        }
+    }
+
+    int add(Type type, const GLfloat *key, std::vector<GLfloat> *vertices, std::vector<GLuint> *elements)
+    {
+        loadFunctions();
+
+        Primitive shape;
+        shape.type = type;
+        shape.numberOfElements = (GLsizei)elements->size();
+        shape.vertexBuffer = 0;
+        shape.elementBuffer = 0;
+        shape.vertexArray = 0;
+
+        for(int value = 0; value < MAXIMUM_KEY_LENGTH; value++)
+        {
+            shape.key[value] = value < keyLength(type) ? key[value] : 0.0f;
+        }
+
+        for(int attribute = 0; attribute < 3; attribute++)
+        {
+            shape.vertexArrayLocations[attribute] = -1;
+        }
+
+        frameStatistics.tessellations++;
+        totalStatistics.tessellations++;
+
+        if(genBuffers != NULL)
+        {
+            ptrdiff_t vertexBytes = (ptrdiff_t)(vertices->size() * sizeof(GLfloat));
+            ptrdiff_t elementBytes = (ptrdiff_t)(elements->size() * sizeof(GLuint));
+
+            genBuffers(1, &shape.vertexBuffer);
+            bindBuffer(GL_ARRAY_BUFFER, shape.vertexBuffer);
+            bufferData(GL_ARRAY_BUFFER, vertexBytes, &(*vertices)[0], GL_STATIC_DRAW);
+            bindBuffer(GL_ARRAY_BUFFER, 0);
+
+            genBuffers(1, &shape.elementBuffer);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, shape.elementBuffer);
+            bufferData(GL_ELEMENT_ARRAY_BUFFER, elementBytes, &(*elements)[0], GL_STATIC_DRAW);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+            frameStatistics.buffersCreated += 2;
+            totalStatistics.buffersCreated += 2;
+            frameStatistics.bytesUploaded += (unsigned int)(vertexBytes + elementBytes);
+            totalStatistics.bytesUploaded += (unsigned int)(vertexBytes + elementBytes);
+        }
+        else
+        {
+            shape.vertices.swap(*vertices);
+            shape.elements.swap(*elements);
+        }
+
+        primitives.push_back(shape);
+        return (int)primitives.size() - 1;
+    }
+
+    // Points the attributes at the vertices of shape and enables them, or disables them again.
+    void setAttributePointers(const Primitive& shape, const GLint *locations, bool isEnabled)
+    {
+        const GLfloat *vertices = shape.vertexBuffer != 0 ? NULL : &shape.vertices[0];
+        static const GLint sizes[] = {3, 3, 2};
+        static const int offsets[] = {0, 3, 6};
+
+        if(isEnabled && shape.vertexBuffer != 0)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, shape.vertexBuffer);
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, shape.elementBuffer);
+        }
+
+        for(int attribute = 0; attribute < 3; attribute++)
+        {
+            if(locations[attribute] < 0)
+            {
+                continue;
+            }
+
+            if(isEnabled)
+            {
+                vertexAttribPointer((GLuint)locations[attribute], sizes[attribute], GL_FLOAT, GL_FALSE, PRIMITIVE_FLOATS_PER_VERTEX * sizeof(GLfloat), vertices + offsets[attribute]);
+                enableVertexAttribArray((GLuint)locations[attribute]);
+            }
+            else
+            {
+                disableVertexAttribArray((GLuint)locations[attribute]);
+            }
+        }
+
+        // The element buffer stays bound, it belongs to the vertex array object when there is one.
+        if(isEnabled && shape.vertexBuffer != 0)
+        {
+            bindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        else if(!isEnabled && shape.vertexBuffer != 0)
+        {
+            bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+    }
+
+    void countDraw(const Primitive& shape)
+    {
+        frameStatistics.draws++;
+        totalStatistics.draws++;
+        frameStatistics.trianglesDrawn += (unsigned int)shape.numberOfElements / 3;
+        totalStatistics.trianglesDrawn += (unsigned int)shape.numberOfElements / 3;
+    }
+};
+
+#endif /* __PRIMITIVES_H__ */
@@ -0,0 +1,442 @@
+#ifndef __PROGRAM_BATCH_H__
+#define __PROGRAM_BATCH_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+#include <GL/glew.h>
+
+#include "programCache.h"
+
+// Builds all the programs of a sample at once instead of one shader at a time. add() describes a
+// program by its stages and attribute locations, submit() then hands every shader to the
+// compiler and every program to the linker without asking for a single status in between, so a
+// driver with GL_KHR_parallel_shader_compile works on all of them on its own threads while the
+// sample goes on. poll(), called once a frame, only asks GL_COMPLETION_STATUS_KHR, which never
+// waits, and finishes the programs the driver is done with. Until a program is ready the sample
+// draws with something else, wait() blocks for the one it cannot draw without.
+//
+// Without the extension GL_COMPLETION_STATUS_KHR does not exist and asking for the link status is
+// what waits for the compiler, so poll() finishes one program per call, one stall a frame rather
+// than all of them before the first frame. Stages with the same type and source pointer are
+// compiled once and shared. With a ProgramCache, programs stored by an earlier launch are ready
+// as soon as they are submitted, and new ones are stored as they finish.
+
+#define PROGRAM_BATCH_MAX_STAGES 5
+#define PROGRAM_BATCH_MAX_ATTRIBUTES 16
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+struct ProgramStage
+{
+    GLenum type;
+    const GLchar *source;
+};
+
+enum
+{
+    PROGRAM_PENDING = 0,
+    PROGRAM_READY,
+    PROGRAM_FAILED
+};
+
+class ProgramBatch
+{
+public:
+    ProgramBatch(ProgramCache *cache = NULL)
+    {
+        this->cache = cache;
+        logFile = NULL;
+        isParallel = false;
+        submitTime = 0.0;
+        submitSeconds = 0.0;
+    }
+
+    // Describes a program, nothing is compiled before submit(). Returns the handle of the program.
+    int add(const char *name, const ProgramStage *stages, int numberOfStages, const ProgramAttribute *attributes, int numberOfAttributes)
+    {
+        Program program;
+
+        program.name = name;
+        program.numberOfStages = numberOfStages < PROGRAM_BATCH_MAX_STAGES ? numberOfStages : PROGRAM_BATCH_MAX_STAGES;
+        program.numberOfAttributes = numberOfAttributes < PROGRAM_BATCH_MAX_ATTRIBUTES ? numberOfAttributes : PROGRAM_BATCH_MAX_ATTRIBUTES;
+        program.object = 0;
+        program.status = PROGRAM_PENDING;
+        program.isCached = false;
+        program.polls = 0;
+        program.readySeconds = 0.0;
+
+        for(int n = 0; n < program.numberOfStages; n++)
+        {
+            program.stages[n] = stages[n];
+            program.shaders[n] = 0;
+        }
+
+        for(int n = 0; n < program.numberOfAttributes; n++)
+        {
+            program.attributes[n] = attributes[n];
+        }
+
+        programs.push_back(program);
+        return (int)programs.size() - 1;
+    }
+
+    // Starts compiling and linking every program added so far, errors go to file.
+    void submit(FILE *file)
+    {
+        logFile = file;
+        submitTime = now();
+        isParallel = GLEW_KHR_parallel_shader_compile ? true : false;
+
+        // As many threads as the driver cares to use.
+        if(isParallel)
+        {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        }
+
+        for(size_t n = 0; n < programs.size(); n++)
+        {
+            Program &program = programs[n];
+
+            if(cache != NULL)
+            {
+                program.key = cache->makeKey();
+
+                for(int stage = 0; stage < program.numberOfStages; stage++)
+                {
+                    program.key.add((int)program.stages[stage].type);
+                    program.key.add(program.stages[stage].source);
+                }
+
+                program.key.addAttributes(program.attributes, program.numberOfAttributes);
+                program.object = cache->load(program.key);
+
+                if(program.object != 0)
+                {
+                    program.status = PROGRAM_READY;
+                    program.isCached = true;
+                    program.readySeconds = now() - submitTime;
+                    continue;
+                }
+            }
+
+            for(int stage = 0; stage < program.numberOfStages; stage++)
+            {
+                program.shaders[stage] = compileShader(program.stages[stage]);
+            }
+        }
+
+        // Linking only after every compile has been handed out, so none waits for another.
+        for(size_t n = 0; n < programs.size(); n++)
+        {
+            Program &program = programs[n];
+
+            if(program.status != PROGRAM_PENDING)
+            {
+                continue;
+            }
+
+            program.object = glCreateProgram();
+
+            for(int stage = 0; stage < program.numberOfStages; stage++)
+            {
+                glAttachShader(program.object, program.shaders[stage]);
+            }
+
+            for(int attribute = 0; attribute < program.numberOfAttributes; attribute++)
+            {
+                glBindAttribLocation(program.object, program.attributes[attribute].index, program.attributes[attribute].name);
+            }
+
+            if(cache != NULL)
+            {
+                cache->prepare(program.object);
+            }
+
+            glLinkProgram(program.object);
+        }
+
+        releaseShaders();
+        submitSeconds = now() - submitTime;
+    }
+
+    // Finishes the programs the driver is done with, never waits when the driver compiles in
+    // parallel. Returns true once no program is pending.
+    bool poll(void)
+    {
+        for(size_t n = 0; n < programs.size(); n++)
+        {
+            Program &program = programs[n];
+
+            if(program.status != PROGRAM_PENDING)
+            {
+                continue;
+            }
+
+            ++program.polls;
+
+            if(isParallel)
+            {
+                GLint isComplete = GL_FALSE;
+                glGetProgramiv(program.object, GL_COMPLETION_STATUS_KHR, &isComplete);
+
+                if(isComplete == GL_FALSE)
+                {
+                    continue;
+                }
+            }
+
+            finish(program);
+
+            if(!isParallel)
+            {
+                break;
+            }
+        }
+
+        releaseShaders();
+        return isDone();
+    }
+
+    // Blocks until the program is ready or has failed.
+    int wait(int handle)
+    {
+        Program &program = programs[handle];
+
+        if(program.status == PROGRAM_PENDING)
+        {
+            ++program.polls;
+            finish(program);
+            releaseShaders();
+        }
+
+        return program.status;
+    }
+
+    int getStatus(int handle) const
+    {
+        return programs[handle].status;
+    }
+
+    // The linked program, 0 until it is ready. It belongs to the batch until destroy().
+    GLuint getProgram(int handle) const
+    {
+        return programs[handle].status == PROGRAM_READY ? programs[handle].object : 0;
+    }
+
+    bool isDone(void) const
+    {
+        for(size_t n = 0; n < programs.size(); n++)
+        {
+            if(programs[n].status == PROGRAM_PENDING)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Deletes every program and every shader still waiting to be linked.
+    void destroy(void)
+    {
+        for(size_t n = 0; n < programs.size(); n++)
+        {
+            if(programs[n].object != 0)
+            {
+                glDeleteProgram(programs[n].object);
+            }
+        }
+
+        for(size_t n = 0; n < shaders.size(); n++)
+        {
+            glDeleteShader(shaders[n].object);
+        }
+
+        programs.clear();
+        shaders.clear();
+    }
+
+    // Where every program came from and how long after submit() it was ready.
+    void log(FILE *file, const char *title) const
+    {
+        if(file == NULL)
+        {
+            return;
+        }
+
+        fprintf(file, "%s: %d programs, %s, submit() took %.3f ms.\n", title, (int)programs.size(), isParallel ? "compiled in parallel" : "compiled one at a time", submitSeconds * 1000.0);
+
+        for(size_t n = 0; n < programs.size(); n++)
+        {
+            const Program &program = programs[n];
+            const char *status = program.status == PROGRAM_PENDING ? "pending" : program.status == PROGRAM_FAILED ? "failed" : program.isCached ? "loaded from the cache" : "compiled";
+
+            fprintf(file, "    %-24s %-22s %8.3f ms after submit, %d polls\n", program.name, status, program.readySeconds * 1000.0, program.polls);
+        }
+
+        fflush(file);
+    }
+
+private:
+    struct Program
+    {
+        const char *name;
+        ProgramStage stages[PROGRAM_BATCH_MAX_STAGES];
+        GLuint shaders[PROGRAM_BATCH_MAX_STAGES];
+        int numberOfStages;
+        ProgramAttribute attributes[PROGRAM_BATCH_MAX_ATTRIBUTES];
+        int numberOfAttributes;
+        ProgramKey key;
+        GLuint object;
+        int status;
+        bool isCached;
+        int polls;
+        double readySeconds;
+    };
+
+    struct Shader
+    {
+        ProgramStage stage;
+        GLuint object;
+        int users;
+    };
+
+    ProgramCache *cache;
+    FILE *logFile;
+    bool isParallel;
+    double submitTime;
+    double submitSeconds;
+    std::vector<Program> programs;
+    std::vector<Shader> shaders;
+
+    static double now(void)
+    {
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return (double)time.tv_sec + (double)time.tv_nsec * 1.0e-9;
+    }
+
+    // Compiles a stage, or hands out the shader already compiled from the same source.
+    GLuint compileShader(const ProgramStage &stage)
+    {
+        for(size_t n = 0; n < shaders.size(); n++)
+        {
+            if(shaders[n].stage.type == stage.type && shaders[n].stage.source == stage.source)
+            {
+                ++shaders[n].users;
+                return shaders[n].object;
+            }
+        }
+
+        Shader shader;
+        shader.stage = stage;
+        shader.object = glCreateShader(stage.type);
+        shader.users = 1;
+
+        glShaderSource(shader.object, 1, &stage.source, NULL);
+        glCompileShader(shader.object);
+
+        shaders.push_back(shader);
+        return shader.object;
+    }
+
+    // Asks for the link status, which waits for the driver when it is not done yet.
+    void finish(Program &program)
+    {
+        GLint linkStatus = GL_FALSE;
+        glGetProgramiv(program.object, GL_LINK_STATUS, &linkStatus);
+
+        program.readySeconds = now() - submitTime;
+
+        if(linkStatus == GL_FALSE)
+        {
+            logErrors(program);
+            program.status = PROGRAM_FAILED;
+        }
+        else
+        {
+            program.status = PROGRAM_READY;
+
+            if(cache != NULL)
+            {
+                cache->store(program.object, program.key);
+            }
+        }
+
+        for(int stage = 0; stage < program.numberOfStages; stage++)
+        {
+            glDetachShader(program.object, program.shaders[stage]);
+            releaseShader(program.shaders[stage]);
+            program.shaders[stage] = 0;
+        }
+
+        if(program.status == PROGRAM_FAILED)
+        {
+            glDeleteProgram(program.object);
+            program.object = 0;
+        }
+    }
+
+    void releaseShader(GLuint object)
+    {
+        for(size_t n = 0; n < shaders.size(); n++)
+        {
+            if(shaders[n].object == object)
+            {
+                --shaders[n].users;
+            }
+        }
+    }
+
+    // Deletes the shaders no pending program is linked from any more.
+    void releaseShaders(void)
+    {
+        for(size_t n = 0; n < shaders.size();)
+        {
+            if(shaders[n].users <= 0)
+            {
+                glDeleteShader(shaders[n].object);
+                shaders[n] = shaders.back();
+                shaders.pop_back();
+            }
+            else
+            {
+                n++;
+            }
+        }
+    }
+
+    void logErrors(const Program &program)
+    {
+        if(logFile == NULL)
+        {
+            return;
+        }
+
+        for(int stage = 0; stage < program.numberOfStages; stage++)
+        {
+            GLint compileStatus = GL_FALSE;
+            glGetShaderiv(program.shaders[stage], GL_COMPILE_STATUS, &compileStatus);
+
+            if(compileStatus == GL_FALSE)
+            {
+                char infoLog[4096];
+                GLsizei written = 0;
+                glGetShaderInfoLog(program.shaders[stage], sizeof(infoLog), &written, infoLog);
+                fprintf(logFile, "CG: %s, shader %d compilation log: %s\n", program.name, stage, infoLog);
+            }
+        }
+
+        char infoLog[4096];
+        GLsizei written = 0;
+        glGetProgramInfoLog(program.object, sizeof(infoLog), &written, infoLog);
+        fprintf(logFile, "CG: %s link log: %s\n", program.name, infoLog);
+        fflush(logFile);
+    }
+};
+
+#endif /* __PROGRAM_BATCH_H__ */
@@ -0,0 +1,340 @@
+#ifndef __PROGRAM_CACHE_H__
+#define __PROGRAM_CACHE_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <GL/glew.h>
+
+// Linked program binaries kept on disk between launches. A program is looked up by a ProgramKey,
+// a 64 bit FNV-1a hash of the driver's vendor, renderer, version and GLSL version strings and of
+// whatever the sample adds: every shader source, defines put in front of them and the attribute
+// locations bound before linking. A hit is handed to glProgramBinary() and skips compiling and
+// linking altogether. A miss, or a binary the driver no longer accepts, returns 0 and the sample
+// compiles as before, marks the program with prepare() before linking it and stores it after.
+//
+// The binaries go to $XDG_CACHE_HOME/realTimeRendering.programs (~/.cache without it), one file
+// per key. A driver update changes the key, so old files are simply never read again. Without
+// GL_ARB_get_program_binary, or when the driver offers no binary format, nothing is loaded or
+// stored, and neither is anything whose path does not fit in PATH_MAX.
+
+#define PROGRAM_CACHE_DIRECTORY_NAME "realTimeRendering.programs"
+#define PROGRAM_CACHE_PATH_LENGTH PATH_MAX
+#define PROGRAM_CACHE_MAGIC 0x42504743u
+
+struct ProgramAttribute
+{
+    GLuint index;
+    const GLchar *name;
+};
+
+struct ProgramKey
+{
+    unsigned long long hash;
+
+    ProgramKey(void)
+    {
+        hash = 14695981039346656037ULL;
+    }
+
+    void add(const void *data, size_t size)
+    {
+        const unsigned char *bytes = (const unsigned char *)data;
+
+        for(size_t n = 0; n < size; n++)
+        {
+            hash = (hash ^ bytes[n]) * 1099511628211ULL;
+        }
+    }
+
+    // With the terminating zero, so "ab" + "c" and "a" + "bc" differ.
+    void add(const char *text)
+    {
+        if(text == NULL)
+        {
+            text = "";
+        }
+
+        add(text, strlen(text) + 1);
+    }
+
+    void add(int value)
+    {
+        add(&value, sizeof(value));
+    }
+
+    void addAttributes(const ProgramAttribute *attributes, int numberOfAttributes)
+    {
+        for(int n = 0; n < numberOfAttributes; n++)
+        {
+            add((int)attributes[n].index);
+            add(attributes[n].name);
+        }
+    }
+};
+
+class ProgramCache
+{
+public:
+    ProgramCache(void)
+    {
+        isChecked = false;
+        isAvailable = false;
+        loaded = 0;
+        missed = 0;
+        rejected = 0;
+        stored = 0;
+        directory[0] = '\0';
+    }
+
+    // A key holding the driver strings, for the sample to add its sources and bindings to.
+    ProgramKey makeKey(void) const
+    {
+        ProgramKey key;
+
+        key.add((const char *)glGetString(GL_VENDOR));
+        key.add((const char *)glGetString(GL_RENDERER));
+        key.add((const char *)glGetString(GL_VERSION));
+        key.add((const char *)glGetString(GL_SHADING_LANGUAGE_VERSION));
+
+        return key;
+    }
+
+    // A linked program made from the binary stored for key, 0 when there is none or the driver
+    // turns it down.
+    GLuint load(const ProgramKey &key)
+    {
+        if(!checkAvailable())
+        {
+            return 0;
+        }
+
+        char path[PROGRAM_CACHE_PATH_LENGTH];
+        FILE *file = getPath(key, path, sizeof(path)) ? fopen(path, "rb") : NULL;
+
+        if(file == NULL)
+        {
+            ++missed;
+            return 0;
+        }
+
+        Header header;
+        void *binary = NULL;
+
+        if(fread(&header, sizeof(header), 1, file) == 1 && header.magic == PROGRAM_CACHE_MAGIC && header.hash == key.hash && header.length > 0)
+        {
+            binary = malloc(header.length);
+
+            if(binary != NULL && fread(binary, 1, header.length, file) != header.length)
+            {
+                free(binary);
+                binary = NULL;
+            }
+        }
+
+        fclose(file);
+
+        if(binary == NULL)
+        {
+            ++rejected;
+            remove(path);
+            return 0;
+        }
+
+        GLuint program = glCreateProgram();
+        GLint linkStatus = GL_FALSE;
+
+        glProgramBinary(program, (GLenum)header.format, binary, (GLsizei)header.length);
+        glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+        free(binary);
+
+        // Usually a driver built from other sources than the one that wrote the binary.
+        if(linkStatus == GL_FALSE)
+        {
+            glDeleteProgram(program);
+            ++rejected;
+            remove(path);
+            return 0;
+        }
+
+        ++loaded;
+        return program;
+    }
+
+    // Asks the driver to keep the binary of program, call before glLinkProgram().
+    void prepare(GLuint program)
+    {
+        if(checkAvailable())
+        {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+    }
+
+    // Writes the binary of a linked program for the next launch.
+    bool store(GLuint program, const ProgramKey &key)
+    {
+        if(!checkAvailable())
+        {
+            return false;
+        }
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+        if(length <= 0)
+        {
+            return false;
+        }
+
+        void *binary = malloc((size_t)length);
+
+        if(binary == NULL)
+        {
+            return false;
+        }
+
+        Header header;
+        GLenum format = 0;
+        GLsizei written = 0;
+
+        glGetProgramBinary(program, length, &written, &format, binary);
+
+        header.magic = PROGRAM_CACHE_MAGIC;
+        header.format = (unsigned int)format;
+        header.hash = key.hash;
+        header.length = (unsigned int)written;
+        header.reserved = 0;
+
+        char path[PROGRAM_CACHE_PATH_LENGTH];
+        FILE *file = written > 0 && getPath(key, path, sizeof(path)) ? fopen(path, "wb") : NULL;
+        bool isStored = file != NULL && fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(binary, 1, (size_t)written, file) == (size_t)written;
+
+        if(file != NULL && fclose(file) != 0)
+        {
+            isStored = false;
+        }
+
+        // A half written file would only be rejected on the next launch.
+        if(file != NULL && !isStored)
+        {
+            remove(path);
+        }
+
+        free(binary);
+
+        if(isStored)
+        {
+            ++stored;
+        }
+
+        return isStored;
+    }
+
+    bool isEnabled(void)
+    {
+        return checkAvailable();
+    }
+
+    void log(FILE *file, const char *title)
+    {
+        if(file == NULL)
+        {
+            return;
+        }
+
+        if(!checkAvailable())
+        {
+            fprintf(file, "%s: not available, every program is compiled.\n", title);
+        }
+        else
+        {
+            fprintf(file, "%s: %d loaded, %d missed, %d rejected, %d stored, in %s\n", title, loaded, missed, rejected, stored, directory);
+        }
+
+        fflush(file);
+    }
+
+private:
+    struct Header
+    {
+        unsigned int magic;
+        unsigned int format;
+        unsigned long long hash;
+        unsigned int length;
+        unsigned int reserved;
+    };
+
+    bool isChecked;
+    bool isAvailable;
+    int loaded;
+    int missed;
+    int rejected;
+    int stored;
+    char directory[PROGRAM_CACHE_PATH_LENGTH];
+
+    // Needs a context, so it is asked on first use instead of in the constructor.
+    bool checkAvailable(void)
+    {
+        if(isChecked)
+        {
+            return isAvailable;
+        }
+
+        isChecked = true;
+
+        GLint numberOfFormats = 0;
+
+        if(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+        {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numberOfFormats);
+        }
+
+        const char *cacheHome = getenv("XDG_CACHE_HOME");
+        const char *home = getenv("HOME");
+
+        if(cacheHome != NULL && cacheHome[0] != '\0')
+        {
+            if(!isPrinted(snprintf(directory, sizeof(directory), "%s/%s", cacheHome, PROGRAM_CACHE_DIRECTORY_NAME), sizeof(directory)))
+            {
+                directory[0] = '\0';
+            }
+        }
+        else if(home != NULL && home[0] != '\0')
+        {
+            char cacheDirectory[PROGRAM_CACHE_PATH_LENGTH];
+
+            if(isPrinted(snprintf(cacheDirectory, sizeof(cacheDirectory), "%s/.cache", home), sizeof(cacheDirectory)))
+            {
+                mkdir(cacheDirectory, 0700);
+
+                if(!isPrinted(snprintf(directory, sizeof(directory), "%s/%s", cacheDirectory, PROGRAM_CACHE_DIRECTORY_NAME), sizeof(directory)))
+                {
+                    directory[0] = '\0';
+                }
+            }
+        }
+
+        if(directory[0] != '\0')
+        {
+            mkdir(directory, 0700);
+        }
+
+        isAvailable = numberOfFormats > 0 && directory[0] != '\0';
+        return isAvailable;
+    }
+
+    // A truncated path would name some other file, so it counts as no path at all.
+    static bool isPrinted(int length, size_t size)
+    {
+        return length >= 0 && (size_t)length < size;
+    }
+
+    bool getPath(const ProgramKey &key, char *path, size_t size) const
+    {
+        return isPrinted(snprintf(path, size, "%s/%016llx.bin", directory, key.hash), size);
+    }
+};
+
+#endif /* __PROGRAM_CACHE_H__ */
@@ -0,0 +1,461 @@
+#ifndef __STATE_CACHE_H__
+#define __STATE_CACHE_H__
+
+#include <stdio.h>
+#include <string.h>
+#include <GL/glew.h>
+
+// Shadow copies of the bindings and switches display() sets every frame, so that binding what is
+// already bound costs a compare instead of a driver call. Every call made through StateCache is
+// counted as issued when it reached GL and as elided when the shadow already had that value;
+// endFrame() closes the counts of a frame, getLastFrame() returns them and log() writes the
+// averages since the start.
+//
+// The shadow only knows what went through it. Code that binds behind its back (a helper that
+// creates a VAO, glBindBufferBase(), anything before the cache was used) must be followed by
+// invalidate(), and deleting an object through GL by the matching forget call, since GL hands the
+// same name out again. After invalidate() every value is unknown and the next call of each kind
+// is issued. Element array buffer bindings belong to the VAO and are forgotten whenever the VAO
+// changes.
+
+#define STATE_CACHE_UNKNOWN 0xFFFFFFFFu
+#define STATE_CACHE_TEXTURE_UNITS 16
+
+enum
+{
+    STATE_CALL_PROGRAM = 0,
+    STATE_CALL_VERTEX_ARRAY,
+    STATE_CALL_BUFFER,
+    STATE_CALL_ACTIVE_TEXTURE,
+    STATE_CALL_TEXTURE,
+    STATE_CALL_CAPABILITY,
+    STATE_CALL_DEPTH,
+    STATE_CALL_BLEND,
+    STATE_CALL_CULL,
+    STATE_CALL_COUNT
+};
+
+struct StateCacheCounters
+{
+    unsigned int issued[STATE_CALL_COUNT];
+    unsigned int elided[STATE_CALL_COUNT];
+
+    unsigned int getIssued(void) const
+    {
+        unsigned int total = 0;
+
+        for(int call = 0; call < STATE_CALL_COUNT; call++)
+        {
+            total += issued[call];
+        }
+
+        return total;
+    }
+
+    unsigned int getElided(void) const
+    {
+        unsigned int total = 0;
+
+        for(int call = 0; call < STATE_CALL_COUNT; call++)
+        {
+            total += elided[call];
+        }
+
+        return total;
+    }
+};
+
+class StateCache
+{
+public:
+    StateCache(void)
+    {
+        memset(&current, 0, sizeof(current));
+        memset(&lastFrame, 0, sizeof(lastFrame));
+        memset(&total, 0, sizeof(total));
+        frames = 0;
+        invalidate();
+    }
+
+    void useProgram(GLuint program)
+    {
+        if(set(&this->program, program, STATE_CALL_PROGRAM))
+        {
+            glUseProgram(program);
+        }
+    }
+
+    void bindVertexArray(GLuint vertexArray)
+    {
+        if(set(&this->vertexArray, vertexArray, STATE_CALL_VERTEX_ARRAY))
+        {
+            glBindVertexArray(vertexArray);
+            buffers[STATE_CACHE_ELEMENT_ARRAY_BUFFER] = STATE_CACHE_UNKNOWN;
+        }
+    }
+
+    // Targets without a shadow are always issued.
+    void bindBuffer(GLenum target, GLuint buffer)
+    {
+        int slot = getBufferSlot(target);
+
+        if(slot < 0 || set(&buffers[slot], buffer, STATE_CALL_BUFFER))
+        {
+            if(slot < 0)
+            {
+                ++current.issued[STATE_CALL_BUFFER];
+            }
+
+            glBindBuffer(target, buffer);
+        }
+    }
+
+    void activeTexture(GLenum unit)
+    {
+        if(set(&activeUnit, unit, STATE_CALL_ACTIVE_TEXTURE))
+        {
+            glActiveTexture(unit);
+        }
+    }
+
+    // Binds to the active unit, like glBindTexture().
+    void bindTexture(GLenum target, GLuint texture)
+    {
+        int unit = (int)(activeUnit - GL_TEXTURE0);
+        int slot = getTextureSlot(target);
+
+        if(activeUnit == STATE_CACHE_UNKNOWN || unit < 0 || unit >= STATE_CACHE_TEXTURE_UNITS || slot < 0)
+        {
+            ++current.issued[STATE_CALL_TEXTURE];
+            glBindTexture(target, texture);
+            return;
+        }
+
+        if(set(&textures[unit][slot], texture, STATE_CALL_TEXTURE))
+        {
+            glBindTexture(target, texture);
+        }
+    }
+
+    // Shadowed for depth test, blending, face culling and the scissor test, issued for the rest.
+    void enable(GLenum capability)
+    {
+        setCapability(capability, true);
+    }
+
+    void disable(GLenum capability)
+    {
+        setCapability(capability, false);
+    }
+
+    void depthFunc(GLenum function)
+    {
+        if(set(&depthFunction, function, STATE_CALL_DEPTH))
+        {
+            glDepthFunc(function);
+        }
+    }
+
+    void depthMask(GLboolean isWritten)
+    {
+        if(set(&depthWriteMask, isWritten, STATE_CALL_DEPTH))
+        {
+            glDepthMask(isWritten);
+        }
+    }
+
+    // Both factors are shadowed as one value, GL blend factors fit in 16 bits.
+    void blendFunc(GLenum source, GLenum destination)
+    {
+        if(set(&blendFactors, (source << 16) | (destination & 0xFFFF), STATE_CALL_BLEND))
+        {
+            glBlendFunc(source, destination);
+        }
+    }
+
+    void cullFace(GLenum face)
+    {
+        if(set(&culledFace, face, STATE_CALL_CULL))
+        {
+            glCullFace(face);
+        }
+    }
+
+    // The object is about to be or has been deleted, its name may come back as another object.
+    void forgetProgram(GLuint program)
+    {
+        if(this->program == program)
+        {
+            this->program = STATE_CACHE_UNKNOWN;
+        }
+    }
+
+    void forgetVertexArray(GLuint vertexArray)
+    {
+        if(this->vertexArray == vertexArray)
+        {
+            this->vertexArray = STATE_CACHE_UNKNOWN;
+        }
+    }
+
+    void forgetBuffer(GLuint buffer)
+    {
+        for(int slot = 0; slot < STATE_CACHE_BUFFER_TARGETS; slot++)
+        {
+            if(buffers[slot] == buffer)
+            {
+                buffers[slot] = STATE_CACHE_UNKNOWN;
+            }
+        }
+    }
+
+    void forgetTexture(GLuint texture)
+    {
+        for(int unit = 0; unit < STATE_CACHE_TEXTURE_UNITS; unit++)
+        {
+            for(int slot = 0; slot < STATE_CACHE_TEXTURE_TARGETS; slot++)
+            {
+                if(textures[unit][slot] == texture)
+                {
+                    textures[unit][slot] = STATE_CACHE_UNKNOWN;
+                }
+            }
+        }
+    }
+
+    // Forgets everything, for after state was changed without the cache.
+    void invalidate(void)
+    {
+        program = STATE_CACHE_UNKNOWN;
+        vertexArray = STATE_CACHE_UNKNOWN;
+        activeUnit = STATE_CACHE_UNKNOWN;
+        depthFunction = STATE_CACHE_UNKNOWN;
+        depthWriteMask = STATE_CACHE_UNKNOWN;
+        blendFactors = STATE_CACHE_UNKNOWN;
+        culledFace = STATE_CACHE_UNKNOWN;
+
+        for(int slot = 0; slot < STATE_CACHE_BUFFER_TARGETS; slot++)
+        {
+            buffers[slot] = STATE_CACHE_UNKNOWN;
+        }
+
+        for(int unit = 0; unit < STATE_CACHE_TEXTURE_UNITS; unit++)
+        {
+            for(int slot = 0; slot < STATE_CACHE_TEXTURE_TARGETS; slot++)
+            {
+                textures[unit][slot] = STATE_CACHE_UNKNOWN;
+            }
+        }
+
+        for(int slot = 0; slot < STATE_CACHE_CAPABILITIES; slot++)
+        {
+            capabilities[slot] = STATE_CACHE_UNKNOWN;
+        }
+    }
+
+    // Closes the counts of the frame, called once at the end of display().
+    void endFrame(void)
+    {
+        lastFrame = current;
+
+        for(int call = 0; call < STATE_CALL_COUNT; call++)
+        {
+            total.issued[call] += current.issued[call];
+            total.elided[call] += current.elided[call];
+        }
+
+        memset(&current, 0, sizeof(current));
+        ++frames;
+    }
+
+    const StateCacheCounters &getLastFrame(void) const
+    {
+        return lastFrame;
+    }
+
+    unsigned int getFrames(void) const
+    {
+        return frames;
+    }
+
+    // Issued and elided calls per frame since the start, in all and for each kind of call.
+    void log(FILE *file) const
+    {
+        if(file == NULL || frames == 0)
+        {
+            return;
+        }
+
+        fprintf(file, "State changes per frame over %u frames: %.1f issued, %.1f elided.\n", frames, (double)total.getIssued() / frames, (double)total.getElided() / frames);
+
+        for(int call = 0; call < STATE_CALL_COUNT; call++)
+        {
+            if(total.issued[call] + total.elided[call] > 0)
+            {
+                fprintf(file, "    %-14s %8.1f issued %8.1f elided\n", getCallName(call), (double)total.issued[call] / frames, (double)total.elided[call] / frames);
+            }
+        }
+
+        fflush(file);
+    }
+
+    static const char *getCallName(int call)
+    {
+        static const char *names[STATE_CALL_COUNT] = {"program", "vertex array", "buffer", "active texture", "texture", "capability", "depth", "blend", "cull"};
+
+        return call >= 0 && call < STATE_CALL_COUNT ? names[call] : "unknown";
+    }
+
+private:
+    enum
+    {
+        STATE_CACHE_ARRAY_BUFFER = 0,
+        STATE_CACHE_ELEMENT_ARRAY_BUFFER,
+        STATE_CACHE_UNIFORM_BUFFER,
+        STATE_CACHE_SHADER_STORAGE_BUFFER,
+        STATE_CACHE_DRAW_INDIRECT_BUFFER,
+        STATE_CACHE_PIXEL_UNPACK_BUFFER,
+        STATE_CACHE_BUFFER_TARGETS
+    };
+
+    enum
+    {
+        STATE_CACHE_TEXTURE_2D = 0,
+        STATE_CACHE_TEXTURE_3D,
+        STATE_CACHE_TEXTURE_CUBE_MAP,
+        STATE_CACHE_TEXTURE_2D_ARRAY,
+        STATE_CACHE_TEXTURE_TARGETS
+    };
+
+    enum
+    {
+        STATE_CACHE_DEPTH_TEST = 0,
+        STATE_CACHE_BLEND,
+        STATE_CACHE_CULL_FACE,
+        STATE_CACHE_SCISSOR_TEST,
+        STATE_CACHE_CAPABILITIES
+    };
+
+    GLuint program;
+    GLuint vertexArray;
+    GLuint buffers[STATE_CACHE_BUFFER_TARGETS];
+    GLuint activeUnit;
+    GLuint textures[STATE_CACHE_TEXTURE_UNITS][STATE_CACHE_TEXTURE_TARGETS];
+    GLuint capabilities[STATE_CACHE_CAPABILITIES];
+    GLuint depthFunction;
+    GLuint depthWriteMask;
+    GLuint blendFactors;
+    GLuint culledFace;
+
+    StateCacheCounters current;
+    StateCacheCounters lastFrame;
+    StateCacheCounters total;
+    unsigned int frames;
+
+    // Stores value and counts the call, true when it has to reach GL.
+    bool set(GLuint *shadow, GLuint value, int call)
+    {
+        if(*shadow == value)
+        {
+            ++current.elided[call];
+            return false;
+        }
+
+        *shadow = value;
+        ++current.issued[call];
+        return true;
+    }
+
+    void setCapability(GLenum capability, bool isEnabled)
+    {
+        int slot = getCapabilitySlot(capability);
+
+        if(slot < 0 || set(&capabilities[slot], isEnabled ? 1 : 0, STATE_CALL_CAPABILITY))
+        {
+            if(slot < 0)
+            {
+                ++current.issued[STATE_CALL_CAPABILITY];
+            }
+
+            if(isEnabled)
+            {
+                glEnable(capability);
+            }
+            else
+            {
+                glDisable(capability);
+            }
+        }
+    }
+
+    static int getBufferSlot(GLenum target)
+    {
+        switch(target)
+        {
+            case GL_ARRAY_BUFFER:
+                return STATE_CACHE_ARRAY_BUFFER;
+
+            case GL_ELEMENT_ARRAY_BUFFER:
+                return STATE_CACHE_ELEMENT_ARRAY_BUFFER;
+
+            case GL_UNIFORM_BUFFER:
+                return STATE_CACHE_UNIFORM_BUFFER;
+
+            case GL_SHADER_STORAGE_BUFFER:
+                return STATE_CACHE_SHADER_STORAGE_BUFFER;
+
+            case GL_DRAW_INDIRECT_BUFFER:
+                return STATE_CACHE_DRAW_INDIRECT_BUFFER;
+
+            case GL_PIXEL_UNPACK_BUFFER:
+                return STATE_CACHE_PIXEL_UNPACK_BUFFER;
+
+            default:
+                return -1;
+        }
+    }
+
+    static int getTextureSlot(GLenum target)
+    {
+        switch(target)
+        {
+            case GL_TEXTURE_2D:
+                return STATE_CACHE_TEXTURE_2D;
+
+            case GL_TEXTURE_3D:
+                return STATE_CACHE_TEXTURE_3D;
+
+            case GL_TEXTURE_CUBE_MAP:
+                return STATE_CACHE_TEXTURE_CUBE_MAP;
+
+            case GL_TEXTURE_2D_ARRAY:
+                return STATE_CACHE_TEXTURE_2D_ARRAY;
+
+            default:
+                return -1;
+        }
+    }
+
+    static int getCapabilitySlot(GLenum capability)
+    {
+        switch(capability)
+        {
+            case GL_DEPTH_TEST:
+                return STATE_CACHE_DEPTH_TEST;
+
+            case GL_BLEND:
+                return STATE_CACHE_BLEND;
+
+            case GL_CULL_FACE:
+                return STATE_CACHE_CULL_FACE;
+
+            case GL_SCISSOR_TEST:
+                return STATE_CACHE_SCISSOR_TEST;
+
+            default:
+                return -1;
+        }
+    }
+};
+
+#endif /* __STATE_CACHE_H__ */
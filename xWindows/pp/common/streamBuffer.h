@@ -0,0 +1,250 @@
+#ifndef __STREAM_BUFFER_H__
+#define __STREAM_BUFFER_H__
+
+#include <stdio.h>
+#include <time.h>
+#include <GL/glew.h>
+
+// One buffer for everything a sample writes anew every frame: streamed vertices, elements and
+// uniform blocks. It is made with glBufferStorage() and mapped once, persistent and coherent, so
+// a frame writes straight into memory the GPU reads and binds what it wrote by offset, with no
+// glBufferData() to respecify and no glMapBufferRange() per upload.
+//
+// The buffer is split into STREAM_BUFFER_FRAMES parts used in turn, one per frame. endFrame()
+// puts a fence behind the frame's draws, and beginFrame() waits for the fence of the part it is
+// about to reuse, which with three parts is the GPU falling two frames behind. The time spent
+// waiting is counted with the bytes written per frame.
+//
+// A frame that outgrows its part makes allocate() move to a buffer twice as large. The old one is
+// unmapped and deleted, GL keeps it until the draws already made from it are done, so whatever
+// one allocation holds has to be written and drawn before the next allocate(), and a draw that
+// needs vertices and elements takes both from one allocation.
+
+#define STREAM_BUFFER_FRAMES 3
+
+class StreamBuffer
+{
+public:
+    StreamBuffer(GLsizeiptr bytesPerFrame)
+    {
+        partSize = bytesPerFrame;
+        buffer = 0;
+        mapping = NULL;
+        part = 0;
+        head = 0;
+        uniformAlignment = 256;
+
+        for(int n = 0; n < STREAM_BUFFER_FRAMES; n++)
+        {
+            fences[n] = 0;
+        }
+
+        bytesThisFrame = 0;
+        bytesLastFrame = 0;
+        totalBytes = 0;
+        frames = 0;
+        waits = 0;
+        grows = 0;
+        waitSeconds = 0.0;
+        maximumWaitSeconds = 0.0;
+    }
+
+    // Needs GL 4.4 or GL_ARB_buffer_storage, false without or when the buffer cannot be mapped.
+    bool create(void)
+    {
+        if(!GLEW_VERSION_4_4 && !GLEW_ARB_buffer_storage)
+        {
+            return false;
+        }
+
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        uniformAlignment = alignment > 0 ? alignment : 256;
+
+        return allocateBuffer();
+    }
+
+    void destroy(void)
+    {
+        releaseBuffer();
+    }
+
+    // Moves to the next part and waits until the GPU has read what was written there three
+    // frames ago.
+    void beginFrame(void)
+    {
+        part = (part + 1) % STREAM_BUFFER_FRAMES;
+        head = 0;
+
+        if(fences[part] == 0)
+        {
+            return;
+        }
+
+        // Mostly signaled already, then there is no flush and no timing.
+        GLenum result = glClientWaitSync(fences[part], 0, 0);
+
+        if(result == GL_TIMEOUT_EXPIRED)
+        {
+            double start = now();
+
+            do
+            {
+                result = glClientWaitSync(fences[part], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+            }
+            while(result == GL_TIMEOUT_EXPIRED);
+
+            double seconds = now() - start;
+            waitSeconds += seconds;
+            maximumWaitSeconds = seconds > maximumWaitSeconds ? seconds : maximumWaitSeconds;
+            ++waits;
+        }
+
+        glDeleteSync(fences[part]);
+        fences[part] = 0;
+    }
+
+    // size bytes at an offset that is a multiple of alignment, to be written through the pointer
+    // and bound with the offset. NULL only when a larger buffer cannot be made.
+    void *allocate(GLsizeiptr size, GLsizeiptr alignment, GLintptr *offset)
+    {
+        GLsizeiptr start = alignment > 1 ? (head + alignment - 1) / alignment * alignment : head;
+
+        if(start + size > partSize)
+        {
+            GLsizeiptr needed = size + alignment;
+
+            partSize = partSize * 2 > needed ? partSize * 2 : needed * 2;
+            ++grows;
+
+            releaseBuffer();
+
+            if(!allocateBuffer())
+            {
+                return NULL;
+            }
+
+            start = 0;
+        }
+
+        head = start + size;
+        bytesThisFrame += size;
+
+        *offset = part * partSize + start;
+        return mapping + *offset;
+    }
+
+    // Fences the draws of the frame, called after the last one.
+    void endFrame(void)
+    {
+        if(fences[part] != 0)
+        {
+            glDeleteSync(fences[part]);
+        }
+
+        fences[part] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        bytesLastFrame = bytesThisFrame;
+        totalBytes += bytesThisFrame;
+        bytesThisFrame = 0;
+        ++frames;
+    }
+
+    GLuint getBuffer(void) const
+    {
+        return buffer;
+    }
+
+    GLint getUniformAlignment(void) const
+    {
+        return uniformAlignment;
+    }
+
+    long long getBytesLastFrame(void) const
+    {
+        return bytesLastFrame;
+    }
+
+    void log(FILE *file, const char *title) const
+    {
+        if(file == NULL || frames == 0)
+        {
+            return;
+        }
+
+        fprintf(file, "%s: %.0f bytes streamed per frame over %lld frames, %lld in the last, %lld bytes per part after %d grows, waited in %d frames for %.3f ms, at most %.3f ms.\n", title, (double)totalBytes / frames, frames, bytesLastFrame, (long long)partSize, grows, waits, waitSeconds * 1000.0, maximumWaitSeconds * 1000.0);
+        fflush(file);
+    }
+
+private:
+    GLuint buffer;
+    unsigned char *mapping;
+    GLsizeiptr partSize;
+    int part;
+    GLsizeiptr head;
+    GLint uniformAlignment;
+    GLsync fences[STREAM_BUFFER_FRAMES];
+
+    long long bytesThisFrame;
+    long long bytesLastFrame;
+    long long totalBytes;
+    long long frames;
+    int waits;
+    int grows;
+    double waitSeconds;
+    double maximumWaitSeconds;
+
+    static double now(void)
+    {
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return (double)time.tv_sec + (double)time.tv_nsec * 1.0e-9;
+    }
+
+    bool allocateBuffer(void)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr size = partSize * STREAM_BUFFER_FRAMES;
+
+        // The copy target leaves the element buffer binding of whatever VAO is bound alone.
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferStorage(GL_COPY_WRITE_BUFFER, size, NULL, flags);
+        mapping = (unsigned char *)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+        part = 0;
+        head = 0;
+
+        return mapping != NULL;
+    }
+
+    void releaseBuffer(void)
+    {
+        for(int n = 0; n < STREAM_BUFFER_FRAMES; n++)
+        {
+            if(fences[n] != 0)
+            {
+                glDeleteSync(fences[n]);
+                fences[n] = 0;
+            }
+        }
+
+        if(buffer != 0)
+        {
+            if(mapping != NULL)
+            {
+                glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+                glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+                glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            }
+
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+
+        mapping = NULL;
+    }
+};
+
+#endif /* __STREAM_BUFFER_H__ */
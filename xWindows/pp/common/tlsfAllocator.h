@@ -0,0 +1,407 @@
+#ifndef __TLSF_ALLOCATOR_H__
+#define __TLSF_ALLOCATOR_H__
+
+#include <vector>
+
+// Two level segregated fit allocator for ranges of a buffer that lives somewhere else, a GL buffer
+// in GeometryPool. It only hands out offsets and never touches the memory itself, so sizes and
+// offsets are in whatever unit the caller picks, vertices or elements for a geometry pool.
+//
+// Free ranges are kept in lists by size class: the first level is the highest set bit of the size,
+// the second splits each power of two into SECOND_LEVEL_COUNT equal steps. Two bitmaps say which
+// lists are non empty, so allocate() and release() are a few bit scans and list operations, O(1)
+// whatever the number of ranges. Neighbouring free ranges are merged on release().
+class TlsfAllocator
+{
+public:
+    enum
+    {
+        INVALID = -1
+    };
+
+    explicit TlsfAllocator(unsigned int capacity = 0)
+    {
+        reset(capacity);
+    }
+
+    // Forgets every allocation, leaving one free range of capacity units.
+    void reset(unsigned int capacity)
+    {
+        this->capacity = capacity;
+        used = 0;
+        lastBlock = INVALID;
+        firstLevelBitmap = 0;
+        blocks.clear();
+        unusedBlocks.clear();
+
+        for(int first = 0; first < FIRST_LEVEL_COUNT; first++)
+        {
+            secondLevelBitmaps[first] = 0;
+
+            for(int second = 0; second < SECOND_LEVEL_COUNT; second++)
+            {
+                freeLists[first][second] = INVALID;
+            }
+        }
+
+        if(capacity > 0)
+        {
+            int block = newBlock(0, capacity);
+            lastBlock = block;
+            insertFree(block);
+        }
+    }
+
+    // Returns a handle to size units, or INVALID when no free range is large enough.
+    int allocate(unsigned int size)
+    {
+        if(size == 0 || size > MAXIMUM_SIZE)
+        {
+            return INVALID;
+        }
+
+        // Round up to the next size class so any range in the list found is large enough.
+        unsigned int searchSize = size;
+
+        if(searchSize >= SECOND_LEVEL_COUNT)
+        {
+            searchSize += (1u << (highestBit(searchSize) - SECOND_LEVEL_LOG2)) - 1;
+        }
+
+        int first = 0;
+        int second = 0;
+        mapping(searchSize, &first, &second);
+
+        int block = findFree(first, second);
+
+        if(block == INVALID)
+        {
+            return INVALID;
+        }
+
+        removeFree(block);
+
+        if(blocks[block].size > size)
+        {
+            int rest = newBlock(blocks[block].offset + size, blocks[block].size - size);
+
+            blocks[rest].previousPhysical = block;
+            blocks[rest].nextPhysical = blocks[block].nextPhysical;
+
+            if(blocks[block].nextPhysical != INVALID)
+            {
+                blocks[blocks[block].nextPhysical].previousPhysical = rest;
+            }
+            else
+            {
+                lastBlock = rest;
+            }
+
+            blocks[block].nextPhysical = rest;
+            blocks[block].size = size;
+            insertFree(rest);
+        }
+
+        blocks[block].isFree = false;
+        blocks[block].owner = INVALID;
+        used += size;
+
+        return block;
+    }
+
+    void release(int handle)
+    {
+        if(handle < 0 || handle >= (int)blocks.size() || blocks[handle].isFree)
+        {
+            return;
+        }
+
+        int block = handle;
+        used -= blocks[block].size;
+        blocks[block].isFree = true;
+
+        int next = blocks[block].nextPhysical;
+
+        if(next != INVALID && blocks[next].isFree)
+        {
+            removeFree(next);
+            absorbNext(block);
+        }
+
+        int previous = blocks[block].previousPhysical;
+
+        if(previous != INVALID && blocks[previous].isFree)
+        {
+            removeFree(previous);
+            absorbNext(previous);
+            block = previous;
+        }
+
+        insertFree(block);
+    }
+
+    unsigned int offsetOf(int handle) const
+    {
+        return blocks[handle].offset;
+    }
+
+    unsigned int sizeOf(int handle) const
+    {
+        return blocks[handle].size;
+    }
+
+    // Whatever the caller wants to remember about an allocation, INVALID until set.
+    void setOwner(int handle, int owner)
+    {
+        blocks[handle].owner = owner;
+    }
+
+    int ownerOf(int handle) const
+    {
+        return blocks[handle].owner;
+    }
+
+    // The allocation with the highest offset, INVALID when there is none. Everything after it is
+    // one free range, so this is the one to move when compacting.
+    int highestAllocation(void) const
+    {
+        if(lastBlock == INVALID)
+        {
+            return INVALID;
+        }
+
+        if(!blocks[lastBlock].isFree)
+        {
+            return lastBlock;
+        }
+
+        // Free neighbours are always merged, so the one before a free range is in use.
+        return blocks[lastBlock].previousPhysical;
+    }
+
+    unsigned int getCapacity(void) const
+    {
+        return capacity;
+    }
+
+    unsigned int usedUnits(void) const
+    {
+        return used;
+    }
+
+    unsigned int freeUnits(void) const
+    {
+        return capacity - used;
+    }
+
+    // The largest single allocation that would succeed right now.
+    unsigned int largestFreeRange(void) const
+    {
+        if(firstLevelBitmap == 0)
+        {
+            return 0;
+        }
+
+        int first = highestBit(firstLevelBitmap);
+        int second = highestBit(secondLevelBitmaps[first]);
+        unsigned int largest = 0;
+
+        for(int block = freeLists[first][second]; block != INVALID; block = blocks[block].nextFree)
+        {
+            if(blocks[block].size > largest)
+            {
+                largest = blocks[block].size;
+            }
+        }
+
+        return largest;
+    }
+
+    // 0 when all free units are one range, approaching 1 as they are scattered in small pieces.
+    double fragmentation(void) const
+    {
+        unsigned int free = freeUnits();
+        return free > 0 ? 1.0 - (double)largestFreeRange() / (double)free : 0.0;
+    }
+
+private:
+    enum
+    {
+        SECOND_LEVEL_LOG2 = 4,
+        SECOND_LEVEL_COUNT = 1 << SECOND_LEVEL_LOG2,
+        FIRST_LEVEL_COUNT = 33 - SECOND_LEVEL_LOG2
+    };
+
+    // Rounding a size up to its class must not overflow 32 bits.
+    static const unsigned int MAXIMUM_SIZE = 0x7FFFFFFFu;
+
+    struct Block
+    {
+        unsigned int offset;
+        unsigned int size;
+        int previousPhysical;
+        int nextPhysical;
+        int previousFree;
+        int nextFree;
+        int owner;
+        bool isFree;
+    };
+
+    unsigned int capacity;
+    unsigned int used;
+    int lastBlock;
+    unsigned int firstLevelBitmap;
+    unsigned int secondLevelBitmaps[FIRST_LEVEL_COUNT];
+    int freeLists[FIRST_LEVEL_COUNT][SECOND_LEVEL_COUNT];
+    std::vector<Block> blocks;
+    std::vector<int> unusedBlocks;
+
+    static int highestBit(unsigned int value)
+    {
+        return 31 - __builtin_clz(value);
+    }
+
+    static int lowestBit(unsigned int value)
+    {
+        return __builtin_ctz(value);
+    }
+
+    // Sizes below SECOND_LEVEL_COUNT get a list each in the first level 0.
+    static void mapping(unsigned int size, int *first, int *second)
+    {
+        if(size < SECOND_LEVEL_COUNT)
+        {
+            *first = 0;
+            *second = (int)size;
+        }
+        else
+        {
+            int bit = highestBit(size);
+            *second = (int)(size >> (bit - SECOND_LEVEL_LOG2)) ^ SECOND_LEVEL_COUNT;
+            *first = bit - SECOND_LEVEL_LOG2 + 1;
+        }
+    }
+
+    int findFree(int first, int second) const
+    {
+        unsigned int secondMap = secondLevelBitmaps[first] & (~0u << second);
+
+        if(secondMap == 0)
+        {
+            unsigned int firstMap = first + 1 < FIRST_LEVEL_COUNT ? firstLevelBitmap & (~0u << (first + 1)) : 0;
+
+            if(firstMap == 0)
+            {
+                return INVALID;
+            }
+
+            first = lowestBit(firstMap);
+            secondMap = secondLevelBitmaps[first];
+        }
+
+        return freeLists[first][lowestBit(secondMap)];
+    }
+
+    void insertFree(int block)
+    {
+        int first = 0;
+        int second = 0;
+        mapping(blocks[block].size, &first, &second);
+
+        blocks[block].isFree = true;
+        blocks[block].previousFree = INVALID;
+        blocks[block].nextFree = freeLists[first][second];
+
+        if(freeLists[first][second] != INVALID)
+        {
+            blocks[freeLists[first][second]].previousFree = block;
+        }
+
+        freeLists[first][second] = block;
+        firstLevelBitmap |= 1u << first;
+        secondLevelBitmaps[first] |= 1u << second;
+    }
+
+    void removeFree(int block)
+    {
+        int first = 0;
+        int second = 0;
+        mapping(blocks[block].size, &first, &second);
+
+        int previous = blocks[block].previousFree;
+        int next = blocks[block].nextFree;
+
+        if(previous != INVALID)
+        {
+            blocks[previous].nextFree = next;
+        }
+        else
+        {
+            freeLists[first][second] = next;
+        }
+
+        if(next != INVALID)
+        {
+            blocks[next].previousFree = previous;
+        }
+
+        if(freeLists[first][second] == INVALID)
+        {
+            secondLevelBitmaps[first] &= ~(1u << second);
+
+            if(secondLevelBitmaps[first] == 0)
+            {
+                firstLevelBitmap &= ~(1u << first);
+            }
+        }
+    }
+
+    // block takes over its physical successor, whose slot is recycled.
+    void absorbNext(int block)
+    {
+        int next = blocks[block].nextPhysical;
+
+        blocks[block].size += blocks[next].size;
+        blocks[block].nextPhysical = blocks[next].nextPhysical;
+
+        if(blocks[next].nextPhysical != INVALID)
+        {
+            blocks[blocks[next].nextPhysical].previousPhysical = block;
+        }
+        else
+        {
+            lastBlock = block;
+        }
+
+        unusedBlocks.push_back(next);
+    }
+
+    int newBlock(unsigned int offset, unsigned int size)
+    {
+        int block = 0;
+
+        if(!unusedBlocks.empty())
+        {
+            block = unusedBlocks.back();
+            unusedBlocks.pop_back();
+        }
+        else
+        {
+            block = (int)blocks.size();
+            blocks.push_back(Block());
+        }
+
+        blocks[block].offset = offset;
+        blocks[block].size = size;
+        blocks[block].previousPhysical = INVALID;
+        blocks[block].nextPhysical = INVALID;
+        blocks[block].previousFree = INVALID;
+        blocks[block].nextFree = INVALID;
+        blocks[block].owner = INVALID;
+        blocks[block].isFree = true;
+
+        return block;
+    }
+};
+
+#endif /* __TLSF_ALLOCATOR_H__ */
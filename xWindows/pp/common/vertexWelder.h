@@ -0,0 +1,268 @@
+#ifndef __VERTEX_WELDER_H__
+#define __VERTEX_WELDER_H__
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Merges the vertices of a triangle soup that are equal within an epsilon into an indexed vertex
+// list. A vertex is a fixed number of floats, the first three being the position, and two vertices
+// are the same when every float differs by less than epsilon, the test Sphere::addTriangle() used
+// to run against every vertex so far.
+//
+// Positions are quantized into cells at least 2 * epsilon wide and every vertex is linked into a
+// hash bucket by its cell. A vertex within epsilon of another can only be in one of the at most
+// 2 x 2 x 2 cells its epsilon box touches, so add() looks at a handful of candidates however many
+// vertices there are, and welding n vertices is O(n) instead of O(n^2).
+class VertexWelder
+{
+public:
+    enum
+    {
+        FAILED = 0xFFFFFFFF
+    };
+
+    // floatsPerVertex is at least 3 and epsilon greater than 0. expectedVertices only sizes the
+    // first allocation.
+    VertexWelder(int floatsPerVertex, float epsilon, int expectedVertices = 1024)
+    {
+        this->floatsPerVertex = floatsPerVertex < 3 ? 3 : floatsPerVertex;
+        this->epsilon = epsilon;
+        cellSize = 2.0f * epsilon;
+        vertexCount = 0;
+        vertexCapacity = 0;
+        bucketMask = 0;
+        vertices = NULL;
+        next = NULL;
+        buckets = NULL;
+
+        reserve(expectedVertices < 16 ? 16 : expectedVertices);
+    }
+
+    ~VertexWelder()
+    {
+        free(vertices);
+        free(next);
+        free(buckets);
+    }
+
+    // Forgets all vertices, keeping the memory.
+    void reset(void)
+    {
+        vertexCount = 0;
+
+        if(buckets != NULL)
+        {
+            memset(buckets, 0xFF, sizeof(unsigned int) * (bucketMask + 1));
+        }
+    }
+
+    // Returns the index of a vertex already added within epsilon of vertex, or adds vertex and
+    // returns its new index. FAILED when growing the arrays fails.
+    unsigned int add(const float *vertex)
+    {
+        if(buckets == NULL)
+        {
+            return FAILED;
+        }
+
+        long long cell[3];
+        long long low[3];
+        long long high[3];
+
+        for(int i = 0; i < 3; i++)
+        {
+            cell[i] = cellOf(vertex[i]);
+            low[i] = cellOf(vertex[i] - epsilon);
+            high[i] = cellOf(vertex[i] + epsilon);
+        }
+
+        // A duplicate is nearly always in the same cell, so that one is looked at first.
+        unsigned int bucket = hash(cell[0], cell[1], cell[2]);
+        unsigned int found = find(vertex, bucket);
+
+        if(found != FAILED)
+        {
+            return found;
+        }
+
+        for(long long x = low[0]; x <= high[0]; x++)
+        {
+            for(long long y = low[1]; y <= high[1]; y++)
+            {
+                for(long long z = low[2]; z <= high[2]; z++)
+                {
+                    if(x != cell[0] || y != cell[1] || z != cell[2])
+                    {
+                        found = find(vertex, hash(x, y, z));
+
+                        if(found != FAILED)
+                        {
+                            return found;
+                        }
+                    }
+                }
+            }
+        }
+
+        if(vertexCount == vertexCapacity)
+        {
+            if(!reserve(vertexCapacity * 2))
+            {
+                return FAILED;
+            }
+
+            // There may be more buckets now.
+            bucket = hash(cell[0], cell[1], cell[2]);
+        }
+
+        unsigned int index = vertexCount++;
+
+        memcpy(vertices + (size_t)index * floatsPerVertex, vertex, sizeof(float) * floatsPerVertex);
+        next[index] = buckets[bucket];
+        buckets[bucket] = index;
+
+        return index;
+    }
+
+    // Welds count soup vertices, floatsPerVertex floats apart, writing one index per vertex.
+    // Returns false if an add() failed.
+    bool addAll(const float *soup, int count, unsigned int *indices)
+    {
+        for(int i = 0; i < count; i++)
+        {
+            indices[i] = add(soup + (size_t)i * floatsPerVertex);
+
+            if(indices[i] == FAILED)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    int getVertexCount(void) const
+    {
+        return (int)vertexCount;
+    }
+
+    int getFloatsPerVertex(void) const
+    {
+        return floatsPerVertex;
+    }
+
+    // Welded vertices, floatsPerVertex floats each, in the order they were first added.
+    const float *getVertices(void) const
+    {
+        return vertices;
+    }
+
+private:
+    int floatsPerVertex;
+    float epsilon;
+    float cellSize;
+    unsigned int vertexCount;
+    unsigned int vertexCapacity;
+    unsigned int bucketMask;
+    float *vertices;
+    unsigned int *next;
+    unsigned int *buckets;
+
+    long long cellOf(float value) const
+    {
+        return (long long)floorf(value / cellSize);
+    }
+
+    unsigned int hash(long long x, long long y, long long z) const
+    {
+        unsigned long long h = (unsigned long long)x * 73856093ULL ^ (unsigned long long)y * 19349663ULL ^ (unsigned long long)z * 83492791ULL;
+        return (unsigned int)(h ^ (h >> 29)) & bucketMask;
+    }
+
+    unsigned int find(const float *vertex, unsigned int bucket) const
+    {
+        for(unsigned int candidate = buckets[bucket]; candidate != FAILED; candidate = next[candidate])
+        {
+            const float *other = vertices + (size_t)candidate * floatsPerVertex;
+            int i = 0;
+
+            while(i < floatsPerVertex && fabsf(other[i] - vertex[i]) < epsilon)
+            {
+                i++;
+            }
+
+            if(i == floatsPerVertex)
+            {
+                return candidate;
+            }
+        }
+
+        return FAILED;
+    }
+
+    // Grows the vertex arrays to capacity and keeps at least two buckets per vertex, rebuilding
+    // the chains when the bucket count changes.
+    bool reserve(unsigned int capacity)
+    {
+        float *newVertices = (float *)realloc(vertices, sizeof(float) * floatsPerVertex * (size_t)capacity);
+
+        if(newVertices == NULL)
+        {
+            return false;
+        }
+
+        vertices = newVertices;
+
+        unsigned int *newNext = (unsigned int *)realloc(next, sizeof(unsigned int) * (size_t)capacity);
+
+        if(newNext == NULL)
+        {
+            return false;
+        }
+
+        next = newNext;
+        vertexCapacity = capacity;
+
+        unsigned int bucketCount = 16;
+
+        while(bucketCount < capacity * 2)
+        {
+            bucketCount *= 2;
+        }
+
+        if(bucketCount == bucketMask + 1 && buckets != NULL)
+        {
+            return true;
+        }
+
+        unsigned int *newBuckets = (unsigned int *)malloc(sizeof(unsigned int) * (size_t)bucketCount);
+
+        if(newBuckets == NULL)
+        {
+            return false;
+        }
+
+        free(buckets);
+        buckets = newBuckets;
+        bucketMask = bucketCount - 1;
+        memset(buckets, 0xFF, sizeof(unsigned int) * bucketCount);
+
+        for(unsigned int i = 0; i < vertexCount; i++)
+        {
+            const float *vertex = vertices + (size_t)i * floatsPerVertex;
+            unsigned int bucket = hash(cellOf(vertex[0]), cellOf(vertex[1]), cellOf(vertex[2]));
+
+            next[i] = buckets[bucket];
+            buckets[bucket] = i;
+        }
+
+        return true;
+    }
+
+    // Owns malloc()ed arrays.
+    VertexWelder(const VertexWelder&);
+    VertexWelder& operator=(const VertexWelder&);
+};
+
+#endif /* __VERTEX_WELDER_H__ */
@@ -0,0 +1,185 @@
+#ifndef __VMATH_FRUSTUM_H__
+#define __VMATH_FRUSTUM_H__
+
+#include "vmath.h"
+#include "vmathSimd.h"
+
+namespace vmath
+{
+
+// Eight bounding spheres stored component wise for the 8 wide culling kernels.
+struct alignas(32) sphere8
+{
+    float x[8];
+    float y[8];
+    float z[8];
+    float radius[8];
+};
+
+// Eight axis aligned boxes stored as center and half extent, which is the form the plane test
+// needs, so no min/max conversion happens per test.
+struct alignas(32) aabb8
+{
+    float centerX[8];
+    float centerY[8];
+    float centerZ[8];
+    float extentX[8];
+    float extentY[8];
+    float extentZ[8];
+};
+
+// The six planes of a view frustum, extracted from a (projection * view) matrix built with
+// perspective(), frustum() or ortho(). Plane normals point inwards and are normalized, so the
+// plane equation gives the signed distance in the units of the space the matrix maps from:
+// world space for projection * view, object space for projection * view * model.
+class Frustum
+{
+public:
+    enum
+    {
+        PLANE_LEFT = 0,
+        PLANE_RIGHT,
+        PLANE_BOTTOM,
+        PLANE_TOP,
+        PLANE_NEAR,
+        PLANE_FAR,
+        PLANE_COUNT
+    };
+
+    inline Frustum()
+    {
+        // Uninitialized, call set() before testing anything.
+    }
+
+    inline explicit Frustum(const mat4& viewProjection)
+    {
+        set(viewProjection);
+    }
+
+    // Gribb and Hartmann: each plane is the last row of the matrix plus or minus one of the other
+    // rows, since a point is inside when -w <= x, y, z <= w in clip space.
+    inline void set(const mat4& m)
+    {
+        const vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        const vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        const vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        const vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        planes[PLANE_LEFT] = row3 + row0;
+        planes[PLANE_RIGHT] = row3 - row0;
+        planes[PLANE_BOTTOM] = row3 + row1;
+        planes[PLANE_TOP] = row3 - row1;
+        planes[PLANE_NEAR] = row3 + row2;
+        planes[PLANE_FAR] = row3 - row2;
+
+        for (int n = 0; n < PLANE_COUNT; n++)
+        {
+            const float length = sqrtf(planes[n][0] * planes[n][0] + planes[n][1] * planes[n][1] + planes[n][2] * planes[n][2]);
+            planes[n] /= length;
+        }
+    }
+
+    inline const vec4& plane(int n) const
+    {
+        return planes[n];
+    }
+
+    // Scalar tests, for single objects.
+    inline bool isSphereVisible(const vec3& center, float radius) const
+    {
+        for (int n = 0; n < PLANE_COUNT; n++)
+        {
+            if (distance(n, center) < -radius)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    inline bool isBoxVisible(const vec3& center, const vec3& extent) const
+    {
+        for (int n = 0; n < PLANE_COUNT; n++)
+        {
+            const float radius = fabsf(planes[n][0]) * extent[0] + fabsf(planes[n][1]) * extent[1] + fabsf(planes[n][2]) * extent[2];
+
+            if (distance(n, center) < -radius)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Tests eight spheres at once. Bit n of the result is set when sphere n is at least partly
+    // inside the frustum.
+    inline unsigned int cullSpheres(const sphere8& spheres) const
+    {
+        const float8 x = float8::load(spheres.x);
+        const float8 y = float8::load(spheres.y);
+        const float8 z = float8::load(spheres.z);
+        const float8 negativeRadius = -float8::load(spheres.radius);
+        float8 outside(0.0f);
+
+        for (int n = 0; n < PLANE_COUNT; n++)
+        {
+            const float8 d = madd(float8(planes[n][0]), x, madd(float8(planes[n][1]), y, madd(float8(planes[n][2]), z, float8(planes[n][3]))));
+            outside = outside | (d < negativeRadius);
+        }
+
+        return ~(unsigned int)movemask(outside) & 0xFFu;
+    }
+
+    // Tests eight boxes at once, bit n of the result is set when box n is at least partly inside.
+    // Each box is projected onto the plane normal to get the radius it reaches towards the plane.
+    inline unsigned int cullBoxes(const aabb8& boxes) const
+    {
+        const float8 x = float8::load(boxes.centerX);
+        const float8 y = float8::load(boxes.centerY);
+        const float8 z = float8::load(boxes.centerZ);
+        const float8 ex = float8::load(boxes.extentX);
+        const float8 ey = float8::load(boxes.extentY);
+        const float8 ez = float8::load(boxes.extentZ);
+        float8 outside(0.0f);
+
+        for (int n = 0; n < PLANE_COUNT; n++)
+        {
+            const float8 d = madd(float8(planes[n][0]), x, madd(float8(planes[n][1]), y, madd(float8(planes[n][2]), z, float8(planes[n][3]))));
+            const float8 radius = madd(float8(fabsf(planes[n][0])), ex, madd(float8(fabsf(planes[n][1])), ey, float8(fabsf(planes[n][2])) * ez));
+            outside = outside | (d < -radius);
+        }
+
+        return ~(unsigned int)movemask(outside) & 0xFFu;
+    }
+
+    // Array forms: visibility[i] receives the mask of block i.
+    inline void cullSpheres(const sphere8 *spheres, int count, unsigned char *visibility) const
+    {
+        for (int i = 0; i < count; i++)
+        {
+            visibility[i] = (unsigned char)cullSpheres(spheres[i]);
+        }
+    }
+
+    inline void cullBoxes(const aabb8 *boxes, int count, unsigned char *visibility) const
+    {
+        for (int i = 0; i < count; i++)
+        {
+            visibility[i] = (unsigned char)cullBoxes(boxes[i]);
+        }
+    }
+
+private:
+    vec4 planes[PLANE_COUNT];
+
+    inline float distance(int n, const vec3& p) const
+    {
+        return planes[n][0] * p[0] + planes[n][1] * p[1] + planes[n][2] * p[2] + planes[n][3];
+    }
+};
+
+};
+
+#endif /* __VMATH_FRUSTUM_H__ */
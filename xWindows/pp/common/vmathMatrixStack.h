@@ -0,0 +1,213 @@
+#ifndef __VMATH_MATRIX_STACK_H__
+#define __VMATH_MATRIX_STACK_H__
+
+#include "vmath.h"
+#include "vmathSimdOps.h"
+
+namespace vmath
+{
+
+// Programmable pipeline replacement for glPushMatrix()/glPopMatrix(). The stack holds the model
+// matrix of each hierarchy level in fixed, 64 byte aligned storage, so push and pop never
+// allocate. Translations, scales and rotations about the x, y or z axis update the affected
+// columns in place rather than doing a full multiply. Each level also caches base * model, where
+// base is usually projection * view, so a sample uploads one matrix per draw and a parent's
+// product is still there after a pop.
+class MatrixStack
+{
+public:
+    enum
+    {
+        MAX_DEPTH = 32
+    };
+
+    inline MatrixStack()
+    {
+        base = mat4::identity();
+        reset();
+    }
+
+    // Empties the stack to a single identity level.
+    inline void reset()
+    {
+        topIndex = 0;
+        entries[0].model = mat4::identity();
+        entries[0].isCombinedValid = false;
+        multiplies = 0;
+    }
+
+    // Matrix every combined() result is premultiplied by, typically projection * view. Setting it
+    // invalidates the cached products of every level.
+    inline void setBase(const mat4& m)
+    {
+        base = m;
+
+        for (int n = 0; n <= topIndex; n++)
+        {
+            entries[n].isCombinedValid = false;
+        }
+    }
+
+    inline void loadIdentity()
+    {
+        entries[topIndex].model = mat4::identity();
+        entries[topIndex].isCombinedValid = false;
+    }
+
+    inline void load(const mat4& m)
+    {
+        entries[topIndex].model = m;
+        entries[topIndex].isCombinedValid = false;
+    }
+
+    // Duplicates the top level, cached product included. Returns false and leaves the stack as it
+    // is when it is full, like GL_STACK_OVERFLOW.
+    inline bool push()
+    {
+        if (topIndex + 1 >= MAX_DEPTH)
+        {
+            return false;
+        }
+
+        entries[topIndex + 1] = entries[topIndex];
+        topIndex++;
+
+        return true;
+    }
+
+    // Returns false when only the bottom level is left, like GL_STACK_UNDERFLOW.
+    inline bool pop()
+    {
+        if (topIndex == 0)
+        {
+            return false;
+        }
+
+        topIndex--;
+
+        return true;
+    }
+
+    // top = top * m, like glMultMatrixf().
+    inline void multiply(const mat4& m)
+    {
+        Entry& entry = entries[topIndex];
+        multiplySimd(entry.model, m, entry.model);
+        entry.isCombinedValid = false;
+        multiplies++;
+    }
+
+    // top = top * translate(x, y, z). Only the last column changes, so this is done in place
+    // instead of as a full multiply.
+    inline void translate(float x, float y, float z)
+    {
+        Entry& entry = entries[topIndex];
+        mat4& m = entry.model;
+
+        m[3] = m[0] * x + m[1] * y + m[2] * z + m[3];
+        entry.isCombinedValid = false;
+    }
+
+    // top = top * scale(x, y, z), done by scaling the first three columns.
+    inline void scale(float x, float y, float z)
+    {
+        Entry& entry = entries[topIndex];
+        mat4& m = entry.model;
+
+        m[0] *= x;
+        m[1] *= y;
+        m[2] *= z;
+        entry.isCombinedValid = false;
+    }
+
+    // top = top * rotate(angle, x, y, z), angle in degrees like glRotatef(). A rotation about one
+    // of the x, y or z axes only mixes two columns, which is what hierarchies mostly use, so only
+    // other axes pay for a full multiply.
+    inline void rotate(float angle, float x, float y, float z)
+    {
+        if (x == 1.0f && y == 0.0f && z == 0.0f)
+        {
+            rotateColumns(angle, 1, 2);
+        }
+        else if (x == 0.0f && y == 1.0f && z == 0.0f)
+        {
+            rotateColumns(angle, 2, 0);
+        }
+        else if (x == 0.0f && y == 0.0f && z == 1.0f)
+        {
+            rotateColumns(angle, 0, 1);
+        }
+        else
+        {
+            multiply(vmath::rotate(angle, x, y, z));
+        }
+    }
+
+    inline const mat4& top() const
+    {
+        return entries[topIndex].model;
+    }
+
+    // base * top, computed at most once per change of the top level.
+    inline const mat4& combined()
+    {
+        Entry& entry = entries[topIndex];
+
+        if (!entry.isCombinedValid)
+        {
+            multiplySimd(base, entry.model, entry.combined);
+            entry.isCombinedValid = true;
+            multiplies++;
+        }
+
+        return entry.combined;
+    }
+
+    inline int depth() const
+    {
+        return topIndex + 1;
+    }
+
+    // Number of full mat4 products done since the last reset() or resetMultiplyCount().
+    inline unsigned int multiplyCount() const
+    {
+        return multiplies;
+    }
+
+    inline void resetMultiplyCount()
+    {
+        multiplies = 0;
+    }
+
+private:
+    struct alignas(64) Entry
+    {
+        mat4 model;
+        mat4 combined;
+        bool isCombinedValid;
+    };
+
+    // Columns a and b of top * (rotation by angle from axis a towards axis b).
+    inline void rotateColumns(float angle, int a, int b)
+    {
+        Entry& entry = entries[topIndex];
+        mat4& m = entry.model;
+        const float rads = angle * 0.0174532925f;
+        const float c = cosf(rads);
+        const float s = sinf(rads);
+        const vec4 columnA = m[a];
+
+        m[a] = columnA * c + m[b] * s;
+        m[b] = m[b] * c - columnA * s;
+        entry.isCombinedValid = false;
+    }
+
+    Entry entries[MAX_DEPTH];
+    mat4 base;
+    int topIndex;
+    unsigned int multiplies;
+};
+
+};
+
+#endif /* __VMATH_MATRIX_STACK_H__ */
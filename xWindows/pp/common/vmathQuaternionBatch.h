@@ -0,0 +1,322 @@
+#ifndef __VMATH_QUATERNION_BATCH_H__
+#define __VMATH_QUATERNION_BATCH_H__
+
+#include "vmath.h"
+#include "vmathSimd.h"
+
+namespace vmath
+{
+
+// Eight quaternions stored component wise (structure of arrays), so that one float8 holds the same
+// component of all eight. Lane n of x, y, z and w is one quaternion laid out like Tquaternion,
+// i.e. w is the real part as used by Tquaternion::operator* and Tquaternion::asMatrix.
+struct alignas(32) quaternion8
+{
+    float x[8];
+    float y[8];
+    float z[8];
+    float w[8];
+};
+
+enum slerpMode
+{
+    SLERP_EXACT = 0,    // acos/sin weights, within a few ulp of a double precision slerp.
+    SLERP_FAST,         // nlerp with a corrected t, no transcendental functions, under 1e-3 radians error.
+};
+
+// Gathers eight quaternions into a block.
+static inline void loadQuaternion8(const quaternion *q, quaternion8& out)
+{
+    for (int n = 0; n < 8; n++)
+    {
+        out.x[n] = q[n][0];
+        out.y[n] = q[n][1];
+        out.z[n] = q[n][2];
+        out.w[n] = q[n][3];
+    }
+}
+
+// Scatters a block back to eight quaternions.
+static inline void storeQuaternion8(const quaternion8& in, quaternion *q)
+{
+    for (int n = 0; n < 8; n++)
+    {
+        q[n] = quaternion(in.x[n], in.y[n], in.z[n], in.w[n]);
+    }
+}
+
+// Scalar versions, for single quaternions and for the tail of arrays that are not a multiple of 8.
+template <typename T>
+static inline Tquaternion<T> nlerp(const Tquaternion<T>& a, const Tquaternion<T>& b, T t)
+{
+    const T d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+    const T s = d < T(0) ? -t : t;
+    const T r = T(1) - t;
+
+    Tquaternion<T> q(r * a[0] + s * b[0], r * a[1] + s * b[1], r * a[2] + s * b[2], r * a[3] + s * b[3]);
+
+    return q / (T)sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+}
+
+template <typename T>
+static inline Tquaternion<T> slerp(const Tquaternion<T>& a, const Tquaternion<T>& b, T t)
+{
+    T d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+    const T sign = d < T(0) ? T(-1) : T(1);
+    d = d * sign;
+
+    // Nearly parallel, sin(theta) is too small to divide by so fall back to nlerp.
+    if (d > T(0.9995))
+    {
+        return nlerp(a, b, t);
+    }
+
+    const T theta = (T)acos(d);
+    const T sinTheta = (T)sqrt(T(1) - d * d);
+    const T wa = (T)sin((T(1) - t) * theta) / sinTheta;
+    const T wb = sign * (T)sin(t * theta) / sinTheta;
+
+    return Tquaternion<T>(wa * a[0] + wb * b[0], wa * a[1] + wb * b[1], wa * a[2] + wb * b[2], wa * a[3] + wb * b[3]);
+}
+
+// acos(x) for x in [0, 1], from the Cephes asinf polynomial.
+static inline float8 acosPositive8(const float8& x)
+{
+    const float8 half(0.5f);
+    const float8 useHalfAngle = x > half;
+
+    // acos(x) = 2 * asin(sqrt((1 - x) / 2)) above 0.5 and pi / 2 - asin(x) below it.
+    const float8 z = select(useHalfAngle, x * x, half * (float8(1.0f) - x));
+    const float8 s = select(useHalfAngle, x, sqrt(z));
+
+    float8 p(4.2163199048E-2f);
+    p = madd(p, z, float8(2.4181311049E-2f));
+    p = madd(p, z, float8(4.5470025998E-2f));
+    p = madd(p, z, float8(7.4953002686E-2f));
+    p = madd(p, z, float8(1.6666752422E-1f));
+    const float8 asinS = madd(p * z, s, s);
+
+    return select(useHalfAngle, float8(1.57079632679f) - asinS, asinS + asinS);
+}
+
+// sin(x) for x in [0, pi / 2], Taylor series to x^11 which stays under 6e-8 absolute error there.
+static inline float8 sinQuadrant8(const float8& x)
+{
+    const float8 x2 = x * x;
+
+    float8 p(-2.5052108385e-8f);
+    p = madd(p, x2, float8(2.7557319224e-6f));
+    p = madd(p, x2, float8(-1.9841269841e-4f));
+    p = madd(p, x2, float8(8.3333333333e-3f));
+    p = madd(p, x2, float8(-1.6666666667e-1f));
+    p = madd(p, x2, float8(1.0f));
+
+    return p * x;
+}
+
+// Blends a and b with weights wa and wb and renormalizes, shared by the interpolation kernels.
+static inline void blendQuaternion8(const quaternion8& a, const quaternion8& b, const float8& wa, const float8& wb, quaternion8& result)
+{
+    float8 x = madd(wa, float8::load(a.x), wb * float8::load(b.x));
+    float8 y = madd(wa, float8::load(a.y), wb * float8::load(b.y));
+    float8 z = madd(wa, float8::load(a.z), wb * float8::load(b.z));
+    float8 w = madd(wa, float8::load(a.w), wb * float8::load(b.w));
+
+    const float8 invLength = float8(1.0f) / sqrt(madd(x, x, madd(y, y, madd(z, z, w * w))));
+    x *= invLength;
+    y *= invLength;
+    z *= invLength;
+    w *= invLength;
+
+    x.store(result.x);
+    y.store(result.y);
+    z.store(result.z);
+    w.store(result.w);
+}
+
+static inline float8 dotQuaternion8(const quaternion8& a, const quaternion8& b)
+{
+    return madd(float8::load(a.x), float8::load(b.x),
+           madd(float8::load(a.y), float8::load(b.y),
+           madd(float8::load(a.z), float8::load(b.z),
+                float8::load(a.w) * float8::load(b.w))));
+}
+
+// a * b for count blocks, the Hamilton product as in Tquaternion::operator*.
+static inline void multiplyBatch(const quaternion8 *a, const quaternion8 *b, quaternion8 *result, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const float8 x1 = float8::load(a[i].x);
+        const float8 y1 = float8::load(a[i].y);
+        const float8 z1 = float8::load(a[i].z);
+        const float8 w1 = float8::load(a[i].w);
+        const float8 x2 = float8::load(b[i].x);
+        const float8 y2 = float8::load(b[i].y);
+        const float8 z2 = float8::load(b[i].z);
+        const float8 w2 = float8::load(b[i].w);
+
+        (w1 * x2 + x1 * w2 + y1 * z2 - z1 * y2).store(result[i].x);
+        (w1 * y2 + y1 * w2 + z1 * x2 - x1 * z2).store(result[i].y);
+        (w1 * z2 + z1 * w2 + x1 * y2 - y1 * x2).store(result[i].z);
+        (w1 * w2 - x1 * x2 - y1 * y2 - z1 * z2).store(result[i].w);
+    }
+}
+
+// normalize() for count blocks.
+static inline void normalizeBatch(const quaternion8 *q, quaternion8 *result, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const float8 x = float8::load(q[i].x);
+        const float8 y = float8::load(q[i].y);
+        const float8 z = float8::load(q[i].z);
+        const float8 w = float8::load(q[i].w);
+        const float8 invLength = float8(1.0f) / sqrt(madd(x, x, madd(y, y, madd(z, z, w * w))));
+
+        (x * invLength).store(result[i].x);
+        (y * invLength).store(result[i].y);
+        (z * invLength).store(result[i].z);
+        (w * invLength).store(result[i].w);
+    }
+}
+
+// Normalized linear interpolation of count blocks, taking the shortest path.
+// t holds 8 * count interpolation factors, one per lane.
+static inline void nlerpBatch(const quaternion8 *a, const quaternion8 *b, const float *t, quaternion8 *result, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const float8 d = dotQuaternion8(a[i], b[i]);
+        const float8 tb = float8::loadUnaligned(t + i * 8);
+        const float8 ta = float8(1.0f) - tb;
+
+        blendQuaternion8(a[i], b[i], ta, flipSign(tb, d), result[i]);
+    }
+}
+
+// Spherical linear interpolation of count blocks, taking the shortest path.
+// t holds 8 * count interpolation factors, one per lane.
+static inline void slerpBatch(const quaternion8 *a, const quaternion8 *b, const float *t, quaternion8 *result, int count, slerpMode mode = SLERP_EXACT)
+{
+    const float8 one(1.0f);
+
+    for (int i = 0; i < count; i++)
+    {
+        const float8 d = dotQuaternion8(a[i], b[i]);
+        const float8 cosTheta = min(abs(d), one);
+        const float8 tb = float8::loadUnaligned(t + i * 8);
+
+        if (mode == SLERP_FAST)
+        {
+            // Corrected nlerp: t is bent along a cubic fitted against slerp over the whole range
+            // of cosTheta, which brings nlerp to within 1e-3 radians of slerp.
+            const float8 half(0.5f);
+            const float8 tc = tb - half;
+            const float8 a0 = madd(madd(madd(float8(-1.43519f), cosTheta, float8(3.55645f)), cosTheta, float8(-3.2452f)), cosTheta, float8(1.0904f));
+            const float8 b0 = madd(madd(float8(0.215638f), cosTheta, float8(-1.06021f)), cosTheta, float8(0.848013f));
+            const float8 k = madd(a0 * tc, tc, b0);
+            const float8 ot = madd(tb * tc * (tb - one), k, tb);
+
+            blendQuaternion8(a[i], b[i], one - ot, flipSign(ot, d), result[i]);
+        }
+        else
+        {
+            const float8 theta = acosPositive8(cosTheta);
+            const float8 sinTheta = sqrt(max(one - cosTheta * cosTheta, float8(0.0f)));
+
+            // Nearly parallel lanes use nlerp weights, sin(theta) is too small to divide by.
+            const float8 nearlyParallel = cosTheta > float8(0.9995f);
+            const float8 invSinTheta = one / select(nearlyParallel, sinTheta, one);
+            const float8 wa = select(nearlyParallel, sinQuadrant8((one - tb) * theta) * invSinTheta, one - tb);
+            const float8 wb = select(nearlyParallel, sinQuadrant8(tb * theta) * invSinTheta, tb);
+
+            blendQuaternion8(a[i], b[i], wa, flipSign(wb, d), result[i]);
+        }
+    }
+}
+
+// Rotation part of each quaternion in the block, laid out like Tquaternion::asMatrix.
+// Quaternions are expected to be normalized.
+static inline void quaternionRotation8(const quaternion8& q, float (&m)[9][8])
+{
+    const float8 x = float8::load(q.x);
+    const float8 y = float8::load(q.y);
+    const float8 z = float8::load(q.z);
+    const float8 w = float8::load(q.w);
+    const float8 one(1.0f);
+    const float8 two(2.0f);
+
+    const float8 x2 = x * two;
+    const float8 y2 = y * two;
+    const float8 z2 = z * two;
+
+    const float8 xx = x * x2;
+    const float8 yy = y * y2;
+    const float8 zz = z * z2;
+    const float8 xy = x * y2;
+    const float8 xz = x * z2;
+    const float8 yz = y * z2;
+    const float8 xw = w * x2;
+    const float8 yw = w * y2;
+    const float8 zw = w * z2;
+
+    (one - (yy + zz)).store(m[0]);
+    (xy - zw).store(m[1]);
+    (xz + yw).store(m[2]);
+
+    (xy + zw).store(m[3]);
+    (one - (xx + zz)).store(m[4]);
+    (yz - xw).store(m[5]);
+
+    (xz - yw).store(m[6]);
+    (yz + xw).store(m[7]);
+    (one - (xx + yy)).store(m[8]);
+}
+
+// Converts count blocks to 8 * count matrices, the batched form of quaternionToMatrix.
+static inline void quaternionToMatrixBatch(const quaternion8 *q, mat4 *m, int count)
+{
+    alignas(32) float r[9][8];
+
+    for (int i = 0; i < count; i++)
+    {
+        quaternionRotation8(q[i], r);
+
+        for (int n = 0; n < 8; n++)
+        {
+            float *out = (float *)m[i * 8 + n];
+
+            out[0] = r[0][n];  out[1] = r[1][n];  out[2] = r[2][n];  out[3] = 0.0f;
+            out[4] = r[3][n];  out[5] = r[4][n];  out[6] = r[5][n];  out[7] = 0.0f;
+            out[8] = r[6][n];  out[9] = r[7][n];  out[10] = r[8][n]; out[11] = 0.0f;
+            out[12] = 0.0f;    out[13] = 0.0f;    out[14] = 0.0f;    out[15] = 1.0f;
+        }
+    }
+}
+
+// Converts count blocks to 8 * count row major 3x4 matrices (three vec4 rows of the same matrix
+// quaternionToMatrix produces, with a zero translation column), the compact form used for bone
+// palettes and instance data.
+static inline void quaternionToMatrix3x4Batch(const quaternion8 *q, float (*m)[12], int count)
+{
+    alignas(32) float r[9][8];
+
+    for (int i = 0; i < count; i++)
+    {
+        quaternionRotation8(q[i], r);
+
+        for (int n = 0; n < 8; n++)
+        {
+            float *out = m[i * 8 + n];
+
+            out[0] = r[0][n];  out[1] = r[3][n];  out[2] = r[6][n];  out[3] = 0.0f;
+            out[4] = r[1][n];  out[5] = r[4][n];  out[6] = r[7][n];  out[7] = 0.0f;
+            out[8] = r[2][n];  out[9] = r[5][n];  out[10] = r[8][n]; out[11] = 0.0f;
+        }
+    }
+}
+
+};
+
+#endif /* __VMATH_QUATERNION_BATCH_H__ */
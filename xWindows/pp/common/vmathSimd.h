@@ -0,0 +1,251 @@
+#ifndef __VMATH_SIMD_H__
+#define __VMATH_SIMD_H__
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "vmath.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace vmath
+{
+
+// The float8 overloads below would otherwise hide the scalar sqrt and abs from code inside vmath.
+using ::sqrt;
+using ::abs;
+
+// Eight floats processed together. When compiled with -mavx this maps to one 256 bit register,
+// otherwise it falls back to a plain loop over the lanes so that the batch kernels built on top
+// of it still compile and give the same results on any target.
+//
+// Comparison operators return a lane mask: all bits set in lanes where the comparison is true and
+// all bits clear elsewhere, which is what select() and movemask() expect.
+struct alignas(32) float8
+{
+#if defined(__AVX__)
+    __m256 v;
+
+    inline float8() {}
+    inline float8(__m256 _v) : v(_v) {}
+    inline explicit float8(float s) : v(_mm256_set1_ps(s)) {}
+
+    static inline float8 load(const float *p) { return float8(_mm256_load_ps(p)); }
+    static inline float8 loadUnaligned(const float *p) { return float8(_mm256_loadu_ps(p)); }
+    inline void store(float *p) const { _mm256_store_ps(p, v); }
+    inline void storeUnaligned(float *p) const { _mm256_storeu_ps(p, v); }
+#else
+    float v[8];
+
+    inline float8() {}
+    inline explicit float8(float s) { for (int n = 0; n < 8; n++) v[n] = s; }
+
+    static inline float8 load(const float *p) { float8 r; memcpy(r.v, p, sizeof(r.v)); return r; }
+    static inline float8 loadUnaligned(const float *p) { return load(p); }
+    inline void store(float *p) const { memcpy(p, v, sizeof(v)); }
+    inline void storeUnaligned(float *p) const { store(p); }
+#endif
+};
+
+#if defined(__AVX__)
+
+static inline float8 operator+(const float8& a, const float8& b) { return _mm256_add_ps(a.v, b.v); }
+static inline float8 operator-(const float8& a, const float8& b) { return _mm256_sub_ps(a.v, b.v); }
+static inline float8 operator*(const float8& a, const float8& b) { return _mm256_mul_ps(a.v, b.v); }
+static inline float8 operator/(const float8& a, const float8& b) { return _mm256_div_ps(a.v, b.v); }
+static inline float8 operator-(const float8& a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+
+static inline float8 operator<(const float8& a, const float8& b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ); }
+static inline float8 operator<=(const float8& a, const float8& b) { return _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ); }
+static inline float8 operator>(const float8& a, const float8& b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ); }
+static inline float8 operator>=(const float8& a, const float8& b) { return _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ); }
+static inline float8 operator&(const float8& a, const float8& b) { return _mm256_and_ps(a.v, b.v); }
+static inline float8 operator|(const float8& a, const float8& b) { return _mm256_or_ps(a.v, b.v); }
+static inline float8 operator^(const float8& a, const float8& b) { return _mm256_xor_ps(a.v, b.v); }
+
+static inline float8 min(const float8& a, const float8& b) { return _mm256_min_ps(a.v, b.v); }
+static inline float8 max(const float8& a, const float8& b) { return _mm256_max_ps(a.v, b.v); }
+static inline float8 sqrt(const float8& a) { return _mm256_sqrt_ps(a.v); }
+static inline float8 abs(const float8& a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+
+// Multiply add, fused when the target has FMA.
+static inline float8 madd(const float8& a, const float8& b, const float8& c)
+{
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a.v, b.v, c.v);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v);
+#endif
+}
+
+// Picks b in lanes where mask is set and a elsewhere.
+static inline float8 select(const float8& mask, const float8& a, const float8& b) { return _mm256_blendv_ps(a.v, b.v, mask.v); }
+
+// The sign bit of each lane of a, packed into the low 8 bits of the result.
+static inline int movemask(const float8& a) { return _mm256_movemask_ps(a.v); }
+
+#else
+
+#define VMATH_FLOAT8_BINARY(op)                                               \
+static inline float8 operator op(const float8& a, const float8& b)            \
+{                                                                             \
+    float8 r;                                                                 \
+    for (int n = 0; n < 8; n++) r.v[n] = a.v[n] op b.v[n];                    \
+    return r;                                                                 \
+}
+
+#define VMATH_FLOAT8_COMPARE(op)                                              \
+static inline float8 operator op(const float8& a, const float8& b)            \
+{                                                                             \
+    float8 r;                                                                 \
+    for (int n = 0; n < 8; n++)                                               \
+    {                                                                         \
+        unsigned int bits = (a.v[n] op b.v[n]) ? 0xFFFFFFFFu : 0u;            \
+        memcpy(&r.v[n], &bits, sizeof(bits));                                 \
+    }                                                                         \
+    return r;                                                                 \
+}
+
+#define VMATH_FLOAT8_BITWISE(op)                                              \
+static inline float8 operator op(const float8& a, const float8& b)            \
+{                                                                             \
+    float8 r;                                                                 \
+    for (int n = 0; n < 8; n++)                                               \
+    {                                                                         \
+        unsigned int x, y;                                                    \
+        memcpy(&x, &a.v[n], sizeof(x));                                       \
+        memcpy(&y, &b.v[n], sizeof(y));                                       \
+        x = x op y;                                                           \
+        memcpy(&r.v[n], &x, sizeof(x));                                       \
+    }                                                                         \
+    return r;                                                                 \
+}
+
+VMATH_FLOAT8_BINARY(+)
+VMATH_FLOAT8_BINARY(-)
+VMATH_FLOAT8_BINARY(*)
+VMATH_FLOAT8_BINARY(/)
+VMATH_FLOAT8_COMPARE(<)
+VMATH_FLOAT8_COMPARE(<=)
+VMATH_FLOAT8_COMPARE(>)
+VMATH_FLOAT8_COMPARE(>=)
+VMATH_FLOAT8_BITWISE(&)
+VMATH_FLOAT8_BITWISE(|)
+VMATH_FLOAT8_BITWISE(^)
+
+#undef VMATH_FLOAT8_BINARY
+#undef VMATH_FLOAT8_COMPARE
+#undef VMATH_FLOAT8_BITWISE
+
+static inline float8 operator-(const float8& a)
+{
+    float8 r;
+    for (int n = 0; n < 8; n++) r.v[n] = -a.v[n];
+    return r;
+}
+
+static inline float8 min(const float8& a, const float8& b)
+{
+    float8 r;
+    for (int n = 0; n < 8; n++) r.v[n] = a.v[n] < b.v[n] ? a.v[n] : b.v[n];
+    return r;
+}
+
+static inline float8 max(const float8& a, const float8& b)
+{
+    float8 r;
+    for (int n = 0; n < 8; n++) r.v[n] = a.v[n] > b.v[n] ? a.v[n] : b.v[n];
+    return r;
+}
+
+static inline float8 sqrt(const float8& a)
+{
+    float8 r;
+    for (int n = 0; n < 8; n++) r.v[n] = sqrtf(a.v[n]);
+    return r;
+}
+
+static inline float8 abs(const float8& a)
+{
+    float8 r;
+    for (int n = 0; n < 8; n++) r.v[n] = fabsf(a.v[n]);
+    return r;
+}
+
+static inline float8 madd(const float8& a, const float8& b, const float8& c)
+{
+    return a * b + c;
+}
+
+static inline float8 select(const float8& mask, const float8& a, const float8& b)
+{
+    float8 r;
+    for (int n = 0; n < 8; n++)
+    {
+        unsigned int bits;
+        memcpy(&bits, &mask.v[n], sizeof(bits));
+        r.v[n] = (bits & 0x80000000u) ? b.v[n] : a.v[n];
+    }
+    return r;
+}
+
+static inline int movemask(const float8& a)
+{
+    int result = 0;
+    for (int n = 0; n < 8; n++)
+    {
+        unsigned int bits;
+        memcpy(&bits, &a.v[n], sizeof(bits));
+        result |= (int)(bits >> 31) << n;
+    }
+    return result;
+}
+
+#endif
+
+static inline float8 operator+=(float8& a, const float8& b) { return (a = a + b); }
+static inline float8 operator-=(float8& a, const float8& b) { return (a = a - b); }
+static inline float8 operator*=(float8& a, const float8& b) { return (a = a * b); }
+
+// a with its sign flipped in the lanes where s is negative, i.e. a * sign(s) without a multiply.
+static inline float8 flipSign(const float8& a, const float8& s)
+{
+    return a ^ (s & float8(-0.0f));
+}
+
+// Loads four consecutive floats from base + offsets[n] for each lane n and transposes them, so
+// out[k] holds element k of all eight. This is the gather pattern of a palette lookup, done with
+// plain loads and shuffles since hardware gathers are slow on many CPUs.
+static inline void gather4(const float *base, const int *offsets, float8 *out)
+{
+#if defined(__AVX__)
+    const __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(base + offsets[0])), _mm_loadu_ps(base + offsets[4]), 1);
+    const __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(base + offsets[1])), _mm_loadu_ps(base + offsets[5]), 1);
+    const __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(base + offsets[2])), _mm_loadu_ps(base + offsets[6]), 1);
+    const __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(base + offsets[3])), _mm_loadu_ps(base + offsets[7]), 1);
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+    out[0] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    out[1] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    out[2] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    out[3] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+#else
+    for (int n = 0; n < 8; n++)
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            out[k].v[n] = base[offsets[n] + k];
+        }
+    }
+#endif
+}
+
+};
+
+#endif /* __VMATH_SIMD_H__ */
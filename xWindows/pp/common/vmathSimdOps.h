@@ -0,0 +1,155 @@
+#ifndef __VMATH_SIMD_OPS_H__
+#define __VMATH_SIMD_OPS_H__
+
+#include "vmath.h"
+#include "vmathSimd.h"
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace vmath
+{
+
+// SIMD variants of the vmath operations that show up in every frame. Each one gives the same
+// result as the vmath function named in its comment, up to rounding, so they can be swapped in
+// where profiling says it is worth it. Without SSE they fall back to the vmath code itself.
+
+// result = a * b, like matNM::operator*.
+static inline void multiplySimd(const mat4& a, const mat4& b, mat4& result)
+{
+#if defined(__SSE__)
+    const float *pa = a;
+    const float *pb = b;
+    float *pr = result;
+
+    const __m128 a0 = _mm_loadu_ps(pa + 0);
+    const __m128 a1 = _mm_loadu_ps(pa + 4);
+    const __m128 a2 = _mm_loadu_ps(pa + 8);
+    const __m128 a3 = _mm_loadu_ps(pa + 12);
+
+    // Column j of the result is the columns of a weighted by column j of b.
+    for (int j = 0; j < 4; j++)
+    {
+        __m128 r = _mm_mul_ps(a0, _mm_set1_ps(pb[j * 4 + 0]));
+        r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(pb[j * 4 + 1])));
+        r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(pb[j * 4 + 2])));
+        r = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(pb[j * 4 + 3])));
+        _mm_storeu_ps(pr + j * 4, r);
+    }
+#else
+    result = a * b;
+#endif
+}
+
+// result = v * m, like the vecN * matNM operator, i.e. each result component is the dot product
+// of v with one column of m.
+static inline void multiplySimd(const vec4& v, const mat4& m, vec4& result)
+{
+#if defined(__SSE__)
+    const float *pm = m;
+
+    __m128 c0 = _mm_loadu_ps(pm + 0);
+    __m128 c1 = _mm_loadu_ps(pm + 4);
+    __m128 c2 = _mm_loadu_ps(pm + 8);
+    __m128 c3 = _mm_loadu_ps(pm + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+
+    alignas(16) float out[4];
+    _mm_store_ps(out, r);
+    result = vec4(out[0], out[1], out[2], out[3]);
+#else
+    result = v * m;
+#endif
+}
+
+// result = m.transpose().
+static inline void transposeSimd(const mat4& m, mat4& result)
+{
+#if defined(__SSE__)
+    const float *pm = m;
+    float *pr = result;
+
+    __m128 c0 = _mm_loadu_ps(pm + 0);
+    __m128 c1 = _mm_loadu_ps(pm + 4);
+    __m128 c2 = _mm_loadu_ps(pm + 8);
+    __m128 c3 = _mm_loadu_ps(pm + 12);
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+    _mm_storeu_ps(pr + 0, c0);
+    _mm_storeu_ps(pr + 4, c1);
+    _mm_storeu_ps(pr + 8, c2);
+    _mm_storeu_ps(pr + 12, c3);
+#else
+    result = m.transpose();
+#endif
+}
+
+// Eight vec3 stored component wise, the vector counterpart of quaternion8.
+struct alignas(32) vec3x8
+{
+    float x[8];
+    float y[8];
+    float z[8];
+};
+
+static inline void loadVec3x8(const vec3 *v, vec3x8& out)
+{
+    for (int n = 0; n < 8; n++)
+    {
+        out.x[n] = v[n][0];
+        out.y[n] = v[n][1];
+        out.z[n] = v[n][2];
+    }
+}
+
+static inline void storeVec3x8(const vec3x8& in, vec3 *v)
+{
+    for (int n = 0; n < 8; n++)
+    {
+        v[n] = vec3(in.x[n], in.y[n], in.z[n]);
+    }
+}
+
+// normalize() for count blocks of eight vectors.
+static inline void normalizeBatch(const vec3x8 *v, vec3x8 *result, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const float8 x = float8::load(v[i].x);
+        const float8 y = float8::load(v[i].y);
+        const float8 z = float8::load(v[i].z);
+        const float8 invLength = float8(1.0f) / sqrt(madd(x, x, madd(y, y, z * z)));
+
+        (x * invLength).store(result[i].x);
+        (y * invLength).store(result[i].y);
+        (z * invLength).store(result[i].z);
+    }
+}
+
+// cross() for count blocks of eight vector pairs.
+static inline void crossBatch(const vec3x8 *a, const vec3x8 *b, vec3x8 *result, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        const float8 ax = float8::load(a[i].x);
+        const float8 ay = float8::load(a[i].y);
+        const float8 az = float8::load(a[i].z);
+        const float8 bx = float8::load(b[i].x);
+        const float8 by = float8::load(b[i].y);
+        const float8 bz = float8::load(b[i].z);
+
+        (ay * bz - by * az).store(result[i].x);
+        (az * bx - bz * ax).store(result[i].y);
+        (ax * by - bx * ay).store(result[i].z);
+    }
+}
+
+};
+
+#endif /* __VMATH_SIMD_OPS_H__ */
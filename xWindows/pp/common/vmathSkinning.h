@@ -0,0 +1,478 @@
+#ifndef __VMATH_SKINNING_H__
+#define __VMATH_SKINNING_H__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+#include "vmath.h"
+#include "vmathSimd.h"
+#include "vmathSimdOps.h"
+
+namespace vmath
+{
+
+// CPU skinning of vertex blocks in the vec3x8 layout, with linear blend skinning (LBS) or dual
+// quaternion skinning (DQS). Joint indices and weights come in matching blocks of eight vertices,
+// four influences each; unused influences have weight 0 and any valid joint index.
+//
+// Palettes are built once per frame from the skinning matrices (joint world matrix times inverse
+// bind matrix) and read per lane with gather4(), so the joint count is only limited by memory.
+
+enum
+{
+    SKINNING_INFLUENCES = 4
+};
+
+enum skinningMode
+{
+    SKINNING_LINEAR_BLEND = 0,
+    SKINNING_DUAL_QUATERNION
+};
+
+struct alignas(32) skinInfluences8
+{
+    int joint[SKINNING_INFLUENCES][8];
+    float weight[SKINNING_INFLUENCES][8];
+};
+
+// One skinning pass over count blocks. normals and skinnedNormals may both be NULL.
+struct skinningJob
+{
+    const vec3x8 *positions;
+    const vec3x8 *normals;
+    const skinInfluences8 *influences;
+    const float (*matrixPalette)[12];
+    const float (*dualQuaternionPalette)[8];
+    vec3x8 *skinnedPositions;
+    vec3x8 *skinnedNormals;
+    int count;
+};
+
+// Row major 3x4 matrices, the bottom row of a skinning matrix is always (0, 0, 0, 1).
+static inline void buildMatrixPalette(const mat4 *joints, int count, float (*palette)[12])
+{
+    for (int j = 0; j < count; j++)
+    {
+        for (int row = 0; row < 3; row++)
+        {
+            for (int column = 0; column < 4; column++)
+            {
+                palette[j][row * 4 + column] = joints[j][column][row];
+            }
+        }
+    }
+}
+
+// Unit dual quaternions (real x, y, z, w, dual x, y, z, w) for rigid skinning matrices. Scale in
+// the matrices is not representable and is dropped.
+static inline void buildDualQuaternionPalette(const mat4 *joints, int count, float (*palette)[8])
+{
+    for (int j = 0; j < count; j++)
+    {
+        const mat4& m = joints[j];
+        float x, y, z, w;
+
+        // Largest of the four candidates first, so the square root is never taken of a small value.
+        const float trace = m[0][0] + m[1][1] + m[2][2];
+
+        if (trace > 0.0f)
+        {
+            const float s = 0.5f / sqrtf(trace + 1.0f);
+            w = 0.25f / s;
+            x = (m[1][2] - m[2][1]) * s;
+            y = (m[2][0] - m[0][2]) * s;
+            z = (m[0][1] - m[1][0]) * s;
+        }
+        else if (m[0][0] > m[1][1] && m[0][0] > m[2][2])
+        {
+            const float s = 2.0f * sqrtf(1.0f + m[0][0] - m[1][1] - m[2][2]);
+            w = (m[1][2] - m[2][1]) / s;
+            x = 0.25f * s;
+            y = (m[1][0] + m[0][1]) / s;
+            z = (m[2][0] + m[0][2]) / s;
+        }
+        else if (m[1][1] > m[2][2])
+        {
+            const float s = 2.0f * sqrtf(1.0f + m[1][1] - m[0][0] - m[2][2]);
+            w = (m[2][0] - m[0][2]) / s;
+            x = (m[1][0] + m[0][1]) / s;
+            y = 0.25f * s;
+            z = (m[2][1] + m[1][2]) / s;
+        }
+        else
+        {
+            const float s = 2.0f * sqrtf(1.0f + m[2][2] - m[0][0] - m[1][1]);
+            w = (m[0][1] - m[1][0]) / s;
+            x = (m[2][0] + m[0][2]) / s;
+            y = (m[2][1] + m[1][2]) / s;
+            z = 0.25f * s;
+        }
+
+        const float invLength = 1.0f / sqrtf(x * x + y * y + z * z + w * w);
+        x *= invLength;
+        y *= invLength;
+        z *= invLength;
+        w *= invLength;
+
+        // dual = 0.5 * (0, t) * real
+        const float tx = m[3][0];
+        const float ty = m[3][1];
+        const float tz = m[3][2];
+
+        palette[j][0] = x;
+        palette[j][1] = y;
+        palette[j][2] = z;
+        palette[j][3] = w;
+        palette[j][4] = 0.5f * (w * tx + ty * z - tz * y);
+        palette[j][5] = 0.5f * (w * ty + tz * x - tx * z);
+        palette[j][6] = 0.5f * (w * tz + tx * y - ty * x);
+        palette[j][7] = -0.5f * (tx * x + ty * y + tz * z);
+    }
+}
+
+// Scalar LBS of one vertex, the reference for the batch kernel.
+static inline void skinLinearBlend(const vec3& position, const vec3& normal, const int *joints, const float *weights,
+                                   const float (*palette)[12], vec3& skinnedPosition, vec3& skinnedNormal)
+{
+    float m[12] = {0.0f};
+
+    for (int i = 0; i < SKINNING_INFLUENCES; i++)
+    {
+        for (int k = 0; k < 12; k++)
+        {
+            m[k] += weights[i] * palette[joints[i]][k];
+        }
+    }
+
+    skinnedPosition = vec3(m[0] * position[0] + m[1] * position[1] + m[2] * position[2] + m[3],
+                           m[4] * position[0] + m[5] * position[1] + m[6] * position[2] + m[7],
+                           m[8] * position[0] + m[9] * position[1] + m[10] * position[2] + m[11]);
+    skinnedNormal = normalize(vec3(m[0] * normal[0] + m[1] * normal[1] + m[2] * normal[2],
+                                   m[4] * normal[0] + m[5] * normal[1] + m[6] * normal[2],
+                                   m[8] * normal[0] + m[9] * normal[1] + m[10] * normal[2]));
+}
+
+// Scalar DQS of one vertex, the reference for the batch kernel.
+static inline void skinDualQuaternion(const vec3& position, const vec3& normal, const int *joints, const float *weights,
+                                      const float (*palette)[8], vec3& skinnedPosition, vec3& skinnedNormal)
+{
+    float b[8] = {0.0f};
+    const float *first = palette[joints[0]];
+
+    for (int i = 0; i < SKINNING_INFLUENCES; i++)
+    {
+        const float *q = palette[joints[i]];
+
+        // q and -q are the same rotation, blend each one on the same side as the first.
+        const float dot = q[0] * first[0] + q[1] * first[1] + q[2] * first[2] + q[3] * first[3];
+        const float w = dot < 0.0f ? -weights[i] : weights[i];
+
+        for (int k = 0; k < 8; k++)
+        {
+            b[k] += w * q[k];
+        }
+    }
+
+    const float invLength = 1.0f / sqrtf(b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3]);
+
+    for (int k = 0; k < 8; k++)
+    {
+        b[k] *= invLength;
+    }
+
+    const vec3 r(b[0], b[1], b[2]);
+    const vec3 d(b[4], b[5], b[6]);
+    const vec3 t = (d * b[3] - r * b[7] + cross(r, d)) * 2.0f;
+
+    skinnedPosition = position + cross(r, cross(r, position) + position * b[3]) * 2.0f + t;
+    skinnedNormal = normal + cross(r, cross(r, normal) + normal * b[3]) * 2.0f;
+}
+
+// LBS of blocks [first, last) of job. The blended 3x4 matrix is built per lane from gathered
+// palette rows; normals are transformed by its 3x3 part and renormalized.
+static inline void skinLinearBlendBatch(const skinningJob& job, int first, int last)
+{
+    const float *palette = job.matrixPalette[0];
+
+    for (int block = first; block < last; block++)
+    {
+        const skinInfluences8& influences = job.influences[block];
+        float8 m[12];
+
+        for (int i = 0; i < SKINNING_INFLUENCES; i++)
+        {
+            alignas(32) int offsets[8];
+
+            for (int n = 0; n < 8; n++)
+            {
+                offsets[n] = influences.joint[i][n] * 12;
+            }
+
+            const float8 weight = float8::load(influences.weight[i]);
+
+            float8 rows[12];
+            gather4(palette, offsets, rows);
+            gather4(palette + 4, offsets, rows + 4);
+            gather4(palette + 8, offsets, rows + 8);
+
+            for (int k = 0; k < 12; k++)
+            {
+                m[k] = i == 0 ? weight * rows[k] : madd(weight, rows[k], m[k]);
+            }
+        }
+
+        const float8 x = float8::load(job.positions[block].x);
+        const float8 y = float8::load(job.positions[block].y);
+        const float8 z = float8::load(job.positions[block].z);
+
+        madd(m[0], x, madd(m[1], y, madd(m[2], z, m[3]))).store(job.skinnedPositions[block].x);
+        madd(m[4], x, madd(m[5], y, madd(m[6], z, m[7]))).store(job.skinnedPositions[block].y);
+        madd(m[8], x, madd(m[9], y, madd(m[10], z, m[11]))).store(job.skinnedPositions[block].z);
+
+        if (job.normals != NULL)
+        {
+            const float8 nx = float8::load(job.normals[block].x);
+            const float8 ny = float8::load(job.normals[block].y);
+            const float8 nz = float8::load(job.normals[block].z);
+            const float8 rx = madd(m[0], nx, madd(m[1], ny, m[2] * nz));
+            const float8 ry = madd(m[4], nx, madd(m[5], ny, m[6] * nz));
+            const float8 rz = madd(m[8], nx, madd(m[9], ny, m[10] * nz));
+            const float8 invLength = float8(1.0f) / sqrt(madd(rx, rx, madd(ry, ry, rz * rz)));
+
+            (rx * invLength).store(job.skinnedNormals[block].x);
+            (ry * invLength).store(job.skinnedNormals[block].y);
+            (rz * invLength).store(job.skinnedNormals[block].z);
+        }
+    }
+}
+
+// DQS of blocks [first, last) of job.
+static inline void skinDualQuaternionBatch(const skinningJob& job, int first, int last)
+{
+    const float *palette = job.dualQuaternionPalette[0];
+
+    for (int block = first; block < last; block++)
+    {
+        const skinInfluences8& influences = job.influences[block];
+        float8 b[8];
+        float8 first[4];
+
+        for (int i = 0; i < SKINNING_INFLUENCES; i++)
+        {
+            alignas(32) int offsets[8];
+
+            for (int n = 0; n < 8; n++)
+            {
+                offsets[n] = influences.joint[i][n] * 8;
+            }
+
+            float8 q[8];
+            gather4(palette, offsets, q);
+            gather4(palette + 4, offsets, q + 4);
+
+            float8 weight = float8::load(influences.weight[i]);
+
+            if (i == 0)
+            {
+                for (int k = 0; k < 8; k++)
+                {
+                    b[k] = weight * q[k];
+                }
+
+                for (int k = 0; k < 4; k++)
+                {
+                    first[k] = q[k];
+                }
+            }
+            else
+            {
+                // Keep every influence on the same side as the first, see skinDualQuaternion().
+                weight = flipSign(weight, madd(q[0], first[0], madd(q[1], first[1], madd(q[2], first[2], q[3] * first[3]))));
+
+                for (int k = 0; k < 8; k++)
+                {
+                    b[k] = madd(weight, q[k], b[k]);
+                }
+            }
+        }
+
+        const float8 invLength = float8(1.0f) / sqrt(madd(b[0], b[0], madd(b[1], b[1], madd(b[2], b[2], b[3] * b[3]))));
+        const float8 rx = b[0] * invLength;
+        const float8 ry = b[1] * invLength;
+        const float8 rz = b[2] * invLength;
+        const float8 rw = b[3] * invLength;
+        const float8 dx = b[4] * invLength;
+        const float8 dy = b[5] * invLength;
+        const float8 dz = b[6] * invLength;
+        const float8 dw = b[7] * invLength;
+
+        // t = 2 * (rw * d - dw * r + r x d)
+        const float8 two(2.0f);
+        const float8 tx = two * (madd(rw, dx, ry * dz - rz * dy) - dw * rx);
+        const float8 ty = two * (madd(rw, dy, rz * dx - rx * dz) - dw * ry);
+        const float8 tz = two * (madd(rw, dz, rx * dy - ry * dx) - dw * rz);
+
+        // v + 2 * r x (r x v + rw * v)
+        const float8 x = float8::load(job.positions[block].x);
+        const float8 y = float8::load(job.positions[block].y);
+        const float8 z = float8::load(job.positions[block].z);
+        float8 cx = madd(rw, x, ry * z - rz * y);
+        float8 cy = madd(rw, y, rz * x - rx * z);
+        float8 cz = madd(rw, z, rx * y - ry * x);
+
+        madd(two, ry * cz - rz * cy, x + tx).store(job.skinnedPositions[block].x);
+        madd(two, rz * cx - rx * cz, y + ty).store(job.skinnedPositions[block].y);
+        madd(two, rx * cy - ry * cx, z + tz).store(job.skinnedPositions[block].z);
+
+        if (job.normals != NULL)
+        {
+            const float8 nx = float8::load(job.normals[block].x);
+            const float8 ny = float8::load(job.normals[block].y);
+            const float8 nz = float8::load(job.normals[block].z);
+            cx = madd(rw, nx, ry * nz - rz * ny);
+            cy = madd(rw, ny, rz * nx - rx * nz);
+            cz = madd(rw, nz, rx * ny - ry * nx);
+
+            madd(two, ry * cz - rz * cy, nx).store(job.skinnedNormals[block].x);
+            madd(two, rz * cx - rx * cz, ny).store(job.skinnedNormals[block].y);
+            madd(two, rx * cy - ry * cx, nz).store(job.skinnedNormals[block].z);
+        }
+    }
+}
+
+static inline void skinBatch(const skinningJob& job, skinningMode mode, int first, int last)
+{
+    if (mode == SKINNING_DUAL_QUATERNION)
+    {
+        skinDualQuaternionBatch(job, first, last);
+    }
+    else
+    {
+        skinLinearBlendBatch(job, first, last);
+    }
+}
+
+// Splits skinning jobs across worker threads that live as long as the pool, so a frame only pays
+// for waking them up. The calling thread takes the first share of every job.
+class SkinningThreadPool
+{
+public:
+    // threadCount counts the calling thread, 0 means one per hardware thread.
+    inline explicit SkinningThreadPool(int threadCount = 0)
+    {
+        if (threadCount <= 0)
+        {
+            threadCount = (int)std::thread::hardware_concurrency();
+        }
+
+        threads = threadCount > 1 ? threadCount : 1;
+        generation = 0;
+        pending = 0;
+        isStopping = false;
+        currentJob = NULL;
+        currentMode = SKINNING_LINEAR_BLEND;
+
+        for (int n = 1; n < threads; n++)
+        {
+            workers.push_back(std::thread(&SkinningThreadPool::workerMain, this, n));
+        }
+    }
+
+    inline ~SkinningThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopping = true;
+            generation++;
+        }
+
+        wakeUp.notify_all();
+
+        for (size_t n = 0; n < workers.size(); n++)
+        {
+            workers[n].join();
+        }
+    }
+
+    inline int threadCount() const
+    {
+        return threads;
+    }
+
+    // Skins the whole job and returns when every block is written.
+    inline void run(const skinningJob& job, skinningMode mode)
+    {
+        if (threads == 1)
+        {
+            skinBatch(job, mode, 0, job.count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            currentJob = &job;
+            currentMode = mode;
+            pending = threads - 1;
+            generation++;
+        }
+
+        wakeUp.notify_all();
+        runShare(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return pending == 0; });
+        currentJob = NULL;
+    }
+
+private:
+    inline void runShare(int index)
+    {
+        const int count = currentJob->count;
+        skinBatch(*currentJob, currentMode, count * index / threads, count * (index + 1) / threads);
+    }
+
+    inline void workerMain(int index)
+    {
+        unsigned int seenGeneration = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [&]() { return generation != seenGeneration; });
+                seenGeneration = generation;
+
+                if (isStopping)
+                {
+                    return;
+                }
+            }
+
+            runShare(index);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending--;
+            }
+
+            finished.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable finished;
+    const skinningJob *currentJob;
+    skinningMode currentMode;
+    unsigned int generation;
+    int pending;
+    int threads;
+    bool isStopping;
+};
+
+};
+
+#endif /* __VMATH_SKINNING_H__ */
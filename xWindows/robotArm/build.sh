@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o robotArm robotArm.cpp -lX11 -lGL -lGLU
+g++ -I../pp/common -o robotArm robotArm.cpp -lX11 -lGL -lGLU
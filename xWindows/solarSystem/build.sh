@@ -1,3 +1,3 @@
 #!/bin/bash
 
-g++ -o solarSystem solarSystem.cpp -lX11 -lGL -lGLU
+g++ -I../pp/common -o solarSystem solarSystem.cpp -lX11 -lGL -lGLU
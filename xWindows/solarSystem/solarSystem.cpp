@@ -3,7 +3,11 @@
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <memory.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/XKBlib.h>
@@ -12,6 +16,8 @@
 #include <GL/glx.h>
 #include <GL/glu.h>
 
+#include "primitives.h"
+
 bool isFullscreen = false;
 bool isCloseButtonClicked = false;
 bool isEscapeKeyPressed = false;
@@ -22,7 +28,20 @@ int windowHeight = 600;
 GLint year = 0;
 GLint day = 0;
 
-GLUquadric *guadric = NULL;
+PrimitiveLibrary primitives;
+int sphereSun = PrimitiveLibrary::INVALID;
+int sphereEarth = PrimitiveLibrary::INVALID;
+
+// With --statistics, heap growth and primitives tessellated per frame, averaged over FRAMES_PER_LOG
+// frames because the driver allocates and frees a little on its own, printed whenever they change.
+// The heap is measured with glibc's mallinfo2() and stays 0 elsewhere.
+#define FRAMES_PER_LOG 100
+bool isStatisticsEnabled = false;
+int framesSinceLog = 0;
+long long heapInUseAtLog = 0;
+unsigned int tessellationsSinceLog = 0;
+long long loggedHeapGrowth = -1;
+unsigned int loggedTessellations = ~0u;
 
 Display *gDisplay = NULL;
 XVisualInfo *visualInfo = NULL;
@@ -35,15 +54,25 @@ void initialize(void);
 void cleanup(void);
 void handleEvent(XEvent *event);
 void display(void);
+void logFrameStatistics(void);
+long long heapInUse(void);
 void drawSolarSystem(void);
 void resize(int width, int height);
 void toggleFullscreen(bool isFullscreen);
 
-int main(void)
+int main(int argc, char **argv)
 {
     XEvent event;
     bool done = false;
 
+    for(int n = 1; n < argc; n++)
+    {
+        if(strcmp(argv[n], "--statistics") == 0)
+        {
+            isStatisticsEnabled = true;
+        }
+    }
+
     createWindow();
     initialize();
 
@@ -140,6 +169,15 @@ void initialize(void)
     glDepthFunc(GL_LEQUAL);
     glShadeModel(GL_SMOOTH);
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+
+    // Tessellated once here instead of by gluSphere() every frame.
+    // 2nd parameter is for slices (like longitudes)
+    // 3rd parameter is for stacks (like latitudes)
+    // Higher the value of 2nd and 3rd parameters, i.e. more the subdivisions,
+    // more circular the sphere will look.
+    sphereSun = primitives.sphere(0.75f, 30, 30);
+    sphereEarth = primitives.sphere(0.2f, 20, 20);
+
     resize(windowWidth, windowHeight);
 }
 
@@ -244,6 +282,8 @@ void handleEvent(XEvent *event)
 
 void display(void)
 {
+    primitives.resetFrameStatistics();
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
@@ -252,9 +292,54 @@ void display(void)
     // Draw the solar system.
     drawSolarSystem();
 
+    if(isStatisticsEnabled)
+    {
+        logFrameStatistics();
+    }
+
     glXSwapBuffers(gDisplay, window);
 }
 
+long long heapInUse(void)
+{
+#ifdef __GLIBC__
+    return (long long)mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+void logFrameStatistics(void)
+{
+    long long heapNow = heapInUse();
+
+    tessellationsSinceLog += primitives.getFrameStatistics().tessellations;
+
+    if(framesSinceLog++ == 0)
+    {
+        heapInUseAtLog = heapNow;
+        return;
+    }
+
+    if(framesSinceLog <= FRAMES_PER_LOG)
+    {
+        return;
+    }
+
+    long long heapGrowth = (heapNow - heapInUseAtLog) / FRAMES_PER_LOG;
+
+    if(heapGrowth != loggedHeapGrowth || tessellationsSinceLog != loggedTessellations)
+    {
+        printf("Per frame: %lld bytes of heap allocated, %u primitives tessellated, %u drawn with %u triangles.\n", heapGrowth, tessellationsSinceLog / FRAMES_PER_LOG, primitives.getFrameStatistics().draws, primitives.getFrameStatistics().trianglesDrawn);
+        loggedHeapGrowth = heapGrowth;
+        loggedTessellations = tessellationsSinceLog;
+    }
+
+    framesSinceLog = 1;
+    heapInUseAtLog = heapNow;
+    tessellationsSinceLog = 0;
+}
+
 void drawSolarSystem(void)
 {
     // Push initial matrix.
@@ -267,14 +352,8 @@ void drawSolarSystem(void)
 	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
     // Draw the sun
-    guadric = gluNewQuadric();
     glColor3f(1.0f, 1.0f, 0.0f);
-
-    // 3rd parameter is for slices (like longitudes)
-    // 4th parameter is for stacks (like latitudes)
-    // Higher the value of 3rd and 4th parameters, i.e. more the subdivisions,
-    // more circular the sphere will look.
-    gluSphere(guadric, 0.75, 30, 30);
+    primitives.draw(sphereSun);
 
     // Pop back to initial state.
     glPopMatrix();
@@ -294,9 +373,8 @@ void drawSolarSystem(void)
     glRotatef((GLfloat)day, 0.0f, 0.0f, 1.0f);
 
     glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    guadric = gluNewQuadric();
     glColor3f(0.4f, 0.9f, 1.0f);
-    gluSphere(guadric, 0.2f, 20, 20);
+    primitives.draw(sphereEarth);
 
     // Pop the elbow transformation state.
     glPopMatrix();
@@ -343,6 +421,8 @@ void cleanup(void)
         toggleFullscreen(false);
     }
 
+    primitives.clear();
+
     GLXContext currentContext = glXGetCurrentContext();
 
     if(currentContext != NULL && currentContext == glxContext)